@@ -0,0 +1,471 @@
+/*
+   Copyright (c) 2026, the contributors of this file. See the version
+   control history for the individual authors.
+
+   This file is a contribution to MySQL. It is distributed under the same
+   license as the rest of the server, with no copyright assigned to
+   Oracle.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+*/
+
+/*
+  Linux native aio benchmark.
+
+  Measures IOPS against a local file at queue depths 1 .. 128 with the
+  two submission strategies of the InnoDB native aio path:
+
+  single   every page is its own iocb and its own io_submit() call,
+           which is how os_aio_func() used to dispatch requests;
+
+  batched  the pages that are queued while the previous requests are
+           in flight form one batch, runs of contiguous pages are merged
+           into one vectored iocb (IO_CMD_PREADV / IO_CMD_PWRITEV) and
+           the whole batch goes to the kernel in one io_submit() call,
+           as os_aio_linux_submit_pending() does.
+
+  Completions are reaped in bulk with io_getevents() in both modes.
+  The workload picks random runs of -r contiguous pages, which models
+  read-ahead and neighbour flushing. The file is opened with O_DIRECT.
+
+  Usage: innodb_aio_bench [-w] [-s size_mb] [-b block] [-t secs]
+                          [-r run] file
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <libaio.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/** maximum queue depth that is measured */
+#define BENCH_MAX_DEPTH		128
+
+/** maximum number of pages merged into one iocb */
+#define BENCH_MERGE_MAX		16
+
+/** One request in flight */
+struct bench_req_t {
+	struct iocb	control;		/* aio control block */
+	struct iovec	iov[BENCH_MERGE_MAX];	/* pages of the request */
+	unsigned	n_pages;		/* number of pages */
+	unsigned	bufs[BENCH_MERGE_MAX];	/* buffer numbers */
+};
+
+/** Benchmark parameters */
+struct bench_opt_t {
+	bool		write;		/* true for writes */
+	unsigned long	size_mb;	/* size of the file in MiB */
+	unsigned long	block;		/* page size in bytes */
+	unsigned long	secs;		/* seconds per measurement */
+	unsigned long	run;		/* contiguous pages per run */
+	const char*	path;		/* file to run against */
+};
+
+/** Result of one measurement */
+struct bench_res_t {
+	double		secs;		/* elapsed time */
+	unsigned long	pages;		/* pages transferred */
+	unsigned long	submits;	/* io_submit() calls */
+	unsigned long	iocbs;		/* iocbs submitted */
+};
+
+/** Stream of page numbers made of random runs of contiguous pages */
+struct bench_stream_t {
+	unsigned long	n_pages;	/* pages in the file */
+	unsigned long	run;		/* pages per run */
+	unsigned long	next;		/* next page number */
+	unsigned long	left;		/* pages left in current run */
+	unsigned int	seed;		/* rand_r() state */
+};
+
+/*********************************************************************//**
+Returns the current time in seconds. */
+static
+double
+bench_now(void)
+{
+	struct timeval	tv;
+
+	gettimeofday(&tv, NULL);
+
+	return(tv.tv_sec + tv.tv_usec / 1000000.0);
+}
+
+/*********************************************************************//**
+Returns the next page number of the stream. */
+static
+unsigned long
+bench_stream_next(
+	bench_stream_t*	s)	/*!< in/out: stream */
+{
+	if (s->left == 0) {
+		unsigned long	n_runs = s->n_pages / s->run;
+		unsigned long	r;
+
+		r = ((unsigned long) rand_r(&s->seed) << 16)
+			^ (unsigned long) rand_r(&s->seed);
+
+		s->next = (r % n_runs) * s->run;
+		s->left = s->run;
+	}
+
+	s->left--;
+
+	return(s->next++);
+}
+
+/*********************************************************************//**
+Creates the file and fills it, so that reads hit allocated blocks.
+@return file descriptor opened with O_DIRECT, or -1 */
+static
+int
+bench_open(
+	const bench_opt_t*	opt)	/*!< in: parameters */
+{
+	unsigned long	chunk = 1024 * 1024;
+	unsigned long	size = opt->size_mb * chunk;
+	struct stat	st;
+	int		fd;
+
+	if (stat(opt->path, &st) != 0 || (unsigned long) st.st_size < size) {
+		char*	buf;
+
+		fd = open(opt->path, O_RDWR | O_CREAT, 0660);
+
+		if (fd < 0) {
+			perror(opt->path);
+			return(-1);
+		}
+
+		buf = static_cast<char*>(malloc(chunk));
+		memset(buf, 0xA5, chunk);
+
+		for (unsigned long off = 0; off < size; off += chunk) {
+			if (pwrite(fd, buf, chunk, off) != (ssize_t) chunk) {
+				perror("pwrite");
+				free(buf);
+				close(fd);
+				return(-1);
+			}
+		}
+
+		fsync(fd);
+		free(buf);
+		close(fd);
+	}
+
+	fd = open(opt->path, O_RDWR | O_DIRECT);
+
+	if (fd < 0) {
+		perror(opt->path);
+	}
+
+	return(fd);
+}
+
+/*********************************************************************//**
+Runs the workload at one queue depth.
+@return 0 on success */
+static
+int
+bench_run(
+	const bench_opt_t*	opt,	/*!< in: parameters */
+	int			fd,	/*!< in: file */
+	char*			mem,	/*!< in: BENCH_MAX_DEPTH aligned
+					page buffers */
+	unsigned		depth,	/*!< in: pages in flight */
+	bool			batched,/*!< in: merge and batch requests */
+	bench_res_t*		res)	/*!< out: result */
+{
+	io_context_t	ctx;
+	bench_req_t	reqs[BENCH_MAX_DEPTH];
+	bench_req_t*	free_reqs[BENCH_MAX_DEPTH];
+	unsigned	free_bufs[BENCH_MAX_DEPTH];
+	struct iocb*	batch[BENCH_MAX_DEPTH];
+	struct io_event	events[BENCH_MAX_DEPTH];
+	unsigned	n_free_reqs = depth;
+	unsigned	n_free_bufs = depth;
+	unsigned	in_flight = 0;
+	bench_stream_t	stream;
+	double		start;
+	double		end;
+	int		ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+
+	ret = io_setup(depth, &ctx);
+
+	if (ret != 0) {
+		fprintf(stderr, "io_setup: %s\n", strerror(-ret));
+		return(1);
+	}
+
+	for (unsigned i = 0; i < depth; i++) {
+		free_reqs[i] = &reqs[i];
+		free_bufs[i] = i;
+	}
+
+	stream.n_pages = opt->size_mb * 1024 * 1024 / opt->block;
+	stream.run = opt->run;
+	stream.left = 0;
+	stream.next = 0;
+	stream.seed = depth;
+
+	memset(res, 0, sizeof(*res));
+
+	start = bench_now();
+	end = start + opt->secs;
+
+	for (;;) {
+		unsigned	n_batch = 0;
+		bench_req_t*	prev = NULL;
+		unsigned long	prev_end = 0;
+
+		/* Queue pages until the queue depth is reached. */
+		while (in_flight < depth && bench_now() < end) {
+			unsigned long	page = bench_stream_next(&stream);
+			unsigned	buf = free_bufs[--n_free_bufs];
+			bench_req_t*	req;
+
+			in_flight++;
+
+			if (batched && prev != NULL && page == prev_end
+			    && prev->n_pages < BENCH_MERGE_MAX) {
+
+				/* Contiguous with the previous request
+				of the batch: merge. */
+				req = prev;
+			} else {
+				req = free_reqs[--n_free_reqs];
+				req->n_pages = 0;
+
+				if (batched) {
+					batch[n_batch++] = &req->control;
+				}
+			}
+
+			req->bufs[req->n_pages] = buf;
+			req->iov[req->n_pages].iov_base
+				= mem + (size_t) buf * opt->block;
+			req->iov[req->n_pages].iov_len = opt->block;
+
+			if (req->n_pages++ == 0) {
+				off_t	off = (off_t) page * opt->block;
+
+				if (opt->write) {
+					io_prep_pwritev(&req->control, fd,
+							req->iov, 1, off);
+				} else {
+					io_prep_preadv(&req->control, fd,
+						       req->iov, 1, off);
+				}
+
+				req->control.data = req;
+			} else {
+				req->control.u.v.nr = req->n_pages;
+			}
+
+			prev = req;
+			prev_end = page + 1;
+
+			if (!batched) {
+				struct iocb*	iocb = &req->control;
+
+				ret = io_submit(ctx, 1, &iocb);
+				res->submits++;
+				res->iocbs++;
+
+				if (ret != 1) {
+					fprintf(stderr, "io_submit: %s\n",
+						strerror(-ret));
+					return(1);
+				}
+
+				prev = NULL;
+			}
+		}
+
+		for (unsigned done = 0; done < n_batch; ) {
+			ret = io_submit(ctx, n_batch - done, batch + done);
+			res->submits++;
+
+			if (ret <= 0) {
+				fprintf(stderr, "io_submit: %s\n",
+					strerror(-ret));
+				return(1);
+			}
+
+			res->iocbs += ret;
+			done += ret;
+		}
+
+		if (in_flight == 0) {
+			break;
+		}
+
+		/* Reap all the completions that are available. */
+		ret = io_getevents(ctx, 1, depth, events, NULL);
+
+		if (ret < 0) {
+			if (ret == -EINTR) {
+				continue;
+			}
+
+			fprintf(stderr, "io_getevents: %s\n", strerror(-ret));
+			return(1);
+		}
+
+		for (int i = 0; i < ret; i++) {
+			bench_req_t*	req = static_cast<bench_req_t*>(
+				events[i].data);
+
+			if ((long) events[i].res
+			    != (long) (req->n_pages * opt->block)) {
+				fprintf(stderr, "short or failed i/o: %ld\n",
+					(long) events[i].res);
+				return(1);
+			}
+
+			for (unsigned j = 0; j < req->n_pages; j++) {
+				free_bufs[n_free_bufs++] = req->bufs[j];
+			}
+
+			in_flight -= req->n_pages;
+			res->pages += req->n_pages;
+			free_reqs[n_free_reqs++] = req;
+		}
+	}
+
+	res->secs = bench_now() - start;
+
+	io_destroy(ctx);
+
+	return(0);
+}
+
+/*********************************************************************//**
+Prints the usage and exits. */
+static
+void
+bench_usage(
+	const char*	name)	/*!< in: program name */
+{
+	fprintf(stderr,
+		"Usage: %s [-w] [-s size_mb] [-b block] [-t secs] [-r run]"
+		" file\n"
+		"  -w  measure writes instead of reads\n"
+		"  -s  size of the test file in MiB (default 1024)\n"
+		"  -b  page size in bytes (default 16384)\n"
+		"  -t  seconds per measurement (default 5)\n"
+		"  -r  contiguous pages per run (default 4)\n", name);
+	exit(1);
+}
+
+int
+main(
+	int	argc,
+	char**	argv)
+{
+	bench_opt_t	opt;
+	void*		mem;
+	int		fd;
+	int		c;
+
+	opt.write = false;
+	opt.size_mb = 1024;
+	opt.block = 16384;
+	opt.secs = 5;
+	opt.run = 4;
+
+	while ((c = getopt(argc, argv, "ws:b:t:r:")) != -1) {
+		switch (c) {
+		case 'w':
+			opt.write = true;
+			break;
+		case 's':
+			opt.size_mb = strtoul(optarg, NULL, 10);
+			break;
+		case 'b':
+			opt.block = strtoul(optarg, NULL, 10);
+			break;
+		case 't':
+			opt.secs = strtoul(optarg, NULL, 10);
+			break;
+		case 'r':
+			opt.run = strtoul(optarg, NULL, 10);
+			break;
+		default:
+			bench_usage(argv[0]);
+		}
+	}
+
+	if (optind != argc - 1
+	    || opt.block == 0 || opt.block % 512 != 0
+	    || opt.run == 0 || opt.secs == 0
+	    || opt.size_mb * 1024 * 1024 / opt.block < opt.run) {
+		bench_usage(argv[0]);
+	}
+
+	opt.path = argv[optind];
+
+	fd = bench_open(&opt);
+
+	if (fd < 0) {
+		return(1);
+	}
+
+	if (posix_memalign(&mem, 4096, BENCH_MAX_DEPTH * opt.block) != 0) {
+		fprintf(stderr, "out of memory\n");
+		return(1);
+	}
+
+	memset(mem, 0x5A, BENCH_MAX_DEPTH * opt.block);
+
+	printf("%s, %lu byte pages, runs of %lu pages, %lu MiB file\n",
+	       opt.write ? "random writes" : "random reads",
+	       opt.block, opt.run, opt.size_mb);
+	printf("%5s  %-7s  %10s  %9s  %12s  %11s\n",
+	       "depth", "mode", "IOPS", "MB/s", "submits/s", "pages/iocb");
+
+	for (unsigned depth = 1; depth <= BENCH_MAX_DEPTH; depth *= 2) {
+		for (int batched = 0; batched < 2; batched++) {
+			bench_res_t	res;
+
+			if (bench_run(&opt, fd, static_cast<char*>(mem),
+				      depth, batched != 0, &res)) {
+				return(1);
+			}
+
+			printf("%5u  %-7s  %10.0f  %9.1f  %12.0f  %11.2f\n",
+			       depth, batched ? "batched" : "single",
+			       res.pages / res.secs,
+			       res.pages * (double) opt.block
+			       / res.secs / 1048576.0,
+			       res.submits / res.secs,
+			       res.iocbs
+			       ? (double) res.pages / res.iocbs : 0.0);
+		}
+	}
+
+	free(mem);
+	close(fd);
+
+	return(0);
+}
@@ -0,0 +1,555 @@
+/*****************************************************************************
+
+Copyright (c) 2026, the contributors of this file. See the version control
+history for the individual authors.
+
+This file is a contribution to MySQL. It is distributed under the same
+license as the rest of the server, with no copyright assigned to Oracle.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file btr/btr0bulk.cc
+Bottom-up loading of a B-tree from sorted input
+
+Created 10/18/2026
+*******************************************************/
+
+#include "btr0bulk.h"
+
+#include "buf0lru.h"
+#include "dict0dict.h"
+#include "fsp0fsp.h"
+#include "ibuf0ibuf.h"
+#include "log0log.h"
+#include "page0page.h"
+#include "rem0rec.h"
+#include "trx0sys.h"
+#include "trx0trx.h"
+
+/** innodb_fill_factor: percentage of the space of each B-tree page that
+is filled by the bulk loader, leaving the rest for future inserts */
+UNIV_INTERN ulong	btr_bulk_fill_factor = 100;
+
+/** Size of the memory heap for building a node pointer */
+#define BTR_BULK_NODE_PTR_HEAP_SIZE	1024
+
+/*********************************************************************//**
+Appends a record to a level of the tree.
+@return	DB_SUCCESS or error code */
+static
+dberr_t
+btr_bulk_insert_low(
+/*================*/
+	btr_bulk_t*	bulk,		/*!< in/out: bulk load */
+	ulint		level_no,	/*!< in: B-tree level */
+	const dtuple_t*	tuple)		/*!< in: index entry or node pointer */
+	__attribute__((nonnull, warn_unused_result));
+
+/*********************************************************************//**
+Allocates and creates a page of the tree that is being bulk loaded, and
+x-latches it in a mini-transaction that is started here. If the page
+cannot be allocated, the mini-transaction is committed.
+@return	DB_SUCCESS or DB_OUT_OF_FILE_SPACE */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+btr_bulk_page_create(
+/*=================*/
+	btr_bulk_t*	bulk,		/*!< in: bulk load */
+	ulint		level_no,	/*!< in: B-tree level of the page */
+	ulint		prev_page_no,	/*!< in: the preceding page on the
+					level, or FIL_NULL */
+	mtr_t*		mtr,		/*!< out: mini-transaction */
+	buf_block_t**	block)		/*!< out: the page */
+{
+	dict_index_t*	index	= bulk->index;
+	ulint		space	= dict_index_get_space(index);
+	ulint		hint_page_no;
+	ulint		n_reserved;
+	mtr_t		alloc_mtr;
+	page_t*		page;
+
+	mtr_start(mtr);
+	mtr_set_log_mode(mtr, bulk->log_mode);
+
+	/* The page allocation is always redo logged, so that the file
+	segments stay consistent even if the tree is not. */
+	mtr_start(&alloc_mtr);
+	mtr_x_lock(dict_index_get_lock(index), &alloc_mtr);
+
+	if (!fsp_reserve_free_extents(&n_reserved, space, 2,
+				      FSP_NORMAL, &alloc_mtr)) {
+		mtr_commit(&alloc_mtr);
+		mtr_commit(mtr);
+		return(DB_OUT_OF_FILE_SPACE);
+	}
+
+	hint_page_no = prev_page_no == FIL_NULL
+		? dict_index_get_page(index) + 1
+		: prev_page_no + 1;
+
+	*block = btr_page_alloc(index, hint_page_no, FSP_UP, level_no,
+				&alloc_mtr, mtr);
+
+	if (n_reserved > 0) {
+		fil_space_release_free_extents(space, n_reserved);
+	}
+
+	mtr_commit(&alloc_mtr);
+
+	if (*block == NULL) {
+		mtr_commit(mtr);
+		return(DB_OUT_OF_FILE_SPACE);
+	}
+
+	btr_page_create(*block, NULL, index, level_no, mtr);
+
+	page = buf_block_get_frame(*block);
+
+	btr_page_set_next(page, NULL, FIL_NULL, mtr);
+	btr_page_set_prev(page, NULL, prev_page_no, mtr);
+
+	if (level_no == 0 && dict_index_is_sec_or_ibuf(index)) {
+		page_update_max_trx_id(*block, NULL, bulk->trx_id, mtr);
+
+		/* The bits may be left over from an earlier use of the
+		page. They are set when the page has been filled. */
+		ibuf_reset_free_bits(*block);
+	}
+
+	return(DB_SUCCESS);
+}
+
+/*********************************************************************//**
+Commits the mini-transaction of the current page of a level, after
+updating the insert buffer free bits of a filled leaf page. */
+static __attribute__((nonnull))
+void
+btr_bulk_page_commit(
+/*=================*/
+	btr_bulk_t*		bulk,		/*!< in: bulk load */
+	btr_bulk_level_t*	level,		/*!< in/out: level */
+	ulint			level_no)	/*!< in: B-tree level */
+{
+	if (level_no == 0 && dict_index_is_sec_or_ibuf(bulk->index)) {
+		ibuf_update_free_bits_low(level->block, 0, level->mtr);
+	}
+
+	mtr_commit(level->mtr);
+	level->block = NULL;
+}
+
+/*********************************************************************//**
+Starts a level of the tree, whose first page will be its leftmost page.
+@return	DB_SUCCESS or error code */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+btr_bulk_level_create(
+/*==================*/
+	btr_bulk_t*	bulk,		/*!< in/out: bulk load */
+	ulint		level_no)	/*!< in: B-tree level, equal to
+					bulk->n_levels */
+{
+	btr_bulk_level_t*	level;
+	dberr_t			err;
+
+	ut_ad(level_no == bulk->n_levels);
+
+	if (level_no >= BTR_MAX_LEVELS) {
+		return(DB_CORRUPTION);
+	}
+
+	level = static_cast<btr_bulk_level_t*>(
+		mem_heap_zalloc(bulk->heap, sizeof *level));
+
+	level->mtr = &level->mtrs[0];
+
+	err = btr_bulk_page_create(bulk, level_no, FIL_NULL,
+				   level->mtr, &level->block);
+
+	if (err != DB_SUCCESS) {
+		return(err);
+	}
+
+	level->page_no = buf_block_get_page_no(level->block);
+	page_cur_set_before_first(level->block, &level->cur);
+
+	bulk->levels[level_no] = level;
+	bulk->n_levels = level_no + 1;
+
+	return(DB_SUCCESS);
+}
+
+/*********************************************************************//**
+Appends the node pointer to the current page of a level to the level
+above it, which is started if it does not exist yet.
+@return	DB_SUCCESS or error code */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+btr_bulk_node_ptr_insert(
+/*=====================*/
+	btr_bulk_t*	bulk,		/*!< in/out: bulk load */
+	ulint		level_no)	/*!< in: B-tree level of the child */
+{
+	btr_bulk_level_t*	level	= bulk->levels[level_no];
+	const rec_t*		first;
+	dtuple_t*		node_ptr;
+	mem_heap_t*		heap;
+	dberr_t			err;
+
+	first = page_rec_get_next_const(page_get_infimum_rec(
+		buf_block_get_frame(level->block)));
+	ut_ad(page_rec_is_user_rec(first));
+
+	heap = mem_heap_create(BTR_BULK_NODE_PTR_HEAP_SIZE);
+
+	node_ptr = dict_index_build_node_ptr(
+		bulk->index, first, level->page_no, heap, level_no);
+
+	err = btr_bulk_insert_low(bulk, level_no + 1, node_ptr);
+
+	mem_heap_free(heap);
+
+	return(err);
+}
+
+/*********************************************************************//**
+Releases the latches on the current pages of all levels, so that the
+thread may wait for a log checkpoint. */
+static __attribute__((nonnull))
+void
+btr_bulk_release(
+/*=============*/
+	btr_bulk_t*	bulk)	/*!< in/out: bulk load */
+{
+	for (ulint i = 0; i < bulk->n_levels; i++) {
+		btr_bulk_level_t*	level = bulk->levels[i];
+
+		level->cur_offset = page_offset(page_cur_get_rec(&level->cur));
+
+		mtr_commit(level->mtr);
+		level->block = NULL;
+	}
+}
+
+/*********************************************************************//**
+Latches the current pages of all levels again after btr_bulk_release(). */
+static __attribute__((nonnull))
+void
+btr_bulk_relatch(
+/*=============*/
+	btr_bulk_t*	bulk)	/*!< in/out: bulk load */
+{
+	ulint	space = dict_index_get_space(bulk->index);
+	ulint	i = bulk->n_levels;
+
+	while (i--) {
+		btr_bulk_level_t*	level = bulk->levels[i];
+
+		mtr_start(level->mtr);
+		mtr_set_log_mode(level->mtr, bulk->log_mode);
+
+		level->block = btr_block_get(space, 0, level->page_no,
+					     RW_X_LATCH, bulk->index,
+					     level->mtr);
+
+		page_cur_position(buf_block_get_frame(level->block)
+				  + level->cur_offset,
+				  level->block, &level->cur);
+	}
+}
+
+/*********************************************************************//**
+Continues a level on a new page. The node pointer to the filled page is
+appended to the level above it. After a leaf page has been filled, the
+latches are released for a log_free_check().
+@return	DB_SUCCESS or error code */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+btr_bulk_switch_page(
+/*=================*/
+	btr_bulk_t*	bulk,		/*!< in/out: bulk load */
+	ulint		level_no)	/*!< in: B-tree level */
+{
+	btr_bulk_level_t*	level	= bulk->levels[level_no];
+	mtr_t*			new_mtr;
+	buf_block_t*		new_block;
+	dberr_t			err;
+
+	new_mtr = level->mtr == &level->mtrs[0]
+		? &level->mtrs[1] : &level->mtrs[0];
+
+	err = btr_bulk_page_create(bulk, level_no, level->page_no,
+				   new_mtr, &new_block);
+
+	if (err != DB_SUCCESS) {
+		return(err);
+	}
+
+	btr_page_set_next(buf_block_get_frame(level->block), NULL,
+			  buf_block_get_page_no(new_block), level->mtr);
+
+	err = btr_bulk_node_ptr_insert(bulk, level_no);
+
+	/* Even on error, move on to the new page, so that only one
+	mini-transaction per level remains to be committed. */
+	btr_bulk_page_commit(bulk, level, level_no);
+
+	level->mtr = new_mtr;
+	level->block = new_block;
+	level->page_no = buf_block_get_page_no(new_block);
+	page_cur_set_before_first(new_block, &level->cur);
+
+	if (err == DB_SUCCESS && level_no == 0) {
+		btr_bulk_release(bulk);
+		log_free_check();
+		btr_bulk_relatch(bulk);
+	}
+
+	return(err);
+}
+
+/*********************************************************************//**
+Appends a record to a level of the tree.
+@return	DB_SUCCESS or error code */
+static
+dberr_t
+btr_bulk_insert_low(
+/*================*/
+	btr_bulk_t*	bulk,		/*!< in/out: bulk load */
+	ulint		level_no,	/*!< in: B-tree level */
+	const dtuple_t*	tuple)		/*!< in: index entry or node pointer */
+{
+	btr_bulk_level_t*	level;
+	const page_t*		page;
+	rec_t*			rec;
+	dberr_t			err;
+
+	if (level_no == bulk->n_levels) {
+		err = btr_bulk_level_create(bulk, level_no);
+
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
+	}
+
+	level = bulk->levels[level_no];
+	page = buf_block_get_frame(level->block);
+
+	/* Keep at least two records on every page, whatever the fill
+	factor, so that each level has fewer pages than the one below
+	and the tree converges to a single root. */
+	if (page_get_n_recs(page) > 1
+	    && page_get_data_size(page)
+	    + rec_get_converted_size(bulk->index, tuple, 0)
+	    > bulk->fill_limit) {
+
+		err = btr_bulk_switch_page(bulk, level_no);
+
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
+	}
+
+	rec = page_cur_tuple_insert(&level->cur, tuple, bulk->index,
+				    &bulk->offsets, &bulk->offsets_heap,
+				    0, level->mtr);
+
+	if (rec == NULL) {
+		/* The page directory or a low fill factor may leave
+		less space than was estimated above. */
+		if (page_get_n_recs(buf_block_get_frame(level->block)) == 0) {
+			return(DB_TOO_BIG_RECORD);
+		}
+
+		err = btr_bulk_switch_page(bulk, level_no);
+
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
+
+		rec = page_cur_tuple_insert(&level->cur, tuple, bulk->index,
+					    &bulk->offsets,
+					    &bulk->offsets_heap,
+					    0, level->mtr);
+
+		if (rec == NULL) {
+			return(DB_TOO_BIG_RECORD);
+		}
+	}
+
+	page_cur_position(rec, level->block, &level->cur);
+
+	page = buf_block_get_frame(level->block);
+
+	if (level_no > 0
+	    && page_get_n_recs(page) == 1
+	    && btr_page_get_prev(page, level->mtr) == FIL_NULL) {
+
+		btr_set_min_rec_mark(rec, level->mtr);
+	}
+
+	return(DB_SUCCESS);
+}
+
+/*********************************************************************//**
+Copies the only page of the highest level to the root page, and frees
+the page.
+@return	DB_SUCCESS or error code */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+btr_bulk_root_copy(
+/*===============*/
+	btr_bulk_t*	bulk)	/*!< in/out: bulk load */
+{
+	dict_index_t*		index	= bulk->index;
+	ulint			space	= dict_index_get_space(index);
+	ulint			top_no	= bulk->n_levels - 1;
+	btr_bulk_level_t*	top	= bulk->levels[top_no];
+	buf_block_t*		root;
+	buf_block_t*		block;
+	mtr_t			mtr;
+
+	ut_ad(btr_page_get_prev(buf_block_get_frame(top->block), top->mtr)
+	      == FIL_NULL);
+	ut_ad(btr_page_get_next(buf_block_get_frame(top->block), top->mtr)
+	      == FIL_NULL);
+
+	mtr_start(&mtr);
+	mtr_set_log_mode(&mtr, bulk->log_mode);
+
+	root = btr_block_get(space, 0, dict_index_get_page(index),
+			     RW_X_LATCH, index, &mtr);
+
+	if (page_get_n_recs(buf_block_get_frame(root)) != 0) {
+		mtr_commit(&mtr);
+		return(DB_CORRUPTION);
+	}
+
+	btr_page_set_level(buf_block_get_frame(root), NULL, top_no, &mtr);
+
+	page_copy_rec_list_end(
+		root, top->block,
+		page_rec_get_next(page_get_infimum_rec(
+			buf_block_get_frame(top->block))),
+		index, &mtr);
+
+	mtr_commit(&mtr);
+
+	mtr_commit(top->mtr);
+	bulk->n_levels--;
+
+	mtr_start(&mtr);
+	mtr_x_lock(dict_index_get_lock(index), &mtr);
+
+	block = btr_block_get(space, 0, top->page_no, RW_X_LATCH, index, &mtr);
+	btr_page_free(index, block, &mtr);
+
+	mtr_commit(&mtr);
+
+	return(DB_SUCCESS);
+}
+
+/*********************************************************************//**
+Starts a bulk load of an empty B-tree. */
+UNIV_INTERN
+void
+btr_bulk_init(
+/*==========*/
+	btr_bulk_t*	bulk,	/*!< out: bulk load */
+	dict_index_t*	index,	/*!< in: index whose tree is empty; not
+				ROW_FORMAT=COMPRESSED */
+	trx_id_t	trx_id)	/*!< in: transaction creating the index */
+{
+	ut_ad(!dict_table_zip_size(index->table));
+
+	bulk->index = index;
+	bulk->trx_id = trx_id;
+	bulk->log_mode = dict_index_get_space(index) == TRX_SYS_SPACE
+		? MTR_LOG_ALL : MTR_LOG_NO_REDO;
+	bulk->fill_limit = page_get_free_space_of_empty(
+		dict_table_is_comp(index->table))
+		* btr_bulk_fill_factor / 100;
+	bulk->n_levels = 0;
+	bulk->heap = mem_heap_create(2 * sizeof(btr_bulk_level_t));
+	bulk->offsets = NULL;
+	bulk->offsets_heap = NULL;
+}
+
+/*********************************************************************//**
+Appends a record to the B-tree that is being bulk loaded. The records
+must be appended in ascending order, and must not need off-page storage.
+@return	DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+btr_bulk_insert(
+/*============*/
+	btr_bulk_t*	bulk,	/*!< in/out: bulk load */
+	const dtuple_t*	tuple)	/*!< in: index entry */
+{
+	return(btr_bulk_insert_low(bulk, 0, tuple));
+}
+
+/*********************************************************************//**
+Ends a bulk load. On success, completes the tree and makes sure that
+the pages that were not redo logged are written to the data file.
+@return	DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+btr_bulk_finish(
+/*============*/
+	btr_bulk_t*	bulk,	/*!< in/out: bulk load */
+	dberr_t		err,	/*!< in: DB_SUCCESS, or the error that
+				aborted the load, in which case the
+				latches are just released */
+	const trx_t*	trx)	/*!< in: transaction, for checking if
+				the flush must be interrupted */
+{
+	/* Appending a node pointer may start a new page on the level
+	above, and even a new level, so n_levels must be reread. */
+	for (ulint i = 0; err == DB_SUCCESS && i + 1 < bulk->n_levels; i++) {
+		err = btr_bulk_node_ptr_insert(bulk, i);
+	}
+
+	if (err == DB_SUCCESS && bulk->n_levels > 0) {
+		err = btr_bulk_root_copy(bulk);
+	}
+
+	for (ulint i = 0; i < bulk->n_levels; i++) {
+		btr_bulk_level_t*	level = bulk->levels[i];
+
+		if (level->block != NULL) {
+			btr_bulk_page_commit(bulk, level, i);
+		}
+	}
+
+	if (err == DB_SUCCESS && bulk->log_mode == MTR_LOG_NO_REDO) {
+		buf_LRU_flush_or_remove_pages(
+			dict_index_get_space(bulk->index),
+			BUF_REMOVE_FLUSH_WRITE, trx);
+
+		if (trx_is_interrupted(trx)) {
+			err = DB_INTERRUPTED;
+		}
+	}
+
+	if (bulk->offsets_heap != NULL) {
+		mem_heap_free(bulk->offsets_heap);
+	}
+
+	mem_heap_free(bulk->heap);
+
+	return(err);
+}
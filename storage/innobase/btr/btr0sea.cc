@@ -44,9 +44,12 @@ Created 2/17/1996 Heikki Tuuri
 #include "ha0ha.h"
 
 /** Flag: has the search system been enabled?
-Protected by btr_search_latch. */
+Protected by the latches of all partitions. */
 UNIV_INTERN char		btr_search_enabled	= TRUE;
 
+/** Number of adaptive hash index partitions */
+UNIV_INTERN ulong		btr_ahi_parts		= 8;
+
 /** A dummy variable to fool the compiler */
 UNIV_INTERN ulint		btr_search_this_is_zero = 0;
 
@@ -57,26 +60,12 @@ UNIV_INTERN ulint		btr_search_n_succ	= 0;
 UNIV_INTERN ulint		btr_search_n_hash_fail	= 0;
 #endif /* UNIV_SEARCH_PERF_STAT */
 
-/** padding to prevent other memory update
-hotspots from residing on the same memory
-cache line as btr_search_latch */
-UNIV_INTERN byte		btr_sea_pad1[64];
-
-/** The latch protecting the adaptive search system: this latch protects the
-(1) positions of records on those pages where a hash index has been built.
+/** The adaptive hash index. The latch of each partition protects the
+(1) positions of records on those pages where a hash index has been built
+in the partition.
 NOTE: It does not protect values of non-ordering fields within a record from
 being updated in-place! We can use fact (1) to perform unique searches to
 indexes. */
-
-/* We will allocate the latch from dynamic memory to get it to the
-same DRAM page as other hotspot semaphores */
-UNIV_INTERN rw_lock_t*		btr_search_latch_temp;
-
-/** padding to prevent other memory update hotspots from residing on
-the same memory cache line */
-UNIV_INTERN byte		btr_sea_pad2[64];
-
-/** The adaptive hash index */
 UNIV_INTERN btr_search_sys_t*	btr_search_sys;
 
 #ifdef UNIV_PFS_RWLOCK
@@ -122,18 +111,20 @@ allocate a new node to the hash table, it will succeed. However, the check
 will not guarantee success. */
 static
 void
-btr_search_check_free_space_in_heap(void)
-/*=====================================*/
+btr_search_check_free_space_in_heap(
+/*================================*/
+	btr_search_part_t*	part)	/*!< in: partition that the
+					operation might add nodes to */
 {
 	hash_table_t*	table;
 	mem_heap_t*	heap;
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!rw_lock_own(&part->latch, RW_LOCK_SHARED));
+	ut_ad(!rw_lock_own(&part->latch, RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
-	table = btr_search_sys->hash_index;
+	table = part->hash_index;
 
 	heap = table->heap;
 
@@ -144,7 +135,7 @@ btr_search_check_free_space_in_heap(void)
 	if (heap->free_block == NULL) {
 		buf_block_t*	block = buf_block_alloc(NULL);
 
-		rw_lock_x_lock(&btr_search_latch);
+		rw_lock_x_lock(&part->latch);
 
 		if (heap->free_block == NULL) {
 			heap->free_block = block;
@@ -152,7 +143,7 @@ btr_search_check_free_space_in_heap(void)
 			buf_block_free(block);
 		}
 
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 	}
 }
 
@@ -162,25 +153,36 @@ UNIV_INTERN
 void
 btr_search_sys_create(
 /*==================*/
-	ulint	hash_size)	/*!< in: hash index hash table size */
+	ulint	hash_size)	/*!< in: hash index hash table size,
+				divided among the partitions */
 {
-	/* We allocate the search latch from dynamic memory:
-	see above at the global variable definition */
+	ulint	i;
 
-	btr_search_latch_temp = (rw_lock_t*) mem_alloc(sizeof(rw_lock_t));
-
-	rw_lock_create(btr_search_latch_key, &btr_search_latch,
-		       SYNC_SEARCH_SYS);
+	ut_a(btr_ahi_parts > 0);
+	ut_a(btr_ahi_parts <= BTR_AHI_PARTS_MAX);
 
 	btr_search_sys = (btr_search_sys_t*)
 		mem_alloc(sizeof(btr_search_sys_t));
 
-	btr_search_sys->hash_index = ha_create(hash_size, 0,
-					MEM_HEAP_FOR_BTR_SEARCH, 0);
+	/* The partitions are allocated from dynamic memory to get
+	the latches to the same DRAM page as other hotspot semaphores.
+	btr_search_part_t::pad keeps them on separate cache lines. */
+
+	btr_search_sys->parts = (btr_search_part_t*)
+		mem_zalloc(btr_ahi_parts * sizeof(btr_search_part_t));
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		btr_search_part_t*	part = &btr_search_sys->parts[i];
+
+		rw_lock_create(btr_search_latch_key, &part->latch,
+			       SYNC_SEARCH_SYS);
+
+		part->hash_index = ha_create(hash_size / btr_ahi_parts, 0,
+					     MEM_HEAP_FOR_BTR_SEARCH, 0);
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
-	btr_search_sys->hash_index->adaptive = TRUE;
+		part->hash_index->adaptive = TRUE;
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
-
+	}
 }
 
 /*****************************************************************//**
@@ -190,15 +192,162 @@ void
 btr_search_sys_free(void)
 /*=====================*/
 {
-	rw_lock_free(&btr_search_latch);
-	mem_free(btr_search_latch_temp);
-	btr_search_latch_temp = NULL;
-	mem_heap_free(btr_search_sys->hash_index->heap);
-	hash_table_free(btr_search_sys->hash_index);
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		btr_search_part_t*	part = &btr_search_sys->parts[i];
+
+		rw_lock_free(&part->latch);
+		mem_heap_free(part->hash_index->heap);
+		hash_table_free(part->hash_index);
+	}
+
+	mem_free(btr_search_sys->parts);
 	mem_free(btr_search_sys);
 	btr_search_sys = NULL;
 }
 
+/********************************************************************//**
+X-latches the latches of all adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_x_lock_all(void)
+/*=======================*/
+{
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		rw_lock_x_lock(&btr_search_sys->parts[i].latch);
+	}
+}
+
+/********************************************************************//**
+Releases the x-latches of all adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_x_unlock_all(void)
+/*=========================*/
+{
+	ulint	i;
+
+	for (i = btr_ahi_parts; i--; ) {
+		rw_lock_x_unlock(&btr_search_sys->parts[i].latch);
+	}
+}
+
+#ifdef UNIV_SYNC_DEBUG
+/********************************************************************//**
+Checks if the thread owns the latches of all adaptive hash index
+partitions in the given mode.
+@return	TRUE if all are owned */
+UNIV_INTERN
+ibool
+btr_search_own_all(
+/*===============*/
+	ulint	lock_type)	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+{
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		if (!rw_lock_own(&btr_search_sys->parts[i].latch,
+				 lock_type)) {
+			return(FALSE);
+		}
+	}
+
+	return(TRUE);
+}
+
+/********************************************************************//**
+Checks if the thread owns the latch of any adaptive hash index
+partition in the given mode.
+@return	TRUE if some latch is owned */
+UNIV_INTERN
+ibool
+btr_search_own_any(
+/*===============*/
+	ulint	lock_type)	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+{
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		if (rw_lock_own(&btr_search_sys->parts[i].latch,
+				lock_type)) {
+			return(TRUE);
+		}
+	}
+
+	return(FALSE);
+}
+
+/********************************************************************//**
+Checks if the thread owns the latch of the adaptive hash index partition
+that the hash table belongs to.
+@return	TRUE if the latch is owned */
+UNIV_INTERN
+ibool
+btr_search_own_table(
+/*=================*/
+	const hash_table_t*	table,		/*!< in: hash table of
+						a partition */
+	ulint			lock_type)	/*!< in: RW_LOCK_SHARED
+						or RW_LOCK_EX */
+{
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		btr_search_part_t*	part = &btr_search_sys->parts[i];
+
+		if (part->hash_index == table) {
+			return(rw_lock_own(&part->latch, lock_type));
+		}
+	}
+
+	ut_error;
+	return(FALSE);
+}
+#endif /* UNIV_SYNC_DEBUG */
+
+/********************************************************************//**
+Gets the adaptive hash index partition of an index page. The index id is
+read from the page frame, so that block->index is not dereferenced before
+the partition latch is acquired.
+@return	partition where the page is hashed, if it is hashed at all */
+static
+btr_search_part_t*
+btr_search_get_block_part(
+/*======================*/
+	const buf_block_t*	block)	/*!< in: index page */
+{
+	return(btr_search_sys->parts
+	       + ut_fold_ull(btr_page_get_index_id(block->frame))
+	       % btr_ahi_parts);
+}
+
+/********************************************************************//**
+Prints info of the adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_print_info(
+/*==================*/
+	FILE*	file)	/*!< in: file where to print */
+{
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		const btr_search_part_t*	part
+			= &btr_search_sys->parts[i];
+
+		fprintf(file, "AHI partition %lu: ", (ulong) i + 1);
+		ha_print_info(file, part->hash_index);
+		fprintf(file,
+			"%lu hits, %lu misses, %lu latch waits\n",
+			(ulong) part->n_hits,
+			(ulong) part->n_misses,
+			(ulong) part->latch.count_os_wait);
+	}
+}
+
 /********************************************************************//**
 Set index->ref_count = 0 on all indexes of a table. */
 static
@@ -211,7 +360,7 @@ btr_search_disable_ref_count(
 
 	ut_ad(mutex_own(&dict_sys->mutex));
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(btr_search_own_all(RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
 	for (index = dict_table_get_first_index(table); index;
@@ -229,9 +378,10 @@ btr_search_disable(void)
 /*====================*/
 {
 	dict_table_t*	table;
+	ulint		i;
 
 	mutex_enter(&dict_sys->mutex);
-	rw_lock_x_lock(&btr_search_latch);
+	btr_search_x_lock_all();
 
 	btr_search_enabled = FALSE;
 
@@ -255,10 +405,14 @@ btr_search_disable(void)
 	buf_pool_clear_hash_index();
 
 	/* Clear the adaptive hash index. */
-	hash_table_clear(btr_search_sys->hash_index);
-	mem_heap_empty(btr_search_sys->hash_index->heap);
+	for (i = 0; i < btr_ahi_parts; i++) {
+		btr_search_part_t*	part = &btr_search_sys->parts[i];
 
-	rw_lock_x_unlock(&btr_search_latch);
+		hash_table_clear(part->hash_index);
+		mem_heap_empty(part->hash_index->heap);
+	}
+
+	btr_search_x_unlock_all();
 }
 
 /********************************************************************//**
@@ -268,11 +422,11 @@ void
 btr_search_enable(void)
 /*====================*/
 {
-	rw_lock_x_lock(&btr_search_latch);
+	btr_search_x_lock_all();
 
 	btr_search_enabled = TRUE;
 
-	rw_lock_x_unlock(&btr_search_latch);
+	btr_search_x_unlock_all();
 }
 
 /*****************************************************************//**
@@ -318,26 +472,28 @@ btr_search_info_create(
 
 /*****************************************************************//**
 Returns the value of ref_count. The value is protected by
-btr_search_latch.
+the latch of the adaptive hash index partition of the index.
 @return	ref_count value. */
 UNIV_INTERN
 ulint
 btr_search_info_get_ref_count(
 /*==========================*/
-	btr_search_t*   info)	/*!< in: search info. */
+	btr_search_t*   info,	/*!< in: search info. */
+	dict_index_t*	index)	/*!< in: index */
 {
-	ulint ret;
+	ulint		ret;
+	rw_lock_t*	latch	= btr_search_get_latch(index);
 
 	ut_ad(info);
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!rw_lock_own(latch, RW_LOCK_SHARED));
+	ut_ad(!rw_lock_own(latch, RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
-	rw_lock_s_lock(&btr_search_latch);
+	rw_lock_s_lock(latch);
 	ret = info->ref_count;
-	rw_lock_s_unlock(&btr_search_latch);
+	rw_lock_s_unlock(latch);
 
 	return(ret);
 }
@@ -357,13 +513,13 @@ btr_search_info_update_hash(
 	ulint		n_unique;
 	int		cmp;
 
+	index = cursor->index;
+
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!rw_lock_own(btr_search_get_latch(index), RW_LOCK_SHARED));
+	ut_ad(!rw_lock_own(btr_search_get_latch(index), RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
-	index = cursor->index;
-
 	if (dict_index_is_ibuf(index)) {
 		/* So many deletes are performed on an insert buffer tree
 		that we do not consider a hash index useful on it: */
@@ -476,13 +632,15 @@ btr_search_update_block_hash_info(
 	btr_cur_t*	cursor __attribute__((unused)))
 				/*!< in: cursor */
 {
+	ut_ad(cursor);
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!rw_lock_own(btr_search_get_latch(cursor->index),
+			   RW_LOCK_SHARED));
+	ut_ad(!rw_lock_own(btr_search_get_latch(cursor->index),
+			   RW_LOCK_EX));
 	ut_ad(rw_lock_own(&block->lock, RW_LOCK_SHARED)
 	      || rw_lock_own(&block->lock, RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
-	ut_ad(cursor);
 
 	info->last_hash_succ = FALSE;
 
@@ -562,7 +720,7 @@ btr_search_update_hash_ref(
 
 	ut_ad(cursor->flag == BTR_CUR_HASH_FAIL);
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(rw_lock_own(btr_search_get_latch(cursor->index), RW_LOCK_EX));
 	ut_ad(rw_lock_own(&(block->lock), RW_LOCK_SHARED)
 	      || rw_lock_own(&(block->lock), RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
@@ -603,11 +761,11 @@ btr_search_update_hash_ref(
 			mem_heap_free(heap);
 		}
 #ifdef UNIV_SYNC_DEBUG
-		ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+		ut_ad(rw_lock_own(btr_search_get_latch(index), RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
-		ha_insert_for_fold(btr_search_sys->hash_index, fold,
-				   block, rec);
+		ha_insert_for_fold(btr_search_get_part(index)->hash_index,
+				   fold, block, rec);
 
 		MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 	}
@@ -626,10 +784,13 @@ btr_search_info_update_slow(
 	ibool		build_index;
 	ulint*		params;
 	ulint*		params2;
+	btr_search_part_t*	part;
+
+	part = btr_search_get_part(cursor->index);
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!rw_lock_own(&part->latch, RW_LOCK_SHARED));
+	ut_ad(!rw_lock_own(&part->latch, RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
 	block = btr_cur_get_block(cursor);
@@ -645,7 +806,7 @@ btr_search_info_update_slow(
 
 	if (build_index || (cursor->flag == BTR_CUR_HASH_FAIL)) {
 
-		btr_search_check_free_space_in_heap();
+		btr_search_check_free_space_in_heap(part);
 	}
 
 	if (cursor->flag == BTR_CUR_HASH_FAIL) {
@@ -655,11 +816,11 @@ btr_search_info_update_slow(
 		btr_search_n_hash_fail++;
 #endif /* UNIV_SEARCH_PERF_STAT */
 
-		rw_lock_x_lock(&btr_search_latch);
+		rw_lock_x_lock(&part->latch);
 
 		btr_search_update_hash_ref(info, block, cursor);
 
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 	}
 
 	if (build_index) {
@@ -703,7 +864,7 @@ btr_search_check_guess(
 	ibool		can_only_compare_to_cursor_rec,
 				/*!< in: if we do not have a latch on the page
 				of cursor, but only a latch on
-				btr_search_latch, then ONLY the columns
+				the partition, then ONLY the columns
 				of the record UNDER the cursor are
 				protected, not the next or previous record
 				in the chain: we cannot look at the next or
@@ -858,7 +1019,8 @@ btr_search_guess_on_hash(
 					to protect the record! */
 	btr_cur_t*	cursor,		/*!< out: tree cursor */
 	ulint		has_search_latch,/*!< in: latch mode the caller
-					currently has on btr_search_latch:
+					currently has on
+					btr_search_get_latch(index):
 					RW_S_LATCH, RW_X_LATCH, or 0 */
 	mtr_t*		mtr)		/*!< in: mtr */
 {
@@ -867,6 +1029,7 @@ btr_search_guess_on_hash(
 	const rec_t*	rec;
 	ulint		fold;
 	index_id_t	index_id;
+	btr_search_part_t*	part;
 #ifdef notdefined
 	btr_cur_t	cursor2;
 	btr_pcur_t	pcur;
@@ -903,18 +1066,20 @@ btr_search_guess_on_hash(
 	cursor->fold = fold;
 	cursor->flag = BTR_CUR_HASH;
 
+	part = btr_search_get_part(index);
+
 	if (UNIV_LIKELY(!has_search_latch)) {
-		rw_lock_s_lock(&btr_search_latch);
+		rw_lock_s_lock(&part->latch);
 
 		if (UNIV_UNLIKELY(!btr_search_enabled)) {
 			goto failure_unlock;
 		}
 	}
 
-	ut_ad(rw_lock_get_writer(&btr_search_latch) != RW_LOCK_EX);
-	ut_ad(rw_lock_get_reader_count(&btr_search_latch) > 0);
+	ut_ad(rw_lock_get_writer(&part->latch) != RW_LOCK_EX);
+	ut_ad(rw_lock_get_reader_count(&part->latch) > 0);
 
-	rec = (rec_t*) ha_search_and_get_data(btr_search_sys->hash_index, fold);
+	rec = (rec_t*) ha_search_and_get_data(part->hash_index, fold);
 
 	if (UNIV_UNLIKELY(!rec)) {
 		goto failure_unlock;
@@ -932,7 +1097,7 @@ btr_search_guess_on_hash(
 			goto failure_unlock;
 		}
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 
 		buf_block_dbg_add_level(block, SYNC_TREE_NODE_FROM_HASH);
 	}
@@ -954,7 +1119,7 @@ btr_search_guess_on_hash(
 
 	/* Check the validity of the guess within the page */
 
-	/* If we only have the latch on btr_search_latch, not on the
+	/* If we only have the latch on the partition, not on the
 	page, it only protects the columns of the record the cursor
 	is positioned on. We cannot look at the next of the previous
 	record to determine if our guess for the cursor position is
@@ -1013,6 +1178,8 @@ btr_search_guess_on_hash(
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
 #endif
+	part->n_hits++;
+
 	if (UNIV_LIKELY(!has_search_latch)
 	    && buf_page_peek_if_too_old(&block->page)) {
 
@@ -1029,10 +1196,11 @@ btr_search_guess_on_hash(
 	/*-------------------------------------------*/
 failure_unlock:
 	if (UNIV_LIKELY(!has_search_latch)) {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 	}
 failure:
 	cursor->flag = BTR_CUR_HASH_FAIL;
+	part->n_misses++;
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	info->n_hash_fail++;
@@ -1077,30 +1245,37 @@ btr_search_drop_page_hash_index(
 	const dict_index_t*	index;
 	ulint*			offsets;
 	btr_search_t*		info;
-
-#ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
-#endif /* UNIV_SYNC_DEBUG */
+	btr_search_part_t*	part;
 
 	/* Do a dirty check on block->index, return if the block is
 	not in the adaptive hash index. This is to avoid acquiring
-	shared btr_search_latch for performance consideration. */
+	the shared partition latch for performance consideration. */
 	if (!block->index) {
 		return;
 	}
 
+	/* The index id on a hashed page cannot change: the hash index
+	of the page is dropped before the page is freed. */
+	part = btr_search_get_block_part(block);
+
+#ifdef UNIV_SYNC_DEBUG
+	ut_ad(!rw_lock_own(&part->latch, RW_LOCK_SHARED));
+	ut_ad(!rw_lock_own(&part->latch, RW_LOCK_EX));
+#endif /* UNIV_SYNC_DEBUG */
+
 retry:
-	rw_lock_s_lock(&btr_search_latch);
+	rw_lock_s_lock(&part->latch);
 	index = block->index;
 
 	if (UNIV_LIKELY(!index)) {
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 
 		return;
 	}
 
+	ut_ad(part == btr_search_get_part(index));
+
 	ut_a(!dict_index_is_ibuf(index));
 #ifdef UNIV_DEBUG
 	switch (dict_index_get_online_status(index)) {
@@ -1123,7 +1298,7 @@ retry:
 	}
 #endif /* UNIV_DEBUG */
 
-	table = btr_search_sys->hash_index;
+	table = part->hash_index;
 
 #ifdef UNIV_SYNC_DEBUG
 	ut_ad(rw_lock_own(&(block->lock), RW_LOCK_SHARED)
@@ -1136,10 +1311,10 @@ retry:
 	n_bytes = block->curr_n_bytes;
 
 	/* NOTE: The fields of block must not be accessed after
-	releasing btr_search_latch, as the index page might only
+	releasing the partition latch, as the index page might only
 	be s-latched! */
 
-	rw_lock_s_unlock(&btr_search_latch);
+	rw_lock_s_unlock(&part->latch);
 
 	ut_a(n_fields + n_bytes > 0);
 
@@ -1190,7 +1365,7 @@ next_rec:
 		mem_heap_free(heap);
 	}
 
-	rw_lock_x_lock(&btr_search_latch);
+	rw_lock_x_lock(&part->latch);
 
 	if (UNIV_UNLIKELY(!block->index)) {
 		/* Someone else has meanwhile dropped the hash index */
@@ -1206,7 +1381,7 @@ next_rec:
 		/* Someone else has meanwhile built a new hash index on the
 		page, with different parameters */
 
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 
 		mem_free(folds);
 		goto retry;
@@ -1237,14 +1412,14 @@ cleanup:
 			"InnoDB: the hash index to a page of %s,"
 			" still %lu hash nodes remain.\n",
 			index->name, (ulong) block->n_pointers);
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 
 		ut_ad(btr_search_validate());
 	} else {
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 	}
 #else /* UNIV_AHI_DEBUG || UNIV_DEBUG */
-	rw_lock_x_unlock(&btr_search_latch);
+	rw_lock_x_unlock(&part->latch);
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 
 	mem_free(folds);
@@ -1317,36 +1492,39 @@ btr_search_build_page_hash_index(
 	mem_heap_t*	heap		= NULL;
 	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
 	ulint*		offsets		= offsets_;
+	btr_search_part_t*	part;
 	rec_offs_init(offsets_);
 
 	ut_ad(index);
 	ut_a(!dict_index_is_ibuf(index));
 
+	part = btr_search_get_part(index);
+
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(!rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(!rw_lock_own(&part->latch, RW_LOCK_EX));
 	ut_ad(rw_lock_own(&(block->lock), RW_LOCK_SHARED)
 	      || rw_lock_own(&(block->lock), RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
-	rw_lock_s_lock(&btr_search_latch);
+	rw_lock_s_lock(&part->latch);
 
 	if (!btr_search_enabled) {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 		return;
 	}
 
-	table = btr_search_sys->hash_index;
+	table = part->hash_index;
 	page = buf_block_get_frame(block);
 
 	if (block->index && ((block->curr_n_fields != n_fields)
 			     || (block->curr_n_bytes != n_bytes)
 			     || (block->curr_left_side != left_side))) {
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 
 		btr_search_drop_page_hash_index(block);
 	} else {
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(&part->latch);
 	}
 
 	n_recs = page_get_n_recs(page);
@@ -1440,9 +1618,9 @@ btr_search_build_page_hash_index(
 		fold = next_fold;
 	}
 
-	btr_search_check_free_space_in_heap();
+	btr_search_check_free_space_in_heap(part);
 
-	rw_lock_x_lock(&btr_search_latch);
+	rw_lock_x_lock(&part->latch);
 
 	if (UNIV_UNLIKELY(!btr_search_enabled)) {
 		goto exit_func;
@@ -1478,7 +1656,7 @@ btr_search_build_page_hash_index(
 	MONITOR_INC(MONITOR_ADAPTIVE_HASH_PAGE_ADDED);
 	MONITOR_INC_VALUE(MONITOR_ADAPTIVE_HASH_ROW_ADDED, n_cached);
 exit_func:
-	rw_lock_x_unlock(&btr_search_latch);
+	rw_lock_x_unlock(&part->latch);
 
 	mem_free(folds);
 	mem_free(recs);
@@ -1504,16 +1682,17 @@ btr_search_move_or_delete_hash_entries(
 					from this page */
 	dict_index_t*	index)		/*!< in: record descriptor */
 {
-	ulint	n_fields;
-	ulint	n_bytes;
-	ibool	left_side;
+	ulint		n_fields;
+	ulint		n_bytes;
+	ibool		left_side;
+	rw_lock_t*	latch	= btr_search_get_latch(index);
 
 #ifdef UNIV_SYNC_DEBUG
 	ut_ad(rw_lock_own(&(block->lock), RW_LOCK_EX));
 	ut_ad(rw_lock_own(&(new_block->lock), RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 
-	rw_lock_s_lock(&btr_search_latch);
+	rw_lock_s_lock(latch);
 
 	ut_a(!new_block->index || new_block->index == index);
 	ut_a(!block->index || block->index == index);
@@ -1522,7 +1701,7 @@ btr_search_move_or_delete_hash_entries(
 
 	if (new_block->index) {
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(latch);
 
 		btr_search_drop_page_hash_index(block);
 
@@ -1539,7 +1718,7 @@ btr_search_move_or_delete_hash_entries(
 		new_block->n_bytes = block->curr_n_bytes;
 		new_block->left_side = left_side;
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(latch);
 
 		ut_a(n_fields + n_bytes > 0);
 
@@ -1551,7 +1730,7 @@ btr_search_move_or_delete_hash_entries(
 		return;
 	}
 
-	rw_lock_s_unlock(&btr_search_latch);
+	rw_lock_s_unlock(latch);
 }
 
 /********************************************************************//**
@@ -1571,6 +1750,7 @@ btr_search_update_hash_on_delete(
 	dict_index_t*	index;
 	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
 	mem_heap_t*	heap		= NULL;
+	btr_search_part_t*	part;
 	rec_offs_init(offsets_);
 
 	block = btr_cur_get_block(cursor);
@@ -1590,7 +1770,8 @@ btr_search_update_hash_on_delete(
 	ut_a(block->curr_n_fields + block->curr_n_bytes > 0);
 	ut_a(!dict_index_is_ibuf(index));
 
-	table = btr_search_sys->hash_index;
+	part = btr_search_get_part(index);
+	table = part->hash_index;
 
 	rec = btr_cur_get_rec(cursor);
 
@@ -1601,7 +1782,7 @@ btr_search_update_hash_on_delete(
 		mem_heap_free(heap);
 	}
 
-	rw_lock_x_lock(&btr_search_latch);
+	rw_lock_x_lock(&part->latch);
 
 	if (block->index) {
 		ut_a(block->index == index);
@@ -1614,7 +1795,7 @@ btr_search_update_hash_on_delete(
 		}
 	}
 
-	rw_lock_x_unlock(&btr_search_latch);
+	rw_lock_x_unlock(&part->latch);
 }
 
 /********************************************************************//**
@@ -1632,6 +1813,7 @@ btr_search_update_hash_node_on_insert(
 	buf_block_t*	block;
 	dict_index_t*	index;
 	rec_t*		rec;
+	btr_search_part_t*	part;
 
 	rec = btr_cur_get_rec(cursor);
 
@@ -1651,7 +1833,9 @@ btr_search_update_hash_node_on_insert(
 	ut_a(cursor->index == index);
 	ut_a(!dict_index_is_ibuf(index));
 
-	rw_lock_x_lock(&btr_search_latch);
+	part = btr_search_get_part(index);
+
+	rw_lock_x_lock(&part->latch);
 
 	if (!block->index) {
 
@@ -1665,7 +1849,7 @@ btr_search_update_hash_node_on_insert(
 	    && (cursor->n_bytes == block->curr_n_bytes)
 	    && !block->curr_left_side) {
 
-		table = btr_search_sys->hash_index;
+		table = part->hash_index;
 
 		if (ha_search_and_update_if_found(
 			table, cursor->fold, rec, block,
@@ -1674,9 +1858,9 @@ btr_search_update_hash_node_on_insert(
 		}
 
 func_exit:
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 	} else {
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 
 		btr_search_update_hash_on_insert(cursor);
 	}
@@ -1709,6 +1893,7 @@ btr_search_update_hash_on_insert(
 	mem_heap_t*	heap		= NULL;
 	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
 	ulint*		offsets		= offsets_;
+	btr_search_part_t*	part;
 	rec_offs_init(offsets_);
 
 	block = btr_cur_get_block(cursor);
@@ -1724,9 +1909,11 @@ btr_search_update_hash_on_insert(
 		return;
 	}
 
-	btr_search_check_free_space_in_heap();
+	part = btr_search_get_part(index);
+
+	btr_search_check_free_space_in_heap(part);
 
-	table = btr_search_sys->hash_index;
+	table = part->hash_index;
 
 	rec = btr_cur_get_rec(cursor);
 
@@ -1758,7 +1945,7 @@ btr_search_update_hash_on_insert(
 	} else {
 		if (left_side) {
 
-			rw_lock_x_lock(&btr_search_latch);
+			rw_lock_x_lock(&part->latch);
 
 			locked = TRUE;
 
@@ -1776,7 +1963,7 @@ btr_search_update_hash_on_insert(
 
 		if (!locked) {
 
-			rw_lock_x_lock(&btr_search_latch);
+			rw_lock_x_lock(&part->latch);
 
 			locked = TRUE;
 
@@ -1798,7 +1985,7 @@ check_next_rec:
 		if (!left_side) {
 
 			if (!locked) {
-				rw_lock_x_lock(&btr_search_latch);
+				rw_lock_x_lock(&part->latch);
 
 				locked = TRUE;
 
@@ -1817,7 +2004,7 @@ check_next_rec:
 
 		if (!locked) {
 
-			rw_lock_x_lock(&btr_search_latch);
+			rw_lock_x_lock(&part->latch);
 
 			locked = TRUE;
 
@@ -1844,21 +2031,23 @@ function_exit:
 		mem_heap_free(heap);
 	}
 	if (locked) {
-		rw_lock_x_unlock(&btr_search_latch);
+		rw_lock_x_unlock(&part->latch);
 	}
 }
 
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
 /********************************************************************//**
-Validates the search system.
+Validates a partition of the search system.
 @return	TRUE if ok */
-UNIV_INTERN
+static
 ibool
-btr_search_validate(void)
+btr_search_validate_part(
 /*=====================*/
+	btr_search_part_t*	part,	/*!< in: partition */
+	ulint*		n_page_dumps)	/*!< in/out: number of pages
+					printed */
 {
 	ha_node_t*	node;
-	ulint		n_page_dumps	= 0;
 	ibool		ok		= TRUE;
 	ulint		i;
 	ulint		cell_count;
@@ -1867,29 +2056,29 @@ btr_search_validate(void)
 	ulint*		offsets		= offsets_;
 
 	/* How many cells to check before temporarily releasing
-	btr_search_latch. */
+	the partition latch. */
 	ulint		chunk_size = 10000;
 
 	rec_offs_init(offsets_);
 
-	rw_lock_x_lock(&btr_search_latch);
+	rw_lock_x_lock(&part->latch);
 	buf_pool_mutex_enter_all();
 
-	cell_count = hash_get_n_cells(btr_search_sys->hash_index);
+	cell_count = hash_get_n_cells(part->hash_index);
 
 	for (i = 0; i < cell_count; i++) {
-		/* We release btr_search_latch every once in a while to
+		/* We release the partition latch every once in a while to
 		give other queries a chance to run. */
 		if ((i != 0) && ((i % chunk_size) == 0)) {
 			buf_pool_mutex_exit_all();
-			rw_lock_x_unlock(&btr_search_latch);
+			rw_lock_x_unlock(&part->latch);
 			os_thread_yield();
-			rw_lock_x_lock(&btr_search_latch);
+			rw_lock_x_lock(&part->latch);
 			buf_pool_mutex_enter_all();
 		}
 
 		node = (ha_node_t*)
-			hash_get_nth_cell(btr_search_sys->hash_index, i)->node;
+			hash_get_nth_cell(part->hash_index, i)->node;
 
 		for (; node != NULL; node = node->next) {
 			const buf_block_t*	block
@@ -1927,7 +2116,7 @@ btr_search_validate(void)
 				After that, it invokes
 				btr_search_drop_page_hash_index() to
 				remove the block from
-				btr_search_sys->hash_index. */
+				the adaptive hash index. */
 
 				ut_a(buf_block_get_state(block)
 				     == BUF_BLOCK_REMOVE_HASH);
@@ -1981,11 +2170,11 @@ btr_search_validate(void)
 					(ulong) block->curr_n_bytes,
 					(ulong) block->curr_left_side);
 
-				if (n_page_dumps < 20) {
+				if (*n_page_dumps < 20) {
 					buf_page_print(
 						page, 0,
 						BUF_PAGE_PRINT_NO_CRASH);
-					n_page_dumps++;
+					(*n_page_dumps)++;
 				}
 			}
 		}
@@ -1994,27 +2183,49 @@ btr_search_validate(void)
 	for (i = 0; i < cell_count; i += chunk_size) {
 		ulint end_index = ut_min(i + chunk_size - 1, cell_count - 1);
 
-		/* We release btr_search_latch every once in a while to
+		/* We release the partition latch every once in a while to
 		give other queries a chance to run. */
 		if (i != 0) {
 			buf_pool_mutex_exit_all();
-			rw_lock_x_unlock(&btr_search_latch);
+			rw_lock_x_unlock(&part->latch);
 			os_thread_yield();
-			rw_lock_x_lock(&btr_search_latch);
+			rw_lock_x_lock(&part->latch);
 			buf_pool_mutex_enter_all();
 		}
 
-		if (!ha_validate(btr_search_sys->hash_index, i, end_index)) {
+		if (!ha_validate(part->hash_index, i, end_index)) {
 			ok = FALSE;
 		}
 	}
 
 	buf_pool_mutex_exit_all();
-	rw_lock_x_unlock(&btr_search_latch);
+	rw_lock_x_unlock(&part->latch);
 	if (UNIV_LIKELY_NULL(heap)) {
 		mem_heap_free(heap);
 	}
 
 	return(ok);
 }
+
+/********************************************************************//**
+Validates the search system.
+@return	TRUE if ok */
+UNIV_INTERN
+ibool
+btr_search_validate(void)
+/*=====================*/
+{
+	ulint	n_page_dumps	= 0;
+	ibool	ok		= TRUE;
+	ulint	i;
+
+	for (i = 0; i < btr_ahi_parts; i++) {
+		if (!btr_search_validate_part(&btr_search_sys->parts[i],
+					      &n_page_dumps)) {
+			ok = FALSE;
+		}
+	}
+
+	return(ok);
+}
 #endif /* defined UNIV_AHI_DEBUG || defined UNIV_DEBUG */
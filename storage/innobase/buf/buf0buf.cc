@@ -39,6 +39,7 @@ Created 11/5/1995 Heikki Tuuri
 #include "mem0mem.h"
 #include "btr0btr.h"
 #include "fil0fil.h"
+#include "fil0pagecompress.h"
 #ifndef UNIV_HOTBACKUP
 #include "buf0buddy.h"
 #include "lock0lock.h"
@@ -145,7 +146,10 @@ in the database, using tables whose size is a power of 2.
 There are several lists of control blocks.
 
 The free list (buf_pool->free) contains blocks which are currently not
-used.
+used. It is protected by buf_pool->free_list_mutex rather than by
+buf_pool->mutex, so that a thread which needs a free block does not have
+to acquire buf_pool->mutex as long as the free list is not empty. Blocks
+are added to the free list while holding both mutexes.
 
 The common LRU list contains all the blocks holding a file page
 except those for which the bufferfix count is non-zero.
@@ -288,6 +292,8 @@ UNIV_INTERN mysql_pfs_key_t	buffer_block_mutex_key;
 UNIV_INTERN mysql_pfs_key_t	buf_pool_mutex_key;
 UNIV_INTERN mysql_pfs_key_t	buf_pool_zip_mutex_key;
 UNIV_INTERN mysql_pfs_key_t	flush_list_mutex_key;
+UNIV_INTERN mysql_pfs_key_t	free_list_mutex_key;
+UNIV_INTERN mysql_pfs_key_t	buf_LRU_young_batch_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
 
 #if defined UNIV_PFS_MUTEX || defined UNIV_PFS_RWLOCK
@@ -1051,8 +1057,15 @@ buf_block_init(
 #endif /* UNIV_DEBUG_FILE_ACCESSES || UNIV_DEBUG */
 
 	block->check_index_page_at_flush = FALSE;
+	block->comp_frame = NULL;
+	block->comp_frame_alloc = NULL;
 	block->index = NULL;
 
+	block->search_keys = NULL;
+	block->search_keys_size = 0;
+	block->search_n_slots = 0;
+	block->search_clock = 0;
+
 #ifdef UNIV_DEBUG
 	block->page.in_page_hash = FALSE;
 	block->page.in_zip_hash = FALSE;
@@ -1281,6 +1294,42 @@ buf_chunk_not_freed(
 	return(NULL);
 }
 
+/********************************************************************//**
+Registers the memory of all buffer pool chunks with the aio subsystem, so
+that page i/o can use the registered buffers of io_uring. */
+static
+void
+buf_pool_register_io_buffers(void)
+/*==============================*/
+{
+	ulint	n = 0;
+	ulint	i;
+
+	for (i = 0; i < srv_buf_pool_instances; i++) {
+		n += buf_pool_from_array(i)->n_chunks;
+	}
+
+	byte**	bufs = static_cast<byte**>(ut_malloc(n * sizeof(*bufs)));
+	ulint*	lens = static_cast<ulint*>(ut_malloc(n * sizeof(*lens)));
+
+	n = 0;
+
+	for (i = 0; i < srv_buf_pool_instances; i++) {
+		const buf_pool_t*	buf_pool = buf_pool_from_array(i);
+
+		for (ulint j = 0; j < buf_pool->n_chunks; j++) {
+			bufs[n] = static_cast<byte*>(buf_pool->chunks[j].mem);
+			lens[n] = buf_pool->chunks[j].mem_size;
+			n++;
+		}
+	}
+
+	os_aio_register_buffers(bufs, lens, n);
+
+	ut_free(bufs);
+	ut_free(lens);
+}
+
 /********************************************************************//**
 Set buffer pool size variables after resizing it */
 static
@@ -1326,6 +1375,8 @@ buf_pool_init_instance(
 		     &buf_pool->mutex, SYNC_BUF_POOL);
 	mutex_create(buf_pool_zip_mutex_key,
 		     &buf_pool->zip_mutex, SYNC_BUF_BLOCK);
+	mutex_create(free_list_mutex_key,
+		     &buf_pool->free_list_mutex, SYNC_BUF_FREE_LIST);
 
 	buf_pool_mutex_enter(buf_pool);
 
@@ -1365,6 +1416,8 @@ buf_pool_init_instance(
 
 		buf_pool->zip_hash = hash_create(2 * buf_pool->curr_size);
 
+		buf_LRU_ghost_create(buf_pool);
+
 		buf_pool->last_printout_time = ut_time();
 
 	}
@@ -1381,6 +1434,11 @@ buf_pool_init_instance(
 	buf_pool->watch = (buf_page_t*) mem_zalloc(
 		sizeof(*buf_pool->watch) * BUF_POOL_WATCH_SIZE);
 
+	for (i = 0; i < BUF_LRU_YOUNG_BATCHES; i++) {
+		os_fast_mutex_init(buf_LRU_young_batch_mutex_key,
+				   &buf_pool->young_batch[i].mutex);
+	}
+
 	/* All fields are initialized by mem_zalloc(). */
 
 	buf_pool->try_LRU_scan = TRUE;
@@ -1425,10 +1483,20 @@ buf_pool_free_instance(
 	mem_free(buf_pool->watch);
 	buf_pool->watch = NULL;
 
+	buf_LRU_ghost_free(buf_pool);
+
+	for (ulint i = 0; i < BUF_LRU_YOUNG_BATCHES; i++) {
+		os_fast_mutex_free(&buf_pool->young_batch[i].mutex);
+	}
+
 	chunks = buf_pool->chunks;
 	chunk = chunks + buf_pool->n_chunks;
 
 	while (--chunk >= chunks) {
+		for (ulint i = 0; i < chunk->size; i++) {
+			ut_free(chunk->blocks[i].search_keys);
+		}
+
 		os_mem_free_large(chunk->mem, chunk->mem_size);
 	}
 
@@ -1558,6 +1626,8 @@ buf_pool_init(
 
 	btr_search_sys_create(buf_pool_get_curr_size() / sizeof(void*) / 64);
 
+	buf_pool_register_io_buffers();
+
 #ifdef SSD_CACHE_FACE
     if (srv_use_ssd_cache) {
     	/* Initialize SSD cache file, SSD cache hash table and SSD metadata directory. */
@@ -1661,7 +1731,7 @@ buf_pool_clear_hash_index(void)
 	ulint	p;
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(btr_search_own_all(RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 	ut_ad(!btr_search_enabled);
 
@@ -1678,7 +1748,7 @@ buf_pool_clear_hash_index(void)
 				dict_index_t*	index	= block->index;
 
 				/* We can set block->index = NULL
-				when we have an x-latch on btr_search_latch;
+				when we have an x-latch on all AHI partitions;
 				see the comment in buf0buf.h */
 
 				if (!index) {
@@ -2090,7 +2160,7 @@ buf_page_make_young_if_needed(
 	ut_a(buf_page_in_file(bpage));
 
 	if (buf_page_peek_if_too_old(bpage)) {
-		buf_page_make_young(bpage);
+		buf_LRU_make_block_young_lazy(bpage);
 	}
 }
 
@@ -3578,6 +3648,7 @@ buf_page_init_low(
 	bpage->flush_type = BUF_FLUSH_LRU;
 	bpage->io_fix = BUF_IO_NONE;
 	bpage->buf_fix_count = 0;
+	bpage->made_young = FALSE;
 	bpage->freed_page_clock = 0;
 	bpage->access_time = 0;
 	bpage->newest_modification = 0;
@@ -4308,6 +4379,12 @@ buf_page_io_complete(
 		} else {
 			ut_a(uncompressed);
 			frame = ((buf_block_t*) bpage)->frame;
+
+			if (fil_page_is_compressed(frame)
+			    && !fil_page_decompress(frame)) {
+
+				goto corrupt;
+			}
 		}
 
 		/* If this page is not uninitialized and not in the
@@ -4434,6 +4511,11 @@ corrupt:
 				bpage->offset, buf_page_get_zip_size(bpage),
 				TRUE);
 		}
+	} else if (uncompressed
+		   && ((buf_block_t*) bpage)->comp_frame != NULL) {
+		/* The page was written compressed by
+		innodb_page_compression. */
+		buf_flush_compress_complete((buf_block_t*) bpage);
 	}
 
 	buf_pool_mutex_enter(buf_pool);
@@ -4840,7 +4922,10 @@ assert_s_latched:
 	}
 
 	ut_a(UT_LIST_GET_LEN(buf_pool->LRU) == n_lru);
-	if (UT_LIST_GET_LEN(buf_pool->free) != n_free) {
+	/* Blocks are added to the free list only while holding
+	buf_pool->mutex, but buf_LRU_get_free_only() may remove them
+	concurrently before changing their state. */
+	if (UT_LIST_GET_LEN(buf_pool->free) > n_free) {
 		fprintf(stderr, "Free list len %lu, free blocks %lu\n",
 			(ulong) UT_LIST_GET_LEN(buf_pool->free),
 			(ulong) n_free);
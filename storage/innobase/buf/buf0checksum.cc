@@ -71,6 +71,30 @@ buf_calc_page_crc32(
 	return(checksum);
 }
 
+/********************************************************************//**
+Calculates the page CRC32 of several pages, as buf_calc_page_crc32()
+would, interleaving the computation for consecutive pages. */
+UNIV_INTERN
+void
+buf_calc_page_crc32_batch(
+/*======================*/
+	const byte* const*	pages,	/*!< in: buffer pages */
+	ulint			n,	/*!< in: number of pages */
+	ib_uint32_t*		checksums)/*!< out: checksum of each page */
+{
+	/* The same fields as in buf_calc_page_crc32() are skipped. */
+
+	ut_crc32_batch(pages, n, FIL_PAGE_DATA,
+		       UNIV_PAGE_SIZE - FIL_PAGE_DATA
+		       - FIL_PAGE_END_LSN_OLD_CHKSUM, checksums);
+
+	for (ulint i = 0; i < n; i++) {
+		checksums[i] ^= ut_crc32(pages[i] + FIL_PAGE_OFFSET,
+					 FIL_PAGE_FILE_FLUSH_LSN
+					 - FIL_PAGE_OFFSET);
+	}
+}
+
 /********************************************************************//**
 Calculates a page checksum which is stored to the page when it is written
 to a file. Note that we must be careful to calculate the same value on
@@ -35,6 +35,8 @@ Created 2011/12/19
 #include "srv0srv.h"
 #include "page0zip.h"
 #include "trx0sys.h"
+#include "buf0flu.h"
+#include "fil0pagecompress.h"
 
 #ifndef UNIV_HOTBACKUP
 
@@ -169,6 +171,9 @@ buf_dblwr_init(
 
 	buf_dblwr->buf_block_arr = static_cast<buf_page_t**>(
 		mem_zalloc(buf_size * sizeof(void*)));
+
+	buf_dblwr->checksum_pending = static_cast<bool*>(
+		mem_zalloc(buf_size * sizeof(bool)));
 }
 
 /****************************************************************//**
@@ -517,6 +522,17 @@ buf_dblwr_process()
 			       zip_size ? zip_size : UNIV_PAGE_SIZE,
 			       read_buf, NULL);
 
+			/* A page image that cannot be decompressed is
+			detected as corrupted below. */
+			if (fil_page_is_compressed(read_buf)
+			    && !fil_page_decompress(read_buf)) {
+
+				ib_logf(IB_LOG_LEVEL_WARN,
+					"Cannot decompress space %lu"
+					" page %lu.",
+					(ulong) space_id, (ulong) page_no);
+			}
+
 			/* Check if the page is corrupt */
 
 			if (buf_page_is_corrupted(true, read_buf, zip_size)) {
@@ -617,6 +633,9 @@ buf_dblwr_free(void)
 	mem_free(buf_dblwr->buf_block_arr);
 	buf_dblwr->buf_block_arr = NULL;
 
+	mem_free(buf_dblwr->checksum_pending);
+	buf_dblwr->checksum_pending = NULL;
+
 	mem_free(buf_dblwr->in_use);
 	buf_dblwr->in_use = NULL;
 
@@ -775,6 +794,64 @@ buf_dblwr_check_block(
 	}
 }
 
+/** Number of pages whose checksums buf_dblwr_store_batch_checksums()
+computes in one call of buf_calc_page_crc32_batch() */
+#define BUF_DBLWR_CHECKSUM_BATCH	24
+
+/********************************************************************//**
+Computes the CRC32 checksums that were left pending by
+buf_flush_write_block_low() for the pages of a doublewrite batch, and
+stores them in the copies of the pages in write_buf and in the buffer
+pool frames, which are io-fixed until the batch has been written. */
+static
+void
+buf_dblwr_store_batch_checksums(
+/*============================*/
+	ulint	n_slots)	/*!< in: number of pages in the batch */
+{
+	const byte*	pages[BUF_DBLWR_CHECKSUM_BATCH];
+	ulint		slots[BUF_DBLWR_CHECKSUM_BATCH];
+	ib_uint32_t	checksums[BUF_DBLWR_CHECKSUM_BATCH];
+	ulint		n = 0;
+
+	for (ulint i = 0; i < n_slots; i++) {
+
+		if (buf_dblwr->checksum_pending[i]) {
+			buf_dblwr->checksum_pending[i] = false;
+			pages[n] = buf_dblwr->write_buf + i * UNIV_PAGE_SIZE;
+			slots[n++] = i;
+		}
+
+		if (n == BUF_DBLWR_CHECKSUM_BATCH
+		    || (n > 0 && i + 1 == n_slots)) {
+
+			buf_calc_page_crc32_batch(pages, n, checksums);
+
+			for (ulint j = 0; j < n; j++) {
+				byte*	page = const_cast<byte*>(pages[j]);
+				byte*	frame = reinterpret_cast<buf_block_t*>(
+					buf_dblwr->buf_block_arr[slots[j]])
+					->frame;
+
+				mach_write_to_4(page + FIL_PAGE_SPACE_OR_CHKSUM,
+						checksums[j]);
+				mach_write_to_4(page + UNIV_PAGE_SIZE
+						- FIL_PAGE_END_LSN_OLD_CHKSUM,
+						checksums[j]);
+
+				memcpy(frame + FIL_PAGE_SPACE_OR_CHKSUM,
+				       page + FIL_PAGE_SPACE_OR_CHKSUM, 4);
+				memcpy(frame + UNIV_PAGE_SIZE
+				       - FIL_PAGE_END_LSN_OLD_CHKSUM,
+				       page + UNIV_PAGE_SIZE
+				       - FIL_PAGE_END_LSN_OLD_CHKSUM, 4);
+			}
+
+			n = 0;
+		}
+	}
+}
+
 /********************************************************************//**
 Writes a page that has already been written to the doublewrite buffer
 to the datafile. It is the job of the caller to sync the datafile. */
@@ -805,13 +882,20 @@ buf_dblwr_write_block_to_datafile(
 	}
 
 
-	const buf_block_t* block = (buf_block_t*) bpage;
+	buf_block_t*	block = (buf_block_t*) bpage;
+	byte*		frame;
+	ulint		len;
+
 	ut_a(buf_block_get_state(block) == BUF_BLOCK_FILE_PAGE);
 	buf_dblwr_check_page_lsn(block->frame);
 
+	/* The doublewrite buffer holds the uncompressed page, so that
+	the page can be restored from it whatever was written here. */
+	len = buf_flush_compress_page(block, &frame);
+
 	fil_io(flags, sync, buf_block_get_space(block), 0,
-	       buf_block_get_page_no(block), 0, UNIV_PAGE_SIZE,
-	       (void*) block->frame, (void*) block);
+	       buf_block_get_page_no(block), 0, len,
+	       (void*) frame, (void*) block);
 
 }
 
@@ -924,6 +1008,8 @@ try_again:
 
 	write_buf = buf_dblwr->write_buf;
 
+	buf_dblwr_store_batch_checksums(first_free);
+
 	for (ulint len2 = 0, i = 0;
 	     i < buf_dblwr->first_free;
 	     len2 += UNIV_PAGE_SIZE, i++) {
@@ -1165,7 +1251,11 @@ UNIV_INTERN
 void
 buf_dblwr_add_to_batch(
 /*====================*/
-	buf_page_t*	bpage)	/*!< in: buffer block to write */
+	buf_page_t*	bpage,	/*!< in: buffer block to write */
+	bool		checksum_pending)
+				/*!< in: true if the CRC32 checksum of
+				the page is to be stored when the batch
+				is flushed */
 {
 	ulint	zip_size;
 
@@ -1221,6 +1311,7 @@ try_again:
 	}
 
 	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
+	buf_dblwr->checksum_pending[buf_dblwr->first_free] = checksum_pending;
 
 	buf_dblwr->first_free++;
 	buf_dblwr->b_reserved++;
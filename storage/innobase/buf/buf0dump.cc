@@ -68,6 +68,72 @@ typedef ib_uint64_t	buf_dump_t;
 #define BUF_DUMP_SPACE(a)		((ulint) ((a) >> 32))
 #define BUF_DUMP_PAGE(a)		((ulint) ((a) & 0xFFFFFFFFUL))
 
+/* The dump file starts with the header line BUF_DUMP_HEADER followed by
+the format number, BUF_DUMP_FORMAT. It then has one line
+"space,page,heat" per page. The heat of a page is its recency, the
+position of the page in the LRU list of its buffer pool instance scaled
+to 0..BUF_DUMP_HEAT_RECENCY-1 (the head of the list being the hottest),
+plus BUF_DUMP_HEAT_RECENCY if the page was in the "new" sublist, that
+is, it had been accessed repeatedly.
+
+Files written by older versions (format 1) have no header and no heat
+column. Each buffer pool instance is written in the same LRU order,
+coldest page first, so the heat of a page is derived from its position
+among the pages of its instance.
+
+Older versions cannot read format 2: they stop the load with a parse
+error and start with a cold buffer pool. A dump must be written again
+by the older version after a downgrade. */
+#define BUF_DUMP_HEADER		"#ib_buffer_pool format "
+#define BUF_DUMP_FORMAT		2
+#define BUF_DUMP_HEAT_RECENCY	1000
+#define BUF_DUMP_HEAT_MAX	(2 * BUF_DUMP_HEAT_RECENCY - 1)
+
+/* Pages are loaded in bands of this much heat, hottest band first.
+Within a band, pages are loaded in space_no, page_no order in order to
+increase the chance for sequential IO. */
+#define BUF_LOAD_HEAT_BAND	100
+
+/* Number of pages that a load thread reads from a buffer pool instance
+before it moves on to the next instance */
+#define BUF_LOAD_BATCH		64
+
+/* A page to load */
+struct buf_load_page_t {
+	buf_dump_t	id;		/*!< space id and page number */
+	ulint		heat;		/*!< heat, see BUF_DUMP_HEAT_MAX */
+	ulint		instance;	/*!< buffer pool instance number */
+};
+
+/* State of a buffer pool load, shared by the load threads */
+struct buf_load_t {
+	buf_load_page_t*	pages;		/*!< pages to load, sorted by
+						buf_load_cmp() */
+	ulint			n_pages;	/*!< number of pages */
+	ulint*			first;		/*!< first[i] is the index
+						of the first page of buffer
+						pool instance i in pages[],
+						first[srv_buf_pool_instances]
+						== n_pages */
+	ulint*			next;		/*!< next[i] is the index of
+						the next page of instance
+						i to load; incremented
+						atomically by BUF_LOAD_BATCH */
+	ulint			n_done;		/*!< number of pages for which
+						a read has been issued or that
+						were skipped; updated
+						atomically */
+	ulint			n_threads;	/*!< number of active load
+						threads; updated atomically */
+	ullint			start_us;	/*!< start time of the load,
+						for the I/O budget */
+	os_event_t		done;		/*!< set by the last load
+						thread when it exits */
+};
+
+/* The load currently in progress, or NULL */
+static buf_load_t*	buf_load_ctx = NULL;
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -208,11 +274,21 @@ buf_dump(
 	}
 	/* else */
 
+	if (fprintf(f, BUF_DUMP_HEADER "%d\n", BUF_DUMP_FORMAT) < 0) {
+		fclose(f);
+		buf_dump_status(STATUS_ERR,
+				"Cannot write to '%s': %s",
+				tmp_filename, strerror(errno));
+		/* leave tmp_filename to exist */
+		return;
+	}
+
 	/* walk through each buffer pool */
 	for (i = 0; i < srv_buf_pool_instances && !SHOULD_QUIT(); i++) {
 		buf_pool_t*		buf_pool;
 		const buf_page_t*	bpage;
 		buf_dump_t*		dump;
+		ulint*			heat;
 		ulint			n_pages;
 		ulint			j;
 
@@ -231,19 +307,23 @@ buf_dump(
 		}
 
 		dump = static_cast<buf_dump_t*>(
-			ut_malloc(n_pages * sizeof(*dump))) ;
+			ut_malloc(n_pages * (sizeof(*dump) + sizeof(*heat))));
 
 		if (dump == NULL) {
 			buf_pool_mutex_exit(buf_pool);
 			fclose(f);
 			buf_dump_status(STATUS_ERR,
 					"Cannot allocate " ULINTPF " bytes: %s",
-					(ulint) (n_pages * sizeof(*dump)),
+					(ulint) (n_pages
+						 * (sizeof(*dump)
+						    + sizeof(*heat))),
 					strerror(errno));
 			/* leave tmp_filename to exist */
 			return;
 		}
 
+		heat = reinterpret_cast<ulint*>(dump + n_pages);
+
 		for (bpage = UT_LIST_GET_LAST(buf_pool->LRU), j = 0;
 		     bpage != NULL;
 		     bpage = UT_LIST_GET_PREV(LRU, bpage), j++) {
@@ -252,6 +332,14 @@ buf_dump(
 
 			dump[j] = BUF_DUMP_CREATE(buf_page_get_space(bpage),
 						  buf_page_get_page_no(bpage));
+
+			/* The list is walked from the tail (coldest)
+			to the head (hottest). */
+			heat[j] = j * BUF_DUMP_HEAT_RECENCY / n_pages;
+
+			if (!buf_page_is_old(bpage)) {
+				heat[j] += BUF_DUMP_HEAT_RECENCY;
+			}
 		}
 
 		ut_a(j == n_pages);
@@ -259,9 +347,10 @@ buf_dump(
 		buf_pool_mutex_exit(buf_pool);
 
 		for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
-			ret = fprintf(f, ULINTPF "," ULINTPF "\n",
+			ret = fprintf(f, ULINTPF "," ULINTPF "," ULINTPF "\n",
 				      BUF_DUMP_SPACE(dump[j]),
-				      BUF_DUMP_PAGE(dump[j]));
+				      BUF_DUMP_PAGE(dump[j]),
+				      heat[j]);
 			if (ret < 0) {
 				ut_free(dump);
 				fclose(f);
@@ -325,20 +414,31 @@ buf_dump(
 }
 
 /*****************************************************************//**
-Compare two buffer pool dump entries, used to sort the dump on
-space_no,page_no before loading in order to increase the chance for
-sequential IO.
+Compare two pages to load. Pages are ordered by buffer pool instance,
+then by heat band, hottest first, and within a band on space_no,page_no
+in order to increase the chance for sequential IO.
 @return -1/0/1 if entry 1 is smaller/equal/bigger than entry 2 */
 static
 lint
-buf_dump_cmp(
+buf_load_cmp(
 /*=========*/
-	const buf_dump_t	d1,	/*!< in: buffer pool dump entry 1 */
-	const buf_dump_t	d2)	/*!< in: buffer pool dump entry 2 */
+	const buf_load_page_t&	p1,	/*!< in: page to load 1 */
+	const buf_load_page_t&	p2)	/*!< in: page to load 2 */
 {
-	if (d1 < d2) {
+	if (p1.instance != p2.instance) {
+		return(p1.instance < p2.instance ? -1 : 1);
+	}
+
+	ulint	band1 = p1.heat / BUF_LOAD_HEAT_BAND;
+	ulint	band2 = p2.heat / BUF_LOAD_HEAT_BAND;
+
+	if (band1 != band2) {
+		return(band1 > band2 ? -1 : 1);
+	}
+
+	if (p1.id < p2.id) {
 		return(-1);
-	} else if (d1 == d2) {
+	} else if (p1.id == p2.id) {
 		return(0);
 	} else {
 		return(1);
@@ -346,24 +446,136 @@ buf_dump_cmp(
 }
 
 /*****************************************************************//**
-Sort a buffer pool dump on space_no, page_no. */
+Sort the pages to load, see buf_load_cmp(). */
 static
 void
-buf_dump_sort(
+buf_load_sort(
 /*==========*/
-	buf_dump_t*	dump,	/*!< in/out: buffer pool dump to sort */
-	buf_dump_t*	tmp,	/*!< in/out: temp storage */
-	ulint		low,	/*!< in: lowest index (inclusive) */
-	ulint		high)	/*!< in: highest index (non-inclusive) */
+	buf_load_page_t*	pages,	/*!< in/out: pages to sort */
+	buf_load_page_t*	tmp,	/*!< in/out: temp storage */
+	ulint			low,	/*!< in: lowest index (inclusive) */
+	ulint			high)	/*!< in: highest index
+					(non-inclusive) */
 {
-	UT_SORT_FUNCTION_BODY(buf_dump_sort, dump, tmp, low, high,
-			      buf_dump_cmp);
+	UT_SORT_FUNCTION_BODY(buf_load_sort, pages, tmp, low, high,
+			      buf_load_cmp);
+}
+
+/*****************************************************************//**
+Sleeps if the load is ahead of innodb_buffer_pool_load_io_capacity. */
+static
+void
+buf_load_throttle(
+/*==============*/
+	const buf_load_t*	load)	/*!< in: load in progress */
+{
+	ulint	io_capacity = srv_buf_load_io_capacity;
+
+	if (io_capacity == 0) {
+		return;
+	}
+
+	ullint	target_us = static_cast<ullint>(load->n_done) * 1000000
+		/ io_capacity;
+	ullint	elapsed_us = ut_time_us(NULL) - load->start_us;
+
+	if (target_us > elapsed_us) {
+		os_thread_sleep(static_cast<ulint>(
+			ut_min(target_us - elapsed_us, 1000000ULL)));
+	}
+}
+
+/*****************************************************************//**
+Loads pages of the buffer pool load in progress. Each thread takes
+batches of BUF_LOAD_BATCH pages from the buffer pool instances in turn,
+so that all instances are warmed up hottest pages first, and issues
+asynchronous reads for them. An instance is done when all of its pages
+have been read or when it has no free blocks left: the remaining pages
+are colder than the ones already loaded, and the ones brought in by the
+workload that is running meanwhile.
+@return this function does not return, it calls os_thread_exit() */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(buf_load_thread)(
+/*============================*/
+	void*	arg)	/*!< in: thread number */
+{
+	buf_load_t*	load = buf_load_ctx;
+	ulint		instance = reinterpret_cast<ulint>(arg);
+	ulint		n_idle = 0;
+
+	/* Stop when no instance had any pages left to load during a
+	full round over the instances. */
+	while (n_idle < srv_buf_pool_instances
+	       && !SHUTTING_DOWN() && !buf_load_abort_flag) {
+		buf_pool_t*	buf_pool;
+		ulint		first;
+		ulint		end;
+
+		instance = (instance + 1) % srv_buf_pool_instances;
+		buf_pool = buf_pool_from_array(instance);
+		end = load->first[instance + 1];
+
+		if (load->next[instance] >= end) {
+			n_idle++;
+			continue;
+		}
+
+		if (UT_LIST_GET_LEN(buf_pool->free) == 0) {
+			/* Skip the rest of this instance. */
+			first = os_atomic_increment_ulint(
+				&load->next[instance], end) - end;
+			if (first < end) {
+				os_atomic_increment_ulint(
+					&load->n_done, end - first);
+			}
+			n_idle++;
+			continue;
+		}
+
+		first = os_atomic_increment_ulint(
+			&load->next[instance], BUF_LOAD_BATCH)
+			- BUF_LOAD_BATCH;
+
+		if (first >= end) {
+			n_idle++;
+			continue;
+		}
+
+		n_idle = 0;
+		end = ut_min(end, first + BUF_LOAD_BATCH);
+
+		for (ulint i = first; i < end; i++) {
+			buf_read_page_async(
+				BUF_DUMP_SPACE(load->pages[i].id),
+				BUF_DUMP_PAGE(load->pages[i].id));
+		}
+
+		os_aio_simulated_wake_handler_threads();
+
+		os_atomic_increment_ulint(&load->n_done, end - first);
+
+		buf_load_throttle(load);
+	}
+
+	if (os_atomic_decrement_ulint(&load->n_threads, 1) == 0) {
+		os_event_set(load->done);
+	}
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
 }
 
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
 innodb_buffer_pool_load_status will be set accordingly, see buf_load_status().
+The pages are read by innodb_buffer_pool_load_threads threads, hottest
+pages first, see buf_load_thread(); the server keeps serving requests
+meanwhile.
 The dump filename can be specified by (relative to srv_data_home):
 SET GLOBAL innodb_buffer_pool_filename='filename'; */
 static
@@ -372,16 +584,21 @@ buf_load()
 /*======*/
 {
 	char		full_filename[OS_FILE_MAX_PATH];
+	char		line[128];
 	char		now[32];
 	FILE*		f;
-	buf_dump_t*	dump;
-	buf_dump_t*	dump_tmp;
+	buf_load_t	load;
+	buf_load_page_t*	pages_tmp;
 	ulint		dump_n;
 	ulint		total_buffer_pools_pages;
+	ulint		n_threads;
 	ulint		i;
 	ulint		space_id;
 	ulint		page_no;
-	int		fscanf_ret;
+	ulint		heat;
+	ulint		format;
+	ulint*		n_legacy = NULL;
+	int		sscanf_ret;
 
 	/* Ignore any leftovers from before */
 	buf_load_abort_flag = FALSE;
@@ -402,17 +619,37 @@ buf_load()
 	}
 	/* else */
 
+	/* A dump without the header line was written by an older
+	version. */
+	format = 1;
+
+	if (fgets(line, sizeof line, f) != NULL && line[0] == '#') {
+		if (sscanf(line, BUF_DUMP_HEADER ULINTPF, &format) != 1
+		    || format < 2 || format > BUF_DUMP_FORMAT) {
+
+			fclose(f);
+			buf_load_status(STATUS_ERR,
+					"Unsupported format of '%s', "
+					"unable to load buffer pool",
+					full_filename);
+			return;
+		}
+	} else {
+		rewind(f);
+	}
+
 	/* First scan the file to estimate how many entries are in it.
 	This file is tiny (approx 500KB per 1GB buffer pool), reading it
 	two times is fine. */
 	dump_n = 0;
-	while (fscanf(f, ULINTPF "," ULINTPF, &space_id, &page_no) == 2
+	while (fgets(line, sizeof line, f) != NULL
+	       && sscanf(line, ULINTPF "," ULINTPF, &space_id, &page_no) == 2
 	       && !SHUTTING_DOWN()) {
 		dump_n++;
 	}
 
 	if (!SHUTTING_DOWN() && !feof(f)) {
-		/* fscanf() returned != 2 */
+		/* sscanf() returned != 2 */
 		const char*	what;
 		if (ferror(f)) {
 			what = "reading";
@@ -435,44 +672,62 @@ buf_load()
 		dump_n = total_buffer_pools_pages;
 	}
 
-	dump = static_cast<buf_dump_t*>(ut_malloc(dump_n * sizeof(*dump)));
+	load.pages = static_cast<buf_load_page_t*>(
+		ut_malloc(dump_n * sizeof(*load.pages)));
 
-	if (dump == NULL) {
+	if (load.pages == NULL) {
 		fclose(f);
 		buf_load_status(STATUS_ERR,
 				"Cannot allocate " ULINTPF " bytes: %s",
-				(ulint) (dump_n * sizeof(*dump)),
+				(ulint) (dump_n * sizeof(*load.pages)),
 				strerror(errno));
 		return;
 	}
 
-	dump_tmp = static_cast<buf_dump_t*>(
-		ut_malloc(dump_n * sizeof(*dump_tmp)));
+	pages_tmp = static_cast<buf_load_page_t*>(
+		ut_malloc(dump_n * sizeof(*pages_tmp)));
 
-	if (dump_tmp == NULL) {
-		ut_free(dump);
+	if (pages_tmp == NULL) {
+		ut_free(load.pages);
 		fclose(f);
 		buf_load_status(STATUS_ERR,
 				"Cannot allocate " ULINTPF " bytes: %s",
-				(ulint) (dump_n * sizeof(*dump_tmp)),
+				(ulint) (dump_n * sizeof(*pages_tmp)),
 				strerror(errno));
 		return;
 	}
 
+	if (format == 1) {
+		/* Pages of each buffer pool instance seen so far */
+		n_legacy = static_cast<ulint*>(
+			mem_zalloc(srv_buf_pool_instances
+				   * sizeof *n_legacy));
+	}
+
 	rewind(f);
 
+	if (format > 1 && fgets(line, sizeof line, f) == NULL) {
+		/* The file got truncated after we read the header
+		line the first time. */
+		dump_n = 0;
+	}
+
 	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-		fscanf_ret = fscanf(f, ULINTPF "," ULINTPF,
-				    &space_id, &page_no);
+		if (fgets(line, sizeof line, f) == NULL) {
+			/* The file got truncated after we read it
+			the first time. */
+			break;
+		}
 
-		if (fscanf_ret != 2) {
-			if (feof(f)) {
-				break;
-			}
-			/* else */
+		sscanf_ret = sscanf(line, ULINTPF "," ULINTPF "," ULINTPF,
+				    &space_id, &page_no, &heat);
 
-			ut_free(dump);
-			ut_free(dump_tmp);
+		if (sscanf_ret < 2) {
+			if (n_legacy != NULL) {
+				mem_free(n_legacy);
+			}
+			ut_free(load.pages);
+			ut_free(pages_tmp);
 			fclose(f);
 			buf_load_status(STATUS_ERR,
 					"Error parsing '%s', unable "
@@ -482,8 +737,11 @@ buf_load()
 		}
 
 		if (space_id > ULINT32_MASK || page_no > ULINT32_MASK) {
-			ut_free(dump);
-			ut_free(dump_tmp);
+			if (n_legacy != NULL) {
+				mem_free(n_legacy);
+			}
+			ut_free(load.pages);
+			ut_free(pages_tmp);
 			fclose(f);
 			buf_load_status(STATUS_ERR,
 					"Error parsing '%s': bogus "
@@ -496,7 +754,22 @@ buf_load()
 			return;
 		}
 
-		dump[i] = BUF_DUMP_CREATE(space_id, page_no);
+		load.pages[i].id = BUF_DUMP_CREATE(space_id, page_no);
+		load.pages[i].instance = buf_pool_index(
+			buf_pool_get(space_id, page_no));
+
+		if (n_legacy != NULL) {
+			/* The position among the pages of the
+			instance, scaled below. */
+			heat = n_legacy[load.pages[i].instance]++;
+		} else if (sscanf_ret == 2) {
+			/* A line without heat, added by hand */
+			heat = 0;
+		} else {
+			heat = ut_min(heat, (ulint) BUF_DUMP_HEAT_MAX);
+		}
+
+		load.pages[i].heat = heat;
 	}
 
 	/* Set dump_n to the actual number of initialized elements,
@@ -504,10 +777,25 @@ buf_load()
 	we read it the first time. */
 	dump_n = i;
 
+	if (n_legacy != NULL) {
+		/* A legacy dump lists each instance coldest page first.
+		Scale the position of each page among the pages of its
+		instance to the recency range of the heat. */
+		for (i = 0; i < dump_n; i++) {
+			buf_load_page_t*	page = &load.pages[i];
+
+			page->heat = page->heat * BUF_DUMP_HEAT_RECENCY
+				/ n_legacy[page->instance];
+		}
+
+		mem_free(n_legacy);
+	}
+
 	fclose(f);
 
 	if (dump_n == 0) {
-		ut_free(dump);
+		ut_free(load.pages);
+		ut_free(pages_tmp);
 		ut_sprintf_timestamp(now);
 		buf_load_status(STATUS_NOTICE,
 				"Buffer pool(s) load completed at %s "
@@ -516,37 +804,61 @@ buf_load()
 	}
 
 	if (!SHUTTING_DOWN()) {
-		buf_dump_sort(dump, dump_tmp, 0, dump_n);
+		buf_load_sort(load.pages, pages_tmp, 0, dump_n);
 	}
 
-	ut_free(dump_tmp);
+	ut_free(pages_tmp);
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+	load.n_pages = dump_n;
+	load.first = static_cast<ulint*>(
+		mem_zalloc(2 * (srv_buf_pool_instances + 1)
+			   * sizeof *load.first));
+	load.next = load.first + srv_buf_pool_instances + 1;
 
-		buf_read_page_async(BUF_DUMP_SPACE(dump[i]),
-				    BUF_DUMP_PAGE(dump[i]));
+	for (i = 0; i < dump_n; i++) {
+		load.first[load.pages[i].instance + 1]++;
+	}
 
-		if (i % 64 == 63) {
-			os_aio_simulated_wake_handler_threads();
-		}
+	for (i = 0; i < srv_buf_pool_instances; i++) {
+		load.first[i + 1] += load.first[i];
+		load.next[i] = load.first[i];
+	}
 
-		if (i % 128 == 0) {
-			buf_load_status(STATUS_INFO,
-					"Loaded " ULINTPF "/" ULINTPF " pages",
-					i + 1, dump_n);
-		}
+	load.n_done = 0;
+	load.start_us = ut_time_us(NULL);
+	load.done = os_event_create();
 
-		if (buf_load_abort_flag) {
-			buf_load_abort_flag = FALSE;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_NOTICE,
-				"Buffer pool(s) load aborted on request");
-			return;
-		}
+	n_threads = ut_min(srv_buf_load_threads, dump_n / BUF_LOAD_BATCH + 1);
+	load.n_threads = n_threads;
+
+	buf_load_ctx = &load;
+
+	for (i = 0; i < n_threads; i++) {
+		os_thread_create(buf_load_thread,
+				 reinterpret_cast<void*>(i), NULL);
 	}
 
-	ut_free(dump);
+	while (os_event_wait_time(load.done, 1000000)
+	       == OS_SYNC_TIME_EXCEEDED) {
+
+		buf_load_status(STATUS_INFO,
+				"Loaded " ULINTPF "/" ULINTPF " pages",
+				load.n_done, dump_n);
+	}
+
+	buf_load_ctx = NULL;
+
+	os_event_free(load.done);
+	mem_free(load.first);
+	ut_free(load.pages);
+
+	if (buf_load_abort_flag) {
+		buf_load_abort_flag = FALSE;
+		buf_load_status(
+			STATUS_NOTICE,
+			"Buffer pool(s) load aborted on request");
+		return;
+	}
 
 	ut_sprintf_timestamp(now);
 
@@ -39,6 +39,7 @@ Created 11/11/1995 Heikki Tuuri
 #include "ut0lst.h"
 #include "page0page.h"
 #include "fil0fil.h"
+#include "fil0pagecompress.h"
 #include "buf0lru.h"
 #include "buf0rea.h"
 #include "ibuf0ibuf.h"
@@ -65,6 +66,7 @@ reduce the wait time for the threads waiting for a clean block */
 
 #ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t buf_page_cleaner_thread_key;
+UNIV_INTERN mysql_pfs_key_t buf_page_cleaner_worker_thread_key;
 #endif /* UNIV_PFS_THREAD */
 
 /** If LRU list of a buf_pool is less than this size then LRU eviction
@@ -736,6 +738,83 @@ buf_flush_write_complete(
 
 	buf_dblwr_update(bpage, flush_type);
 }
+
+/********************************************************************//**
+Compresses an uncompressed page that is about to be written to its data
+file, if innodb_page_compression is enabled and the page qualifies: only
+B-tree pages of file-per-table tablespaces are compressed. The page must
+have been prepared by buf_flush_init_for_writing(), including its checksum.
+The image is kept in block->comp_frame until buf_flush_compress_complete().
+@return	number of bytes to write from the returned frame */
+UNIV_INTERN
+ulint
+buf_flush_compress_page(
+/*====================*/
+	buf_block_t*	block,	/*!< in/out: block being written */
+	byte**		frame)	/*!< out: block->frame, or the compressed
+				image of it */
+{
+	ulint	algorithm	= fil_page_compression;
+	ulint	len;
+
+	ut_ad(buf_block_get_state(block) == BUF_BLOCK_FILE_PAGE);
+	ut_ad(buf_page_get_io_fix(&block->page) == BUF_IO_WRITE);
+	ut_ad(block->comp_frame == NULL);
+
+	*frame = block->frame;
+
+	/* The system and undo tablespaces are never compressed. */
+	if (algorithm == FIL_PAGE_COMPRESSION_NONE
+	    || block->page.zip.data != NULL
+	    || block->page.space <= srv_undo_tablespaces_open
+	    || fil_page_get_type(block->frame) != FIL_PAGE_INDEX) {
+
+		return(UNIV_PAGE_SIZE);
+	}
+
+	block->comp_frame_alloc = ut_malloc(2 * UNIV_PAGE_SIZE);
+	block->comp_frame = static_cast<byte*>(
+		ut_align(block->comp_frame_alloc, UNIV_PAGE_SIZE));
+
+	len = fil_page_compress(block->frame, block->comp_frame, algorithm);
+
+	if (len == 0) {
+		ut_free(block->comp_frame_alloc);
+		block->comp_frame_alloc = NULL;
+		block->comp_frame = NULL;
+
+		return(UNIV_PAGE_SIZE);
+	}
+
+	*frame = block->comp_frame;
+
+	return(len);
+}
+
+/********************************************************************//**
+Releases the compressed image of a page after its write has completed, and
+the file blocks beyond it. */
+UNIV_INTERN
+void
+buf_flush_compress_complete(
+/*========================*/
+	buf_block_t*	block)	/*!< in/out: block that was written */
+{
+	ulint	len;
+
+	ut_ad(block->comp_frame != NULL);
+
+	len = ut_calc_align(FIL_PAGE_DATA
+			    + mach_read_from_2(block->comp_frame
+					       + FIL_PAGE_COMP_SIZE),
+			    FIL_PAGE_COMPRESS_BLOCK_SIZE);
+
+	fil_page_punch_hole(block->page.space, block->page.offset, len);
+
+	ut_free(block->comp_frame_alloc);
+	block->comp_frame_alloc = NULL;
+	block->comp_frame = NULL;
+}
 #endif /* !UNIV_HOTBACKUP */
 
 /********************************************************************//**
@@ -762,15 +841,20 @@ buf_flush_update_zip_checksum(
 }
 
 /********************************************************************//**
-Initializes a page for writing to the tablespace. */
-UNIV_INTERN
-void
-buf_flush_init_for_writing(
-/*=======================*/
+Initializes a page for writing to the tablespace.
+@return true if the CRC32 checksum of the page was left for the caller
+to compute and store */
+static
+bool
+buf_flush_init_for_writing_low(
+/*===========================*/
 	byte*	page,		/*!< in/out: page */
 	void*	page_zip_,	/*!< in/out: compressed page, or NULL */
-	lsn_t	newest_lsn)	/*!< in: newest modification lsn
+	lsn_t	newest_lsn,	/*!< in: newest modification lsn
 				to the page */
+	bool	defer_crc32)	/*!< in: true if the caller computes a
+				CRC32 checksum itself, together with
+				those of other pages */
 {
 	ib_uint32_t	checksum = 0 /* silence bogus gcc warning */;
 
@@ -803,7 +887,7 @@ buf_flush_init_for_writing(
 			buf_flush_update_zip_checksum(
 				page_zip->data, zip_size, newest_lsn);
 
-			return;
+			return(false);
 		}
 
 		ut_print_timestamp(stderr);
@@ -827,6 +911,12 @@ buf_flush_init_for_writing(
 	switch ((srv_checksum_algorithm_t) srv_checksum_algorithm) {
 	case SRV_CHECKSUM_ALGORITHM_CRC32:
 	case SRV_CHECKSUM_ALGORITHM_STRICT_CRC32:
+		if (defer_crc32) {
+			/* Both checksum fields will be stored by
+			buf_dblwr_flush_buffered_writes(). */
+			return(true);
+		}
+
 		checksum = buf_calc_page_crc32(page);
 		mach_write_to_4(page + FIL_PAGE_SPACE_OR_CHKSUM, checksum);
 		break;
@@ -860,6 +950,22 @@ buf_flush_init_for_writing(
 
 	mach_write_to_4(page + UNIV_PAGE_SIZE - FIL_PAGE_END_LSN_OLD_CHKSUM,
 			checksum);
+
+	return(false);
+}
+
+/********************************************************************//**
+Initializes a page for writing to the tablespace. */
+UNIV_INTERN
+void
+buf_flush_init_for_writing(
+/*=======================*/
+	byte*	page,		/*!< in/out: page */
+	void*	page_zip_,	/*!< in/out: compressed page, or NULL */
+	lsn_t	newest_lsn)	/*!< in: newest modification lsn
+				to the page */
+{
+	buf_flush_init_for_writing_low(page, page_zip_, newest_lsn, false);
 }
 
 #ifndef UNIV_HOTBACKUP
@@ -878,6 +984,7 @@ buf_flush_write_block_low(
 {
 	ulint	zip_size	= buf_page_get_zip_size(bpage);
 	page_t*	frame		= NULL;
+	bool	checksum_pending = false;
 
 #ifdef UNIV_DEBUG
 	buf_pool_t*	buf_pool = buf_pool_from_bpage(bpage);
@@ -942,24 +1049,34 @@ buf_flush_write_block_low(
 			frame = ((buf_block_t*) bpage)->frame;
 		}
 
-		buf_flush_init_for_writing(((buf_block_t*) bpage)->frame,
-					   bpage->zip.data
-					   ? &bpage->zip : NULL,
-					   bpage->newest_modification);
+		/* Uncompressed pages that go through the doublewrite
+		batch get their CRC32 checksums computed together. */
+		checksum_pending = buf_flush_init_for_writing_low(
+			((buf_block_t*) bpage)->frame,
+			bpage->zip.data ? &bpage->zip : NULL,
+			bpage->newest_modification,
+			srv_use_doublewrite_buf && buf_dblwr
+			&& flush_type != BUF_FLUSH_SINGLE_PAGE);
 		break;
 	}
 
 	if (!srv_use_doublewrite_buf || !buf_dblwr) {
+		ulint	len = zip_size ? zip_size : UNIV_PAGE_SIZE;
+
+		if (!zip_size) {
+			len = buf_flush_compress_page(
+				(buf_block_t*) bpage, &frame);
+		}
+
 		fil_io(OS_FILE_WRITE | OS_AIO_SIMULATED_WAKE_LATER,
 		       sync, buf_page_get_space(bpage), zip_size,
-		       buf_page_get_page_no(bpage), 0,
-		       zip_size ? zip_size : UNIV_PAGE_SIZE,
+		       buf_page_get_page_no(bpage), 0, len,
 		       frame, bpage);
 	} else if (flush_type == BUF_FLUSH_SINGLE_PAGE) {
 		buf_dblwr_write_single_page(bpage, sync);
 	} else {
 		ut_ad(!sync);
-		buf_dblwr_add_to_batch(bpage);
+		buf_dblwr_add_to_batch(bpage, checksum_pending);
 	}
 
 	/* When doing single page flushing the IO is done synchronously
@@ -1870,6 +1987,55 @@ buf_flush_LRU(
 	return(true);
 }
 
+/*******************************************************************//**
+This utility flushes dirty blocks from the end of the flush list of
+one buffer pool instance.
+NOTE: The calling thread is not allowed to own any latches on pages!
+@return true if a batch was queued successfully. false if another batch
+of same type was already running in the instance */
+static
+bool
+buf_flush_list_instance(
+/*====================*/
+	buf_pool_t*	buf_pool,	/*!< in/out: buffer pool instance */
+	ulint		min_n,		/*!< in: wished minimum mumber of blocks
+					flushed (it is not guaranteed that the
+					actual number is that big, though) */
+	lsn_t		lsn_limit,	/*!< in: all blocks whose
+					oldest_modification is smaller than
+					this should be flushed (if their
+					number does not exceed min_n) */
+	ulint*		n_processed)	/*!< out: the number of pages
+					which were processed */
+{
+	ulint		page_count;
+
+	*n_processed = 0;
+
+	if (!buf_flush_start(buf_pool, BUF_FLUSH_LIST)) {
+		return(false);
+	}
+
+	page_count = buf_flush_batch(
+		buf_pool, BUF_FLUSH_LIST, min_n, lsn_limit);
+
+	buf_flush_end(buf_pool, BUF_FLUSH_LIST);
+
+	buf_flush_common(BUF_FLUSH_LIST, page_count);
+
+	if (page_count) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_FLUSH_BATCH_TOTAL_PAGE,
+			MONITOR_FLUSH_BATCH_COUNT,
+			MONITOR_FLUSH_BATCH_PAGES,
+			page_count);
+	}
+
+	*n_processed = page_count;
+
+	return(true);
+}
+
 /*******************************************************************//**
 This utility flushes dirty blocks from the end of the flush list of
 all buffer pool instances.
@@ -1912,12 +2078,10 @@ buf_flush_list(
 
 	/* Flush to lsn_limit in all buffer pool instances */
 	for (i = 0; i < srv_buf_pool_instances; i++) {
-		buf_pool_t*	buf_pool;
 		ulint		page_count = 0;
 
-		buf_pool = buf_pool_from_array(i);
-
-		if (!buf_flush_start(buf_pool, BUF_FLUSH_LIST)) {
+		if (!buf_flush_list_instance(buf_pool_from_array(i),
+					     min_n, lsn_limit, &page_count)) {
 			/* We have two choices here. If lsn_limit was
 			specified then skipping an instance of buffer
 			pool means we cannot guarantee that all pages
@@ -1933,24 +2097,9 @@ buf_flush_list(
 			continue;
 		}
 
-		page_count = buf_flush_batch(
-			buf_pool, BUF_FLUSH_LIST, min_n, lsn_limit);
-
-		buf_flush_end(buf_pool, BUF_FLUSH_LIST);
-
-		buf_flush_common(BUF_FLUSH_LIST, page_count);
-
 		if (n_processed) {
 			*n_processed += page_count;
 		}
-
-		if (page_count) {
-			MONITOR_INC_VALUE_CUMULATIVE(
-				MONITOR_FLUSH_BATCH_TOTAL_PAGE,
-				MONITOR_FLUSH_BATCH_COUNT,
-				MONITOR_FLUSH_BATCH_PAGES,
-				page_count);
-		}
 	}
 
 	return(success);
@@ -2053,6 +2202,64 @@ buf_flush_single_page_from_LRU(
 	return(freed);
 }
 
+/*********************************************************************//**
+Clears up tail of the LRU list of one buffer pool instance:
+* Put replaceable pages at the tail of LRU to the free list
+* Flush dirty pages at the tail of LRU to the disk
+The depth to which we scan the buffer pool is controlled by dynamic
+config parameter innodb_LRU_scan_depth.
+@return total pages flushed */
+static
+ulint
+buf_flush_LRU_tail_instance(
+/*========================*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
+{
+	ulint	total_flushed = 0;
+	ulint	scan_depth;
+
+	/* srv_LRU_scan_depth can be arbitrarily large value.
+	We cap it with current LRU size. */
+	buf_pool_mutex_enter(buf_pool);
+	scan_depth = UT_LIST_GET_LEN(buf_pool->LRU);
+	buf_pool_mutex_exit(buf_pool);
+
+	scan_depth = ut_min(srv_LRU_scan_depth, scan_depth);
+
+	/* We divide LRU flush into smaller chunks because
+	there may be user threads waiting for the flush to
+	end in buf_LRU_get_free_block(). */
+	for (ulint j = 0;
+	     j < scan_depth;
+	     j += PAGE_CLEANER_LRU_BATCH_CHUNK_SIZE) {
+
+		ulint	n_flushed = 0;
+
+		/* Currently the page cleaner owning this instance is
+		the only thread that can trigger an LRU flush. It is
+		possible that a batch triggered during last iteration
+		is still running, */
+		if (buf_flush_LRU(buf_pool,
+				  PAGE_CLEANER_LRU_BATCH_CHUNK_SIZE,
+				  &n_flushed)) {
+
+			/* Allowed only one batch per
+			buffer pool instance. */
+			buf_flush_wait_batch_end(
+				buf_pool, BUF_FLUSH_LRU);
+		}
+
+		if (n_flushed) {
+			total_flushed += n_flushed;
+		} else {
+			/* Nothing to flush */
+			break;
+		}
+	}
+
+	return(total_flushed);
+}
+
 /*********************************************************************//**
 Clears up tail of the LRU lists:
 * Put replaceable pages at the tail of LRU to the free list
@@ -2068,48 +2275,8 @@ buf_flush_LRU_tail(void)
 	ulint	total_flushed = 0;
 
 	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
-
-		buf_pool_t*	buf_pool = buf_pool_from_array(i);
-		ulint		scan_depth;
-
-		/* srv_LRU_scan_depth can be arbitrarily large value.
-		We cap it with current LRU size. */
-		buf_pool_mutex_enter(buf_pool);
-		scan_depth = UT_LIST_GET_LEN(buf_pool->LRU);
-		buf_pool_mutex_exit(buf_pool);
-
-		scan_depth = ut_min(srv_LRU_scan_depth, scan_depth);
-
-		/* We divide LRU flush into smaller chunks because
-		there may be user threads waiting for the flush to
-		end in buf_LRU_get_free_block(). */
-		for (ulint j = 0;
-		     j < scan_depth;
-		     j += PAGE_CLEANER_LRU_BATCH_CHUNK_SIZE) {
-
-			ulint	n_flushed = 0;
-
-			/* Currently page_cleaner is the only thread
-			that can trigger an LRU flush. It is possible
-			that a batch triggered during last iteration is
-			still running, */
-			if (buf_flush_LRU(buf_pool,
-					  PAGE_CLEANER_LRU_BATCH_CHUNK_SIZE,
-					  &n_flushed)) {
-
-				/* Allowed only one batch per
-				buffer pool instance. */
-				buf_flush_wait_batch_end(
-					buf_pool, BUF_FLUSH_LRU);
-			}
-
-			if (n_flushed) {
-				total_flushed += n_flushed;
-			} else {
-				/* Nothing to flush */
-				break;
-			}
-		}
+		total_flushed += buf_flush_LRU_tail_instance(
+			buf_pool_from_array(i));
 	}
 
 	if (total_flushed) {
@@ -2148,6 +2315,279 @@ buf_flush_wait_LRU_batch_end(void)
 	}
 }
 
+/** Work request handed by the page_cleaner coordinator to one page
+cleaner slot. Slot i is owned by exactly one thread, which is the only
+one to flush the buffer pool instances j for which
+j % page_cleaner->n_slots == i. The coordinator itself serves slot 0. */
+struct page_cleaner_slot_t {
+	os_event_t	is_requested;	/*!< set by the coordinator when
+					there is work for the slot */
+	os_event_t	is_finished;	/*!< set by the worker when the
+					requested work has been done */
+	bool		exit;		/*!< in: the worker should exit */
+	bool		flush_lru;	/*!< in: whether to clean the tail
+					of the LRU lists */
+	ulint		n_pages_requested;
+					/*!< in: pages to flush from the
+					flush_list of each instance,
+					0 if none */
+	lsn_t		lsn_limit;	/*!< in: flush_list lsn limit */
+	bool		success;	/*!< out: false if a flush_list
+					batch was already running in one
+					of the instances */
+	ulint		n_flushed_lru;	/*!< out: pages flushed from the
+					LRU lists */
+	ulint		n_flushed_list;	/*!< out: pages flushed from the
+					flush_lists */
+	ulint		flush_lru_time;	/*!< out: milliseconds spent in
+					LRU flushing */
+	ulint		flush_list_time;/*!< out: milliseconds spent in
+					flush_list flushing */
+	ulint		total_passes;	/*!< passes served since startup */
+	ulint		total_lru;	/*!< pages flushed from the LRU
+					lists since startup */
+	ulint		total_list;	/*!< pages flushed from the
+					flush_lists since startup */
+	ulint		total_lru_time;	/*!< milliseconds spent in LRU
+					flushing since startup */
+	ulint		total_list_time;/*!< milliseconds spent in
+					flush_list flushing since startup */
+};
+
+/** Page cleaner coordinator state */
+struct page_cleaner_t {
+	ulint			n_slots;	/*!< number of slots, equal to
+						the number of page cleaner
+						threads */
+	page_cleaner_slot_t*	slots;		/*!< array of n_slots */
+	ulint			n_workers;	/*!< number of worker threads
+						still running */
+	ulint			n_passes;	/*!< passes since the stats
+						were last published */
+	ulint			flush_lru_time;	/*!< sum of LRU flush time of
+						all slots since last publish */
+	ulint			flush_list_time;/*!< sum of flush_list time of
+						all slots since last publish */
+	ulint			n_pages;	/*!< sum of pages flushed by all
+						slots since last publish */
+	ulint			max_time;	/*!< longest time a single slot
+						took in one pass since last
+						publish */
+};
+
+/** The page cleaner, NULL if the page cleaner threads are not running */
+static page_cleaner_t*	page_cleaner = NULL;
+
+/*********************************************************************//**
+Performs the work requested from a page cleaner slot on the buffer pool
+instances owned by the slot. */
+static
+void
+page_cleaner_do_slot(
+/*=================*/
+	ulint	slot_no)	/*!< in: slot number */
+{
+	page_cleaner_slot_t*	slot = &page_cleaner->slots[slot_no];
+	ulint			start_time;
+
+	slot->success = true;
+	slot->n_flushed_lru = 0;
+	slot->n_flushed_list = 0;
+	slot->flush_lru_time = 0;
+	slot->flush_list_time = 0;
+
+	if (slot->flush_lru) {
+		start_time = ut_time_ms();
+
+		for (ulint i = slot_no; i < srv_buf_pool_instances;
+		     i += page_cleaner->n_slots) {
+
+			slot->n_flushed_lru += buf_flush_LRU_tail_instance(
+				buf_pool_from_array(i));
+		}
+
+		slot->flush_lru_time = ut_time_ms() - start_time;
+	}
+
+	if (slot->n_pages_requested > 0) {
+		start_time = ut_time_ms();
+
+		for (ulint i = slot_no; i < srv_buf_pool_instances;
+		     i += page_cleaner->n_slots) {
+
+			ulint	n_flushed;
+
+			if (!buf_flush_list_instance(
+				    buf_pool_from_array(i),
+				    slot->n_pages_requested,
+				    slot->lsn_limit, &n_flushed)) {
+
+				slot->success = false;
+			}
+
+			slot->n_flushed_list += n_flushed;
+		}
+
+		slot->flush_list_time = ut_time_ms() - start_time;
+	}
+}
+
+/*********************************************************************//**
+Publishes the per thread page cleaner statistics gathered over the last
+srv_flushing_avg_loops passes to the monitor counters. */
+static
+void
+page_cleaner_update_stats(void)
+/*===========================*/
+{
+	ulint	slot_passes;
+
+	if (++page_cleaner->n_passes < srv_flushing_avg_loops) {
+		return;
+	}
+
+	slot_passes = page_cleaner->n_passes * page_cleaner->n_slots;
+
+	MONITOR_SET(MONITOR_FLUSH_AVG_TIME_THREAD,
+		    page_cleaner->flush_list_time / slot_passes);
+	MONITOR_SET(MONITOR_LRU_BATCH_FLUSH_AVG_TIME_THREAD,
+		    page_cleaner->flush_lru_time / slot_passes);
+	MONITOR_SET(MONITOR_FLUSH_AVG_PAGES_THREAD,
+		    page_cleaner->n_pages / slot_passes);
+	MONITOR_SET(MONITOR_FLUSH_MAX_TIME_THREAD,
+		    page_cleaner->max_time);
+
+	page_cleaner->n_passes = 0;
+	page_cleaner->flush_lru_time = 0;
+	page_cleaner->flush_list_time = 0;
+	page_cleaner->n_pages = 0;
+	page_cleaner->max_time = 0;
+}
+
+/*********************************************************************//**
+Prints the work done by each page cleaner thread since startup, so that
+an imbalance between the threads can be seen. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_print(
+/*=========================*/
+	FILE*	file)	/*!< in: file where to print */
+{
+	if (page_cleaner == NULL) {
+		return;
+	}
+
+	for (ulint i = 0; i < page_cleaner->n_slots; i++) {
+		const page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		fprintf(file,
+			"Page cleaner thread " ULINTPF ": " ULINTPF " passes, "
+			ULINTPF " LRU pages in " ULINTPF " ms, "
+			ULINTPF " flush_list pages in " ULINTPF " ms\n",
+			i, slot->total_passes,
+			slot->total_lru, slot->total_lru_time,
+			slot->total_list, slot->total_list_time);
+	}
+}
+
+/*********************************************************************//**
+Flushes the LRU tails and/or the flush_lists of all buffer pool
+instances, spreading the work over all page cleaner threads. Called
+by the page_cleaner coordinator only.
+@return true if a flush_list batch was queued successfully in each
+buffer pool instance */
+static
+bool
+page_cleaner_flush(
+/*===============*/
+	bool		flush_lru,	/*!< in: whether to clean the tails
+					of the LRU lists */
+	ulint		n_to_flush,	/*!< in: number of pages that we
+					should attempt to flush from the
+					flush_lists, 0 for none */
+	lsn_t		lsn_limit,	/*!< in: LSN up to which flushing
+					must happen */
+	ulint*		n_flushed_lru,	/*!< out: pages flushed from the
+					LRU lists */
+	ulint*		n_flushed_list)	/*!< out: pages flushed from the
+					flush_lists */
+{
+	bool	success = true;
+	ulint	i;
+
+	if (n_to_flush != 0 && n_to_flush != ULINT_MAX) {
+		/* Ensure that flushing is spread evenly amongst the
+		buffer pool instances. */
+		n_to_flush = (n_to_flush + srv_buf_pool_instances - 1)
+			/ srv_buf_pool_instances;
+	}
+
+	for (i = 0; i < page_cleaner->n_slots; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		slot->flush_lru = flush_lru;
+		slot->n_pages_requested = n_to_flush;
+		slot->lsn_limit = lsn_limit;
+
+		if (i > 0) {
+			os_event_reset(slot->is_finished);
+			os_event_set(slot->is_requested);
+		}
+	}
+
+	/* The coordinator does the work of the first slot itself. */
+	page_cleaner_do_slot(0);
+
+	*n_flushed_lru = 0;
+	*n_flushed_list = 0;
+
+	for (i = 0; i < page_cleaner->n_slots; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+		ulint			slot_time;
+
+		if (i > 0) {
+			os_event_wait(slot->is_finished);
+		}
+
+		success = success && slot->success;
+
+		*n_flushed_lru += slot->n_flushed_lru;
+		*n_flushed_list += slot->n_flushed_list;
+
+		slot_time = slot->flush_lru_time + slot->flush_list_time;
+
+		page_cleaner->flush_lru_time += slot->flush_lru_time;
+		page_cleaner->flush_list_time += slot->flush_list_time;
+		page_cleaner->n_pages += slot->n_flushed_lru
+			+ slot->n_flushed_list;
+
+		/* The totals are only written here, by the coordinator,
+		and read without synchronization by
+		buf_flush_page_cleaner_print(). */
+		slot->total_passes++;
+		slot->total_lru += slot->n_flushed_lru;
+		slot->total_list += slot->n_flushed_list;
+		slot->total_lru_time += slot->flush_lru_time;
+		slot->total_list_time += slot->flush_list_time;
+
+		if (slot_time > page_cleaner->max_time) {
+			page_cleaner->max_time = slot_time;
+		}
+	}
+
+	if (*n_flushed_lru) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_LRU_BATCH_TOTAL_PAGE,
+			MONITOR_LRU_BATCH_COUNT,
+			MONITOR_LRU_BATCH_PAGES,
+			*n_flushed_lru);
+	}
+
+	page_cleaner_update_stats();
+
+	return(success);
+}
+
 /*********************************************************************//**
 Flush a batch of dirty pages from the flush list
 @return number of pages flushed, 0 if no page is flushed or if another
@@ -2161,9 +2601,11 @@ page_cleaner_do_flush_batch(
 	lsn_t		lsn_limit)	/*!< in: LSN up to which flushing
 					must happen */
 {
-	ulint n_flushed;
+	ulint	n_flushed_lru;
+	ulint	n_flushed;
 
-	buf_flush_list(n_to_flush, lsn_limit, &n_flushed);
+	page_cleaner_flush(false, n_to_flush, lsn_limit,
+			   &n_flushed_lru, &n_flushed);
 
 	return(n_flushed);
 }
@@ -2244,102 +2686,366 @@ af_get_pct_for_lsn(
 		/ 7.5));
 }
 
-/*********************************************************************//**
-This function is called approximately once every second by the
-page_cleaner thread. Based on various factors it decides if there is a
-need to do flushing. If flushing is needed it is performed and the
-number of pages flushed is returned.
-@return number of pages flushed */
-static
-ulint
-page_cleaner_flush_pages_if_needed(void)
-/*====================================*/
-{
-	static	lsn_t		lsn_avg_rate = 0;
-	static	lsn_t		prev_lsn = 0;
-	static	lsn_t		last_lsn = 0;
-	static	ulint		sum_pages = 0;
-	static	ulint		last_pages = 0;
-	static	ulint		prev_pages = 0;
-	static	ulint		avg_page_rate = 0;
-	static	ulint		n_iterations = 0;
-	lsn_t			oldest_lsn;
-	lsn_t			cur_lsn;
-	lsn_t			age;
-	lsn_t			lsn_rate;
-	ulint			n_pages = 0;
-	ulint			pct_for_dirty = 0;
-	ulint			pct_for_lsn = 0;
-	ulint			pct_total = 0;
-	int			age_factor = 0;
-
-	cur_lsn = log_get_lsn();
-
-	if (prev_lsn == 0) {
-		/* First time around. */
-		prev_lsn = cur_lsn;
-		return(0);
+/** Interface of the flush rate controllers. Once per iteration the
+page_cleaner coordinator asks the controller in use how many pages to
+flush from the flush_lists, flushes them and reports back how many
+pages were actually flushed. */
+class FlushController {
+public:
+	virtual ~FlushController() {}
+
+	/** Forget all state, called when the controller is (re)selected
+	through innodb_adaptive_flushing_method. */
+	virtual void reset() = 0;
+
+	/** Compute the number of pages to flush in this iteration.
+	@param lsn_limit	out: LSN up to which flushing must happen
+	@return number of pages to flush, 0 if none */
+	virtual ulint recommend(lsn_t* lsn_limit) = 0;
+
+	/** Feed back the outcome of the batch that was recommended by the
+	last call to recommend().
+	@param n_flushed	number of pages flushed */
+	virtual void flushed(ulint n_flushed) = 0;
+};
+
+/** The original adaptive flushing heuristic, blending af_get_pct_for_dirty()
+and af_get_pct_for_lsn() and averaging over innodb_flushing_avg_loops
+iterations. */
+class HeuristicFlushController : public FlushController {
+public:
+	HeuristicFlushController() { reset(); }
+
+	virtual void reset()
+	{
+		m_lsn_avg_rate = 0;
+		m_prev_lsn = 0;
+		m_last_lsn = 0;
+		m_cur_lsn = 0;
+		m_sum_pages = 0;
+		m_last_pages = 0;
+		m_prev_pages = 0;
+		m_avg_page_rate = 0;
+		m_n_iterations = 0;
+		m_recommended = false;
+	}
+
+	virtual ulint recommend(lsn_t* lsn_limit)
+	{
+		lsn_t	oldest_lsn;
+		lsn_t	age;
+		lsn_t	lsn_rate;
+		ulint	n_pages = 0;
+		ulint	pct_for_dirty = 0;
+		ulint	pct_for_lsn = 0;
+		ulint	pct_total = 0;
+		int	age_factor = 0;
+
+		m_cur_lsn = log_get_lsn();
+		m_recommended = false;
+		*lsn_limit = 0;
+
+		if (m_prev_lsn == 0) {
+			/* First time around. */
+			m_prev_lsn = m_cur_lsn;
+			return(0);
+		}
+
+		if (m_prev_lsn == m_cur_lsn) {
+			return(0);
+		}
+
+		/* We update our variables every srv_flushing_avg_loops
+		iterations to smooth out transition in workload. */
+		if (++m_n_iterations >= srv_flushing_avg_loops) {
+
+			m_avg_page_rate = ((m_sum_pages
+					    / srv_flushing_avg_loops)
+					   + m_avg_page_rate) / 2;
+
+			/* How much LSN we have generated since last call. */
+			lsn_rate = (m_cur_lsn - m_prev_lsn)
+				/ srv_flushing_avg_loops;
+
+			m_lsn_avg_rate = (m_lsn_avg_rate + lsn_rate) / 2;
+
+			m_prev_lsn = m_cur_lsn;
+
+			m_n_iterations = 0;
+
+			m_sum_pages = 0;
+		}
+
+		oldest_lsn = buf_pool_get_oldest_modification();
+
+		ut_ad(oldest_lsn <= log_get_lsn());
+
+		age = m_cur_lsn > oldest_lsn ? m_cur_lsn - oldest_lsn : 0;
+
+		pct_for_dirty = af_get_pct_for_dirty();
+		pct_for_lsn = af_get_pct_for_lsn(age);
+
+		pct_total = ut_max(pct_for_dirty, pct_for_lsn);
+
+		/* Cap the maximum IO capacity that we are going to use by
+		max_io_capacity. */
+		n_pages = (PCT_IO(pct_total) + m_avg_page_rate) / 2;
+
+		if (n_pages > srv_max_io_capacity) {
+			n_pages = srv_max_io_capacity;
+		}
+
+		if (m_last_pages
+		    && m_cur_lsn - m_last_lsn > m_lsn_avg_rate / 2) {
+			age_factor = static_cast<int>(
+				m_prev_pages / m_last_pages);
+		}
+
+		MONITOR_SET(MONITOR_FLUSH_AVG_PAGE_RATE, m_avg_page_rate);
+		MONITOR_SET(MONITOR_FLUSH_LSN_AVG_RATE, m_lsn_avg_rate);
+		MONITOR_SET(MONITOR_FLUSH_PCT_FOR_DIRTY, pct_for_dirty);
+		MONITOR_SET(MONITOR_FLUSH_PCT_FOR_LSN, pct_for_lsn);
+		MONITOR_SET(MONITOR_FLUSH_CHECKPOINT_AGE, age);
+
+		m_prev_pages = n_pages;
+		m_recommended = true;
+
+		*lsn_limit = oldest_lsn + m_lsn_avg_rate * (age_factor + 1);
+
+		return(n_pages);
 	}
 
-	if (prev_lsn == cur_lsn) {
-		return(0);
+	virtual void flushed(ulint n_flushed)
+	{
+		if (!m_recommended) {
+			return;
+		}
+
+		m_last_lsn = m_cur_lsn;
+		m_last_pages = n_flushed + 1;
+		m_sum_pages += n_flushed;
+	}
+
+private:
+	lsn_t	m_lsn_avg_rate;		/*!< average redo generation rate */
+	lsn_t	m_prev_lsn;		/*!< lsn at the start of the current
+					averaging period */
+	lsn_t	m_last_lsn;		/*!< lsn at the last batch */
+	lsn_t	m_cur_lsn;		/*!< lsn at the last recommend() */
+	ulint	m_sum_pages;		/*!< pages flushed in the current
+					averaging period */
+	ulint	m_last_pages;		/*!< pages flushed by the last
+					batch, plus one */
+	ulint	m_prev_pages;		/*!< pages requested for the last
+					batch */
+	ulint	m_avg_page_rate;	/*!< average flushing rate */
+	ulint	m_n_iterations;		/*!< iterations in the current
+					averaging period */
+	bool	m_recommended;		/*!< whether the last call to
+					recommend() computed a batch */
+};
+
+/** Gains of the PID flush rate controller. The error term is the checkpoint
+age relative to the target age, normalized by the target age, and the
+controller output is expressed in units of innodb_io_capacity. */
+/* @{ */
+#define PID_FLUSH_KP		1.0	/*!< proportional gain */
+#define PID_FLUSH_KI		0.1	/*!< integral gain, per iteration */
+#define PID_FLUSH_KD		0.5	/*!< derivative gain */
+#define PID_FLUSH_I_MAX		10.0	/*!< bound of the integral term */
+#define PID_FLUSH_RATE_WEIGHT	0.3	/*!< weight of the latest redo rate
+					sample in its moving average */
+/* @} */
+
+/** A PID controller driving the checkpoint age towards a set point of
+innodb_adaptive_flushing_target_pct percent of the log capacity. The
+feed-forward term flushes pages at the rate they are being dirtied,
+estimated from the redo generation rate and the average amount of redo
+per dirty page, so that the PID terms only have to correct the error. */
+class PidFlushController : public FlushController {
+public:
+	PidFlushController() { reset(); }
+
+	virtual void reset()
+	{
+		m_prev_lsn = 0;
+		m_lsn_rate = 0.0;
+		m_integral = 0.0;
+		m_prev_error = 0.0;
 	}
 
-	/* We update our variables every srv_flushing_avg_loops
-	iterations to smooth out transition in workload. */
-	if (++n_iterations >= srv_flushing_avg_loops) {
+	virtual ulint recommend(lsn_t* lsn_limit)
+	{
+		lsn_t	cur_lsn = log_get_lsn();
+		lsn_t	oldest_lsn;
+		lsn_t	age;
+		lsn_t	target_age;
+		ulint	LRU_len;
+		ulint	free_len;
+		ulint	flush_list_len;
+		double	feed_forward = 0.0;
+		double	error;
+		double	output;
+		double	n_pages;
+		ulint	pct_for_dirty;
+
+		/* The controller flushes in flush_list order, which is
+		what advances the checkpoint; there is no point in holding
+		back on the LSN. */
+		*lsn_limit = LSN_MAX;
+
+		if (m_prev_lsn == 0) {
+			/* First time around. */
+			m_prev_lsn = cur_lsn;
+			return(0);
+		}
+
+		m_lsn_rate = PID_FLUSH_RATE_WEIGHT
+			* static_cast<double>(cur_lsn - m_prev_lsn)
+			+ (1.0 - PID_FLUSH_RATE_WEIGHT) * m_lsn_rate;
+		m_prev_lsn = cur_lsn;
 
-		avg_page_rate = ((sum_pages / srv_flushing_avg_loops)
-				 + avg_page_rate) / 2;
+		oldest_lsn = buf_pool_get_oldest_modification();
 
-		/* How much LSN we have generated since last call. */
-		lsn_rate = (cur_lsn - prev_lsn) / srv_flushing_avg_loops;
+		age = cur_lsn > oldest_lsn ? cur_lsn - oldest_lsn : 0;
 
-		lsn_avg_rate = (lsn_avg_rate + lsn_rate) / 2;
+		target_age = (srv_adaptive_flushing_target_pct
+			      * log_get_capacity()) / 100;
 
-		prev_lsn = cur_lsn;
+		if (target_age == 0) {
+			target_age = 1;
+		}
 
-		n_iterations = 0;
+		buf_get_total_list_len(&LRU_len, &free_len, &flush_list_len);
 
-		sum_pages = 0;
-	}
+		if (age > 0 && flush_list_len > 0) {
+			/* Pages dirtied per second = redo per second
+			divided by the redo generated per dirty page. */
+			feed_forward = m_lsn_rate
+				* static_cast<double>(flush_list_len)
+				/ static_cast<double>(age);
+		}
+
+		error = (static_cast<double>(age)
+			 - static_cast<double>(target_age))
+			/ static_cast<double>(target_age);
+
+		output = PID_FLUSH_KP * error
+			+ PID_FLUSH_KI * m_integral
+			+ PID_FLUSH_KD * (error - m_prev_error);
 
-	oldest_lsn = buf_pool_get_oldest_modification();
+		n_pages = feed_forward + output * srv_io_capacity;
 
-	ut_ad(oldest_lsn <= log_get_lsn());
+		/* Conditional integration: do not wind up the integral
+		term while the output is saturated in the direction of
+		the error. */
+		if (!(n_pages >= srv_max_io_capacity && error > 0)
+		    && !(n_pages <= 0 && error < 0)) {
 
-	age = cur_lsn > oldest_lsn ? cur_lsn - oldest_lsn : 0;
+			m_integral += error;
+			m_integral = ut_min(m_integral, PID_FLUSH_I_MAX);
+			m_integral = ut_max(m_integral, -PID_FLUSH_I_MAX);
+		}
 
-	pct_for_dirty = af_get_pct_for_dirty();
-	pct_for_lsn = af_get_pct_for_lsn(age);
+		m_prev_error = error;
+
+		/* Never flush less than what is needed to stay below the
+		dirty page limits. */
+		pct_for_dirty = af_get_pct_for_dirty();
+
+		n_pages = ut_max(n_pages,
+				 static_cast<double>(PCT_IO(pct_for_dirty)));
+		n_pages = ut_min(n_pages,
+				 static_cast<double>(srv_max_io_capacity));
+		n_pages = ut_max(n_pages, 0.0);
+
+		MONITOR_SET(MONITOR_FLUSH_LSN_AVG_RATE,
+			    static_cast<lsn_t>(m_lsn_rate));
+		MONITOR_SET(MONITOR_FLUSH_PCT_FOR_DIRTY, pct_for_dirty);
+		MONITOR_SET(MONITOR_FLUSH_CHECKPOINT_AGE, age);
+		MONITOR_SET(MONITOR_FLUSH_TARGET_CHECKPOINT_AGE, target_age);
+		MONITOR_SET(MONITOR_FLUSH_PID_FEED_FORWARD,
+			    static_cast<ib_int64_t>(feed_forward));
+		MONITOR_SET(MONITOR_FLUSH_PID_ERROR,
+			    static_cast<ib_int64_t>(error * 1000));
+		MONITOR_SET(MONITOR_FLUSH_PID_INTEGRAL,
+			    static_cast<ib_int64_t>(m_integral * 1000));
+
+		return(static_cast<ulint>(n_pages));
+	}
+
+	virtual void flushed(ulint) {}
+
+private:
+	lsn_t	m_prev_lsn;	/*!< lsn at the last recommend() */
+	double	m_lsn_rate;	/*!< moving average of the redo
+				generation rate, per iteration */
+	double	m_integral;	/*!< integral of the normalized error */
+	double	m_prev_error;	/*!< normalized error at the last
+				recommend() */
+};
 
-	pct_total = ut_max(pct_for_dirty, pct_for_lsn);
+/** The flush rate controllers, one per srv_flush_controller_t */
+static HeuristicFlushController	heuristic_flush_controller;
+static PidFlushController	pid_flush_controller;
 
-	/* Cap the maximum IO capacity that we are going to use by
-	max_io_capacity. */
-	n_pages = (PCT_IO(pct_total) + avg_page_rate) / 2;
+/*********************************************************************//**
+Get the flush rate controller selected by innodb_adaptive_flushing_method,
+resetting it if the selection changed since the last call.
+@return flush rate controller */
+static
+FlushController*
+page_cleaner_get_controller(void)
+/*=============================*/
+{
+	static ulong		method = ULONG_UNDEFINED;
+	FlushController*	controller;
 
-	if (n_pages > srv_max_io_capacity) {
-		n_pages = srv_max_io_capacity;
+	switch (srv_adaptive_flushing_method) {
+	case SRV_FLUSH_CONTROLLER_PID:
+		controller = &pid_flush_controller;
+		break;
+	case SRV_FLUSH_CONTROLLER_HEURISTIC:
+	default:
+		controller = &heuristic_flush_controller;
+		break;
 	}
 
-	if (last_pages && cur_lsn - last_lsn > lsn_avg_rate / 2) {
-		age_factor = static_cast<int>(prev_pages / last_pages);
+	if (method != srv_adaptive_flushing_method) {
+		method = srv_adaptive_flushing_method;
+		controller->reset();
 	}
 
-	MONITOR_SET(MONITOR_FLUSH_N_TO_FLUSH_REQUESTED, n_pages);
+	return(controller);
+}
 
-	prev_pages = n_pages;
-	n_pages = page_cleaner_do_flush_batch(
-		n_pages, oldest_lsn + lsn_avg_rate * (age_factor + 1));
+/*********************************************************************//**
+This function is called approximately once every second by the
+page_cleaner thread. The flush rate controller selected by
+innodb_adaptive_flushing_method decides if there is a need to do
+flushing. If flushing is needed it is performed, together with the
+cleaning of the LRU tails, and the number of pages flushed is returned.
+@return number of pages flushed */
+static
+ulint
+page_cleaner_flush_pages_if_needed(void)
+/*====================================*/
+{
+	FlushController*	controller = page_cleaner_get_controller();
+	lsn_t			lsn_limit;
+	ulint			n_pages;
+	ulint			n_flushed_lru = 0;
 
-	last_lsn= cur_lsn;
-	last_pages= n_pages + 1;
+	n_pages = controller->recommend(&lsn_limit);
 
-	MONITOR_SET(MONITOR_FLUSH_AVG_PAGE_RATE, avg_page_rate);
-	MONITOR_SET(MONITOR_FLUSH_LSN_AVG_RATE, lsn_avg_rate);
-	MONITOR_SET(MONITOR_FLUSH_PCT_FOR_DIRTY, pct_for_dirty);
-	MONITOR_SET(MONITOR_FLUSH_PCT_FOR_LSN, pct_for_lsn);
+	if (lsn_limit != 0) {
+		MONITOR_SET(MONITOR_FLUSH_N_TO_FLUSH_REQUESTED, n_pages);
+	}
+
+	page_cleaner_flush(true, n_pages, lsn_limit,
+			   &n_flushed_lru, &n_pages);
+
+	controller->flushed(n_pages);
 
 	if (n_pages) {
 		MONITOR_INC_VALUE_CUMULATIVE(
@@ -2347,11 +3053,9 @@ page_cleaner_flush_pages_if_needed(void)
 			MONITOR_FLUSH_ADAPTIVE_COUNT,
 			MONITOR_FLUSH_ADAPTIVE_PAGES,
 			n_pages);
-
-		sum_pages += n_pages;
 	}
 
-	return(n_pages);
+	return(n_flushed_lru + n_pages);
 }
 
 /*********************************************************************//**
@@ -2377,8 +3081,126 @@ page_cleaner_sleep_if_needed(
 }
 
 /******************************************************************//**
-page_cleaner thread tasked with flushing dirty pages from the buffer
-pools. As of now we'll have only one instance of this thread.
+Initialize the page_cleaner and start its worker threads. There is one
+page cleaner slot per page cleaner thread; the page_cleaner coordinator
+thread serves the first slot itself. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void)
+/*=============================*/
+{
+	ut_ad(page_cleaner == NULL);
+	ut_ad(srv_n_page_cleaners >= 1);
+	ut_ad(srv_n_page_cleaners <= srv_buf_pool_instances);
+
+	page_cleaner = static_cast<page_cleaner_t*>(
+		mem_zalloc(sizeof(*page_cleaner)));
+
+	page_cleaner->n_slots = srv_n_page_cleaners;
+
+	page_cleaner->slots = static_cast<page_cleaner_slot_t*>(
+		mem_zalloc(page_cleaner->n_slots
+			   * sizeof(*page_cleaner->slots)));
+
+	page_cleaner->n_workers = page_cleaner->n_slots - 1;
+
+	for (ulint i = 1; i < page_cleaner->n_slots; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		slot->is_requested = os_event_create();
+		slot->is_finished = os_event_create();
+
+		os_thread_create(buf_flush_page_cleaner_worker, slot, NULL);
+	}
+}
+
+/******************************************************************//**
+Tell the page_cleaner worker threads to exit, wait for them to do so
+and free the page_cleaner. */
+static
+void
+buf_flush_page_cleaner_close(void)
+/*==============================*/
+{
+	for (ulint i = 1; i < page_cleaner->n_slots; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		slot->exit = true;
+		os_wmb;
+		os_event_set(slot->is_requested);
+	}
+
+	while (page_cleaner->n_workers > 0) {
+		os_thread_sleep(10000);
+	}
+
+	for (ulint i = 1; i < page_cleaner->n_slots; i++) {
+		os_event_free(page_cleaner->slots[i].is_requested);
+		os_event_free(page_cleaner->slots[i].is_finished);
+	}
+
+	mem_free(page_cleaner->slots);
+	mem_free(page_cleaner);
+
+	page_cleaner = NULL;
+}
+
+/******************************************************************//**
+page_cleaner worker thread. It flushes the buffer pool instances owned
+by its page cleaner slot whenever asked to by the page_cleaner
+coordinator.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
+/*==========================================*/
+	void*	arg)	/*!< in: the page cleaner slot of the thread */
+{
+	page_cleaner_slot_t*	slot = static_cast<page_cleaner_slot_t*>(arg);
+	ulint			slot_no = slot - page_cleaner->slots;
+
+	ut_ad(!srv_read_only_mode);
+	ut_ad(slot_no > 0);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(buf_page_cleaner_worker_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+#ifdef UNIV_DEBUG_THREAD_CREATION
+	fprintf(stderr, "InnoDB: page_cleaner worker %lu running, id %lu\n",
+		slot_no, os_thread_pf(os_thread_get_curr_id()));
+#endif /* UNIV_DEBUG_THREAD_CREATION */
+
+	for (;;) {
+		os_event_wait(slot->is_requested);
+		os_event_reset(slot->is_requested);
+
+		/* Pairs with the barrier in buf_flush_page_cleaner_close() */
+		os_rmb;
+
+		if (slot->exit) {
+			break;
+		}
+
+		page_cleaner_do_slot(slot_no);
+
+		os_event_set(slot->is_finished);
+	}
+
+	os_atomic_decrement_ulint(&page_cleaner->n_workers, 1);
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************************//**
+page_cleaner coordinator thread tasked with flushing dirty pages from the
+buffer pools. It decides how much to flush and hands the work out to the
+page_cleaner worker threads, doing the share of the first page cleaner
+slot itself.
 @return a dummy parameter */
 extern "C" UNIV_INTERN
 os_thread_ret_t
@@ -2418,14 +3240,18 @@ DECLARE_THREAD(buf_flush_page_cleaner_thread)(
 
 		next_loop_time = ut_time_ms() + 1000;
 
+		/* Do not let "make young" requests wait for their
+		batch to fill up. */
+		for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+			buf_LRU_flush_young_batches(buf_pool_from_array(i));
+		}
+
 		if (srv_check_activity(last_activity)) {
 			last_activity = srv_get_activity_count();
 
-			/* Flush pages from end of LRU if required */
-			n_flushed = buf_flush_LRU_tail();
-
-			/* Flush pages from flush_list if required */
-			n_flushed += page_cleaner_flush_pages_if_needed();
+			/* Flush pages from end of LRU and from flush_list
+			if required */
+			n_flushed = page_cleaner_flush_pages_if_needed();
 		} else {
 			n_flushed = page_cleaner_do_flush_batch(
 							PCT_IO(100),
@@ -2504,6 +3330,8 @@ DECLARE_THREAD(buf_flush_page_cleaner_thread)(
 	/* We have lived our life. Time to die. */
 
 thread_exit:
+	buf_flush_page_cleaner_close();
+
 	buf_page_cleaner_is_active = FALSE;
 
 	/* We count the number of threads in os_thread_exit(). A created
@@ -126,6 +126,41 @@ UNIV_INTERN buf_LRU_stat_t	buf_LRU_stat_sum;
 /** Move blocks to "new" LRU list only if the first access was at
 least this many milliseconds ago.  Not protected by any mutex or latch. */
 UNIV_INTERN uint	buf_LRU_old_threshold_ms;
+
+/** The LRU replacement policy, a buf_LRU_policy_t.
+Not protected by any mutex or latch. */
+UNIV_INTERN ulong	buf_LRU_policy = BUF_LRU_POLICY_MIDPOINT;
+/* @} */
+
+/** @name Ghost directory of recently evicted pages
+
+In the BUF_LRU_POLICY_ADAPTIVE policy, the id of each page evicted from
+the LRU list is remembered in buf_pool->LRU_ghost, a direct-mapped table
+of 32-bit signatures with one slot per buffer pool block. The table is
+lossy: a newer entry overwrites an older one that maps to the same slot,
+and signatures may collide. Both are harmless, as the directory is only
+a heuristic.
+
+Each entry records whether the page had been made young before it was
+evicted. When a page that has an entry is read in again, it is put to
+the start of the LRU list instead of the old sublist. Following ARC, the
+target length of the old sublist is increased when the page had been
+evicted from the old sublist only, and decreased when it had been made
+young, that is, when the evicted page belonged to the working set. A
+scan of pages that are never read again does not cause any ghost hits,
+and therefore cannot grow the old sublist at the expense of the working
+set.
+
+The directory and the target are protected by buf_pool->mutex. */
+/* @{ */
+
+/** Flag of a ghost directory entry of a page that had been made young
+before it was evicted */
+#define BUF_LRU_GHOST_YOUNG		0x80000000UL
+
+/** Upper limit of buf_pool->LRU_old_ratio in the adaptive policy;
+the same as the upper limit of innodb_old_blocks_pct */
+#define BUF_LRU_ADAPTIVE_RATIO_MAX	(95 * BUF_LRU_OLD_RATIO_DIV / 100)
 /* @} */
 
 /******************************************************************//**
@@ -1093,7 +1128,9 @@ buf_LRU_buf_pool_running_out(void)
 
 /******************************************************************//**
 Returns a free block from the buf_pool.  The block is taken off the
-free list.  If it is empty, returns NULL.
+free list.  If it is empty, returns NULL.  The caller does not need to
+hold buf_pool->mutex: the free list is protected by
+buf_pool->free_list_mutex.
 @return	a free control block, or NULL if the buf_block->free list is empty */
 UNIV_INTERN
 buf_block_t*
@@ -1103,7 +1140,7 @@ buf_LRU_get_free_only(
 {
 	buf_block_t*	block;
 
-	ut_ad(buf_pool_mutex_own(buf_pool));
+	buf_free_list_mutex_enter(buf_pool);
 
 	block = (buf_block_t*) UT_LIST_GET_FIRST(buf_pool->free);
 
@@ -1115,6 +1152,11 @@ buf_LRU_get_free_only(
 		ut_ad(!block->page.in_LRU_list);
 		ut_a(!buf_page_in_file(&block->page));
 		UT_LIST_REMOVE(list, buf_pool->free, (&block->page));
+	}
+
+	buf_free_list_mutex_exit(buf_pool);
+
+	if (block) {
 
 		mutex_enter(&block->mutex);
 
@@ -1133,15 +1175,14 @@ buf_LRU_get_free_only(
 Checks how much of buf_pool is occupied by non-data objects like
 AHI, lock heaps etc. Depending on the size of non-data objects this
 function will either assert or issue a warning and switch on the
-status monitor. */
+status monitor. The list lengths may be read without buf_pool->mutex,
+because the thresholds are far apart from the normal state. */
 static
 void
 buf_LRU_check_size_of_non_data_objects(
 /*===================================*/
 	const buf_pool_t*	buf_pool)	/*!< in: buffer pool instance */
 {
-	ut_ad(buf_pool_mutex_own(buf_pool));
-
 	if (!recv_recovery_on && UT_LIST_GET_LEN(buf_pool->free)
 	    + UT_LIST_GET_LEN(buf_pool->LRU) < buf_pool->curr_size / 20) {
 		ut_print_timestamp(stderr);
@@ -1247,6 +1288,21 @@ buf_LRU_get_free_block(
 	ibool		started_monitor	= FALSE;
 
 	MONITOR_INC(MONITOR_LRU_GET_FREE_SEARCH);
+
+	buf_LRU_check_size_of_non_data_objects(buf_pool);
+
+	/* Fast path: take a block off the free list without acquiring
+	buf_pool->mutex. */
+	block = buf_LRU_get_free_only(buf_pool);
+
+	if (block) {
+
+		MONITOR_INC(MONITOR_LRU_GET_FREE_FAST);
+		ut_ad(buf_pool_from_block(block) == buf_pool);
+		memset(&block->page.zip, 0, sizeof block->page.zip);
+
+		return(block);
+	}
 loop:
 	buf_pool_mutex_enter(buf_pool);
 
@@ -1661,6 +1717,170 @@ buf_LRU_add_block_to_end_low(
 	}
 }
 
+/******************************************************************//**
+Creates the ghost directory of a buffer pool instance. */
+UNIV_INTERN
+void
+buf_LRU_ghost_create(
+/*=================*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
+{
+	ut_ad(buf_pool->curr_size > 0);
+
+	buf_pool->LRU_ghost_size = buf_pool->curr_size;
+	buf_pool->LRU_ghost = static_cast<ib_uint32_t*>(
+		mem_zalloc(buf_pool->LRU_ghost_size
+			   * sizeof *buf_pool->LRU_ghost));
+	buf_pool->LRU_ghost_n_old = 0;
+	buf_pool->LRU_ghost_n_young = 0;
+}
+
+/******************************************************************//**
+Frees the ghost directory of a buffer pool instance. */
+UNIV_INTERN
+void
+buf_LRU_ghost_free(
+/*===============*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
+{
+	if (buf_pool->LRU_ghost != NULL) {
+		mem_free(buf_pool->LRU_ghost);
+		buf_pool->LRU_ghost = NULL;
+	}
+}
+
+/******************************************************************//**
+Computes the ghost directory slot and signature of a page.
+@return	slot number */
+UNIV_INLINE
+ulint
+buf_LRU_ghost_slot(
+/*===============*/
+	const buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	ulint			space,		/*!< in: space id */
+	ulint			offset,		/*!< in: page number */
+	ib_uint32_t*		sig)		/*!< out: nonzero signature
+						without BUF_LRU_GHOST_YOUNG */
+{
+	*sig = static_cast<ib_uint32_t>(
+		ut_fold_ulint_pair(space, offset)
+		% (BUF_LRU_GHOST_YOUNG - 1)) + 1;
+
+	return(ut_hash_ulint(buf_page_address_fold(space, offset),
+			     buf_pool->LRU_ghost_size));
+}
+
+/******************************************************************//**
+Remembers a page that is being evicted from the LRU list. */
+static
+void
+buf_LRU_ghost_insert(
+/*=================*/
+	const buf_page_t*	bpage)	/*!< in: page being evicted */
+{
+	buf_pool_t*	buf_pool = buf_pool_from_bpage(bpage);
+	ib_uint32_t	sig;
+	ib_uint32_t	old_sig;
+	ulint		slot;
+
+	ut_ad(buf_pool_mutex_own(buf_pool));
+
+	slot = buf_LRU_ghost_slot(buf_pool, bpage->space, bpage->offset,
+				  &sig);
+	old_sig = buf_pool->LRU_ghost[slot];
+
+	if (old_sig & BUF_LRU_GHOST_YOUNG) {
+		buf_pool->LRU_ghost_n_young--;
+	} else if (old_sig != 0) {
+		buf_pool->LRU_ghost_n_old--;
+	}
+
+	if (bpage->made_young) {
+		sig |= BUF_LRU_GHOST_YOUNG;
+		buf_pool->LRU_ghost_n_young++;
+	} else {
+		buf_pool->LRU_ghost_n_old++;
+	}
+
+	buf_pool->LRU_ghost[slot] = sig;
+}
+
+/******************************************************************//**
+Looks up a page that is being read in from the ghost directory. If the
+page was recently evicted, removes it from the directory and adjusts
+the target length of the old sublist.
+@return	TRUE if the page was recently evicted */
+static
+ibool
+buf_LRU_ghost_hit(
+/*==============*/
+	const buf_page_t*	bpage)	/*!< in: page being read in */
+{
+	buf_pool_t*	buf_pool = buf_pool_from_bpage(bpage);
+	ib_uint32_t	sig;
+	ib_uint32_t	entry;
+	ulint		slot;
+	ulint		target;
+	ulint		ratio;
+
+	ut_ad(buf_pool_mutex_own(buf_pool));
+
+	slot = buf_LRU_ghost_slot(buf_pool, bpage->space, bpage->offset,
+				  &sig);
+	entry = buf_pool->LRU_ghost[slot];
+
+	if ((entry & ~BUF_LRU_GHOST_YOUNG) != sig) {
+		return(FALSE);
+	}
+
+	buf_pool->LRU_ghost[slot] = 0;
+	target = buf_pool->LRU_old_target;
+
+	if (entry & BUF_LRU_GHOST_YOUNG) {
+		/* A page of the working set was evicted: the old
+		sublist is too long. */
+		buf_pool->LRU_ghost_n_young--;
+		MONITOR_INC(MONITOR_LRU_GHOST_HIT_YOUNG);
+
+		target -= ut_min(target,
+				 ut_max(buf_pool->LRU_ghost_n_old
+					/ ut_max(buf_pool->LRU_ghost_n_young,
+						 1UL),
+					1UL));
+	} else {
+		/* A page was evicted from the old sublist before it
+		was accessed again: the old sublist is too short. */
+		buf_pool->LRU_ghost_n_old--;
+		MONITOR_INC(MONITOR_LRU_GHOST_HIT_OLD);
+
+		target += ut_max(buf_pool->LRU_ghost_n_young
+				 / ut_max(buf_pool->LRU_ghost_n_old, 1UL),
+				 1UL);
+	}
+
+	ratio = target * BUF_LRU_OLD_RATIO_DIV / buf_pool->curr_size;
+
+	if (ratio < BUF_LRU_OLD_RATIO_MIN) {
+		ratio = BUF_LRU_OLD_RATIO_MIN;
+		target = buf_pool->curr_size * ratio / BUF_LRU_OLD_RATIO_DIV;
+	} else if (ratio > BUF_LRU_ADAPTIVE_RATIO_MAX) {
+		ratio = BUF_LRU_ADAPTIVE_RATIO_MAX;
+		target = buf_pool->curr_size * ratio / BUF_LRU_OLD_RATIO_DIV;
+	}
+
+	buf_pool->LRU_old_target = target;
+
+	if (ratio != buf_pool->LRU_old_ratio) {
+		buf_pool->LRU_old_ratio = ratio;
+
+		if (UT_LIST_GET_LEN(buf_pool->LRU) >= BUF_LRU_OLD_MIN_LEN) {
+			buf_LRU_old_adjust_len(buf_pool);
+		}
+	}
+
+	return(TRUE);
+}
+
 /******************************************************************//**
 Adds a block to the LRU list. Please make sure that the zip_size is
 already set into the page zip when invoking the function, so that we
@@ -1688,6 +1908,10 @@ buf_LRU_add_block_low(
 		UT_LIST_ADD_FIRST(LRU, buf_pool->LRU, bpage);
 
 		bpage->freed_page_clock = buf_pool->freed_page_clock;
+
+		if (!old) {
+			bpage->made_young = TRUE;
+		}
 	} else {
 #ifdef UNIV_LRU_DEBUG
 		/* buf_pool->LRU_old must be the first item in the LRU list
@@ -1749,6 +1973,15 @@ buf_LRU_add_block(
 				added to the start, regardless of this
 				parameter */
 {
+	if (old
+	    && buf_LRU_policy == BUF_LRU_POLICY_ADAPTIVE
+	    && buf_LRU_ghost_hit(bpage)) {
+
+		/* The page was evicted recently: do not let it
+		compete with pages that were read only once. */
+		old = FALSE;
+	}
+
 	buf_LRU_add_block_low(bpage, old);
 }
 
@@ -1772,6 +2005,135 @@ buf_LRU_make_block_young(
 	buf_LRU_add_block_low(bpage, FALSE);
 }
 
+/******************************************************************//**
+Applies a batch of deferred "make young" requests to the LRU list under a
+single acquisition of buf_pool->mutex. Pages that have been evicted or
+made young since the request was queued are skipped. */
+static
+void
+buf_LRU_make_young_batch(
+/*=====================*/
+	buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	ulint		n_pages,	/*!< in: number of requests */
+	const ulint*	space,		/*!< in: tablespace ids */
+	const ulint*	offset)		/*!< in: page numbers */
+{
+	buf_pool_mutex_enter(buf_pool);
+
+	for (ulint i = 0; i < n_pages; i++) {
+		ulint		fold;
+		rw_lock_t*	hash_lock;
+		buf_page_t*	bpage;
+
+		fold = buf_page_address_fold(space[i], offset[i]);
+		hash_lock = buf_page_hash_lock_get(buf_pool, fold);
+
+		rw_lock_s_lock(hash_lock);
+
+		bpage = buf_page_hash_get_low(
+			buf_pool, space[i], offset[i], fold);
+
+		if (bpage != NULL
+		    && !buf_pool_watch_is_sentinel(buf_pool, bpage)
+		    && !buf_page_peek_if_young(bpage)) {
+
+			ut_ad(bpage->in_LRU_list);
+			buf_LRU_make_block_young(bpage);
+		}
+
+		rw_lock_s_unlock(hash_lock);
+	}
+
+	buf_pool_mutex_exit(buf_pool);
+
+	MONITOR_INC(MONITOR_LRU_YOUNG_BATCHES);
+}
+
+/******************************************************************//**
+Requests a block to be moved to the start of the LRU list. The request is
+queued in a batch selected by the id of the calling thread, and the batch
+is applied by buf_LRU_make_block_young() once it is full, or by
+buf_LRU_flush_young_batches(). This avoids acquiring buf_pool->mutex on
+every access to an old page. */
+UNIV_INTERN
+void
+buf_LRU_make_block_young_lazy(
+/*==========================*/
+	buf_page_t*	bpage)	/*!< in: control block, buffer-fixed
+				by the caller */
+{
+	buf_pool_t*		buf_pool = buf_pool_from_bpage(bpage);
+	buf_LRU_young_batch_t*	batch;
+	os_thread_id_t		thread_id = os_thread_get_curr_id();
+	ulint			space[BUF_LRU_YOUNG_BATCH_SIZE];
+	ulint			offset[BUF_LRU_YOUNG_BATCH_SIZE];
+	ulint			n_pages = 0;
+
+	ut_ad(!buf_pool_mutex_own(buf_pool));
+	ut_ad(buf_page_in_file(bpage));
+
+	batch = &buf_pool->young_batch[
+		ut_fold_binary(reinterpret_cast<const byte*>(&thread_id),
+			       sizeof thread_id)
+		% BUF_LRU_YOUNG_BATCHES];
+
+	os_fast_mutex_lock(&batch->mutex);
+
+	ut_ad(batch->n_pages < BUF_LRU_YOUNG_BATCH_SIZE);
+
+	batch->space[batch->n_pages] = bpage->space;
+	batch->offset[batch->n_pages] = bpage->offset;
+
+	if (++batch->n_pages == BUF_LRU_YOUNG_BATCH_SIZE) {
+
+		n_pages = batch->n_pages;
+		memcpy(space, batch->space, sizeof space);
+		memcpy(offset, batch->offset, sizeof offset);
+		batch->n_pages = 0;
+	}
+
+	os_fast_mutex_unlock(&batch->mutex);
+
+	if (n_pages > 0) {
+		buf_LRU_make_young_batch(buf_pool, n_pages, space, offset);
+	}
+}
+
+/******************************************************************//**
+Applies the deferred "make young" requests of all batches of a buffer
+pool instance, full or not. Called periodically by the page cleaner so
+that requests do not stay queued in a quiet buffer pool. */
+UNIV_INTERN
+void
+buf_LRU_flush_young_batches(
+/*========================*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
+{
+	ulint	space[BUF_LRU_YOUNG_BATCH_SIZE];
+	ulint	offset[BUF_LRU_YOUNG_BATCH_SIZE];
+
+	ut_ad(!buf_pool_mutex_own(buf_pool));
+
+	for (ulint i = 0; i < BUF_LRU_YOUNG_BATCHES; i++) {
+		buf_LRU_young_batch_t*	batch = &buf_pool->young_batch[i];
+		ulint			n_pages;
+
+		os_fast_mutex_lock(&batch->mutex);
+
+		n_pages = batch->n_pages;
+		memcpy(space, batch->space, n_pages * sizeof *space);
+		memcpy(offset, batch->offset, n_pages * sizeof *offset);
+		batch->n_pages = 0;
+
+		os_fast_mutex_unlock(&batch->mutex);
+
+		if (n_pages > 0) {
+			buf_LRU_make_young_batch(
+				buf_pool, n_pages, space, offset);
+		}
+	}
+}
+
 /******************************************************************//**
 Moves a block to the end of the LRU list. */
 UNIV_INTERN
@@ -1869,6 +2231,11 @@ func_exit:
 #endif /* UNIV_SYNC_DEBUG */
 	ut_ad(buf_page_can_relocate(bpage));
 
+	if (b == NULL && buf_LRU_policy == BUF_LRU_POLICY_ADAPTIVE) {
+		/* The page is being evicted completely. */
+		buf_LRU_ghost_insert(bpage);
+	}
+
 	if (!buf_LRU_block_remove_hashed(bpage, zip)) {
 		return(true);
 	}
@@ -2104,9 +2471,13 @@ buf_LRU_block_free_non_file_page(
 		page_zip_set_size(&block->page.zip, 0);
 	}
 
+	buf_free_list_mutex_enter(buf_pool);
+
 	UT_LIST_ADD_FIRST(list, buf_pool->free, (&block->page));
 	ut_d(block->page.in_free_list = TRUE);
 
+	buf_free_list_mutex_exit(buf_pool);
+
 	UNIV_MEM_ASSERT_AND_FREE(block->frame, UNIV_PAGE_SIZE);
 }
 
@@ -2435,6 +2806,9 @@ buf_LRU_old_ratio_update_instance(
 	if (adjust) {
 		buf_pool_mutex_enter(buf_pool);
 
+		buf_pool->LRU_old_target = buf_pool->curr_size * ratio
+			/ BUF_LRU_OLD_RATIO_DIV;
+
 		if (ratio != buf_pool->LRU_old_ratio) {
 			buf_pool->LRU_old_ratio = ratio;
 
@@ -2448,6 +2822,8 @@ buf_LRU_old_ratio_update_instance(
 		buf_pool_mutex_exit(buf_pool);
 	} else {
 		buf_pool->LRU_old_ratio = ratio;
+		buf_pool->LRU_old_target = buf_pool->curr_size * ratio
+			/ BUF_LRU_OLD_RATIO_DIV;
 	}
 	/* the reverse of
 	ratio = old_pct * BUF_LRU_OLD_RATIO_DIV / 100 */
@@ -2608,6 +2984,8 @@ buf_LRU_validate_instance(
 
 	ut_a(buf_pool->LRU_old_len == old_len);
 
+	buf_free_list_mutex_enter(buf_pool);
+
 	UT_LIST_VALIDATE(list, buf_page_t, buf_pool->free, CheckInFreeList());
 
 	for (bpage = UT_LIST_GET_FIRST(buf_pool->free);
@@ -2617,6 +2995,8 @@ buf_LRU_validate_instance(
 		ut_a(buf_page_get_state(bpage) == BUF_BLOCK_NOT_USED);
 	}
 
+	buf_free_list_mutex_exit(buf_pool);
+
 	UT_LIST_VALIDATE(
                 unzip_LRU, buf_block_t, buf_pool->unzip_LRU,
                 CheckUnzipLRUAndLRUList());
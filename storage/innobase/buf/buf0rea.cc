@@ -562,7 +562,7 @@ buf_read_page_async(
 
 	tablespace_version = fil_space_get_version(space);
 
-	count = buf_read_page_low(&err, true, BUF_READ_ANY_PAGE
+	count = buf_read_page_low(&err, false, BUF_READ_ANY_PAGE
 				  | OS_AIO_SIMULATED_WAKE_LATER
 				  | BUF_READ_IGNORE_NONEXISTENT_PAGES,
 				  space, zip_size, FALSE,
@@ -864,7 +864,8 @@ buf_read_ahead_linear(
 /********************************************************************//**
 Issues read requests for pages which the ibuf module wants to read in, in
 order to contract the insert buffer tree. Technically, this function is like
-a read-ahead function. */
+a read-ahead function. The asynchronous reads are submitted together at the
+end, so that the reads of adjacent pages can be merged. */
 UNIV_INTERN
 void
 buf_read_ibuf_merge_pages(
@@ -899,11 +900,15 @@ buf_read_ibuf_merge_pages(
 		dberr_t		err;
 		buf_pool_t*	buf_pool;
 		ulint		zip_size = fil_space_get_zip_size(space_ids[i]);
+		bool		last = sync && (i + 1 == n_stored);
 
 		buf_pool = buf_pool_get(space_ids[i], page_nos[i]);
 
 		while (buf_pool->n_pend_reads
 		       > buf_pool->curr_size / BUF_READ_AHEAD_PEND_LIMIT) {
+			/* Submit the requests posted so far, so that
+			the pending reads can complete. */
+			os_aio_simulated_wake_handler_threads();
 			os_thread_sleep(500000);
 		}
 
@@ -912,8 +917,21 @@ buf_read_ibuf_merge_pages(
 			goto tablespace_deleted;
 		}
 
-		buf_read_page_low(&err, sync && (i + 1 == n_stored),
-				  BUF_READ_ANY_PAGE, space_ids[i],
+		if (last) {
+			/* Let the posted reads proceed while we wait
+			for this one. */
+			os_aio_simulated_wake_handler_threads();
+		}
+
+		/* The asynchronous reads are posted with
+		OS_AIO_SIMULATED_WAKE_LATER and submitted together, so
+		that the requests for adjacent pages can be merged. */
+		buf_read_page_low(&err, last,
+				  last
+				  ? BUF_READ_ANY_PAGE
+				  : BUF_READ_ANY_PAGE
+				  | OS_AIO_SIMULATED_WAKE_LATER,
+				  space_ids[i],
 				  zip_size, TRUE, space_versions[i],
 				  page_nos[i]);
 
@@ -44,6 +44,7 @@ Created 1/8/1996 Heikki Tuuri
 #include "ut0vec.h"
 #include "dict0priv.h"
 #include "fts0priv.h"
+#include "ibuf0ibuf.h"
 #include "ha_prototypes.h"
 
 /*****************************************************************//**
@@ -736,6 +737,15 @@ dict_drop_index_tree(
 
 	ut_ad(mutex_own(&(dict_sys->mutex)));
 	ut_a(!dict_table_is_comp(dict_sys->sys_indexes));
+
+	ptr = rec_get_nth_field_old(rec, DICT_FLD__SYS_INDEXES__ID, &len);
+
+	ut_ad(len == 8);
+
+	/* Any operations that are still buffered for the index will be
+	discarded when the pages are reused. */
+	ibuf_backlog_drop_index(mach_read_from_8(ptr));
+
 	ptr = rec_get_nth_field_old(
 		rec, DICT_FLD__SYS_INDEXES__PAGE_NO, &len);
 
@@ -112,6 +112,7 @@ UNIV_INTERN ulong	zip_pad_max = 50;
 /* Keys to register rwlocks and mutexes with performance schema */
 #ifdef UNIV_PFS_RWLOCK
 UNIV_INTERN mysql_pfs_key_t	dict_operation_lock_key;
+UNIV_INTERN mysql_pfs_key_t	dict_table_hash_latch_key;
 UNIV_INTERN mysql_pfs_key_t	index_tree_rw_lock_key;
 UNIV_INTERN mysql_pfs_key_t	index_online_log_key;
 UNIV_INTERN mysql_pfs_key_t	dict_table_stats_key;
@@ -482,6 +483,179 @@ dict_table_stats_unlock(
 	}
 }
 
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+/**********************************************************************//**
+Gets the latch protecting the partition of dict_sys->table_hash where a
+table name is hashed.
+@return latch */
+UNIV_INLINE
+rw_lock_t*
+dict_table_get_hash_latch(
+/*======================*/
+	ulint	fold)	/*!< in: ut_fold_string() of the table name */
+{
+	return(dict_sys->hash_latches
+	       + hash_calc_hash(fold, dict_sys->table_hash)
+	       % DICT_TABLE_HASH_N_LATCHES);
+}
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+
+/**********************************************************************//**
+Reserves the latch of the table name hash partition of a table in X mode,
+so that dict_table_open_on_name() cannot look up the table while the caller
+adds it to or removes it from dict_sys->table_hash. The caller must hold
+dict_sys->mutex. */
+UNIV_INLINE
+void
+dict_table_hash_x_lock(
+/*===================*/
+	ulint	fold)	/*!< in: ut_fold_string() of the table name */
+{
+	ut_ad(mutex_own(&dict_sys->mutex));
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	rw_lock_x_lock(dict_table_get_hash_latch(fold));
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+}
+
+/**********************************************************************//**
+Releases the latch reserved in dict_table_hash_x_lock(). */
+UNIV_INLINE
+void
+dict_table_hash_x_unlock(
+/*=====================*/
+	ulint	fold)	/*!< in: ut_fold_string() of the table name */
+{
+	ut_ad(mutex_own(&dict_sys->mutex));
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	rw_lock_x_unlock(dict_table_get_hash_latch(fold));
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+}
+
+/**********************************************************************//**
+Increments the count of open handles to a table. The caller must hold
+dict_sys->mutex. */
+UNIV_INLINE
+void
+dict_table_ref_inc(
+/*===============*/
+	dict_table_t*	table)	/*!< in/out: table */
+{
+	ut_ad(mutex_own(&dict_sys->mutex));
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	os_atomic_increment_ulint(&table->n_ref_count, 1);
+#else /* DICT_TABLE_OPEN_FAST_PATH */
+	++table->n_ref_count;
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+
+	MONITOR_ATOMIC_INC(MONITOR_TABLE_REFERENCE);
+}
+
+/**********************************************************************//**
+Decrements the count of open handles to a table. The caller must hold
+dict_sys->mutex. */
+UNIV_INLINE
+void
+dict_table_ref_dec(
+/*===============*/
+	dict_table_t*	table)	/*!< in/out: table */
+{
+	ut_ad(mutex_own(&dict_sys->mutex));
+	ut_a(table->n_ref_count > 0);
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	os_atomic_decrement_ulint(&table->n_ref_count, 1);
+#else /* DICT_TABLE_OPEN_FAST_PATH */
+	--table->n_ref_count;
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+
+	MONITOR_ATOMIC_DEC(MONITOR_TABLE_REFERENCE);
+}
+
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+/**********************************************************************//**
+Increments the count of open handles to a table without dict_sys->mutex,
+provided that the table is already open. The transitions of the count
+between 0 and 1 are left to the holders of dict_sys->mutex, because
+eviction and DROP TABLE rely on a zero count staying zero while they hold
+the mutex.
+@return true if the count was incremented */
+UNIV_INLINE
+bool
+dict_table_ref_inc_if_open(
+/*=======================*/
+	dict_table_t*	table)	/*!< in/out: table */
+{
+	for (ulint n = table->n_ref_count; n > 0; n = table->n_ref_count) {
+		if (os_compare_and_swap_ulint(&table->n_ref_count, n, n + 1)) {
+			MONITOR_ATOMIC_INC(MONITOR_TABLE_REFERENCE);
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/**********************************************************************//**
+Decrements the count of open handles to a table without dict_sys->mutex,
+provided that the table stays open by another handle.
+@return true if the count was decremented */
+UNIV_INLINE
+bool
+dict_table_ref_dec_if_shared(
+/*=========================*/
+	dict_table_t*	table)	/*!< in/out: table */
+{
+	for (ulint n = table->n_ref_count; n > 1; n = table->n_ref_count) {
+		if (os_compare_and_swap_ulint(&table->n_ref_count, n, n - 1)) {
+			MONITOR_ATOMIC_DEC(MONITOR_TABLE_REFERENCE);
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/**********************************************************************//**
+Looks up a table that is already open by name and increments its count of
+open handles, without reserving dict_sys->mutex. Tables that are corrupted
+or that have indexes whose creation was aborted, and all tables while a
+DDL operation has reserved the data dictionary, are left to
+dict_table_open_on_name(), which handles them under the mutex.
+@return table, or NULL if the table must be opened under dict_sys->mutex */
+static
+dict_table_t*
+dict_table_open_on_name_fast(
+/*=========================*/
+	const char*	table_name)	/*!< in: table name */
+{
+	ulint		fold	= ut_fold_string(table_name);
+	rw_lock_t*	latch	= dict_table_get_hash_latch(fold);
+	dict_table_t*	table;
+
+	rw_lock_s_lock(latch);
+
+	if (dict_sys->open_fast_disabled) {
+		rw_lock_s_unlock(latch);
+
+		return(NULL);
+	}
+
+	HASH_SEARCH(name_hash, dict_sys->table_hash, fold,
+		    dict_table_t*, table, ut_ad(table->cached),
+		    ut_strcmp(table->name, table_name) == 0);
+
+	if (table != NULL
+	    && (table->corrupted || table->drop_aborted
+		|| !dict_table_ref_inc_if_open(table))) {
+
+		table = NULL;
+	}
+
+	rw_lock_s_unlock(latch);
+
+	return(table);
+}
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+
 /**********************************************************************//**
 Try to drop any indexes after an aborted index creation.
 This can also be after a server kill during DROP INDEX. */
@@ -564,14 +738,19 @@ dict_table_close(
 					indexes after an aborted online
 					index creation */
 {
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	if (!dict_locked && !table->drop_aborted
+	    && dict_table_ref_dec_if_shared(table)) {
+
+		return;
+	}
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+
 	if (!dict_locked) {
 		mutex_enter(&dict_sys->mutex);
 	}
 
-	ut_ad(mutex_own(&dict_sys->mutex));
-	ut_a(table->n_ref_count > 0);
-
-	--table->n_ref_count;
+	dict_table_ref_dec(table);
 
 	/* Force persistent stats re-read upon next open of the table
 	so that FLUSH TABLE can be used to forcibly fetch stats from disk
@@ -585,7 +764,12 @@ dict_table_close(
 		dict_stats_deinit(table);
 	}
 
-	MONITOR_DEC(MONITOR_TABLE_REFERENCE);
+	/* Opening a table that is already open does not move it in the
+	LRU list, so that it can be done without dict_sys->mutex. Move the
+	table when its last handle is closed instead. */
+	if (table->n_ref_count == 0 && table->can_be_evicted) {
+		dict_move_to_mru(table);
+	}
 
 	ut_ad(dict_lru_validate());
 
@@ -950,9 +1134,7 @@ dict_table_open_on_id(
 			dict_move_to_mru(table);
 		}
 
-		++table->n_ref_count;
-
-		MONITOR_INC(MONITOR_TABLE_REFERENCE);
+		dict_table_ref_inc(table);
 	}
 
 	if (!dict_locked) {
@@ -1014,6 +1196,50 @@ dict_table_col_in_clustered_key(
 	return(FALSE);
 }
 
+/**********************************************************************//**
+Makes dict_table_open_on_name() reserve dict_sys->mutex for every table
+until dict_table_open_fast_enable() is called, and waits for the lookups
+that did not reserve it to complete. Called when a DDL operation reserves
+the data dictionary, because it relies on the count of open handles of
+the tables it changes staying as it is while it holds dict_sys->mutex.
+The caller must hold dict_sys->mutex. */
+UNIV_INTERN
+void
+dict_table_open_fast_disable(void)
+/*==============================*/
+{
+	ut_ad(mutex_own(&dict_sys->mutex));
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	ut_ad(!dict_sys->open_fast_disabled);
+
+	dict_sys->open_fast_disabled = true;
+
+	/* A lookup that read the flag before it was set holds the S-latch
+	of its partition until it has incremented the count. */
+	for (ulint i = 0; i < DICT_TABLE_HASH_N_LATCHES; i++) {
+		rw_lock_x_lock(&dict_sys->hash_latches[i]);
+		rw_lock_x_unlock(&dict_sys->hash_latches[i]);
+	}
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+}
+
+/**********************************************************************//**
+Allows dict_table_open_on_name() to open a table that is already open
+without reserving dict_sys->mutex again. The caller must hold
+dict_sys->mutex. */
+UNIV_INTERN
+void
+dict_table_open_fast_enable(void)
+/*=============================*/
+{
+	ut_ad(mutex_own(&dict_sys->mutex));
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	ut_ad(dict_sys->open_fast_disabled);
+
+	dict_sys->open_fast_disabled = false;
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+}
+
 /**********************************************************************//**
 Inits the data dictionary module. */
 UNIV_INTERN
@@ -1028,6 +1254,16 @@ dict_init(void)
 	dict_sys->table_hash = hash_create(buf_pool_get_curr_size()
 					   / (DICT_POOL_PER_TABLE_HASH
 					      * UNIV_WORD_SIZE));
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	dict_sys->hash_latches = static_cast<rw_lock_t*>(
+		mem_zalloc(DICT_TABLE_HASH_N_LATCHES * sizeof(rw_lock_t)));
+
+	for (ulint i = 0; i < DICT_TABLE_HASH_N_LATCHES; i++) {
+		rw_lock_create(dict_table_hash_latch_key,
+			       &dict_sys->hash_latches[i],
+			       SYNC_DICT_TABLE_HASH);
+	}
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
 	dict_sys->table_id_hash = hash_create(buf_pool_get_curr_size()
 					      / (DICT_POOL_PER_TABLE_HASH
 						 * UNIV_WORD_SIZE));
@@ -1085,11 +1321,22 @@ dict_table_open_on_name(
 {
 	dict_table_t*	table;
 
+	ut_ad(table_name);
+
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	if (!dict_locked) {
+		table = dict_table_open_on_name_fast(table_name);
+
+		if (table != NULL) {
+			return(table);
+		}
+	}
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+
 	if (!dict_locked) {
 		mutex_enter(&(dict_sys->mutex));
 	}
 
-	ut_ad(table_name);
 	ut_ad(mutex_own(&dict_sys->mutex));
 
 	table = dict_table_check_if_in_cache_low(table_name);
@@ -1129,9 +1376,7 @@ dict_table_open_on_name(
 			dict_move_to_mru(table);
 		}
 
-		++table->n_ref_count;
-
-		MONITOR_INC(MONITOR_TABLE_REFERENCE);
+		dict_table_ref_inc(table);
 	}
 
 	ut_ad(dict_lru_validate());
@@ -1273,8 +1518,10 @@ dict_table_add_to_cache(
 	}
 
 	/* Add table to hash table of tables */
+	dict_table_hash_x_lock(fold);
 	HASH_INSERT(dict_table_t, name_hash, dict_sys->table_hash, fold,
 		    table);
+	dict_table_hash_x_unlock(fold);
 
 	/* Add table to hash table of tables based on table id */
 	HASH_INSERT(dict_table_t, id_hash, dict_sys->table_id_hash, id_fold,
@@ -1342,7 +1589,7 @@ dict_table_can_be_evicted(
 
 			See also: dict_index_remove_from_cache_low() */
 
-			if (btr_search_info_get_ref_count(info) > 0) {
+			if (btr_search_info_get_ref_count(info, index) > 0) {
 				return(FALSE);
 			}
 		}
@@ -1353,10 +1600,19 @@ dict_table_can_be_evicted(
 	return(FALSE);
 }
 
+/** Number of tables that dict_make_room_in_cache() examines before it
+lets other threads reserve dict_sys->mutex */
+#define DICT_EVICT_BATCH	32
+
 /**********************************************************************//**
 Make room in the table cache by evicting an unused table. The unused table
 should not be part of FK relationship and currently not used in any user
 transaction. There is no guarantee that it will remove a table.
+The tables are examined in batches of DICT_EVICT_BATCH starting from the
+LRU end of the list. A table that cannot be evicted is moved to the MRU
+end, and dict_sys->mutex and dict_operation_lock are released and
+reacquired between batches, so that opening a table does not wait for a
+scan of the whole list.
 @return number of tables evicted. If the number of tables in the dict_LRU
 is less than max_tables it will not do anything. */
 UNIV_INTERN
@@ -1371,6 +1627,7 @@ dict_make_room_in_cache(
 	dict_table_t*	table;
 	ulint		check_up_to;
 	ulint		n_evicted = 0;
+	ulint		n_batch = 0;
 
 	ut_a(pct_check > 0);
 	ut_a(pct_check <= 100);
@@ -1409,11 +1666,35 @@ dict_make_room_in_cache(
 			dict_table_remove_from_cache_low(table, TRUE);
 
 			++n_evicted;
+		} else {
+			/* Skip the table in the next batches. */
+			dict_move_to_mru(table);
 		}
 
-		table = prev_table;
+		if (++n_batch < DICT_EVICT_BATCH) {
+			table = prev_table;
+			continue;
+		}
+
+		n_batch = 0;
+
+		mutex_exit(&dict_sys->mutex);
+		rw_lock_x_unlock(&dict_operation_lock);
+
+		os_thread_yield();
+
+		rw_lock_x_lock(&dict_operation_lock);
+		mutex_enter(&dict_sys->mutex);
+
+		/* The tables that were examined are now at the MRU end
+		or evicted. Any other table may have been opened, closed
+		or dropped meanwhile, so continue from the LRU end. */
+		len = UT_LIST_GET_LEN(dict_sys->table_LRU) + n_evicted;
+		table = UT_LIST_GET_LAST(dict_sys->table_LRU);
 	}
 
+	ut_ad(dict_lru_validate());
+
 	return(n_evicted);
 }
 
@@ -1537,6 +1818,7 @@ struct dict_foreign_remove_partial
 		dict_table_t*	table = foreign->referenced_table;
 		if (table != NULL) {
 			table->referenced_set.erase(foreign);
+			dict_table_set_schema_checked(table, false);
 		}
 		dict_foreign_free(foreign);
 	}
@@ -1562,6 +1844,10 @@ dict_table_rename_in_cache(
 
 	ut_ad(mutex_own(&(dict_sys->mutex)));
 
+	/* dict_table_schema_check() looks up the table by name, and the
+	foreign keys may be dropped from the cache below. */
+	dict_table_set_schema_checked(table, false);
+
 	/* store the old/current name to an automatic variable */
 	if (strlen(table->name) + 1 <= sizeof(old_name)) {
 		memcpy(old_name, table->name, strlen(table->name) + 1);
@@ -1680,8 +1966,10 @@ dict_table_rename_in_cache(
 	}
 
 	/* Remove table from the hash tables of tables */
+	dict_table_hash_x_lock(ut_fold_string(old_name));
 	HASH_DELETE(dict_table_t, name_hash, dict_sys->table_hash,
 		    ut_fold_string(old_name), table);
+	dict_table_hash_x_unlock(ut_fold_string(old_name));
 
 	if (strlen(new_name) > strlen(table->name)) {
 		/* We allocate MAX_FULL_NAME_LEN + 1 bytes here to avoid
@@ -1695,8 +1983,10 @@ dict_table_rename_in_cache(
 	memcpy(table->name, new_name, strlen(new_name) + 1);
 
 	/* Add table to hash table of tables */
+	dict_table_hash_x_lock(fold);
 	HASH_INSERT(dict_table_t, name_hash, dict_sys->table_hash, fold,
 		    table);
+	dict_table_hash_x_unlock(fold);
 
 	dict_sys->size += strlen(new_name) - strlen(old_name);
 	ut_a(dict_sys->size > 0);
@@ -2023,8 +2313,10 @@ dict_table_remove_from_cache_low(
 
 	/* Remove table from the hash tables of tables */
 
+	dict_table_hash_x_lock(ut_fold_string(table->name));
 	HASH_DELETE(dict_table_t, name_hash, dict_sys->table_hash,
 		    ut_fold_string(table->name), table);
+	dict_table_hash_x_unlock(ut_fold_string(table->name));
 
 	HASH_DELETE(dict_table_t, id_hash, dict_sys->table_id_hash,
 		    ut_fold_ull(table->id), table);
@@ -2655,7 +2947,7 @@ dict_index_remove_from_cache_low(
 	zero. See also: dict_table_can_be_evicted() */
 
 	do {
-		ulint ref_count = btr_search_info_get_ref_count(info);
+		ulint ref_count = btr_search_info_get_ref_count(info, index);
 
 		if (ref_count == 0) {
 			break;
@@ -3244,12 +3536,18 @@ dict_foreign_remove_from_cache(
 	ut_ad(mutex_own(&(dict_sys->mutex)));
 	ut_a(foreign);
 
+	/* The foreign keys are part of the schema that
+	dict_table_schema_check() compares. */
 	if (foreign->referenced_table != NULL) {
 		foreign->referenced_table->referenced_set.erase(foreign);
+		dict_table_set_schema_checked(
+			foreign->referenced_table, false);
 	}
 
 	if (foreign->foreign_table != NULL) {
 		foreign->foreign_table->foreign_set.erase(foreign);
+		dict_table_set_schema_checked(
+			foreign->foreign_table, false);
 	}
 
 	dict_foreign_free(foreign);
@@ -3417,6 +3715,16 @@ dict_foreign_add_to_cache(
 		foreign->referenced_table_name_lookup);
 	ut_a(for_table || ref_table);
 
+	/* The foreign keys are part of the schema that
+	dict_table_schema_check() compares. */
+	if (for_table) {
+		dict_table_set_schema_checked(for_table, false);
+	}
+
+	if (ref_table) {
+		dict_table_set_schema_checked(ref_table, false);
+	}
+
 	if (for_table) {
 		for_in_cache = dict_foreign_find(for_table, foreign);
 	}
@@ -4144,6 +4452,18 @@ dict_foreign_report_syntax_err(
 	mutex_exit(&dict_foreign_err_mutex);
 }
 
+/** Function object to clear dict_table_t::schema_checked of the referenced
+table of a foreign key constraint, if it is in the dictionary cache. */
+struct dict_foreign_invalidate_referenced_schema
+{
+	void operator()(dict_foreign_t* foreign) const
+	{
+		if (dict_table_t* table = foreign->referenced_table) {
+			dict_table_set_schema_checked(table, false);
+		}
+	}
+};
+
 /*********************************************************************//**
 Scans a table create SQL string and adds to the data dictionary the foreign
 key constraints declared in the string. This function should be called after
@@ -4320,11 +4640,15 @@ loop:
 
 		if (error == DB_SUCCESS) {
 
+			dict_table_set_schema_checked(table, false);
 			table->foreign_set.insert(local_fk_set.begin(),
 						  local_fk_set.end());
 			std::for_each(local_fk_set.begin(),
 				      local_fk_set.end(),
 				      dict_foreign_add_to_referenced_table());
+			std::for_each(local_fk_set.begin(),
+				      local_fk_set.end(),
+				      dict_foreign_invalidate_referenced_schema());
 			local_fk_set.clear();
 		}
 		return(error);
@@ -6061,6 +6385,8 @@ dict_table_schema_check(
 		return(DB_TABLE_NOT_FOUND);
 	}
 
+	dict_table_set_schema_checked(table, false);
+
 	if (table->ibd_file_missing) {
 		/* missing tablespace */
 
@@ -6211,10 +6537,67 @@ dict_table_schema_check(
 		return(DB_ERROR);
 	}
 
+	dict_table_set_schema_checked(table, true);
+
 	return(DB_SUCCESS);
 }
 /* @} */
 
+/*********************************************************************//**
+Sets or clears dict_table_t::schema_checked. The flag is read by
+dict_table_schema_check_is_cached() under the latch of the table name hash
+partition, so it is written under the latch in X mode. The caller must hold
+dict_sys->mutex. */
+UNIV_INTERN
+void
+dict_table_set_schema_checked(
+/*==========================*/
+	dict_table_t*	table,		/*!< in/out: table */
+	bool		checked)	/*!< in: whether the schema of the
+					table is known to be valid */
+{
+	ulint	fold = ut_fold_string(table->name);
+
+	dict_table_hash_x_lock(fold);
+	table->schema_checked = checked;
+	dict_table_hash_x_unlock(fold);
+}
+
+/*********************************************************************//**
+Checks whether a table in the dictionary cache has passed
+dict_table_schema_check() since its columns and foreign keys were last
+changed. This does not reserve dict_sys->mutex.
+@return true if the schema of the table is known to be valid, false if
+dict_table_schema_check() must be called */
+UNIV_INTERN
+bool
+dict_table_schema_check_is_cached(
+/*==============================*/
+	const char*	table_name)	/*!< in: table name */
+{
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	ulint		fold	= ut_fold_string(table_name);
+	rw_lock_t*	latch	= dict_table_get_hash_latch(fold);
+	dict_table_t*	table;
+	bool		checked;
+
+	rw_lock_s_lock(latch);
+
+	HASH_SEARCH(name_hash, dict_sys->table_hash, fold,
+		    dict_table_t*, table, ut_ad(table->cached),
+		    ut_strcmp(table->name, table_name) == 0);
+
+	checked = table != NULL && table->schema_checked
+		&& !table->ibd_file_missing;
+
+	rw_lock_s_unlock(latch);
+
+	return(checked);
+#else /* DICT_TABLE_OPEN_FAST_PATH */
+	return(false);
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+}
+
 /*********************************************************************//**
 Converts a database and table name from filesystem encoding
 (e.g. d@i1b/a@q1b@1Kc, same format as used in dict_table_t::name) in two
@@ -6315,6 +6698,14 @@ dict_close(void)
 
 	hash_table_free(dict_sys->table_hash);
 
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	for (i = 0; i < DICT_TABLE_HASH_N_LATCHES; i++) {
+		rw_lock_free(&dict_sys->hash_latches[i]);
+	}
+
+	mem_free(dict_sys->hash_latches);
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
+
 	/* The elements are the same instance as in dict_sys->table_hash,
 	therefore we don't delete the individual elements. */
 	hash_table_free(dict_sys->table_id_hash);
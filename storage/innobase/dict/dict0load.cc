@@ -1141,6 +1141,24 @@ loop:
 				break;
 			}
 
+			if (srv_lazy_tablespace_open
+			    && !DICT_TF_HAS_DATA_DIR(flags)) {
+				/* Only create the space object; the
+				.ibd file is opened when it is needed. */
+				dberr_t	err = fil_space_create_deferred(
+					space_id, dict_tf_to_fsp_flags(flags),
+					name);
+
+				if (err != DB_SUCCESS) {
+					ib_logf(IB_LOG_LEVEL_ERROR,
+						"Tablespace open failed for"
+						" '%s', ignored.",
+						table_name);
+				}
+
+				break;
+			}
+
 			/* It is a normal database startup: create the
 			space object and check that the .ibd file exists.
 			If the table uses a remote tablespace, look for the
@@ -462,6 +462,8 @@ dict_mem_table_col_rename(
 	ut_ad(!strcmp(from, s));
 
 	dict_mem_table_col_rename_low(table, nth_col, to, s);
+
+	dict_table_set_schema_checked(table, false);
 }
 
 /**********************************************************************//**
@@ -252,6 +252,14 @@ dict_stats_persistent_storage_check(
 	dberr_t		ret;
 
 	if (!caller_has_dict_sys_mutex) {
+		/* Avoid dict_sys->mutex if both tables have already
+		been checked and not altered since. */
+		if (dict_table_schema_check_is_cached(TABLE_STATS_NAME)
+		    && dict_table_schema_check_is_cached(INDEX_STATS_NAME)) {
+
+			return(true);
+		}
+
 		mutex_enter(&(dict_sys->mutex));
 	}
 
@@ -24,12 +24,14 @@ Created 10/25/1995 Heikki Tuuri
 *******************************************************/
 
 #include "fil0fil.h"
+#include "fil0pagecompress.h"
 
 #include <debug_sync.h>
 #include <my_dbug.h>
 
 #include "mem0mem.h"
 #include "hash0hash.h"
+#include "ut0vec.h"
 #include "os0file.h"
 #include "mach0data.h"
 #include "buf0buf.h"
@@ -45,6 +47,7 @@ Created 10/25/1995 Heikki Tuuri
 #include "page0zip.h"
 #include "trx0sys.h"
 #include "row0mysql.h"
+#include "srv0mon.h"
 #ifndef UNIV_HOTBACKUP
 # include "buf0lru.h"
 # include "ibuf0ibuf.h"
@@ -106,10 +109,17 @@ Some operating systems do not support many open files at the same time,
 though NT seems to tolerate at least 900 open files. Therefore, we put the
 open files in an LRU-list. If we need to open another file, we may close the
 file at the end of the LRU-list. When an i/o-operation is pending on a file,
-the file cannot be closed. We take the file nodes with pending i/o-operations
-out of the LRU-list and keep a count of pending operations. When an operation
-completes, we decrement the count and return the file node to the LRU-list if
-the count drops to zero. */
+the file cannot be closed. We keep a count of pending operations in each file
+node; the count is updated with atomic operations so that an i/o on a file
+which is already open does not need to reserve the fil_system mutex at all.
+Instead, such an i/o looks up the space under a shared latch that covers a
+partition of the space id hash table (see fil_node_prepare_for_io_fast()).
+An open file stays in the LRU-list also while it has pending i/o-operations,
+and the i/o path only marks the node as recently accessed; the list is
+scanned with a second-chance policy when we need to close a file. Only
+opening, closing, creating, renaming and dropping files and spaces reserve
+the fil_system mutex, and they take the partition latch in exclusive mode
+for the short time they modify the fields that the fast path reads. */
 
 /** When mysqld is run, the default directory "." is the mysqld datadir,
 but in the MySQL Embedded Server Library and mysqlbackup it is not the default
@@ -138,8 +148,19 @@ UNIV_INTERN mysql_pfs_key_t	fil_system_mutex_key;
 #ifdef UNIV_PFS_RWLOCK
 /* Key to register file space latch with performance schema */
 UNIV_INTERN mysql_pfs_key_t	fil_space_latch_key;
+/* Key to register the space id hash latches with performance schema */
+UNIV_INTERN mysql_pfs_key_t	fil_space_hash_latch_key;
 #endif /* UNIV_PFS_RWLOCK */
 
+#if defined HAVE_ATOMIC_BUILTINS && !defined UNIV_HOTBACKUP
+/** fil_io() can post i/o's on open files without reserving
+fil_system->mutex; this needs atomic updates of fil_node_t::n_pending */
+# define FIL_IO_FAST_PATH
+#endif /* HAVE_ATOMIC_BUILTINS && !UNIV_HOTBACKUP */
+
+/** Number of latches protecting partitions of fil_system->spaces */
+#define FIL_SPACE_HASH_N_LATCHES	64
+
 /** File node of a tablespace or the log data space */
 struct fil_node_t {
 	fil_space_t*	space;	/*!< backpointer to the space where this node
@@ -157,7 +178,11 @@ struct fil_node_t {
 	ulint		n_pending;
 				/*!< count of pending i/o's on this file;
 				closing of the file is not allowed if
-				this is > 0 */
+				this is > 0; updated with atomic
+				operations if FIL_IO_FAST_PATH is
+				defined, and then protected by the
+				space id hash latch in X mode only
+				when it must stay zero */
 	ulint		n_pending_flushes;
 				/*!< count of pending flushes on this file;
 				closing of the file is not allowed if
@@ -174,6 +199,14 @@ struct fil_node_t {
 				/*!< link field for the file chain */
 	UT_LIST_NODE_T(fil_node_t) LRU;
 				/*!< link field for the LRU list */
+	ibool		accessed;
+				/*!< TRUE if an i/o has been posted on
+				this file since the LRU scan last looked
+				at it; set without any latch */
+	ibool		no_punch_hole;
+				/*!< TRUE if punching a hole in this
+				file has failed, see fil_page_punch_hole();
+				set without any latch */
 	ulint		magic_n;/*!< FIL_NODE_MAGIC_N */
 };
 
@@ -249,6 +282,11 @@ struct fil_space_t {
 				unflushed_spaces */
 	UT_LIST_NODE_T(fil_space_t) space_list;
 				/*!< list of all spaces */
+	bool		open_deferred;
+				/*!< true if the space was registered by
+				fil_space_create_deferred() and nobody has
+				checked yet that its file can be opened and
+				carries this space id and flags on page 0 */
 	ulint		magic_n;/*!< FIL_SPACE_MAGIC_N */
 };
 
@@ -265,15 +303,28 @@ struct fil_system_t {
 	hash_table_t*	spaces;		/*!< The hash table of spaces in the
 					system; they are hashed on the space
 					id */
+#ifdef FIL_IO_FAST_PATH
+	rw_lock_t*	hash_latches;	/*!< FIL_SPACE_HASH_N_LATCHES latches,
+					each covering the cells of spaces
+					whose index modulo the number of
+					latches is the same; a reader of
+					spaces may hold either the mutex or
+					the latch of the cell in S mode; a
+					writer must hold both, the latch in
+					X mode. The X latch also covers the
+					changes to fil_space_t::stop_ios,
+					stop_new_ops, chain and
+					fil_node_t::open */
+#endif /* FIL_IO_FAST_PATH */
 	hash_table_t*	name_hash;	/*!< hash table based on the space
 					name */
 	UT_LIST_BASE_NODE_T(fil_node_t) LRU;
 					/*!< base node for the LRU list of the
-					most recently used open files with no
-					pending i/o's; if we start an i/o on
-					the file, we first remove it from this
-					list, and return it to the start of
-					the list when the i/o ends;
+					open files, most recently opened
+					first; an i/o does not move the node
+					but sets fil_node_t::accessed, which
+					gives the node a second chance in
+					fil_try_to_close_file_in_LRU();
 					log files and the system tablespace are
 					not put to this list: they are opened
 					after the startup, and kept open until
@@ -357,6 +408,86 @@ fil_validate_skip(void)
 }
 #endif /* UNIV_DEBUG */
 
+#ifdef FIL_IO_FAST_PATH
+/*******************************************************************//**
+Gets the latch protecting the partition of fil_system->spaces where a space
+id is hashed.
+@return latch */
+UNIV_INLINE
+rw_lock_t*
+fil_space_get_hash_latch(
+/*=====================*/
+	ulint	id)	/*!< in: space id */
+{
+	return(fil_system->hash_latches
+	       + hash_calc_hash(id, fil_system->spaces)
+	       % FIL_SPACE_HASH_N_LATCHES);
+}
+#endif /* FIL_IO_FAST_PATH */
+
+/*******************************************************************//**
+Reserves the latch of the space id hash partition of a space in X mode, so
+that the i/o fast path of fil_io() cannot see the space while the caller
+modifies it. The caller must hold the fil_system mutex. */
+UNIV_INLINE
+void
+fil_space_hash_x_lock(
+/*==================*/
+	ulint	id)	/*!< in: space id */
+{
+	ut_ad(mutex_own(&fil_system->mutex));
+#ifdef FIL_IO_FAST_PATH
+	rw_lock_x_lock(fil_space_get_hash_latch(id));
+#endif /* FIL_IO_FAST_PATH */
+}
+
+/*******************************************************************//**
+Releases the latch reserved in fil_space_hash_x_lock(). */
+UNIV_INLINE
+void
+fil_space_hash_x_unlock(
+/*====================*/
+	ulint	id)	/*!< in: space id */
+{
+	ut_ad(mutex_own(&fil_system->mutex));
+#ifdef FIL_IO_FAST_PATH
+	rw_lock_x_unlock(fil_space_get_hash_latch(id));
+#endif /* FIL_IO_FAST_PATH */
+}
+
+/*******************************************************************//**
+Increments the count of pending i/o's on a file node. */
+UNIV_INLINE
+void
+fil_node_pending_inc(
+/*=================*/
+	fil_node_t*	node)	/*!< in/out: file node */
+{
+#ifdef FIL_IO_FAST_PATH
+	os_atomic_increment_ulint(&node->n_pending, 1);
+#else /* FIL_IO_FAST_PATH */
+	ut_ad(mutex_own(&fil_system->mutex));
+	node->n_pending++;
+#endif /* FIL_IO_FAST_PATH */
+}
+
+/*******************************************************************//**
+Decrements the count of pending i/o's on a file node. */
+UNIV_INLINE
+void
+fil_node_pending_dec(
+/*=================*/
+	fil_node_t*	node)	/*!< in/out: file node */
+{
+	ut_a(node->n_pending > 0);
+#ifdef FIL_IO_FAST_PATH
+	os_atomic_decrement_ulint(&node->n_pending, 1);
+#else /* FIL_IO_FAST_PATH */
+	ut_ad(mutex_own(&fil_system->mutex));
+	node->n_pending--;
+#endif /* FIL_IO_FAST_PATH */
+}
+
 /********************************************************************//**
 Determines if a file node belongs to the least-recently-used list.
 @return TRUE if the file belongs to fil_system->LRU mutex. */
@@ -374,9 +505,8 @@ fil_space_belongs_in_lru(
 NOTE: you must call fil_mutex_enter_and_prepare_for_io() first!
 
 Prepares a file node for i/o. Opens the file if it is closed. Updates the
-pending i/o's field in the node and the system appropriately. Takes the node
-off the LRU list if it is in the LRU list. The caller must hold the fil_sys
-mutex.
+pending i/o's field in the node appropriately. The caller must hold the
+fil_sys mutex.
 @return false if the file can't be opened, otherwise true */
 static
 bool
@@ -387,7 +517,8 @@ fil_node_prepare_for_io(
 	fil_space_t*	space);	/*!< in: space */
 /********************************************************************//**
 Updates the data structures when an i/o operation finishes. Updates the
-pending i/o's field in the node appropriately. */
+pending i/o's field in the node appropriately. The caller must hold the
+fil_sys mutex. */
 static
 void
 fil_node_complete_io(
@@ -479,7 +610,12 @@ fil_space_get_by_id(
 {
 	fil_space_t*	space;
 
+#if defined FIL_IO_FAST_PATH && defined UNIV_SYNC_DEBUG
+	ut_ad(mutex_own(&fil_system->mutex)
+	      || rw_lock_own(fil_space_get_hash_latch(id), RW_LOCK_SHARED));
+#elif !defined FIL_IO_FAST_PATH
 	ut_ad(mutex_own(&fil_system->mutex));
+#endif /* FIL_IO_FAST_PATH && UNIV_SYNC_DEBUG */
 
 	HASH_SEARCH(hash, fil_system->spaces, id,
 		    fil_space_t*, space,
@@ -679,7 +815,9 @@ fil_node_create(
 
 	node->space = space;
 
+	fil_space_hash_x_lock(id);
 	UT_LIST_ADD_LAST(chain, space->chain, node);
+	fil_space_hash_x_unlock(id);
 
 	if (id < SRV_LOG_SPACE_FIRST_ID && fil_system->max_assigned_id < id) {
 
@@ -754,6 +892,20 @@ fil_node_open_file(
 		ut_a(space->purpose != FIL_LOG);
 		ut_a(fil_is_user_tablespace_id(space->id));
 
+		if (space->open_deferred
+		    && size_bytes < FIL_IBD_FILE_INITIAL_SIZE * UNIV_PAGE_SIZE) {
+			/* Nobody has looked at the file since the startup;
+			treat it like a missing file instead of crashing. */
+			os_file_close(node->handle);
+
+			ib_logf(IB_LOG_LEVEL_ERROR,
+				"The size of tablespace file %s is only "
+				UINT64PF " bytes; treating the tablespace"
+				" as missing.", node->name, size_bytes);
+
+			return(false);
+		}
+
 		if (size_bytes < FIL_IBD_FILE_INITIAL_SIZE * UNIV_PAGE_SIZE) {
 			fprintf(stderr,
 				"InnoDB: Error: the size of single-table"
@@ -786,6 +938,25 @@ fil_node_open_file(
 
 		os_file_close(node->handle);
 
+		if (space->open_deferred
+		    && (!success || space_id != space->id
+			|| space->flags != flags)) {
+			/* The file was registered from the data dictionary
+			at the startup without reading it. It may have been
+			replaced by the .ibd file of another table. */
+			ib_logf(IB_LOG_LEVEL_ERROR,
+				"Tablespace file %s has space id %lu and flags"
+				" 0x%lx, but the data dictionary expects space"
+				" id %lu and flags 0x%lx; treating the"
+				" tablespace as missing.",
+				node->name, (ulong) space_id, (ulong) flags,
+				(ulong) space->id, (ulong) space->flags);
+
+			return(false);
+		}
+
+		space->open_deferred = false;
+
 		if (UNIV_UNLIKELY(space_id != space->id)) {
 			fprintf(stderr,
 				"InnoDB: Error: tablespace id is %lu"
@@ -874,7 +1045,11 @@ add_size:
 
 	ut_a(ret);
 
+	os_aio_register_file(node->handle);
+
+	fil_space_hash_x_lock(space->id);
 	node->open = TRUE;
+	fil_space_hash_x_unlock(space->id);
 
 	system->n_open++;
 	fil_n_file_opened++;
@@ -889,11 +1064,14 @@ add_size:
 }
 
 /**********************************************************************//**
-Closes a file. */
+Closes a file unless an i/o is pending on it. The fast path of fil_io() may
+start an i/o on an open file without the fil_system mutex, so the check of
+n_pending is made under the X-latch of the space id hash partition.
+@return TRUE if the file was closed */
 static
-void
-fil_node_close_file(
-/*================*/
+ibool
+fil_node_close_file_low(
+/*====================*/
 	fil_node_t*	node,	/*!< in: file node */
 	fil_system_t*	system)	/*!< in: tablespace memory cache */
 {
@@ -902,7 +1080,6 @@ fil_node_close_file(
 	ut_ad(node && system);
 	ut_ad(mutex_own(&(system->mutex)));
 	ut_a(node->open);
-	ut_a(node->n_pending == 0);
 	ut_a(node->n_pending_flushes == 0);
 	ut_a(!node->being_extended);
 #ifndef UNIV_HOTBACKUP
@@ -910,12 +1087,25 @@ fil_node_close_file(
 	     || srv_fast_shutdown == 2);
 #endif /* !UNIV_HOTBACKUP */
 
+	fil_space_hash_x_lock(node->space->id);
+
+	if (node->n_pending > 0) {
+		fil_space_hash_x_unlock(node->space->id);
+
+		return(FALSE);
+	}
+
+	node->open = FALSE;
+
+	fil_space_hash_x_unlock(node->space->id);
+
+	os_aio_deregister_file(node->handle);
+
 	ret = os_file_close(node->handle);
 	ut_a(ret);
 
 	/* printf("Closing file %s\n", node->name); */
 
-	node->open = FALSE;
 	ut_a(system->n_open > 0);
 	system->n_open--;
 	fil_n_file_opened--;
@@ -927,6 +1117,23 @@ fil_node_close_file(
 		/* The node is in the LRU list, remove it */
 		UT_LIST_REMOVE(LRU, system->LRU, node);
 	}
+
+	return(TRUE);
+}
+
+/**********************************************************************//**
+Closes a file. There must not be any pending i/o's on the file. */
+static
+void
+fil_node_close_file(
+/*================*/
+	fil_node_t*	node,	/*!< in: file node */
+	fil_system_t*	system)	/*!< in: tablespace memory cache */
+{
+	ibool	closed;
+
+	closed = fil_node_close_file_low(node, system);
+	ut_a(closed);
 }
 
 /********************************************************************//**
@@ -954,44 +1161,68 @@ fil_try_to_close_file_in_LRU(
 			(ulong) UT_LIST_GET_LEN(fil_system->LRU));
 	}
 
-	for (node = UT_LIST_GET_LAST(fil_system->LRU);
-	     node != NULL;
-	     node = UT_LIST_GET_PREV(LRU, node)) {
+	/* The i/o path does not move the nodes in the list, it only sets
+	node->accessed. In the first pass we skip the nodes accessed since
+	the previous scan and clear their flag; only if no other file can
+	be closed, we look at them again in the second pass. */
 
-		if (node->modification_counter == node->flush_counter
-		    && node->n_pending_flushes == 0
-		    && !node->being_extended) {
+	for (ulint pass = 0; pass < 2; pass++) {
+		for (node = UT_LIST_GET_LAST(fil_system->LRU);
+		     node != NULL;
+		     node = UT_LIST_GET_PREV(LRU, node)) {
 
-			fil_node_close_file(node, fil_system);
+			if (pass == 0 && node->accessed) {
+				node->accessed = FALSE;
+				continue;
+			}
 
-			return(TRUE);
-		}
+			if (node->n_pending == 0
+			    && node->modification_counter
+			    == node->flush_counter
+			    && node->n_pending_flushes == 0
+			    && !node->being_extended
+			    && fil_node_close_file_low(node, fil_system)) {
 
-		if (!print_info) {
-			continue;
-		}
+				return(TRUE);
+			}
 
-		if (node->n_pending_flushes > 0) {
-			fputs("InnoDB: cannot close file ", stderr);
-			ut_print_filename(stderr, node->name);
-			fprintf(stderr, ", because n_pending_flushes %lu\n",
-				(ulong) node->n_pending_flushes);
-		}
+			if (!print_info || pass == 0) {
+				continue;
+			}
 
-		if (node->modification_counter != node->flush_counter) {
-			fputs("InnoDB: cannot close file ", stderr);
-			ut_print_filename(stderr, node->name);
-			fprintf(stderr,
-				", because mod_count %ld != fl_count %ld\n",
-				(long) node->modification_counter,
-				(long) node->flush_counter);
+			if (node->n_pending > 0) {
+				fputs("InnoDB: cannot close file ", stderr);
+				ut_print_filename(stderr, node->name);
+				fprintf(stderr, ", because n_pending %lu\n",
+					(ulong) node->n_pending);
+			}
 
-		}
+			if (node->n_pending_flushes > 0) {
+				fputs("InnoDB: cannot close file ", stderr);
+				ut_print_filename(stderr, node->name);
+				fprintf(stderr,
+					", because n_pending_flushes %lu\n",
+					(ulong) node->n_pending_flushes);
+			}
+
+			if (node->modification_counter
+			    != node->flush_counter) {
+				fputs("InnoDB: cannot close file ", stderr);
+				ut_print_filename(stderr, node->name);
+				fprintf(stderr,
+					", because mod_count %ld"
+					" != fl_count %ld\n",
+					(long) node->modification_counter,
+					(long) node->flush_counter);
+
+			}
 
-		if (node->being_extended) {
-			fputs("InnoDB: cannot close file ", stderr);
-			ut_print_filename(stderr, node->name);
-			fprintf(stderr, ", because it is being extended\n");
+			if (node->being_extended) {
+				fputs("InnoDB: cannot close file ", stderr);
+				ut_print_filename(stderr, node->name);
+				fprintf(stderr,
+					", because it is being extended\n");
+			}
 		}
 	}
 
@@ -1179,7 +1410,9 @@ fil_node_free(
 
 	space->size -= node->size;
 
+	fil_space_hash_x_lock(space->id);
 	UT_LIST_REMOVE(chain, space->chain, node);
+	fil_space_hash_x_unlock(space->id);
 
 	os_event_free(node->sync_event);
 	mem_free(node->name);
@@ -1320,7 +1553,9 @@ fil_space_create(
 
 	rw_lock_create(fil_space_latch_key, &space->latch, SYNC_FSP);
 
+	fil_space_hash_x_lock(id);
 	HASH_INSERT(fil_space_t, hash, fil_system->spaces, id, space);
+	fil_space_hash_x_unlock(id);
 
 	HASH_INSERT(fil_space_t, name_hash, fil_system->name_hash,
 		    ut_fold_string(name), space);
@@ -1424,7 +1659,9 @@ fil_space_free(
 		return(FALSE);
 	}
 
+	fil_space_hash_x_lock(id);
 	HASH_DELETE(fil_space_t, hash, fil_system->spaces, id, space);
+	fil_space_hash_x_unlock(id);
 
 	fnamespace = fil_space_get_by_name(space->name);
 	ut_a(fnamespace);
@@ -1692,6 +1929,17 @@ fil_init(
 	fil_system->spaces = hash_create(hash_size);
 	fil_system->name_hash = hash_create(hash_size);
 
+#ifdef FIL_IO_FAST_PATH
+	fil_system->hash_latches = static_cast<rw_lock_t*>(
+		mem_zalloc(FIL_SPACE_HASH_N_LATCHES * sizeof(rw_lock_t)));
+
+	for (ulint i = 0; i < FIL_SPACE_HASH_N_LATCHES; i++) {
+		rw_lock_create(fil_space_hash_latch_key,
+			       &fil_system->hash_latches[i],
+			       SYNC_FIL_SPACE_HASH);
+	}
+#endif /* FIL_IO_FAST_PATH */
+
 	UT_LIST_INIT(fil_system->LRU);
 
 	fil_system->max_n_open = max_n_open;
@@ -2554,7 +2802,9 @@ fil_check_pending_operations(
 	mutex_enter(&fil_system->mutex);
 	fil_space_t* sp = fil_space_get_by_id(id);
 	if (sp) {
+		fil_space_hash_x_lock(id);
 		sp->stop_new_ops = TRUE;
+		fil_space_hash_x_unlock(id);
 	}
 	mutex_exit(&fil_system->mutex);
 
@@ -3064,7 +3314,9 @@ retry:
 	operating systems can rename an open file. For the closing we have to
 	wait until there are no pending i/o's or flushes on the file. */
 
+	fil_space_hash_x_lock(id);
 	space->stop_ios = TRUE;
+	fil_space_hash_x_unlock(id);
 
 	/* The following code must change when InnoDB supports
 	multiple datafiles per tablespace. */
@@ -3980,6 +4232,101 @@ cleanup_and_exit:
 
 	return(err);
 }
+
+/********************************************************************//**
+Registers a single-table tablespace of the data dictionary in the memory
+cache without opening its .ibd file in the default location. The file is
+opened on the first i/o, or when fil_space_for_table_exists_in_mem() is
+called for the table; if it cannot be opened then, or page 0 of the file
+does not carry this space id and flags, the space is removed from the
+cache again. Used at a normal startup if srv_lazy_tablespace_open
+is set.
+@return	DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+fil_space_create_deferred(
+/*======================*/
+	ulint		id,		/*!< in: space id */
+	ulint		flags,		/*!< in: tablespace flags */
+	const char*	tablename)	/*!< in: table name in the
+					databasename/tablename format */
+{
+	char*		filepath;
+	dberr_t		err = DB_SUCCESS;
+
+	ut_ad(!FSP_FLAGS_HAS_DATA_DIR(flags));
+
+	if (!fsp_flags_is_valid(flags)) {
+		return(DB_CORRUPTION);
+	}
+
+	filepath = fil_make_ibd_name(tablename, false);
+
+	if (!fil_space_create(tablename, id, flags, FIL_TABLESPACE)) {
+		err = DB_ERROR;
+	} else if (!fil_node_create(filepath, 0, id, FALSE)) {
+		err = DB_ERROR;
+	} else {
+		mutex_enter(&fil_system->mutex);
+		fil_space_get_by_id(id)->open_deferred = true;
+		mutex_exit(&fil_system->mutex);
+	}
+
+	mem_free(filepath);
+
+	return(err);
+}
+
+/*******************************************************************//**
+Opens the .ibd file of a tablespace registered with
+fil_space_create_deferred(), to check that it exists and to learn its
+size. If the file cannot be opened, or it belongs to another space, the
+space is removed from the memory cache, as if it had not been found at the
+startup. The caller must hold
+the fil_sys mutex; it is released and reacquired.
+@return	the space, or NULL if it was removed from the cache */
+static
+fil_space_t*
+fil_space_open_deferred(
+/*====================*/
+	ulint	id)	/*!< in: space id */
+{
+	fil_space_t*	space;
+	fil_node_t*	node;
+
+	ut_ad(mutex_own(&fil_system->mutex));
+
+	mutex_exit(&fil_system->mutex);
+
+	fil_mutex_enter_and_prepare_for_io(id);
+
+	space = fil_space_get_by_id(id);
+
+	if (space == NULL || !space->open_deferred) {
+		return(space);
+	}
+
+	ut_a(UT_LIST_GET_LEN(space->chain) == 1);
+	node = UT_LIST_GET_FIRST(space->chain);
+
+	/* fil_node_open_file() clears open_deferred once it has checked
+	the space id and flags on page 0 of the file. */
+	ut_a(!node->open);
+
+	if (fil_node_prepare_for_io(node, fil_system, space)) {
+		fil_node_complete_io(node, fil_system, OS_FILE_READ);
+
+		return(space);
+	}
+
+	if (space->n_pending_ops == 0) {
+		fil_space_free(id, FALSE);
+
+		return(NULL);
+	}
+
+	return(space);
+}
 #endif /* !UNIV_HOTBACKUP */
 
 #ifdef UNIV_HOTBACKUP
@@ -4614,18 +4961,22 @@ fil_file_readdir_next_file(
 	return(-1);
 }
 
+/** A .ibd or .isl file found in a database directory */
+struct fil_load_file_t {
+	const char*	dbname;		/*!< database directory name */
+	const char*	filename;	/*!< file name, with extension */
+};
+
 /********************************************************************//**
-At the server startup, if we need crash recovery, scans the database
-directories under the MySQL datadir, looking for .ibd files. Those files are
-single-table tablespaces. We need to know the space id in each of them so that
-we know into which file we should look to check the contents of a page stored
-in the doublewrite buffer, also to know where to apply log records where the
-space id is != 0.
+Scans the database directories under the MySQL datadir, looking for .ibd
+and .isl files, and appends them to a vector.
 @return	DB_SUCCESS or error number */
-UNIV_INTERN
+static
 dberr_t
-fil_load_single_table_tablespaces(void)
-/*===================================*/
+fil_scan_single_table_tablespaces(
+/*==============================*/
+	ib_vector_t*	files,	/*!< in/out: vector of fil_load_file_t */
+	mem_heap_t*	heap)	/*!< in: heap for the file names */
 {
 	int		ret;
 	char*		dbpath		= NULL;
@@ -4705,9 +5056,15 @@ fil_load_single_table_tablespaces(void)
 						   + strlen(fileinfo.name) - 4,
 						   ".isl"))) {
 					/* The name ends in .ibd or .isl;
-					try opening the file */
-					fil_load_single_table_tablespace(
-						dbinfo.name, fileinfo.name);
+					remember the file */
+					fil_load_file_t	file;
+
+					file.dbname = mem_heap_strdup(
+						heap, dbinfo.name);
+					file.filename = mem_heap_strdup(
+						heap, fileinfo.name);
+
+					ib_vector_push(files, &file);
 				}
 next_file_item:
 				ret = fil_file_readdir_next_file(&err,
@@ -4743,6 +5100,214 @@ next_datadir_item:
 	return(err);
 }
 
+/** The files to open, shared by the fil_load_thread instances */
+static const fil_load_file_t*	fil_load_files;
+/** Number of elements in fil_load_files */
+static ulint			fil_load_n_files;
+/** Number of fil_load_thread instances */
+static ulint			fil_load_n_threads;
+/** Number of fil_load_thread instances still running; protected by
+fil_system->mutex */
+static ulint			fil_load_n_active;
+/** Partition numbers passed to the fil_load_thread instances */
+static ulint			fil_load_thread_ids[FIL_LOAD_THREADS_MAX];
+
+#if !defined UNIV_HOTBACKUP && defined UNIV_PFS_THREAD
+/* Key to register fil_load_thread with performance schema */
+UNIV_INTERN mysql_pfs_key_t	fil_load_thread_key;
+#endif /* !UNIV_HOTBACKUP && UNIV_PFS_THREAD */
+
+/********************************************************************//**
+Compares two files found by fil_scan_single_table_tablespaces() by the
+database name and the file name without the extension, so that the .ibd
+and .isl file of a table are adjacent after sorting.
+@return negative, 0 or positive if a is smaller, equal or greater than b */
+static
+int
+fil_load_file_cmp(
+/*==============*/
+	const void*	a,	/*!< in: fil_load_file_t */
+	const void*	b)	/*!< in: fil_load_file_t */
+{
+	const fil_load_file_t*	f1 = static_cast<const fil_load_file_t*>(a);
+	const fil_load_file_t*	f2 = static_cast<const fil_load_file_t*>(b);
+	ulint			len1;
+	ulint			len2;
+	int			cmp;
+
+	cmp = strcmp(f1->dbname, f2->dbname);
+
+	if (cmp != 0) {
+		return(cmp);
+	}
+
+	len1 = strlen(f1->filename) - 4;
+	len2 = strlen(f2->filename) - 4;
+
+	cmp = memcmp(f1->filename, f2->filename, ut_min(len1, len2));
+
+	if (cmp != 0) {
+		return(cmp);
+	}
+
+	if (len1 != len2) {
+		return(len1 < len2 ? -1 : 1);
+	}
+
+	return(0);
+}
+
+/********************************************************************//**
+Opens the files of one partition of fil_load_files. */
+static
+void
+fil_load_files_part(
+/*================*/
+	ulint	id)	/*!< in: partition number */
+{
+	for (ulint i = id; i < fil_load_n_files; i += fil_load_n_threads) {
+		fil_load_single_table_tablespace(
+			fil_load_files[i].dbname, fil_load_files[i].filename);
+	}
+}
+
+#ifndef UNIV_HOTBACKUP
+/******************************************************************//**
+Worker thread of fil_load_single_table_tablespaces(). Opens and validates
+the files of its partition of fil_load_files.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(fil_load_thread)(
+/*============================*/
+	void*	arg)	/*!< in: pointer to the partition number */
+{
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(fil_load_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	fil_load_files_part(*static_cast<ulint*>(arg));
+
+	mutex_enter(&fil_system->mutex);
+	ut_a(fil_load_n_active > 0);
+	fil_load_n_active--;
+	mutex_exit(&fil_system->mutex);
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+#endif /* !UNIV_HOTBACKUP */
+
+/********************************************************************//**
+At the server startup, if we need crash recovery, scans the database
+directories under the MySQL datadir, looking for .ibd files. Those files are
+single-table tablespaces. We need to know the space id in each of them so that
+we know into which file we should look to check the contents of a page stored
+in the doublewrite buffer, also to know where to apply log records where the
+space id is != 0. The directories are scanned first, and the files found are
+then opened and validated by srv_tablespace_discovery_threads threads.
+@return	DB_SUCCESS or error number */
+UNIV_INTERN
+dberr_t
+fil_load_single_table_tablespaces(void)
+/*===================================*/
+{
+	mem_heap_t*		heap;
+	ib_vector_t*		files;
+	fil_load_file_t*	file;
+	ulint			n_files	= 0;
+	ulint			start_time;
+	dberr_t			err;
+
+	heap = mem_heap_create(16384);
+	files = ib_vector_create(
+		ib_heap_allocator_create(heap), sizeof(fil_load_file_t), 1024);
+
+	start_time = ut_time_ms();
+
+	err = fil_scan_single_table_tablespaces(files, heap);
+
+	/* A table may have both an .ibd and an .isl file, and
+	fil_load_single_table_tablespace() looks at both of them for
+	either name. Keep one name per table, so that no two threads
+	try to load the same table. */
+
+	ib_vector_sort(files, fil_load_file_cmp);
+
+	for (ulint i = 0; i < ib_vector_size(files); i++) {
+		file = static_cast<fil_load_file_t*>(ib_vector_get(files, i));
+
+		if (n_files == 0
+		    || fil_load_file_cmp(
+			    ib_vector_get(files, n_files - 1), file) != 0) {
+
+			*static_cast<fil_load_file_t*>(
+				ib_vector_get(files, n_files++)) = *file;
+		}
+	}
+
+	fil_load_files = n_files
+		? static_cast<fil_load_file_t*>(ib_vector_get(files, 0))
+		: NULL;
+	fil_load_n_files = n_files;
+
+#ifndef UNIV_HOTBACKUP
+	fil_load_n_threads = ut_min(
+		ut_max(srv_tablespace_discovery_threads, 1),
+		ut_min(FIL_LOAD_THREADS_MAX, ut_max(n_files, 1)));
+#else /* !UNIV_HOTBACKUP */
+	fil_load_n_threads = 1;
+#endif /* !UNIV_HOTBACKUP */
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Opening %lu single-table tablespace files using %lu threads",
+		(ulong) n_files, (ulong) fil_load_n_threads);
+
+#ifndef UNIV_HOTBACKUP
+	fil_load_n_active = fil_load_n_threads - 1;
+
+	for (ulint i = 1; i < fil_load_n_threads; i++) {
+		fil_load_thread_ids[i] = i;
+
+		os_thread_create(fil_load_thread,
+				 &fil_load_thread_ids[i], NULL);
+	}
+#endif /* !UNIV_HOTBACKUP */
+
+	/* This thread handles the first partition itself */
+
+	fil_load_files_part(0);
+
+#ifndef UNIV_HOTBACKUP
+	mutex_enter(&fil_system->mutex);
+
+	while (fil_load_n_active > 0) {
+		mutex_exit(&fil_system->mutex);
+
+		os_thread_sleep(10000);
+
+		mutex_enter(&fil_system->mutex);
+	}
+
+	mutex_exit(&fil_system->mutex);
+#endif /* !UNIV_HOTBACKUP */
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Opened %lu single-table tablespace files in %lu ms",
+		(ulong) n_files, (ulong) (ut_time_ms() - start_time));
+
+	fil_load_files = NULL;
+	fil_load_n_files = 0;
+
+	mem_heap_free(heap);
+
+	return(err);
+}
+
 /*******************************************************************//**
 Returns TRUE if a single-table tablespace does not exist in the memory cache,
 or is being deleted there.
@@ -4872,6 +5437,15 @@ fil_space_for_table_exists_in_mem(
 	directory path from the datadir to the file */
 
 	fnamespace = fil_space_get_by_name(name);
+#ifndef UNIV_HOTBACKUP
+	if (space && space == fnamespace && space->open_deferred) {
+		/* The space was registered at the startup without
+		looking at the file; check that the file exists. */
+
+		space = fil_space_open_deferred(id);
+		fnamespace = fil_space_get_by_name(name);
+	}
+#endif /* !UNIV_HOTBACKUP */
 	if (space && space == fnamespace) {
 		/* Found */
 
@@ -5347,9 +5921,8 @@ fil_space_get_n_reserved_extents(
 NOTE: you must call fil_mutex_enter_and_prepare_for_io() first!
 
 Prepares a file node for i/o. Opens the file if it is closed. Updates the
-pending i/o's field in the node and the system appropriately. Takes the node
-off the LRU list if it is in the LRU list. The caller must hold the fil_sys
-mutex.
+pending i/o's field in the node appropriately. The caller must hold the
+fil_sys mutex.
 @return false if the file can't be opened, otherwise true */
 static
 bool
@@ -5380,22 +5953,87 @@ fil_node_prepare_for_io(
 		}
 	}
 
-	if (node->n_pending == 0 && fil_space_belongs_in_lru(space)) {
-		/* The node is in the LRU list, remove it */
+	node->accessed = TRUE;
 
-		ut_a(UT_LIST_GET_LEN(system->LRU) > 0);
+	fil_node_pending_inc(node);
 
-		UT_LIST_REMOVE(LRU, system->LRU, node);
+	return(true);
+}
+
+#ifdef FIL_IO_FAST_PATH
+/********************************************************************//**
+Prepares a file node for i/o without reserving the fil_sys mutex. This
+succeeds if the space exists, no rename or drop is stopping i/o's on it, and
+the file containing the page is already open and known to be big enough.
+The space is looked up under the S-latch of its space id hash partition;
+while the latch is held, the space cannot be freed and the fields checked
+here cannot change, because their writers hold the latch in X mode. Once
+n_pending has been incremented, the file cannot be closed until
+fil_node_complete_io_nolock() is called.
+@return file node with n_pending incremented, or NULL if the caller must
+take the slow path through fil_mutex_enter_and_prepare_for_io() */
+static
+fil_node_t*
+fil_node_prepare_for_io_fast(
+/*=========================*/
+	ulint	space_id,	/*!< in: space id */
+	ulint	type,		/*!< in: OS_FILE_READ or OS_FILE_WRITE */
+	bool	sync,		/*!< in: true if synchronous aio is desired */
+	ulint*	block_offset)	/*!< in: page number within the space;
+				out: page number within the returned node */
+{
+	rw_lock_t*	latch	= fil_space_get_hash_latch(space_id);
+	fil_space_t*	space;
+	fil_node_t*	node	= NULL;
+	ulint		offset	= *block_offset;
+
+	rw_lock_s_lock(latch);
+
+	space = fil_space_get_by_id(space_id);
+
+	if (space == NULL
+	    || space->stop_ios
+	    || (type == OS_FILE_READ && !sync && space->stop_new_ops)) {
+
+		goto func_exit;
 	}
 
-	node->n_pending++;
+	for (node = UT_LIST_GET_FIRST(space->chain);
+	     node != NULL && node->size != 0 && node->size <= offset;
+	     node = UT_LIST_GET_NEXT(chain, node)) {
 
-	return(true);
+		offset -= node->size;
+	}
+
+	/* A size of zero means that the size of a single-table
+	tablespace is not known before the file is opened. The size of
+	a file only grows, so a stale value read here without the fil_sys
+	mutex can only send us to the slow path. */
+	if (node == NULL || !node->open || node->size <= offset) {
+		node = NULL;
+
+		goto func_exit;
+	}
+
+	os_atomic_increment_ulint(&node->n_pending, 1);
+
+	if (!node->accessed) {
+		node->accessed = TRUE;
+	}
+
+	*block_offset = offset;
+
+func_exit:
+	rw_lock_s_unlock(latch);
+
+	return(node);
 }
+#endif /* FIL_IO_FAST_PATH */
 
 /********************************************************************//**
 Updates the data structures when an i/o operation finishes. Updates the
-pending i/o's field in the node appropriately. */
+pending i/o's field in the node appropriately. The caller must hold the
+fil_sys mutex. */
 static
 void
 fil_node_complete_io(
@@ -5410,10 +6048,6 @@ fil_node_complete_io(
 	ut_ad(system);
 	ut_ad(mutex_own(&(system->mutex)));
 
-	ut_a(node->n_pending > 0);
-
-	node->n_pending--;
-
 	if (type == OS_FILE_WRITE) {
 		ut_ad(!srv_read_only_mode);
 		system->modification_counter++;
@@ -5436,11 +6070,33 @@ fil_node_complete_io(
 		}
 	}
 
-	if (node->n_pending == 0 && fil_space_belongs_in_lru(node->space)) {
+	fil_node_pending_dec(node);
+}
 
-		/* The node must be put back to the LRU list */
-		UT_LIST_ADD_FIRST(LRU, system->LRU, node);
+/********************************************************************//**
+Updates the data structures when an i/o operation posted by fil_io()
+finishes. Only a write needs the fil_sys mutex, to account for the
+unflushed modification; the pending count of a read is just decremented. */
+static
+void
+fil_node_complete_io_nolock(
+/*========================*/
+	fil_node_t*	node,	/*!< in: file node */
+	ulint		type)	/*!< in: OS_FILE_WRITE or OS_FILE_READ */
+{
+#ifdef FIL_IO_FAST_PATH
+	if (type != OS_FILE_WRITE) {
+		fil_node_pending_dec(node);
+
+		return;
 	}
+#endif /* FIL_IO_FAST_PATH */
+
+	mutex_enter(&fil_system->mutex);
+
+	fil_node_complete_io(node, fil_system, type);
+
+	mutex_exit(&fil_system->mutex);
 }
 
 /********************************************************************//**
@@ -5568,99 +6224,115 @@ fil_io(
 		srv_stats.data_written.add(len);
 	}
 
-	/* Reserve the fil_system mutex and make sure that we can open at
-	least one file while holding it, if the file is not already open */
+#ifdef FIL_IO_FAST_PATH
+	/* If the file is already open, post the i/o without the
+	fil_system mutex */
+	node = fil_node_prepare_for_io_fast(
+		space_id, type, sync, &block_offset);
+#else /* FIL_IO_FAST_PATH */
+	node = NULL;
+#endif /* FIL_IO_FAST_PATH */
 
-	fil_mutex_enter_and_prepare_for_io(space_id);
+	if (node == NULL) {
+		/* Reserve the fil_system mutex and make sure that we can
+		open at least one file while holding it, if the file is not
+		already open */
 
-	space = fil_space_get_by_id(space_id);
+		fil_mutex_enter_and_prepare_for_io(space_id);
 
-	/* If we are deleting a tablespace we don't allow async read operations
-	on that. However, we do allow write and sync read operations */
-	if (space == 0
-	    || (type == OS_FILE_READ && !sync && space->stop_new_ops)) {
-		mutex_exit(&fil_system->mutex);
+		space = fil_space_get_by_id(space_id);
 
-		ib_logf(IB_LOG_LEVEL_ERROR,
-			"Trying to do i/o to a tablespace which does "
-			"not exist. i/o type %lu, space id %lu, "
-			"page no. %lu, i/o length %lu bytes",
-			(ulong) type, (ulong) space_id, (ulong) block_offset,
-			(ulong) len);
+		/* If we are deleting a tablespace we don't allow async read
+		operations on that. However, we do allow write and sync read
+		operations */
+		if (space == 0
+		    || (type == OS_FILE_READ && !sync && space->stop_new_ops)) {
+			mutex_exit(&fil_system->mutex);
 
-		return(DB_TABLESPACE_DELETED);
-	}
+			ib_logf(IB_LOG_LEVEL_ERROR,
+				"Trying to do i/o to a tablespace which does "
+				"not exist. i/o type %lu, space id %lu, "
+				"page no. %lu, i/o length %lu bytes",
+				(ulong) type, (ulong) space_id,
+				(ulong) block_offset, (ulong) len);
 
-	ut_ad(mode != OS_AIO_IBUF || space->purpose == FIL_TABLESPACE);
+			return(DB_TABLESPACE_DELETED);
+		}
 
-	node = UT_LIST_GET_FIRST(space->chain);
+		node = UT_LIST_GET_FIRST(space->chain);
 
-	for (;;) {
-		if (node == NULL) {
-			if (ignore_nonexistent_pages) {
-				mutex_exit(&fil_system->mutex);
-				return(DB_ERROR);
-			}
+		for (;;) {
+			if (node == NULL) {
+				if (ignore_nonexistent_pages) {
+					mutex_exit(&fil_system->mutex);
+					return(DB_ERROR);
+				}
 
-			fil_report_invalid_page_access(
-				block_offset, space_id, space->name,
-				byte_offset, len, type);
+				fil_report_invalid_page_access(
+					block_offset, space_id, space->name,
+					byte_offset, len, type);
 
-			ut_error;
+				ut_error;
 
-		} else if (fil_is_user_tablespace_id(space->id)
-			   && node->size == 0) {
+			} else if (fil_is_user_tablespace_id(space->id)
+				   && node->size == 0) {
 
-			/* We do not know the size of a single-table tablespace
-			before we open the file */
-			break;
-		} else if (node->size > block_offset) {
-			/* Found! */
-			break;
-		} else {
-			block_offset -= node->size;
-			node = UT_LIST_GET_NEXT(chain, node);
+				/* We do not know the size of a single-table
+				tablespace before we open the file */
+				break;
+			} else if (node->size > block_offset) {
+				/* Found! */
+				break;
+			} else {
+				block_offset -= node->size;
+				node = UT_LIST_GET_NEXT(chain, node);
+			}
 		}
-	}
 
-	/* Open file if closed */
-	if (!fil_node_prepare_for_io(node, fil_system, space)) {
-		if (space->purpose == FIL_TABLESPACE
-		    && fil_is_user_tablespace_id(space->id)) {
-			mutex_exit(&fil_system->mutex);
+		/* Open file if closed */
+		if (!fil_node_prepare_for_io(node, fil_system, space)) {
+			if (space->purpose == FIL_TABLESPACE
+			    && fil_is_user_tablespace_id(space->id)) {
+				mutex_exit(&fil_system->mutex);
 
-			ib_logf(IB_LOG_LEVEL_ERROR,
-				"Trying to do i/o to a tablespace which "
-				"exists without .ibd data file. "
-				"i/o type %lu, space id %lu, page no %lu, "
-				"i/o length %lu bytes",
-				(ulong) type, (ulong) space_id,
-				(ulong) block_offset, (ulong) len);
+				ib_logf(IB_LOG_LEVEL_ERROR,
+					"Trying to do i/o to a tablespace"
+					" which exists without .ibd data"
+					" file. i/o type %lu, space id %lu,"
+					" page no %lu, i/o length %lu bytes",
+					(ulong) type, (ulong) space_id,
+					(ulong) block_offset, (ulong) len);
 
-			return(DB_TABLESPACE_DELETED);
+				return(DB_TABLESPACE_DELETED);
+			}
+
+			/* The tablespace is for log. Currently, we just
+			assert here to prevent handling errors along the way
+			fil_io returns. Also, if the log files are missing, it
+			would be hard to promise the server can continue
+			running. */
+			ut_a(0);
 		}
 
-		/* The tablespace is for log. Currently, we just assert here
-		to prevent handling errors along the way fil_io returns.
-		Also, if the log files are missing, it would be hard to
-		promise the server can continue running. */
-		ut_a(0);
-	}
+		/* Check that at least the start offset is within the bounds
+		of a single-table tablespace, including rollback
+		tablespaces. */
+		if (UNIV_UNLIKELY(node->size <= block_offset)
+		    && space->id != 0 && space->purpose == FIL_TABLESPACE) {
 
-	/* Check that at least the start offset is within the bounds of a
-	single-table tablespace, including rollback tablespaces. */
-	if (UNIV_UNLIKELY(node->size <= block_offset)
-	    && space->id != 0 && space->purpose == FIL_TABLESPACE) {
+			fil_report_invalid_page_access(
+				block_offset, space_id, space->name,
+				byte_offset, len, type);
 
-		fil_report_invalid_page_access(
-			block_offset, space_id, space->name, byte_offset,
-			len, type);
+			ut_error;
+		}
 
-		ut_error;
+		/* Now we have made the changes in the data structures of
+		fil_system */
+		mutex_exit(&fil_system->mutex);
 	}
 
-	/* Now we have made the changes in the data structures of fil_system */
-	mutex_exit(&fil_system->mutex);
+	ut_ad(mode != OS_AIO_IBUF || node->space->purpose == FIL_TABLESPACE);
 
 	/* Calculate the low 32 bits and the high 32 bits of the file offset */
 
@@ -5712,11 +6384,7 @@ fil_io(
 		/* The i/o operation is already completed when we return from
 		os_aio: */
 
-		mutex_enter(&fil_system->mutex);
-
-		fil_node_complete_io(node, fil_system, type);
-
-		mutex_exit(&fil_system->mutex);
+		fil_node_complete_io_nolock(node, type);
 
 		ut_ad(fil_validate_skip());
 	}
@@ -5725,6 +6393,79 @@ fil_io(
 }
 
 #ifndef UNIV_HOTBACKUP
+/********************************************************************//**
+Releases the unused tail of a page that was written with fewer than
+UNIV_PAGE_SIZE bytes by innodb_page_compression, once the write has
+completed. This is best effort: if the file is not open, or its file system
+does not support punching holes, the tail simply stays allocated. */
+UNIV_INTERN
+void
+fil_page_punch_hole(
+/*================*/
+	ulint	space_id,	/*!< in: space id */
+	ulint	page_no,	/*!< in: page number */
+	ulint	len)		/*!< in: number of bytes written at the
+				start of the page */
+{
+	fil_node_t*	node;
+	ulint		block_offset	= page_no;
+
+	ut_ad(len < UNIV_PAGE_SIZE);
+
+#ifdef FIL_IO_FAST_PATH
+	node = fil_node_prepare_for_io_fast(
+		space_id, OS_FILE_WRITE, true, &block_offset);
+#else /* FIL_IO_FAST_PATH */
+	fil_space_t*	space;
+
+	mutex_enter(&fil_system->mutex);
+
+	space = fil_space_get_by_id(space_id);
+
+	node = (space == NULL || space->stop_ios)
+		? NULL : UT_LIST_GET_FIRST(space->chain);
+
+	for (; node != NULL && node->size != 0 && node->size <= block_offset;
+	     node = UT_LIST_GET_NEXT(chain, node)) {
+
+		block_offset -= node->size;
+	}
+
+	if (node != NULL && node->open && node->size > block_offset) {
+		fil_node_pending_inc(node);
+	} else {
+		node = NULL;
+	}
+
+	mutex_exit(&fil_system->mutex);
+#endif /* FIL_IO_FAST_PATH */
+
+	if (node == NULL) {
+		return;
+	}
+
+	if (!node->no_punch_hole
+	    && !os_file_punch_hole(
+		    node->handle,
+		    ((os_offset_t) block_offset << UNIV_PAGE_SIZE_SHIFT) + len,
+		    UNIV_PAGE_SIZE - len)) {
+
+		/* Do not retry on a file system that does not
+		support it; the page writes stay compressed. */
+		node->no_punch_hole = TRUE;
+
+		MONITOR_INC(MONITOR_PAGE_HOLE_PUNCH_FAILED);
+	}
+
+#ifdef FIL_IO_FAST_PATH
+	fil_node_pending_dec(node);
+#else /* FIL_IO_FAST_PATH */
+	mutex_enter(&fil_system->mutex);
+	fil_node_pending_dec(node);
+	mutex_exit(&fil_system->mutex);
+#endif /* FIL_IO_FAST_PATH */
+}
+
 /**********************************************************************//**
 Waits for an aio operation to complete. This function is used to write the
 handler for completed requests. The aio array of pending requests is divided
@@ -5771,11 +6512,7 @@ fil_aio_wait(
 
 	srv_set_io_thread_op_info(segment, "complete io for fil node");
 
-	mutex_enter(&fil_system->mutex);
-
-	fil_node_complete_io(fil_node, fil_system, type);
-
-	mutex_exit(&fil_system->mutex);
+	fil_node_complete_io_nolock(fil_node, type);
 
 	ut_ad(fil_validate_skip());
 
@@ -6046,8 +6783,6 @@ fil_validate(void)
 	     fil_node != 0;
 	     fil_node = UT_LIST_GET_NEXT(LRU, fil_node)) {
 
-		ut_a(fil_node->n_pending == 0);
-		ut_a(!fil_node->being_extended);
 		ut_a(fil_node->open);
 		ut_a(fil_space_belongs_in_lru(fil_node->space));
 	}
@@ -6138,6 +6873,12 @@ fil_close(void)
 
 	hash_table_free(fil_system->name_hash);
 
+#ifdef FIL_IO_FAST_PATH
+	/* Like the buffer block latches, the hash latches are not
+	rw_lock_free()d: sync_close() has already been called. */
+	mem_free(fil_system->hash_latches);
+#endif /* FIL_IO_FAST_PATH */
+
 	ut_a(UT_LIST_GET_LEN(fil_system->LRU) == 0);
 	ut_a(UT_LIST_GET_LEN(fil_system->unflushed_spaces) == 0);
 	ut_a(UT_LIST_GET_LEN(fil_system->space_list) == 0);
@@ -6258,6 +6999,20 @@ fil_iterate(
 
 			dberr_t	err;
 
+			/* Pages written by innodb_page_compression are
+			decompressed here; if updated, they are written
+			back uncompressed. */
+			if (callback.get_zip_size() == 0
+			    && fil_page_is_compressed(block->frame)
+			    && !fil_page_decompress(block->frame)) {
+
+				ib_logf(IB_LOG_LEVEL_ERROR,
+					"Cannot decompress page %lu.",
+					(ulong) (page_no - 1));
+
+				return(DB_CORRUPTION);
+			}
+
 			if ((err = callback(page_off, block)) != DB_SUCCESS) {
 
 				return(err);
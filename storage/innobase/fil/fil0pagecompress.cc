@@ -0,0 +1,271 @@
+/*****************************************************************************
+
+Copyright (c) 2026, the contributors of this file. See the version control
+history for the individual authors.
+
+This file is a contribution to MySQL. It is distributed under the same
+license as the rest of the server, with no copyright assigned to Oracle.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file fil/fil0pagecompress.cc
+Compression of uncompressed pages on the write path (page compression with
+hole punching)
+
+Created 10/18/2026
+*******************************************************/
+
+#include "fil0pagecompress.h"
+
+#ifdef UNIV_NONINL
+#include "fil0pagecompress.ic"
+#endif
+
+#include "mem0mem.h"
+#include "page0zip.h"
+#include "srv0mon.h"
+#include "zlib.h"
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif /* HAVE_LZ4 */
+
+/** innodb_page_compression: a fil_page_compression_t */
+UNIV_INTERN ulong	fil_page_compression = FIL_PAGE_COMPRESSION_NONE;
+
+/** Size of the memory heap for deflate() over a page */
+#define FIL_PAGE_DEFLATE_HEAP_SIZE				\
+	(UNIV_PAGE_SIZE * 4 + (512 << MAX_MEM_LEVEL))
+
+/** Size of the memory heap for inflate() over a page, including the buffer
+for the decompressed data */
+#define FIL_PAGE_INFLATE_HEAP_SIZE (UNIV_PAGE_SIZE * 3)
+
+/********************************************************************//**
+Compresses the payload of a page with zlib.
+@return	length of the compressed data, or 0 if it does not fit in avail */
+static
+ulint
+fil_page_compress_zlib(
+/*===================*/
+	const byte*	src,	/*!< in: data to compress */
+	ulint		len,	/*!< in: length of src */
+	byte*		dst,	/*!< out: compressed data */
+	ulint		avail)	/*!< in: size of dst */
+{
+	z_stream	c_stream;
+	mem_heap_t*	heap;
+	int		err;
+	ulint		c_len	= 0;
+
+	heap = mem_heap_create(FIL_PAGE_DEFLATE_HEAP_SIZE);
+
+	page_zip_set_alloc(&c_stream, heap);
+
+	err = deflateInit2(&c_stream, static_cast<int>(page_zip_level),
+			   Z_DEFLATED, UNIV_PAGE_SIZE_SHIFT,
+			   MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+	ut_a(err == Z_OK);
+
+	c_stream.next_in = const_cast<byte*>(src);
+	c_stream.avail_in = static_cast<uInt>(len);
+	c_stream.next_out = dst;
+	c_stream.avail_out = static_cast<uInt>(avail);
+
+	if (deflate(&c_stream, Z_FINISH) == Z_STREAM_END) {
+		c_len = c_stream.total_out;
+	}
+
+	deflateEnd(&c_stream);
+	mem_heap_free(heap);
+
+	return(c_len);
+}
+
+/********************************************************************//**
+Decompresses the payload of a page with zlib.
+@return	true if exactly len bytes were decompressed */
+static
+bool
+fil_page_decompress_zlib(
+/*=====================*/
+	const byte*	src,	/*!< in: compressed data */
+	ulint		c_len,	/*!< in: length of src */
+	byte*		dst,	/*!< out: decompressed data */
+	ulint		len,	/*!< in: expected length of the data */
+	mem_heap_t*	heap)	/*!< in: memory heap for zlib */
+{
+	z_stream	d_stream;
+	bool		ok;
+
+	page_zip_set_alloc(&d_stream, heap);
+
+	d_stream.next_in = const_cast<byte*>(src);
+	d_stream.avail_in = static_cast<uInt>(c_len);
+	d_stream.next_out = dst;
+	d_stream.avail_out = static_cast<uInt>(len);
+
+	if (inflateInit2(&d_stream, UNIV_PAGE_SIZE_SHIFT) != Z_OK) {
+		return(false);
+	}
+
+	ok = inflate(&d_stream, Z_FINISH) == Z_STREAM_END
+		&& d_stream.total_out == len;
+
+	inflateEnd(&d_stream);
+
+	return(ok);
+}
+
+/********************************************************************//**
+Compresses an uncompressed page for writing. The page checksum must
+already have been computed.
+@return	number of bytes to write from out, a multiple of
+FIL_PAGE_COMPRESS_BLOCK_SIZE, or 0 if the page should be written
+uncompressed because it would not save a block */
+UNIV_INTERN
+ulint
+fil_page_compress(
+/*==============*/
+	const byte*	page,		/*!< in: uncompressed page */
+	byte*		out,		/*!< out: compressed page image,
+					UNIV_PAGE_SIZE bytes */
+	ulint		algorithm)	/*!< in: fil_page_compression_t */
+{
+	const ulint	len	= UNIV_PAGE_SIZE - FIL_PAGE_DATA;
+	/* Unless the data fits in one block less than the page, there
+	would be nothing to release. */
+	const ulint	avail	= UNIV_PAGE_SIZE - FIL_PAGE_COMPRESS_BLOCK_SIZE
+		- FIL_PAGE_DATA;
+	ulint		c_len;
+	ulint		write_len;
+
+	if (UNIV_PAGE_SIZE <= FIL_PAGE_COMPRESS_BLOCK_SIZE) {
+		return(0);
+	}
+
+	switch (algorithm) {
+	case FIL_PAGE_COMPRESSION_ZLIB:
+		c_len = fil_page_compress_zlib(
+			page + FIL_PAGE_DATA, len, out + FIL_PAGE_DATA, avail);
+		break;
+#ifdef HAVE_LZ4
+	case FIL_PAGE_COMPRESSION_LZ4:
+		c_len = LZ4_compress_default(
+			reinterpret_cast<const char*>(page + FIL_PAGE_DATA),
+			reinterpret_cast<char*>(out + FIL_PAGE_DATA),
+			static_cast<int>(len), static_cast<int>(avail));
+		break;
+#endif /* HAVE_LZ4 */
+	default:
+		return(0);
+	}
+
+	if (c_len == 0) {
+		return(0);
+	}
+
+	write_len = ut_calc_align(FIL_PAGE_DATA + c_len,
+				  FIL_PAGE_COMPRESS_BLOCK_SIZE);
+
+	ut_ad(write_len < UNIV_PAGE_SIZE);
+
+	memcpy(out, page, FIL_PAGE_DATA);
+
+	mach_write_to_2(out + FIL_PAGE_TYPE, FIL_PAGE_COMPRESSED);
+	memset(out + FIL_PAGE_FILE_FLUSH_LSN, 0, 8);
+	mach_write_to_1(out + FIL_PAGE_COMP_VERSION, FIL_PAGE_COMP_VERSION_1);
+	mach_write_to_1(out + FIL_PAGE_COMP_ALGORITHM, algorithm);
+	mach_write_to_2(out + FIL_PAGE_COMP_ORIG_TYPE,
+			mach_read_from_2(page + FIL_PAGE_TYPE));
+	mach_write_to_2(out + FIL_PAGE_COMP_SIZE, c_len);
+
+	/* Do not write garbage after the compressed data. */
+	memset(out + FIL_PAGE_DATA + c_len, 0,
+	       write_len - FIL_PAGE_DATA - c_len);
+
+	MONITOR_INC(MONITOR_PAGE_HOLE_COMPRESS);
+	MONITOR_INC_VALUE(MONITOR_PAGE_HOLE_SAVED,
+			  UNIV_PAGE_SIZE - write_len);
+
+	return(write_len);
+}
+
+/********************************************************************//**
+Decompresses a page image that was written by fil_page_compress(), in
+place.
+@return	true if success, false if the image is corrupted or was written
+with an algorithm that this server does not support */
+UNIV_INTERN
+bool
+fil_page_decompress(
+/*================*/
+	byte*		page)		/*!< in/out: FIL_PAGE_COMPRESSED image;
+					out: uncompressed page */
+{
+	const ulint	len	= UNIV_PAGE_SIZE - FIL_PAGE_DATA;
+	ulint		c_len;
+	mem_heap_t*	heap;
+	byte*		buf;
+	bool		ok;
+
+	ut_ad(fil_page_is_compressed(page));
+
+	c_len = mach_read_from_2(page + FIL_PAGE_COMP_SIZE);
+
+	if (mach_read_from_1(page + FIL_PAGE_COMP_VERSION)
+	    != FIL_PAGE_COMP_VERSION_1
+	    || c_len == 0 || c_len > len) {
+
+		return(false);
+	}
+
+	heap = mem_heap_create(FIL_PAGE_INFLATE_HEAP_SIZE);
+
+	buf = static_cast<byte*>(mem_heap_alloc(heap, len));
+
+	switch (mach_read_from_1(page + FIL_PAGE_COMP_ALGORITHM)) {
+	case FIL_PAGE_COMPRESSION_ZLIB:
+		ok = fil_page_decompress_zlib(
+			page + FIL_PAGE_DATA, c_len, buf, len, heap);
+		break;
+#ifdef HAVE_LZ4
+	case FIL_PAGE_COMPRESSION_LZ4:
+		ok = LZ4_decompress_safe(
+			reinterpret_cast<const char*>(page + FIL_PAGE_DATA),
+			reinterpret_cast<char*>(buf),
+			static_cast<int>(c_len), static_cast<int>(len))
+			== static_cast<int>(len);
+		break;
+#endif /* HAVE_LZ4 */
+	default:
+		ok = false;
+	}
+
+	if (ok) {
+		memcpy(page + FIL_PAGE_DATA, buf, len);
+
+		mach_write_to_2(page + FIL_PAGE_TYPE,
+				mach_read_from_2(page + FIL_PAGE_COMP_ORIG_TYPE));
+		memset(page + FIL_PAGE_FILE_FLUSH_LSN, 0, 8);
+
+		MONITOR_INC(MONITOR_PAGE_HOLE_DECOMPRESS);
+	}
+
+	mem_heap_free(heap);
+
+	return(ok);
+}
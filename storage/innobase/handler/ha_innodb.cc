@@ -65,13 +65,16 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "row0sel.h"
 #include "row0upd.h"
 #include "log0log.h"
+#include "log0recv.h"
 #include "lock0lock.h"
 #include "dict0crea.h"
 #include "btr0cur.h"
 #include "btr0btr.h"
+#include "btr0bulk.h"
 #include "fsp0fsp.h"
 #include "sync0sync.h"
 #include "fil0fil.h"
+#include "fil0pagecompress.h"
 #include "trx0xa.h"
 #include "row0merge.h"
 #include "dict0boot.h"
@@ -235,6 +238,55 @@ static TYPELIB innodb_checksum_algorithm_typelib = {
 	NULL
 };
 
+/** Possible values for system variable "innodb_adaptive_flushing_method". */
+static const char* innodb_adaptive_flushing_method_names[] = {
+	"heuristic",
+	"pid",
+	NullS
+};
+
+/** Used to define an enumerate type of the system variable
+innodb_adaptive_flushing_method. */
+static TYPELIB innodb_adaptive_flushing_method_typelib = {
+	array_elements(innodb_adaptive_flushing_method_names) - 1,
+	"innodb_adaptive_flushing_method_typelib",
+	innodb_adaptive_flushing_method_names,
+	NULL
+};
+
+/** Possible values for system variable "innodb_lru_policy". */
+static const char* innodb_lru_policy_names[] = {
+	"midpoint",
+	"adaptive",
+	NullS
+};
+
+/** Used to define an enumerate type of the system variable
+innodb_lru_policy. */
+static TYPELIB innodb_lru_policy_typelib = {
+	array_elements(innodb_lru_policy_names) - 1,
+	"innodb_lru_policy_typelib",
+	innodb_lru_policy_names,
+	NULL
+};
+
+/** Possible values for system variable "innodb_page_compression". */
+static const char* innodb_page_compression_names[] = {
+	"none",
+	"zlib",
+	"lz4",
+	NullS
+};
+
+/** Used to define an enumerate type of the system variable
+innodb_page_compression. */
+static TYPELIB innodb_page_compression_typelib = {
+	array_elements(innodb_page_compression_names) - 1,
+	"innodb_page_compression_typelib",
+	innodb_page_compression_names,
+	NULL
+};
+
 /* The following counter is used to convey information to InnoDB
 about server activity: in case of normal DML ops it is not
 sensible to call srv_active_wake_master_thread after each
@@ -295,20 +347,24 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 #  endif /* !PFS_SKIP_BUFFER_MUTEX_RWLOCK */
 	{&buf_pool_mutex_key, "buf_pool_mutex", 0},
 	{&buf_pool_zip_mutex_key, "buf_pool_zip_mutex", 0},
+	{&buf_LRU_young_batch_mutex_key, "buf_LRU_young_batch_mutex", 0},
 	{&cache_last_read_mutex_key, "cache_last_read_mutex", 0},
 	{&dict_foreign_err_mutex_key, "dict_foreign_err_mutex", 0},
 	{&dict_sys_mutex_key, "dict_sys_mutex", 0},
 	{&file_format_max_mutex_key, "file_format_max_mutex", 0},
 	{&fil_system_mutex_key, "fil_system_mutex", 0},
 	{&flush_list_mutex_key, "flush_list_mutex", 0},
+	{&free_list_mutex_key, "free_list_mutex", 0},
 	{&fts_bg_threads_mutex_key, "fts_bg_threads_mutex", 0},
 	{&fts_delete_mutex_key, "fts_delete_mutex", 0},
 	{&fts_optimize_mutex_key, "fts_optimize_mutex", 0},
 	{&fts_doc_id_mutex_key, "fts_doc_id_mutex", 0},
 	{&fts_pll_tokenize_mutex_key, "fts_pll_tokenize_mutex", 0},
 	{&log_flush_order_mutex_key, "log_flush_order_mutex", 0},
+	{&log_writer_mutex_key, "log_writer_mutex", 0},
 	{&hash_table_mutex_key, "hash_table_mutex", 0},
 	{&ibuf_bitmap_mutex_key, "ibuf_bitmap_mutex", 0},
+	{&ibuf_backlog_mutex_key, "ibuf_backlog_mutex", 0},
 	{&ibuf_mutex_key, "ibuf_mutex", 0},
 	{&ibuf_pessimistic_insert_mutex_key,
 		 "ibuf_pessimistic_insert_mutex", 0},
@@ -341,7 +397,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	{&buf_dblwr_mutex_key, "buf_dblwr_mutex", 0},
 	{&trx_undo_mutex_key, "trx_undo_mutex", 0},
 	{&srv_sys_mutex_key, "srv_sys_mutex", 0},
-	{&lock_sys_mutex_key, "lock_mutex", 0},
+	{&lock_rec_hash_mutex_key, "lock_rec_hash_mutex", 0},
 	{&lock_sys_wait_mutex_key, "lock_wait_mutex", 0},
 	{&trx_mutex_key, "trx_mutex", 0},
 	{&srv_sys_tasks_mutex_key, "srv_threads_mutex", 0},
@@ -378,10 +434,13 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	{&buf_block_debug_latch_key, "buf_block_debug_latch", 0},
 #  endif /* UNIV_SYNC_DEBUG */
 	{&dict_operation_lock_key, "dict_operation_lock", 0},
+	{&dict_table_hash_latch_key, "dict_table_hash_latch", 0},
 	{&fil_space_latch_key, "fil_space_latch", 0},
+	{&fil_space_hash_latch_key, "fil_space_hash_latch", 0},
 	{&checkpoint_lock_key, "checkpoint_lock", 0},
 	{&fts_cache_rw_lock_key, "fts_cache_rw_lock", 0},
 	{&fts_cache_init_rw_lock_key, "fts_cache_init_rw_lock", 0},
+	{&lock_sys_latch_key, "lock_sys_latch", 0},
 	{&trx_i_s_cache_lock_key, "trx_i_s_cache_lock", 0},
 	{&trx_purge_latch_key, "trx_purge_latch", 0},
 	{&index_tree_rw_lock_key, "index_tree_rw_lock", 0},
@@ -404,7 +463,13 @@ static PSI_thread_info	all_innodb_threads[] = {
 	{&srv_master_thread_key, "srv_master_thread", 0},
 	{&srv_purge_thread_key, "srv_purge_thread", 0},
 	{&buf_page_cleaner_thread_key, "page_cleaner_thread", 0},
-	{&recv_writer_thread_key, "recv_writer_thread", 0}
+	{&buf_page_cleaner_worker_thread_key, "page_cleaner_worker_thread", 0},
+	{&recv_writer_thread_key, "recv_writer_thread", 0},
+	{&recv_apply_thread_key, "recv_apply_thread", 0},
+	{&recv_scan_read_thread_key, "recv_scan_read_thread", 0},
+	{&fil_load_thread_key, "fil_load_thread", 0},
+	{&log_writer_thread_key, "log_writer_thread", 0},
+	{&log_flusher_thread_key, "log_flusher_thread", 0}
 };
 # endif /* UNIV_PFS_THREAD */
 
@@ -635,6 +700,10 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_pages_read,		  SHOW_LONG},
   {"pages_written",
   (char*) &export_vars.innodb_pages_written,		  SHOW_LONG},
+  {"recovery_apply_time",
+  (char*) &export_vars.innodb_recovery_apply_time,	  SHOW_LONG},
+  {"recovery_pages_applied",
+  (char*) &export_vars.innodb_recovery_pages_applied,	  SHOW_LONG},
   {"row_lock_current_waits",
   (char*) &export_vars.innodb_row_lock_current_waits,	  SHOW_LONG},
   {"row_lock_time",
@@ -4720,7 +4789,7 @@ ha_innobase::open(
 	thd = ha_thd();
 
 	/* Under some cases MySQL seems to call this function while
-	holding btr_search_latch. This breaks the latching order as
+	holding an adaptive hash index latch. This breaks the latching order as
 	we acquire dict_sys->mutex below and leads to a deadlock. */
 	if (thd != NULL) {
 		innobase_release_temporary_latches(ht, thd);
@@ -14412,6 +14481,60 @@ innodb_old_blocks_pct_update(
 			*static_cast<const uint*>(save), TRUE));
 }
 
+/****************************************************************//**
+Update the system variable innodb_lru_policy using the "saved"
+value. This function is registered as a callback with MySQL. */
+static
+void
+innodb_lru_policy_update(
+/*=====================*/
+	THD*				thd,	/*!< in: thread handle */
+	struct st_mysql_sys_var*	var,	/*!< in: pointer to
+						system variable */
+	void*				var_ptr,/*!< out: where the
+						formal string goes */
+	const void*			save)	/*!< in: immediate result
+						from check function */
+{
+	buf_LRU_policy = *static_cast<const ulong*>(save);
+
+	if (buf_LRU_policy == BUF_LRU_POLICY_MIDPOINT) {
+		/* Restore the configured length of the old sublist. */
+		buf_LRU_old_ratio_update(innobase_old_blocks_pct, TRUE);
+	}
+}
+
+/****************************************************************//**
+Update the system variable innodb_page_compression using the "saved"
+value. This function is registered as a callback with MySQL. */
+static
+void
+innodb_page_compression_update(
+/*===========================*/
+	THD*				thd,	/*!< in: thread handle */
+	struct st_mysql_sys_var*	var,	/*!< in: pointer to
+						system variable */
+	void*				var_ptr,/*!< out: where the
+						formal string goes */
+	const void*			save)	/*!< in: immediate result
+						from check function */
+{
+	ulong	algorithm = *static_cast<const ulong*>(save);
+
+#ifndef HAVE_LZ4
+	if (algorithm == FIL_PAGE_COMPRESSION_LZ4) {
+		push_warning_printf(thd, Sql_condition::WARN_LEVEL_WARN,
+				    ER_WRONG_ARGUMENTS,
+				    "InnoDB: innodb_page_compression=lz4"
+				    " is not supported by this build,"
+				    " using zlib instead.");
+		algorithm = FIL_PAGE_COMPRESSION_ZLIB;
+	}
+#endif /* !HAVE_LZ4 */
+
+	fil_page_compression = algorithm;
+}
+
 /****************************************************************//**
 Update the system variable innodb_old_blocks_pct using the "saved"
 value. This function is registered as a callback with MySQL. */
@@ -15917,6 +16040,33 @@ static MYSQL_SYSVAR_ULONG(flushing_avg_loops,
   "Number of iterations over which the background flushing is averaged.",
   NULL, NULL, 30, 1, 1000, 0);
 
+static MYSQL_SYSVAR_ENUM(adaptive_flushing_method,
+  srv_adaptive_flushing_method,
+  PLUGIN_VAR_RQCMDARG,
+  "The controller deciding the background flushing rate. Possible values"
+  " are HEURISTIC (blend the dirty page and redo space heuristics,"
+  " averaged over innodb_flushing_avg_loops) and PID (drive the checkpoint"
+  " age towards innodb_adaptive_flushing_target_pct with a PID controller"
+  " fed forward with the redo generation rate).",
+  NULL, NULL, SRV_FLUSH_CONTROLLER_HEURISTIC,
+  &innodb_adaptive_flushing_method_typelib);
+
+static MYSQL_SYSVAR_ULONG(adaptive_flushing_target_pct,
+  srv_adaptive_flushing_target_pct,
+  PLUGIN_VAR_RQCMDARG,
+  "Percentage of log capacity the PID flushing controller keeps the"
+  " checkpoint age at.",
+  NULL, NULL, 50, 5, 75, 0);
+
+static MYSQL_SYSVAR_ULONG(page_cleaners, srv_n_page_cleaners,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Page cleaner threads can be from 1 to 64, and are capped at the"
+  " number of buffer pool instances. Default is 1.",
+  NULL, NULL,
+  1,			/* Default setting */
+  1,			/* Minimum value */
+  64, 0);		/* Maximum value */
+
 static MYSQL_SYSVAR_ULONG(max_purge_lag, srv_max_purge_lag,
   PLUGIN_VAR_RQCMDARG,
   "Desired maximum length of the purge queue (0 = no limit)",
@@ -15985,6 +16135,13 @@ static MYSQL_SYSVAR_BOOL(adaptive_hash_index, btr_search_enabled,
   "Disable with --skip-innodb-adaptive-hash-index.",
   NULL, innodb_adaptive_hash_index_update, TRUE);
 
+static MYSQL_SYSVAR_ULONG(adaptive_hash_index_parts, btr_ahi_parts,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Number of InnoDB adaptive hash index partitions, each with its own "
+  "latch. The pages of an index are always hashed in the same partition "
+  "(default 8).",
+  NULL, NULL, 8, 1, BTR_AHI_PARTS_MAX, 0);
+
 static MYSQL_SYSVAR_ULONG(replication_delay, srv_replication_delay,
   PLUGIN_VAR_RQCMDARG,
   "Replication thread delay (ms) on the slave server if "
@@ -15997,6 +16154,16 @@ static MYSQL_SYSVAR_UINT(compression_level, page_zip_level,
   ", 1 is fastest, 9 is best compression and default is 6.",
   NULL, NULL, DEFAULT_COMPRESSION_LEVEL, 0, 9, 0);
 
+static MYSQL_SYSVAR_ENUM(page_compression, fil_page_compression,
+  PLUGIN_VAR_RQCMDARG,
+  "Compress the B-tree pages of file-per-table tablespaces that are not"
+  " ROW_FORMAT=COMPRESSED when they are written, and release the unused"
+  " part of each page in the file by punching a hole. Possible values are"
+  " NONE, ZLIB (at innodb_compression_level) and LZ4 (if supported by this"
+  " build). The buffer pool only holds uncompressed pages.",
+  NULL, innodb_page_compression_update, FIL_PAGE_COMPRESSION_NONE,
+  &innodb_page_compression_typelib);
+
 static MYSQL_SYSVAR_BOOL(log_compressed_pages, page_zip_log_pages,
        PLUGIN_VAR_OPCMDARG,
   "Enables/disables the logging of entire compressed page images."
@@ -16079,6 +16246,18 @@ static MYSQL_SYSVAR_BOOL(buffer_pool_load_at_startup, srv_buffer_pool_load_at_st
   "Load the buffer pool from a file named @@innodb_buffer_pool_filename",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_load_threads, srv_buf_load_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads reading pages during a buffer pool load",
+  NULL, NULL, 4, 1, 64, 0);
+
+static MYSQL_SYSVAR_ULONG(buffer_pool_load_io_capacity,
+  srv_buf_load_io_capacity,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of pages per second read by a buffer pool load."
+  " 0 means unlimited.",
+  NULL, NULL, 0, 0, SRV_MAX_IO_CAPACITY_LIMIT, 0);
+
 static MYSQL_SYSVAR_ULONG(lru_scan_depth, srv_LRU_scan_depth,
   PLUGIN_VAR_RQCMDARG,
   "How deep to scan LRU to keep it clean",
@@ -16164,6 +16343,18 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(index_build_threads, srv_index_build_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that scan the clustered index and merge sort the"
+  " entries when creating secondary indexes",
+  NULL, NULL, 4, 1, 64, 0);
+
+static MYSQL_SYSVAR_ULONG(fill_factor, btr_bulk_fill_factor,
+  PLUGIN_VAR_RQCMDARG,
+  "Percentage of each B-tree page that is filled when a secondary index"
+  " is built by sorting",
+  NULL, NULL, 100, 10, 100, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -16217,6 +16408,38 @@ static MYSQL_SYSVAR_ULONG(log_files_in_group, srv_n_log_files,
   "Number of log files in the log group. InnoDB writes to the files in a circular fashion.",
   NULL, NULL, 2, 2, SRV_N_LOG_FILES_MAX, 0);
 
+static MYSQL_SYSVAR_BOOL(log_writer_threads, srv_log_writer_threads,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Write and flush the redo log in dedicated log writer and log flusher"
+  " threads instead of in the committing threads.",
+  NULL, NULL, TRUE);
+
+static MYSQL_SYSVAR_ULONG(log_wait_spin_rounds, srv_log_wait_spin_rounds,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of spin rounds a thread waiting for the log writer threads does"
+  " before it sleeps. Higher values use more CPU for lower commit latency.",
+  NULL, NULL, 30, 0, 100000, 0);
+
+static MYSQL_SYSVAR_ULONG(recovery_apply_threads, srv_recovery_apply_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads that read in pages and apply redo log records to them"
+  " during crash recovery.",
+  NULL, NULL, 4, 1, RECV_APPLY_THREADS_MAX, 0);
+
+static MYSQL_SYSVAR_ULONG(tablespace_discovery_threads,
+  srv_tablespace_discovery_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads that open and validate the .ibd files found in the"
+  " data directory when crash recovery is needed.",
+  NULL, NULL, 4, 1, FIL_LOAD_THREADS_MAX, 0);
+
+static MYSQL_SYSVAR_BOOL(lazy_tablespace_open, srv_lazy_tablespace_open,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "At a normal startup, register the tablespaces of the data dictionary"
+  " without opening their .ibd files. A missing file is then reported when"
+  " its table is first opened instead of at startup.",
+  NULL, NULL, FALSE);
+
 /* Note that the default and minimum values are set to 0 to
 detect if the option is passed and print deprecation message */
 static MYSQL_SYSVAR_LONG(mirrored_log_groups, innobase_mirrored_log_groups,
@@ -16236,6 +16459,16 @@ static MYSQL_SYSVAR_UINT(old_blocks_time, buf_LRU_old_threshold_ms,
   " The timeout is disabled if 0.",
   NULL, NULL, 1000, 0, UINT_MAX32, 0);
 
+static MYSQL_SYSVAR_ENUM(lru_policy, buf_LRU_policy,
+  PLUGIN_VAR_RQCMDARG,
+  "The buffer pool LRU replacement policy. Possible values are MIDPOINT"
+  " (insert read pages at innodb_old_blocks_pct from the end of the LRU"
+  " list) and ADAPTIVE (remember recently evicted pages, insert them at"
+  " the start of the LRU list when they are read again, and adapt the"
+  " length of the old sublist to these hits).",
+  NULL, innodb_lru_policy_update, BUF_LRU_POLICY_MIDPOINT,
+  &innodb_lru_policy_typelib);
+
 static MYSQL_SYSVAR_LONG(open_files, innobase_open_files,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "How many files at the maximum InnoDB keeps open at the same time.",
@@ -16339,6 +16572,18 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
   "Use native AIO if supported on this platform.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(use_io_uring, srv_use_io_uring,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Use io_uring instead of libaio for Linux native AIO, if supported by "
+  "the kernel. Falls back to libaio otherwise.",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_BOOL(io_uring_sqpoll, srv_io_uring_sqpoll,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Let a kernel thread poll the io_uring submission queues, so that "
+  "submitting I/O needs no system call.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_BOOL(api_enable_binlog, ib_binlog_enabled,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Enable binlog for applications direct access InnoDB through InnoDB APIs",
@@ -16410,6 +16655,13 @@ static MYSQL_SYSVAR_BOOL(random_read_ahead, srv_random_read_ahead,
   "Whether to use read ahead for random access within an extent.",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_BOOL(page_search_keys, page_cur_search_keys,
+  PLUGIN_VAR_NOCMDARG,
+  "Whether to cache the key prefixes of the page directory of each index"
+  " page with a short integer or binary first key column, for a faster"
+  " binary search within the page.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(read_ahead_threshold, srv_read_ahead_threshold,
   PLUGIN_VAR_RQCMDARG,
   "Number of pages that must be accessed sequentially for InnoDB to "
@@ -16523,6 +16775,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_load_now),
   MYSQL_SYSVAR(buffer_pool_load_abort),
   MYSQL_SYSVAR(buffer_pool_load_at_startup),
+  MYSQL_SYSVAR(buffer_pool_load_threads),
+  MYSQL_SYSVAR(buffer_pool_load_io_capacity),
   MYSQL_SYSVAR(lru_scan_depth),
   MYSQL_SYSVAR(flush_neighbors),
   MYSQL_SYSVAR(checksum_algorithm),
@@ -16530,6 +16784,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(commit_concurrency),
   MYSQL_SYSVAR(concurrency_tickets),
   MYSQL_SYSVAR(compression_level),
+  MYSQL_SYSVAR(page_compression),
   MYSQL_SYSVAR(data_file_path),
   MYSQL_SYSVAR(data_home_dir),
 #if SSD_CACHE_FACE
@@ -16577,6 +16832,11 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(log_buffer_size),
   MYSQL_SYSVAR(log_file_size),
   MYSQL_SYSVAR(log_files_in_group),
+  MYSQL_SYSVAR(log_writer_threads),
+  MYSQL_SYSVAR(log_wait_spin_rounds),
+  MYSQL_SYSVAR(recovery_apply_threads),
+  MYSQL_SYSVAR(tablespace_discovery_threads),
+  MYSQL_SYSVAR(lazy_tablespace_open),
   MYSQL_SYSVAR(log_group_home_dir),
   MYSQL_SYSVAR(log_compressed_pages),
   MYSQL_SYSVAR(max_dirty_pages_pct),
@@ -16584,11 +16844,15 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(adaptive_flushing_lwm),
   MYSQL_SYSVAR(adaptive_flushing),
   MYSQL_SYSVAR(flushing_avg_loops),
+  MYSQL_SYSVAR(adaptive_flushing_method),
+  MYSQL_SYSVAR(adaptive_flushing_target_pct),
+  MYSQL_SYSVAR(page_cleaners),
   MYSQL_SYSVAR(max_purge_lag),
   MYSQL_SYSVAR(max_purge_lag_delay),
   MYSQL_SYSVAR(mirrored_log_groups),
   MYSQL_SYSVAR(old_blocks_pct),
   MYSQL_SYSVAR(old_blocks_time),
+  MYSQL_SYSVAR(lru_policy),
   MYSQL_SYSVAR(open_files),
   MYSQL_SYSVAR(optimize_fulltext_only),
   MYSQL_SYSVAR(rollback_on_timeout),
@@ -16604,12 +16868,15 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_persistent_sample_pages),
   MYSQL_SYSVAR(stats_auto_recalc),
   MYSQL_SYSVAR(adaptive_hash_index),
+  MYSQL_SYSVAR(adaptive_hash_index_parts),
   MYSQL_SYSVAR(stats_method),
   MYSQL_SYSVAR(replication_delay),
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(support_xa),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(index_build_threads),
+  MYSQL_SYSVAR(fill_factor),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -16623,6 +16890,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(version),
   MYSQL_SYSVAR(use_sys_malloc),
   MYSQL_SYSVAR(use_native_aio),
+  MYSQL_SYSVAR(use_io_uring),
+  MYSQL_SYSVAR(io_uring_sqpoll),
   MYSQL_SYSVAR(change_buffering),
   MYSQL_SYSVAR(change_buffer_max_size),
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
@@ -16630,6 +16899,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(disable_background_merge),
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
   MYSQL_SYSVAR(random_read_ahead),
+  MYSQL_SYSVAR(page_search_keys),
   MYSQL_SYSVAR(read_ahead_threshold),
   MYSQL_SYSVAR(read_only),
   MYSQL_SYSVAR(io_capacity),
@@ -5489,6 +5489,8 @@ ha_innobase::commit_inplace_alter_table(
 	or lock waits can happen in it during the data dictionary operation. */
 	row_mysql_lock_data_dictionary(trx);
 
+	DEBUG_SYNC(user_thd, "innodb_alter_commit_after_lock_dict");
+
 	/* Prevent the background statistics collection from accessing
 	the tables. */
 	for (;;) {
@@ -62,6 +62,7 @@ UNIV_INTERN my_bool	srv_ibuf_disable_background_merge;
 #include "srv0start.h" /* srv_shutdown_state */
 #include "ha_prototypes.h"
 #include "rem0cmp.h"
+#include "srv0mon.h"
 
 /*	STRUCTURE OF AN INSERT BUFFER RECORD
 
@@ -207,6 +208,7 @@ UNIV_INTERN ibuf_t*	ibuf			= NULL;
 UNIV_INTERN mysql_pfs_key_t	ibuf_pessimistic_insert_mutex_key;
 UNIV_INTERN mysql_pfs_key_t	ibuf_mutex_key;
 UNIV_INTERN mysql_pfs_key_t	ibuf_bitmap_mutex_key;
+UNIV_INTERN mysql_pfs_key_t	ibuf_backlog_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
 
 #ifdef UNIV_IBUF_COUNT_DEBUG
@@ -298,6 +300,41 @@ static ib_mutex_t	ibuf_mutex;
 /** The mutex protecting the insert buffer bitmaps */
 static ib_mutex_t	ibuf_bitmap_mutex;
 
+/** Change buffer backlog of an index, counted since the server was
+started. The objects are not freed before ibuf_close(), so that
+dict_index_t::ibuf_backlog stays valid without any latch. */
+struct ibuf_backlog_t {
+	index_id_t	index_id;	/*!< index id, protected by
+					ibuf_backlog_mutex */
+	ulint		space;		/*!< tablespace of the index,
+					protected by ibuf_backlog_mutex */
+	ulint		n_buffered;	/*!< number of buffered operations;
+					incremented with an atomic operation
+					where available */
+	ulint		n_merged;	/*!< number of buffered operations
+					that were merged or discarded,
+					protected by ibuf_backlog_mutex */
+	ibuf_backlog_t*	hash;		/*!< hash chain node, or the next
+					object in ibuf_backlog_free */
+};
+
+/** ibuf_backlog_t of the indexes, hashed by index id */
+static hash_table_t*	ibuf_backlog_hash;
+
+/** ibuf_backlog_t of dropped indexes, for reuse */
+static ibuf_backlog_t*	ibuf_backlog_free;
+
+/** The mutex protecting ibuf_backlog_hash and ibuf_backlog_free. It is not
+acquired when an operation is buffered for an index whose
+dict_index_t::ibuf_backlog is set. */
+static os_fast_mutex_t	ibuf_backlog_mutex;
+
+/** Number of cells in ibuf_backlog_hash */
+#define IBUF_BACKLOG_HASH_SIZE		256
+
+/** At most this many indexes are listed by ibuf_print() */
+#define IBUF_BACKLOG_PRINT_MAX		32
+
 /** The area in pages from which contract looks for page numbers for merge */
 #define	IBUF_MERGE_AREA			8UL
 
@@ -310,6 +347,15 @@ page are merged along with the page whose buffer became full */
 batch, in order to merge the entries for them in the insert buffer */
 #define	IBUF_MAX_N_PAGES_MERGED		IBUF_MERGE_AREA
 
+/** The background merge samples the merge areas at up to this many random
+positions of the ibuf tree, and reads the pages of the fullest ones in one
+batch */
+#define IBUF_MERGE_N_SAMPLES		4
+
+/** A sampled merge area is skipped if its buffered volume is less than 1/this
+of the volume of the fullest sampled area */
+#define IBUF_MERGE_SKIP_RATIO		4
+
 /** If the combined size of the ibuf trees exceeds ibuf->max_size by this
 many pages, we start to contract it in connection to inserts there, using
 non-synchronous contract */
@@ -473,6 +519,30 @@ ibuf_close(void)
 	mutex_free(&ibuf_bitmap_mutex);
 	memset(&ibuf_bitmap_mutex, 0x0, sizeof(ibuf_mutex));
 
+	for (ulint i = 0; i < hash_get_n_cells(ibuf_backlog_hash); i++) {
+		ibuf_backlog_t*	backlog = static_cast<ibuf_backlog_t*>(
+			HASH_GET_FIRST(ibuf_backlog_hash, i));
+
+		while (backlog) {
+			ibuf_backlog_t*	next = backlog->hash;
+
+			ut_free(backlog);
+			backlog = next;
+		}
+	}
+
+	hash_table_free(ibuf_backlog_hash);
+	ibuf_backlog_hash = NULL;
+
+	while (ibuf_backlog_free != NULL) {
+		ibuf_backlog_t*	next = ibuf_backlog_free->hash;
+
+		ut_free(ibuf_backlog_free);
+		ibuf_backlog_free = next;
+	}
+
+	os_fast_mutex_free(&ibuf_backlog_mutex);
+
 	mem_free(ibuf);
 	ibuf = NULL;
 }
@@ -535,6 +605,9 @@ ibuf_init_at_db_start(void)
 	mutex_create(ibuf_bitmap_mutex_key,
 		     &ibuf_bitmap_mutex, SYNC_IBUF_BITMAP_MUTEX);
 
+	ibuf_backlog_hash = hash_create(IBUF_BACKLOG_HASH_SIZE);
+	os_fast_mutex_init(ibuf_backlog_mutex_key, &ibuf_backlog_mutex);
+
 	mtr_start(&mtr);
 
 	mutex_enter(&ibuf_mutex);
@@ -1516,6 +1589,208 @@ ibuf_print_ops(
 	putc('\n', file);
 }
 
+/****************************************************************//**
+Counts an operation that was buffered for an index. Only the first
+operation that is buffered for a dict_index_t object acquires
+ibuf_backlog_mutex. */
+static
+void
+ibuf_backlog_buffered(
+/*==================*/
+	dict_index_t*	index,	/*!< in/out: index */
+	ulint		space)	/*!< in: tablespace of the index */
+{
+	ibuf_backlog_t*	backlog = index->ibuf_backlog;
+
+	os_rmb;
+
+	if (backlog == NULL) {
+		ulint	fold = ut_fold_ull(index->id);
+
+		os_fast_mutex_lock(&ibuf_backlog_mutex);
+
+		/* The index may have been evicted from the dictionary
+		cache and loaded again. */
+		HASH_SEARCH(hash, ibuf_backlog_hash, fold,
+			    ibuf_backlog_t*, backlog,
+			    ut_ad(1), backlog->index_id == index->id);
+
+		if (backlog == NULL) {
+			backlog = ibuf_backlog_free;
+
+			if (backlog != NULL) {
+				ibuf_backlog_free = backlog->hash;
+			} else {
+				backlog = static_cast<ibuf_backlog_t*>(
+					ut_malloc(sizeof *backlog));
+			}
+
+			backlog->index_id = index->id;
+			backlog->space = space;
+			backlog->n_buffered = 0;
+			backlog->n_merged = 0;
+
+			HASH_INSERT(ibuf_backlog_t, hash, ibuf_backlog_hash,
+				    fold, backlog);
+		}
+
+		os_wmb;
+		index->ibuf_backlog = backlog;
+
+		os_fast_mutex_unlock(&ibuf_backlog_mutex);
+	}
+
+#ifdef HAVE_ATOMIC_BUILTINS
+	os_atomic_increment_ulint(&backlog->n_buffered, 1);
+#else /* HAVE_ATOMIC_BUILTINS */
+	os_fast_mutex_lock(&ibuf_backlog_mutex);
+	backlog->n_buffered++;
+	os_fast_mutex_unlock(&ibuf_backlog_mutex);
+#endif /* HAVE_ATOMIC_BUILTINS */
+}
+
+/****************************************************************//**
+Counts operations that were merged or discarded for an index. The merges
+for an index that has not buffered any operations since the server was
+started are not counted. */
+static
+void
+ibuf_backlog_merged(
+/*================*/
+	index_id_t	index_id,	/*!< in: index id */
+	ulint		n_merged)	/*!< in: number of operations merged
+					or discarded */
+{
+	ibuf_backlog_t*	backlog;
+
+	os_fast_mutex_lock(&ibuf_backlog_mutex);
+
+	HASH_SEARCH(hash, ibuf_backlog_hash, ut_fold_ull(index_id),
+		    ibuf_backlog_t*, backlog,
+		    ut_ad(1), backlog->index_id == index_id);
+
+	if (backlog != NULL) {
+		backlog->n_merged += n_merged;
+	}
+
+	os_fast_mutex_unlock(&ibuf_backlog_mutex);
+}
+
+/****************************************************************//**
+Forgets the change buffer backlog of the indexes of a tablespace whose
+buffered operations were discarded. The indexes may stay in the
+dictionary cache, so the objects are only reset. */
+static
+void
+ibuf_backlog_discard_space(
+/*=======================*/
+	ulint		space)		/*!< in: tablespace id */
+{
+	os_fast_mutex_lock(&ibuf_backlog_mutex);
+
+	for (ulint i = 0; i < hash_get_n_cells(ibuf_backlog_hash); i++) {
+		ibuf_backlog_t*	backlog;
+
+		for (backlog = static_cast<ibuf_backlog_t*>(
+			     HASH_GET_FIRST(ibuf_backlog_hash, i));
+		     backlog != NULL;
+		     backlog = backlog->hash) {
+
+			if (backlog->space == space) {
+				backlog->n_buffered = 0;
+				backlog->n_merged = 0;
+			}
+		}
+	}
+
+	os_fast_mutex_unlock(&ibuf_backlog_mutex);
+}
+
+/****************************************************************//**
+Forgets the change buffer backlog of an index whose tree is being
+dropped. No more operations can be buffered for the index, so its
+ibuf_backlog_t can be reused for another index. */
+UNIV_INTERN
+void
+ibuf_backlog_drop_index(
+/*====================*/
+	index_id_t	index_id)	/*!< in: index id */
+{
+	ibuf_backlog_t*	backlog;
+	ulint		fold = ut_fold_ull(index_id);
+
+	os_fast_mutex_lock(&ibuf_backlog_mutex);
+
+	HASH_SEARCH(hash, ibuf_backlog_hash, fold, ibuf_backlog_t*, backlog,
+		    ut_ad(1), backlog->index_id == index_id);
+
+	if (backlog != NULL) {
+		HASH_DELETE(ibuf_backlog_t, hash, ibuf_backlog_hash, fold,
+			    backlog);
+
+		backlog->hash = ibuf_backlog_free;
+		ibuf_backlog_free = backlog;
+	}
+
+	os_fast_mutex_unlock(&ibuf_backlog_mutex);
+}
+
+/****************************************************************//**
+Prints the change buffer backlog of the indexes that have operations
+pending in the change buffer. */
+static
+void
+ibuf_backlog_print(
+/*===============*/
+	FILE*	file)	/*!< in: file where to print */
+{
+	ulint	n_printed = 0;
+	ulint	n_skipped = 0;
+
+	fputs("pending operations by index since startup:\n", file);
+
+	os_fast_mutex_lock(&ibuf_backlog_mutex);
+
+	for (ulint i = 0; i < hash_get_n_cells(ibuf_backlog_hash); i++) {
+		const ibuf_backlog_t*	backlog;
+
+		for (backlog = static_cast<const ibuf_backlog_t*>(
+			     HASH_GET_FIRST(ibuf_backlog_hash, i));
+		     backlog != NULL;
+		     backlog = backlog->hash) {
+
+			/* n_buffered may be incremented meanwhile */
+			ulint	n_buffered = backlog->n_buffered;
+
+			/* The merges of operations that were buffered
+			before the server was started are counted too. */
+			if (backlog->n_merged >= n_buffered) {
+				continue;
+			}
+
+			if (n_printed == IBUF_BACKLOG_PRINT_MAX) {
+				n_skipped++;
+				continue;
+			}
+
+			fprintf(file,
+				" index " IB_ID_FMT " space %lu: %lu pending,"
+				" %lu buffered, %lu merged\n",
+				backlog->index_id, (ulong) backlog->space,
+				(ulong) (n_buffered - backlog->n_merged),
+				(ulong) n_buffered,
+				(ulong) backlog->n_merged);
+			n_printed++;
+		}
+	}
+
+	os_fast_mutex_unlock(&ibuf_backlog_mutex);
+
+	if (n_skipped) {
+		fprintf(file, " %lu more indexes\n", (ulong) n_skipped);
+	}
+}
+
 /********************************************************************//**
 Creates a dummy index for inserting a record to a non-clustered index.
 @return	dummy index */
@@ -2558,8 +2833,51 @@ ibuf_get_merge_pages(
 	return(volume);
 }
 
+/** Pages of a merge area that were sampled by ibuf_merge_pages() */
+struct ibuf_merge_range_t {
+	ulint		volume;		/*!< lower limit for the combined
+					volume of the buffered entries */
+	ulint		n_pages;	/*!< number of pages */
+	ulint		page_nos[IBUF_MAX_N_PAGES_MERGED];
+					/*!< page numbers, ascending */
+	ulint		space_ids[IBUF_MAX_N_PAGES_MERGED];
+					/*!< space ids */
+	ib_int64_t	space_versions[IBUF_MAX_N_PAGES_MERGED];
+					/*!< tablespace versions */
+};
+
+/*********************************************************************//**
+Compares the merge areas of two sampled ranges.
+@return negative, 0 or positive if a is before, in the same area as or
+after b */
+static
+int
+ibuf_merge_range_cmp(
+/*=================*/
+	const ibuf_merge_range_t*	a,	/*!< in: sampled range */
+	const ibuf_merge_range_t*	b)	/*!< in: sampled range */
+{
+	if (a->space_ids[0] != b->space_ids[0]) {
+		return(a->space_ids[0] < b->space_ids[0] ? -1 : 1);
+	}
+
+	ulint	area_a = a->page_nos[0] / IBUF_MERGE_AREA;
+	ulint	area_b = b->page_nos[0] / IBUF_MERGE_AREA;
+
+	if (area_a != area_b) {
+		return(area_a < area_b ? -1 : 1);
+	}
+
+	return(0);
+}
+
 /*********************************************************************//**
 Contracts insert buffer trees by reading pages to the buffer pool.
+The merge areas are sampled at n_samples random positions of the ibuf
+tree. The areas that hold much less buffered volume than the fullest one
+are skipped, because their pages are likely to be read for other reasons
+before the next batch. The pages of the other areas are read in ascending
+order, in one batch.
 @return a lower limit for the combined size in bytes of entries which
 will be merged from ibuf trees to the pages read, 0 if ibuf is
 empty */
@@ -2568,55 +2886,143 @@ ulint
 ibuf_merge_pages(
 /*=============*/
 	ulint*	n_pages,	/*!< out: number of pages to which merged */
-	bool	sync)		/*!< in: true if the caller wants to wait for
+	bool	sync,		/*!< in: true if the caller wants to wait for
 				the issued read with the highest tablespace
 				address to complete */
+	ulint	n_samples)	/*!< in: number of positions to sample,
+				1..IBUF_MERGE_N_SAMPLES */
 {
-	mtr_t		mtr;
-	btr_pcur_t	pcur;
-	ulint		sum_sizes;
-	ulint		page_nos[IBUF_MAX_N_PAGES_MERGED];
-	ulint		space_ids[IBUF_MAX_N_PAGES_MERGED];
-	ib_int64_t	space_versions[IBUF_MAX_N_PAGES_MERGED];
+	mtr_t			mtr;
+	btr_pcur_t		pcur;
+	ulint			sum_sizes;
+	ulint			max_volume;
+	ulint			n_ranges;
+	ibuf_merge_range_t	ranges[IBUF_MERGE_N_SAMPLES];
+	ulint			page_nos[IBUF_MERGE_N_SAMPLES
+					 * IBUF_MAX_N_PAGES_MERGED];
+	ulint			space_ids[IBUF_MERGE_N_SAMPLES
+					  * IBUF_MAX_N_PAGES_MERGED];
+	ib_int64_t		space_versions[IBUF_MERGE_N_SAMPLES
+					       * IBUF_MAX_N_PAGES_MERGED];
+
+	ut_ad(n_samples > 0);
+	ut_ad(n_samples <= IBUF_MERGE_N_SAMPLES);
 
 	*n_pages = 0;
+	n_ranges = 0;
+	max_volume = 0;
 
-	ibuf_mtr_start(&mtr);
+	for (ulint i = 0; i < n_samples; i++) {
+		ibuf_merge_range_t*	range = &ranges[n_ranges];
+		ulint			j;
 
-	/* Open a cursor to a randomly chosen leaf of the tree, at a random
-	position within the leaf */
+		ibuf_mtr_start(&mtr);
 
-	btr_pcur_open_at_rnd_pos(ibuf->index, BTR_SEARCH_LEAF, &pcur, &mtr);
+		/* Open a cursor to a randomly chosen leaf of the tree, at
+		a random position within the leaf */
 
-	ut_ad(page_validate(btr_pcur_get_page(&pcur), ibuf->index));
+		btr_pcur_open_at_rnd_pos(
+			ibuf->index, BTR_SEARCH_LEAF, &pcur, &mtr);
 
-	if (page_is_empty(btr_pcur_get_page(&pcur))) {
-		/* If a B-tree page is empty, it must be the root page
-		and the whole B-tree must be empty. InnoDB does not
-		allow empty B-tree pages other than the root. */
-		ut_ad(ibuf->empty);
-		ut_ad(page_get_space_id(btr_pcur_get_page(&pcur))
-		      == IBUF_SPACE_ID);
-		ut_ad(page_get_page_no(btr_pcur_get_page(&pcur))
-		      == FSP_IBUF_TREE_ROOT_PAGE_NO);
+		ut_ad(page_validate(btr_pcur_get_page(&pcur), ibuf->index));
+
+		if (page_is_empty(btr_pcur_get_page(&pcur))) {
+			/* If a B-tree page is empty, it must be the root
+			page and the whole B-tree must be empty. InnoDB
+			does not allow empty B-tree pages other than the
+			root. */
+			ut_ad(ibuf->empty);
+			ut_ad(page_get_space_id(btr_pcur_get_page(&pcur))
+			      == IBUF_SPACE_ID);
+			ut_ad(page_get_page_no(btr_pcur_get_page(&pcur))
+			      == FSP_IBUF_TREE_ROOT_PAGE_NO);
+
+			ibuf_mtr_commit(&mtr);
+			btr_pcur_close(&pcur);
+
+			if (i == 0) {
+				return(0);
+			}
+
+			break;
+		}
+
+		range->volume = ibuf_get_merge_page_nos(
+			TRUE, btr_pcur_get_rec(&pcur), &mtr,
+			range->space_ids, range->space_versions,
+			range->page_nos, &range->n_pages);
 
 		ibuf_mtr_commit(&mtr);
 		btr_pcur_close(&pcur);
 
-		return(0);
+		MONITOR_INC(MONITOR_IBUF_MERGE_SAMPLED);
+
+		if (range->n_pages == 0) {
+			continue;
+		}
+
+		/* Keep the ranges sorted by merge area. If the area was
+		already sampled, keep the fuller of the two ranges. */
+
+		for (j = 0; j < n_ranges; j++) {
+			int	cmp = ibuf_merge_range_cmp(range, &ranges[j]);
+
+			if (cmp < 0) {
+				break;
+			} else if (cmp == 0) {
+				if (range->volume > ranges[j].volume) {
+					ranges[j] = *range;
+				}
+
+				range = NULL;
+				break;
+			}
+		}
+
+		if (range == NULL) {
+			continue;
+		}
+
+		if (j < n_ranges) {
+			ibuf_merge_range_t	tmp = *range;
+
+			memmove(&ranges[j + 1], &ranges[j],
+				(n_ranges - j) * sizeof *ranges);
+			ranges[j] = tmp;
+		}
+
+		n_ranges++;
+	}
+
+	for (ulint i = 0; i < n_ranges; i++) {
+		max_volume = ut_max(max_volume, ranges[i].volume);
+	}
+
+	sum_sizes = 0;
+
+	for (ulint i = 0; i < n_ranges; i++) {
+		const ibuf_merge_range_t*	range = &ranges[i];
+
+		if (range->volume * IBUF_MERGE_SKIP_RATIO < max_volume) {
+			MONITOR_INC(MONITOR_IBUF_MERGE_SKIPPED);
+			continue;
+		}
+
+		memcpy(&page_nos[*n_pages], range->page_nos,
+		       range->n_pages * sizeof *page_nos);
+		memcpy(&space_ids[*n_pages], range->space_ids,
+		       range->n_pages * sizeof *space_ids);
+		memcpy(&space_versions[*n_pages], range->space_versions,
+		       range->n_pages * sizeof *space_versions);
+
+		*n_pages += range->n_pages;
+		sum_sizes += range->volume;
 	}
 
-	sum_sizes = ibuf_get_merge_page_nos(TRUE,
-					    btr_pcur_get_rec(&pcur), &mtr,
-					    space_ids, space_versions,
-					    page_nos, n_pages);
 #if 0 /* defined UNIV_IBUF_DEBUG */
 	fprintf(stderr, "Ibuf contract sync %lu pages %lu volume %lu\n",
 		sync, *n_pages, sum_sizes);
 #endif
-	ibuf_mtr_commit(&mtr);
-	btr_pcur_close(&pcur);
-
 	buf_read_ibuf_merge_pages(
 		sync, space_ids, space_versions, page_nos, *n_pages);
 
@@ -2735,10 +3141,13 @@ ibuf_merge(
 					should be 0 */
 	ulint*		n_pages,	/*!< out: number of pages to
 					which merged */
-	bool		sync)		/*!< in: TRUE if the caller
+	bool		sync,		/*!< in: TRUE if the caller
 					wants to wait for the issued
 					read with the highest
 					tablespace address to complete */
+	ulint		n_samples)	/*!< in: number of positions of
+					the ibuf tree to sample, if
+					table_id is 0 */
 {
 	dict_table_t*	table;
 
@@ -2756,7 +3165,7 @@ ibuf_merge(
 		return(0);
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
 	} else if (table_id == 0) {
-		return(ibuf_merge_pages(n_pages, sync));
+		return(ibuf_merge_pages(n_pages, sync, n_samples));
 	} else if ((table = ibuf_get_table(table_id)) == 0) {
 		/* Table has been dropped. */
 		return(0);
@@ -2784,7 +3193,7 @@ ibuf_contract(
 {
 	ulint	n_pages;
 
-	return(ibuf_merge(0, &n_pages, sync));
+	return(ibuf_merge(0, &n_pages, sync, 1));
 }
 
 /*********************************************************************//**
@@ -2807,6 +3216,7 @@ ibuf_contract_in_background(
 {
 	ulint	sum_bytes	= 0;
 	ulint	sum_pages	= 0;
+	ulint	n_samples	= 1;
 	ulint	n_pag2;
 	ulint	n_pages;
 
@@ -2819,6 +3229,7 @@ ibuf_contract_in_background(
 	if (full) {
 		/* Caller has requested a full batch */
 		n_pages = PCT_IO(100);
+		n_samples = IBUF_MERGE_N_SAMPLES;
 	} else {
 		/* By default we do a batch of 5% of the io_capacity */
 		n_pages = PCT_IO(5);
@@ -2832,6 +3243,12 @@ ibuf_contract_in_background(
 			ulint diff = ibuf->size - ibuf->max_size / 2;
 			n_pages += PCT_IO((diff * 100)
 					   / (ibuf->max_size + 1));
+
+			/* Likewise, sample more merge areas per batch,
+			so that the reads go to the fullest ones. */
+			n_samples += (IBUF_MERGE_N_SAMPLES - 1) * diff
+				/ (ibuf->max_size / 2 + 1);
+			n_samples = ut_min(n_samples, IBUF_MERGE_N_SAMPLES);
 		}
 
 		mutex_exit(&ibuf_mutex);
@@ -2840,12 +3257,14 @@ ibuf_contract_in_background(
 	while (sum_pages < n_pages) {
 		ulint	n_bytes;
 
-		n_bytes = ibuf_merge(table_id, &n_pag2, FALSE);
+		n_bytes = ibuf_merge(table_id, &n_pag2, FALSE, n_samples);
 
 		if (n_bytes == 0) {
 			return(sum_bytes);
 		}
 
+		MONITOR_INC_VALUE(MONITOR_IBUF_MERGE_READ, n_pag2);
+
 		sum_bytes += n_bytes;
 		sum_pages += n_pag2;
 	}
@@ -3767,6 +4186,10 @@ func_exit:
 
 	mem_heap_free(heap);
 
+	if (err == DB_SUCCESS) {
+		ibuf_backlog_buffered(index, space);
+	}
+
 	if (err == DB_SUCCESS && mode == BTR_MODIFY_TREE) {
 		ibuf_contract_after_insert(entry_size);
 	}
@@ -4941,6 +5364,19 @@ reset_bit:
 	mutex_exit(&ibuf_mutex);
 #endif /* HAVE_ATOMIC_BUILTINS */
 
+	if (block && !corruption_noticed) {
+		ulint	n_ops = 0;
+
+		for (ulint i = 0; i < IBUF_OP_COUNT; i++) {
+			n_ops += mops[i] + dops[i];
+		}
+
+		if (n_ops) {
+			ibuf_backlog_merged(
+				btr_page_get_index_id(block->frame), n_ops);
+		}
+	}
+
 	if (update_ibuf_bitmap && !tablespace_being_deleted) {
 
 		fil_decr_pending_ops(space);
@@ -5041,6 +5477,8 @@ leave_loop:
 	mutex_exit(&ibuf_mutex);
 #endif /* HAVE_ATOMIC_BUILTINS */
 
+	ibuf_backlog_discard_space(space);
+
 	mem_heap_free(heap);
 }
 
@@ -5098,6 +5536,8 @@ ibuf_print(
 	fputs("discarded operations:\n ", file);
 	ibuf_print_ops(ibuf->n_discarded_ops, file);
 
+	ibuf_backlog_print(file);
+
 #ifdef UNIV_IBUF_COUNT_DEBUG
 	for (i = 0; i < IBUF_COUNT_N_SPACES; i++) {
 		for (j = 0; j < IBUF_COUNT_N_PAGES; j++) {
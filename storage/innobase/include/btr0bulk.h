@@ -0,0 +1,142 @@
+/*****************************************************************************
+
+Copyright (c) 2026, the contributors of this file. See the version control
+history for the individual authors.
+
+This file is a contribution to MySQL. It is distributed under the same
+license as the rest of the server, with no copyright assigned to Oracle.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/btr0bulk.h
+Bottom-up loading of a B-tree from sorted input
+
+The records are appended to a leaf page until it is filled up to
+innodb_fill_factor percent, or holds at least two records when the
+records are large, and a new leaf page is then allocated and
+linked to it. The node pointer to the full page is appended to the page
+of the level above in the same way, so that the tree grows from the
+leaves up, one page per level being filled at any time. When the input
+ends, the node pointers to the last pages are appended, and the only page
+of the highest level is copied to the root page.
+
+In a single-table tablespace, the pages are written without redo logging:
+only the page allocations are logged, and the tablespace is flushed before
+btr_bulk_finish() returns. In the system tablespace every record insert is
+logged, since flushing it would write out unrelated pages.
+
+Created 10/18/2026
+*******************************************************/
+
+#ifndef btr0bulk_h
+#define btr0bulk_h
+
+#include "univ.i"
+#include "btr0btr.h"
+#include "data0data.h"
+#include "dict0types.h"
+#include "mtr0mtr.h"
+#include "page0cur.h"
+#include "trx0types.h"
+
+/** innodb_fill_factor: percentage of the space of each B-tree page that
+is filled by the bulk loader, leaving the rest for future inserts */
+extern ulong	btr_bulk_fill_factor;
+
+/** The page of a B-tree level that is being filled by the bulk loader */
+struct btr_bulk_level_t {
+	mtr_t		mtrs[2];	/*!< mini-transactions for the
+					page and for its successor, which
+					is allocated before the page is
+					committed */
+	mtr_t*		mtr;		/*!< the mini-transaction of mtrs[]
+					that x-latches the page */
+	buf_block_t*	block;		/*!< the page, or NULL if it is not
+					latched */
+	ulint		page_no;	/*!< page number of the page */
+	page_cur_t	cur;		/*!< cursor on the last appended
+					record */
+	ulint		cur_offset;	/*!< page_offset() of cur while
+					the page is not latched */
+};
+
+/** A bulk load of a B-tree */
+struct btr_bulk_t {
+	dict_index_t*		index;		/*!< the index, whose tree
+						must be empty */
+	trx_id_t		trx_id;		/*!< transaction creating
+						the index */
+	ulint			log_mode;	/*!< logging mode of the page
+						mini-transactions:
+						MTR_LOG_NO_REDO or
+						MTR_LOG_ALL */
+	ulint			fill_limit;	/*!< number of bytes that may
+						be used on a page before a new
+						page is started */
+	ulint			n_levels;	/*!< number of levels that
+						have a page */
+	btr_bulk_level_t*	levels[BTR_MAX_LEVELS];
+						/*!< levels[0] is the leaf
+						level */
+	mem_heap_t*		heap;		/*!< memory heap for levels[]
+						and node pointers */
+	ulint*			offsets;	/*!< offsets of the last
+						appended record */
+	mem_heap_t*		offsets_heap;	/*!< memory heap for
+						offsets */
+};
+
+/*********************************************************************//**
+Starts a bulk load of an empty B-tree. */
+UNIV_INTERN
+void
+btr_bulk_init(
+/*==========*/
+	btr_bulk_t*	bulk,	/*!< out: bulk load */
+	dict_index_t*	index,	/*!< in: index whose tree is empty; not
+				ROW_FORMAT=COMPRESSED */
+	trx_id_t	trx_id)	/*!< in: transaction creating the index */
+	__attribute__((nonnull));
+
+/*********************************************************************//**
+Appends a record to the B-tree that is being bulk loaded. The records
+must be appended in ascending order, and must not need off-page storage.
+@return	DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+btr_bulk_insert(
+/*============*/
+	btr_bulk_t*	bulk,	/*!< in/out: bulk load */
+	const dtuple_t*	tuple)	/*!< in: index entry */
+	__attribute__((nonnull, warn_unused_result));
+
+/*********************************************************************//**
+Ends a bulk load. On success, completes the tree and makes sure that
+the pages that were not redo logged are written to the data file.
+@return	DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+btr_bulk_finish(
+/*============*/
+	btr_bulk_t*	bulk,	/*!< in/out: bulk load */
+	dberr_t		err,	/*!< in: DB_SUCCESS, or the error that
+				aborted the load, in which case the
+				latches are just released */
+	const trx_t*	trx)	/*!< in: transaction, for checking if
+				the flush must be interrupted */
+	__attribute__((nonnull, warn_unused_result));
+
+#endif /* btr0bulk_h */
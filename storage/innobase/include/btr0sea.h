@@ -33,6 +33,7 @@ Created 2/17/1996 Heikki Tuuri
 #include "btr0types.h"
 #include "mtr0mtr.h"
 #include "ha0ha.h"
+#include "ut0counter.h"
 
 /*****************************************************************//**
 Creates and initializes the adaptive search system at a database start. */
@@ -40,7 +41,8 @@ UNIV_INTERN
 void
 btr_search_sys_create(
 /*==================*/
-	ulint	hash_size);	/*!< in: hash index hash table size */
+	ulint	hash_size);	/*!< in: hash index hash table size,
+				divided among the partitions */
 /*****************************************************************//**
 Frees the adaptive search system at a database shutdown. */
 UNIV_INTERN
@@ -61,6 +63,80 @@ void
 btr_search_enable(void);
 /*====================*/
 
+/********************************************************************//**
+Gets the adaptive hash index partition of an index.
+@return	partition where the pages of the index are hashed */
+UNIV_INLINE
+btr_search_part_t*
+btr_search_get_part(
+/*================*/
+	const dict_index_t*	index)	/*!< in: index */
+	__attribute__((nonnull, pure, warn_unused_result));
+/********************************************************************//**
+Gets the latch of the adaptive hash index partition of an index.
+@return	latch protecting the hash index of the pages of the index */
+UNIV_INLINE
+rw_lock_t*
+btr_search_get_latch(
+/*=================*/
+	const dict_index_t*	index)	/*!< in: index */
+	__attribute__((nonnull, pure, warn_unused_result));
+/********************************************************************//**
+X-latches the latches of all adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_x_lock_all(void);
+/*=======================*/
+/********************************************************************//**
+Releases the x-latches of all adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_x_unlock_all(void);
+/*=========================*/
+#ifdef UNIV_SYNC_DEBUG
+/********************************************************************//**
+Checks if the thread owns the latches of all adaptive hash index
+partitions in the given mode.
+@return	TRUE if all are owned */
+UNIV_INTERN
+ibool
+btr_search_own_all(
+/*===============*/
+	ulint	lock_type)	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+	__attribute__((warn_unused_result));
+/********************************************************************//**
+Checks if the thread owns the latch of any adaptive hash index
+partition in the given mode.
+@return	TRUE if some latch is owned */
+UNIV_INTERN
+ibool
+btr_search_own_any(
+/*===============*/
+	ulint	lock_type)	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+	__attribute__((warn_unused_result));
+/********************************************************************//**
+Checks if the thread owns the latch of the adaptive hash index partition
+that the hash table belongs to.
+@return	TRUE if the latch is owned */
+UNIV_INTERN
+ibool
+btr_search_own_table(
+/*=================*/
+	const hash_table_t*	table,		/*!< in: hash table of
+						a partition */
+	ulint			lock_type)	/*!< in: RW_LOCK_SHARED
+						or RW_LOCK_EX */
+	__attribute__((nonnull, warn_unused_result));
+#endif /* UNIV_SYNC_DEBUG */
+/********************************************************************//**
+Prints info of the adaptive hash index partitions. */
+UNIV_INTERN
+void
+btr_search_print_info(
+/*==================*/
+	FILE*	file)	/*!< in: file where to print */
+	__attribute__((nonnull));
+
 /********************************************************************//**
 Returns search info for an index.
 @return	search info; search mutex reserved */
@@ -80,13 +156,14 @@ btr_search_info_create(
 	mem_heap_t*	heap);	/*!< in: heap where created */
 /*****************************************************************//**
 Returns the value of ref_count. The value is protected by
-btr_search_latch.
+the latch of the adaptive hash index partition of the index.
 @return	ref_count value. */
 UNIV_INTERN
 ulint
 btr_search_info_get_ref_count(
 /*==========================*/
-	btr_search_t*   info);	/*!< in: search info. */
+	btr_search_t*   info,	/*!< in: search info. */
+	dict_index_t*	index);	/*!< in: index */
 /*********************************************************************//**
 Updates the search info. */
 UNIV_INLINE
@@ -112,7 +189,8 @@ btr_search_guess_on_hash(
 	ulint		latch_mode,	/*!< in: BTR_SEARCH_LEAF, ... */
 	btr_cur_t*	cursor,		/*!< out: tree cursor */
 	ulint		has_search_latch,/*!< in: latch mode the caller
-					currently has on btr_search_latch:
+					currently has on
+					btr_search_get_latch(index):
 					RW_S_LATCH, RW_X_LATCH, or 0 */
 	mtr_t*		mtr);		/*!< in: mtr */
 /********************************************************************//**
@@ -196,7 +274,8 @@ struct btr_search_t{
 	ulint	ref_count;	/*!< Number of blocks in this index tree
 				that have search index built
 				i.e. block->index points to this index.
-				Protected by btr_search_latch except
+				Protected by btr_search_get_latch()
+				of the index, except
 				when during initialization in
 				btr_search_info_create(). */
 
@@ -246,16 +325,44 @@ struct btr_search_t{
 #endif /* UNIV_DEBUG */
 };
 
+/** A partition of the adaptive hash index */
+struct btr_search_part_t{
+	rw_lock_t	latch;		/*!< latch protecting hash_index
+					and the pages hashed in it,
+					see btr0types.h */
+	hash_table_t*	hash_index;	/*!< the adaptive hash index of
+					the partition, mapping
+					dtuple_fold values to rec_t
+					pointers on index pages */
+	ulint		n_hits;		/*!< number of successful
+					btr_search_guess_on_hash();
+					not protected, may be inexact */
+	ulint		n_misses;	/*!< number of failed
+					btr_search_guess_on_hash();
+					not protected, may be inexact */
+	byte		pad[CACHE_LINE_SIZE];
+					/*!< padding to keep the latches
+					of the partitions on separate
+					cache lines */
+};
+
 /** The hash index system */
 struct btr_search_sys_t{
-	hash_table_t*	hash_index;	/*!< the adaptive hash index,
-					mapping dtuple_fold values
-					to rec_t pointers on index pages */
+	btr_search_part_t*	parts;	/*!< the btr_ahi_parts
+					partitions of the adaptive
+					hash index */
 };
 
 /** The adaptive hash index */
 extern btr_search_sys_t*	btr_search_sys;
 
+/** Number of adaptive hash index partitions,
+innodb_adaptive_hash_index_parts */
+extern ulong			btr_ahi_parts;
+
+/** Maximum value of innodb_adaptive_hash_index_parts */
+#define BTR_AHI_PARTS_MAX	512
+
 #ifdef UNIV_SEARCH_PERF_STAT
 /** Number of successful adaptive hash index lookups */
 extern ulint	btr_search_n_succ;
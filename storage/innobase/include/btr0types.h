@@ -39,12 +39,13 @@ struct btr_cur_t;
 /** B-tree search information for the adaptive hash index */
 struct btr_search_t;
 
-#ifndef UNIV_HOTBACKUP
+/** @brief A partition of the adaptive search system
 
-/** @brief The latch protecting the adaptive search system
-
-This latch protects the
-(1) hash index;
+The adaptive hash index is split into btr_ahi_parts partitions, each
+protected by its own latch btr_search_part_t::latch. All pages of an
+index are hashed in the same partition, chosen by the index id; see
+btr_search_get_latch(). The latch of a partition protects the
+(1) hash index of the partition;
 (2) columns of a record to which we have a pointer in the hash index;
 
 but does NOT protect:
@@ -54,15 +55,11 @@ but does NOT protect:
 
 Bear in mind (3) and (4) when using the hash index.
 */
-extern rw_lock_t*	btr_search_latch_temp;
-
-#endif /* UNIV_HOTBACKUP */
-
-/** The latch protecting the adaptive search system */
-#define btr_search_latch	(*btr_search_latch_temp)
+struct btr_search_part_t;
 
 /** Flag: has the search system been enabled?
-Protected by btr_search_latch. */
+Protected by the latches of all adaptive hash index partitions: it is
+only changed while all of them are x-latched. */
 extern char	btr_search_enabled;
 
 #ifdef UNIV_BLOB_DEBUG
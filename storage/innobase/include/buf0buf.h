@@ -1616,7 +1616,13 @@ struct buf_page_t{
 #endif /* UNIV_DEBUG */
 	unsigned	old:1;		/*!< TRUE if the block is in the old
 					blocks in buf_pool->LRU_old */
-	unsigned	freed_page_clock:31;/*!< the value of
+	unsigned	made_young:1;	/*!< TRUE if the block has been
+					put to the head of the LRU list
+					by buf_LRU_add_block_low() with
+					old == FALSE since it was read in;
+					recorded in the LRU ghost
+					directory on eviction */
+	unsigned	freed_page_clock:30;/*!< the value of
 					buf_pool->freed_page_clock
 					when this block was the last
 					time put to the head of the
@@ -1689,6 +1695,13 @@ struct buf_block_t{
 					but this flag is not set because
 					we do not keep track of all pages;
 					NOT protected by any mutex */
+	byte*		comp_frame;	/*!< the image of frame compressed
+					by innodb_page_compression that is
+					being written, or NULL; protected by
+					io_fix == BUF_IO_WRITE */
+	void*		comp_frame_alloc;
+					/*!< unaligned allocation of
+					comp_frame */
 	/* @} */
 	/** @name Optimistic search field */
 	/* @{ */
@@ -1705,6 +1718,23 @@ struct buf_block_t{
 					bufferfixed, or (2) the thread has an
 					x-latch on the block */
 	/* @} */
+	/** @name In-page search fields
+	The key prefixes are rebuilt by a thread that holds a latch on the
+	block and buf_block_t::mutex, when search_clock and search_n_slots
+	no longer match the page; see page_cur_search_with_match(). */
+	/* @{ */
+
+	ib_uint64_t*	search_keys;	/*!< key prefixes of the records
+					owning the page directory slots,
+					indexed by slot number, or NULL */
+	ulint		search_keys_size;/*!< number of elements allocated
+					in search_keys */
+	ulint		search_n_slots;	/*!< number of page directory slots
+					when search_keys was built, or 0
+					if it is not valid */
+	ib_uint64_t	search_clock;	/*!< modify_clock when search_keys
+					was built */
+	/* @} */
 	/** @name Hash search fields (unprotected)
 	NOTE that these fields are NOT protected by any semaphore! */
 	/* @{ */
@@ -1723,7 +1753,8 @@ struct buf_block_t{
 
 	/** @name Hash search fields
 	These 5 fields may only be modified when we have
-	an x-latch on btr_search_latch AND
+	an x-latch on the adaptive hash index partition of the
+	page (btr_search_get_latch(index)) AND
 	- we are holding an s-latch or x-latch on buf_block_t::lock or
 	- we know that buf_block_t::buf_fix_count == 0.
 
@@ -1731,7 +1762,8 @@ struct buf_block_t{
 	in the buffer pool in buf0buf.cc.
 
 	Another exception is that assigning block->index = NULL
-	is allowed whenever holding an x-latch on btr_search_latch. */
+	is allowed whenever holding an x-latch on all partitions
+	of the adaptive hash index. */
 
 	/* @{ */
 
@@ -1842,6 +1874,28 @@ struct buf_buddy_stat_t {
 	ib_uint64_t	relocated_usec;
 };
 
+/** Number of deferred "make young" batches per buffer pool instance */
+#define BUF_LRU_YOUNG_BATCHES		8
+/** Number of pages collected in a "make young" batch before the batch
+is applied to the LRU list */
+#define BUF_LRU_YOUNG_BATCH_SIZE	32
+
+/** A batch of deferred LRU "make young" requests. Threads are mapped to
+a batch by their thread id, so that a batch is in practice private to a
+small group of threads. The requests are applied to the LRU list under a
+single acquisition of buf_pool->mutex, see buf_LRU_make_block_young_lazy(). */
+struct buf_LRU_young_batch_t {
+	os_fast_mutex_t	mutex;		/*!< protects the fields below;
+					no other latch may be acquired
+					while holding this mutex */
+	ulint		n_pages;	/*!< number of requests in
+					the batch */
+	ulint		space[BUF_LRU_YOUNG_BATCH_SIZE];
+					/*!< tablespace ids of the pages */
+	ulint		offset[BUF_LRU_YOUNG_BATCH_SIZE];
+					/*!< page numbers of the pages */
+};
+
 /** @brief The buffer pool structure.
 
 NOTE! The definition appears here only for other modules of this
@@ -1970,9 +2024,15 @@ struct buf_pool_t{
 	/** @name LRU replacement algorithm fields */
 	/* @{ */
 
+	ib_mutex_t	free_list_mutex;/*!< mutex protecting the
+					free list. A block can be taken
+					off the free list without
+					holding buf_pool->mutex, see
+					buf_LRU_get_free_only() */
 	UT_LIST_BASE_NODE_T(buf_page_t) free;
 					/*!< base node of the free
-					block list */
+					block list; protected by
+					free_list_mutex */
 	UT_LIST_BASE_NODE_T(buf_page_t) LRU;
 					/*!< base node of the LRU list */
 	buf_page_t*	LRU_old;	/*!< pointer to the about
@@ -1989,10 +2049,31 @@ struct buf_pool_t{
 					on this value; 0 if LRU_old == NULL;
 					NOTE: LRU_old_len must be adjusted
 					whenever LRU_old shrinks or grows! */
+	ulint		LRU_old_target;	/*!< target length of the old
+					blocks list, corresponding to
+					LRU_old_ratio; adapted in the
+					BUF_LRU_POLICY_ADAPTIVE policy */
+	ib_uint32_t*	LRU_ghost;	/*!< ghost directory of pages
+					recently evicted from the LRU
+					list, see buf0lru.cc */
+	ulint		LRU_ghost_size;	/*!< number of slots in
+					LRU_ghost */
+	ulint		LRU_ghost_n_old;/*!< number of LRU_ghost entries
+					of pages that were evicted from
+					the old blocks list without
+					having been made young */
+	ulint		LRU_ghost_n_young;
+					/*!< number of LRU_ghost entries
+					of pages that had been made
+					young before they were evicted */
 
 	UT_LIST_BASE_NODE_T(buf_block_t) unzip_LRU;
 					/*!< base node of the
 					unzip_LRU list */
+	buf_LRU_young_batch_t	young_batch[BUF_LRU_YOUNG_BATCHES];
+					/*!< deferred "make young"
+					requests, see
+					buf_LRU_make_block_young_lazy() */
 
 	/* @} */
 	/** @name Buddy allocator fields
@@ -2042,6 +2123,18 @@ Use these instead of accessing buf_pool->mutex directly. */
 	mutex_exit(&b->flush_list_mutex);		\
 } while (0)
 
+/** Test if free list mutex is owned. */
+#define buf_free_list_mutex_own(b) mutex_own(&b->free_list_mutex)
+
+/** Acquire the free list mutex. */
+#define buf_free_list_mutex_enter(b) do {		\
+	mutex_enter(&b->free_list_mutex);		\
+} while (0)
+/** Release the free list mutex. */
+#define buf_free_list_mutex_exit(b) do {		\
+	mutex_exit(&b->free_list_mutex);		\
+} while (0)
+
 /** Test if block->mutex is owned. */
 #define buf_block_mutex_own(b)	mutex_own(&(b)->mutex)
 
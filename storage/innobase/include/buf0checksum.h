@@ -45,6 +45,17 @@ buf_calc_page_crc32(
 /*================*/
 	const byte*	page);	/*!< in: buffer page */
 
+/********************************************************************//**
+Calculates the page CRC32 of several pages, as buf_calc_page_crc32()
+would, interleaving the computation for consecutive pages. */
+UNIV_INTERN
+void
+buf_calc_page_crc32_batch(
+/*======================*/
+	const byte* const*	pages,	/*!< in: buffer pages */
+	ulint			n,	/*!< in: number of pages */
+	ib_uint32_t*		checksums);/*!< out: checksum of each page */
+
 /********************************************************************//**
 Calculates a page checksum which is stored to the page when it is written
 to a file. Note that we must be careful to calculate the same value on
@@ -96,7 +96,11 @@ UNIV_INTERN
 void
 buf_dblwr_add_to_batch(
 /*====================*/
-	buf_page_t*	bpage);	/*!< in: buffer block to write */
+	buf_page_t*	bpage,	/*!< in: buffer block to write */
+	bool		checksum_pending);
+				/*!< in: true if the CRC32 checksum of
+				the page is to be stored when the batch
+				is flushed */
 /********************************************************************//**
 Flushes possible buffered writes from the doublewrite memory buffer to disk,
 and also wakes up the aio thread if simulated aio is used. It is very
@@ -154,6 +158,10 @@ struct buf_dblwr_t{
 	buf_page_t**	buf_block_arr;/*!< array to store pointers to
 				the buffer blocks which have been
 				cached to write_buf */
+	bool*		checksum_pending;/*!< flag telling that the CRC32
+				checksum of the page in a batch slot
+				has not been stored yet; see
+				buf_dblwr_store_batch_checksums() */
 };
 
 #ifdef SSD_CACHE_FACE
@@ -60,6 +60,28 @@ void
 buf_flush_write_complete(
 /*=====================*/
 	buf_page_t*	bpage);	/*!< in: pointer to the block in question */
+/********************************************************************//**
+Compresses an uncompressed page that is about to be written to its data
+file, if innodb_page_compression is enabled and the page qualifies: only
+B-tree pages of file-per-table tablespaces are compressed. The page must
+have been prepared by buf_flush_init_for_writing(), including its checksum.
+The image is kept in block->comp_frame until buf_flush_compress_complete().
+@return	number of bytes to write from the returned frame */
+UNIV_INTERN
+ulint
+buf_flush_compress_page(
+/*====================*/
+	buf_block_t*	block,	/*!< in/out: block being written */
+	byte**		frame);	/*!< out: block->frame, or the compressed
+				image of it */
+/********************************************************************//**
+Releases the compressed image of a page after its write has completed, and
+the file blocks beyond it. */
+UNIV_INTERN
+void
+buf_flush_compress_complete(
+/*========================*/
+	buf_block_t*	block);	/*!< in/out: block that was written */
 #endif /* !UNIV_HOTBACKUP */
 /********************************************************************//**
 Initializes a page for writing to the tablespace. */
@@ -174,8 +196,26 @@ buf_flush_ready_for_replace(
 	buf_page_t*	bpage);	/*!< in: buffer control block, must be
 				buf_page_in_file(bpage) and in the LRU list */
 /******************************************************************//**
-page_cleaner thread tasked with flushing dirty pages from the buffer
-pools. As of now we'll have only one instance of this thread.
+Initialize the page_cleaner and start its worker threads. There is one
+page cleaner slot per page cleaner thread; the page_cleaner coordinator
+thread serves the first slot itself. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void);
+/*=============================*/
+/*********************************************************************//**
+Prints the work done by each page cleaner thread since startup, so that
+an imbalance between the threads can be seen. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_print(
+/*=========================*/
+	FILE*	file);	/*!< in: file where to print */
+/******************************************************************//**
+page_cleaner coordinator thread tasked with flushing dirty pages from the
+buffer pools. It decides how much to flush and hands the work out to the
+page_cleaner worker threads, doing the share of the first page cleaner
+slot itself.
 @return a dummy parameter */
 extern "C" UNIV_INTERN
 os_thread_ret_t
@@ -183,6 +223,17 @@ DECLARE_THREAD(buf_flush_page_cleaner_thread)(
 /*==========================================*/
 	void*	arg);		/*!< in: a dummy parameter required by
 				os_thread_create */
+/******************************************************************//**
+page_cleaner worker thread. It flushes the buffer pool instances owned
+by its page cleaner slot whenever asked to by the page_cleaner
+coordinator.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
+/*==========================================*/
+	void*	arg);		/*!< in: the page cleaner slot of the
+				thread */
 /*********************************************************************//**
 Clears up tail of the LRU lists:
 * Put replaceable pages at the tail of LRU to the free list
@@ -194,6 +194,26 @@ buf_LRU_make_block_young(
 /*=====================*/
 	buf_page_t*	bpage);	/*!< in: control block */
 /******************************************************************//**
+Requests a block to be moved to the start of the LRU list. The request is
+queued in a batch selected by the id of the calling thread, and the batch
+is applied to the LRU list under buf_pool->mutex once it is full, or by
+buf_LRU_flush_young_batches(). */
+UNIV_INTERN
+void
+buf_LRU_make_block_young_lazy(
+/*==========================*/
+	buf_page_t*	bpage);	/*!< in: control block, buffer-fixed
+				by the caller */
+/******************************************************************//**
+Applies the deferred "make young" requests of all batches of a buffer
+pool instance, full or not. Called periodically by the page cleaner so
+that requests do not stay queued in a quiet buffer pool. */
+UNIV_INTERN
+void
+buf_LRU_flush_young_batches(
+/*========================*/
+	buf_pool_t*	buf_pool);	/*!< in/out: buffer pool instance */
+/******************************************************************//**
 Moves a block to the end of the LRU list. */
 UNIV_INTERN
 void
@@ -273,8 +293,41 @@ The minimum must exceed
 /** Move blocks to "new" LRU list only if the first access was at
 least this many milliseconds ago.  Not protected by any mutex or latch. */
 extern uint	buf_LRU_old_threshold_ms;
+
+/** LRU replacement policies */
+enum buf_LRU_policy_t {
+	BUF_LRU_POLICY_MIDPOINT,	/*!< read pages are inserted to the
+					old sublist, whose length is
+					innodb_old_blocks_pct */
+	BUF_LRU_POLICY_ADAPTIVE		/*!< as BUF_LRU_POLICY_MIDPOINT,
+					but recently evicted pages are
+					inserted to the start of the LRU
+					list, and the length of the old
+					sublist is adapted to the hits in
+					the ghost directory of evicted
+					pages (buf_pool->LRU_ghost) */
+};
+
+/** The LRU replacement policy, a buf_LRU_policy_t.
+Not protected by any mutex or latch. */
+extern ulong	buf_LRU_policy;
 /* @} */
 
+/******************************************************************//**
+Creates the ghost directory of a buffer pool instance. */
+UNIV_INTERN
+void
+buf_LRU_ghost_create(
+/*=================*/
+	buf_pool_t*	buf_pool);	/*!< in/out: buffer pool instance */
+/******************************************************************//**
+Frees the ghost directory of a buffer pool instance. */
+UNIV_INTERN
+void
+buf_LRU_ghost_free(
+/*===============*/
+	buf_pool_t*	buf_pool);	/*!< in/out: buffer pool instance */
+
 /** @brief Statistics for selecting the LRU list for eviction.
 
 These statistics are not 'of' LRU but 'for' LRU.  We keep count of I/O
@@ -114,7 +114,8 @@ buf_read_ahead_linear(
 /********************************************************************//**
 Issues read requests for pages which the ibuf module wants to read in, in
 order to contract the insert buffer tree. Technically, this function is like
-a read-ahead function. */
+a read-ahead function. The asynchronous reads are submitted together at the
+end, so that the reads of adjacent pages can be merged. */
 UNIV_INTERN
 void
 buf_read_ibuf_merge_pages(
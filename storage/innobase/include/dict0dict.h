@@ -144,6 +144,25 @@ dict_table_close(
 					index creation */
 	__attribute__((nonnull));
 /**********************************************************************//**
+Makes dict_table_open_on_name() reserve dict_sys->mutex for every table
+until dict_table_open_fast_enable() is called, and waits for the lookups
+that did not reserve it to complete. Called when a DDL operation reserves
+the data dictionary, because it relies on the count of open handles of
+the tables it changes staying as it is while it holds dict_sys->mutex.
+The caller must hold dict_sys->mutex. */
+UNIV_INTERN
+void
+dict_table_open_fast_disable(void);
+/*==============================*/
+/**********************************************************************//**
+Allows dict_table_open_on_name() to open a table that is already open
+without reserving dict_sys->mutex again. The caller must hold
+dict_sys->mutex. */
+UNIV_INTERN
+void
+dict_table_open_fast_enable(void);
+/*=============================*/
+/**********************************************************************//**
 Inits the data dictionary module. */
 UNIV_INTERN
 void
@@ -993,6 +1012,8 @@ dict_index_find_on_id_low(
 Make room in the table cache by evicting an unused table. The unused table
 should not be part of FK relationship and currently not used in any user
 transaction. There is no guarantee that it will remove a table.
+The caller must hold dict_sys->mutex and an X-latch on dict_operation_lock.
+Both are released and reacquired while the LRU list is scanned.
 @return number of tables evicted. */
 UNIV_INTERN
 ulint
@@ -1543,6 +1564,16 @@ extern dict_sys_t*	dict_sys;
 /** the data dictionary rw-latch protecting dict_sys */
 extern rw_lock_t	dict_operation_lock;
 
+#if defined HAVE_ATOMIC_BUILTINS && !defined UNIV_HOTBACKUP
+/** dict_table_open_on_name() and dict_table_close() can reference a table
+that is already open without reserving dict_sys->mutex; this needs atomic
+updates of dict_table_t::n_ref_count */
+# define DICT_TABLE_OPEN_FAST_PATH
+#endif /* HAVE_ATOMIC_BUILTINS && !UNIV_HOTBACKUP */
+
+/** Number of latches protecting partitions of dict_sys->table_hash */
+#define DICT_TABLE_HASH_N_LATCHES	64
+
 /* Dictionary system struct */
 struct dict_sys_t{
 	ib_mutex_t		mutex;		/*!< mutex protecting the data
@@ -1560,6 +1591,23 @@ struct dict_sys_t{
 					the log records */
 	hash_table_t*	table_hash;	/*!< hash table of the tables, based
 					on name */
+#ifdef DICT_TABLE_OPEN_FAST_PATH
+	rw_lock_t*	hash_latches;	/*!< DICT_TABLE_HASH_N_LATCHES
+					latches, each covering the cells of
+					table_hash whose index modulo the
+					number of latches is the same; a
+					reader of table_hash may hold either
+					the mutex or the latch of the cell in
+					S mode; a writer must hold both, the
+					latch in X mode */
+	bool		open_fast_disabled;
+					/*!< true while a DDL operation has
+					reserved the data dictionary; then
+					dict_table_open_on_name() reserves
+					the mutex for every table; protected
+					by the mutex, and may be read under
+					any of hash_latches in S mode */
+#endif /* DICT_TABLE_OPEN_FAST_PATH */
 	hash_table_t*	table_id_hash;	/*!< hash table of the tables, based
 					on id */
 	ulint		size;		/*!< varying space in bytes occupied
@@ -1649,6 +1697,31 @@ dict_table_schema_check(
 	__attribute__((nonnull, warn_unused_result));
 /* @} */
 
+/*********************************************************************//**
+Checks whether a table in the dictionary cache has passed
+dict_table_schema_check() since its columns and foreign keys were last
+changed. This does not reserve dict_sys->mutex.
+@return true if the schema of the table is known to be valid, false if
+dict_table_schema_check() must be called */
+UNIV_INTERN
+bool
+dict_table_schema_check_is_cached(
+/*==============================*/
+	const char*	table_name)	/*!< in: table name */
+	__attribute__((nonnull, warn_unused_result));
+
+/*********************************************************************//**
+Sets or clears dict_table_t::schema_checked. The caller must hold
+dict_sys->mutex. */
+UNIV_INTERN
+void
+dict_table_set_schema_checked(
+/*==========================*/
+	dict_table_t*	table,		/*!< in/out: table */
+	bool		checked)	/*!< in: whether the schema of the
+					table is known to be valid */
+	__attribute__((nonnull));
+
 /*********************************************************************//**
 Converts a database and table name from filesystem encoding
 (e.g. d@i1b/a@q1b@1Kc, same format as used in dict_table_t::name) in two
@@ -34,6 +34,7 @@ Created 1/8/1996 Heikki Tuuri
 #include "row0types.h"
 #include "rem0types.h"
 #include "btr0types.h"
+#include "ibuf0types.h"
 #ifndef UNIV_HOTBACKUP
 # include "lock0types.h"
 # include "que0types.h"
@@ -616,6 +617,11 @@ struct dict_index_t{
 				during online index creation;
 				valid when online_status is
 				ONLINE_INDEX_CREATION */
+	ibuf_backlog_t*	ibuf_backlog;
+				/*!< change buffer backlog of the
+				index, or NULL if no operation has
+				been buffered for this object; see
+				ibuf_backlog_buffered() */
 	/*----------------------*/
 	/** Statistics for query optimization */
 	/* @{ */
@@ -1168,7 +1174,7 @@ struct dict_table_t{
 	const trx_t*	autoinc_trx;
 				/*!< The transaction that currently holds the
 				the AUTOINC lock on this table.
-				Protected by lock_sys->mutex. */
+				Protected by lock_sys->latch. */
 	fts_t*		fts;	/* FTS specific state variables */
 				/* @} */
 	/*----------------------*/
@@ -1184,16 +1190,31 @@ struct dict_table_t{
 				/*!< Count of the number of record locks on
 				this table. We use this to determine whether
 				we can evict the table from the dictionary
-				cache. It is protected by lock_sys->mutex. */
+				cache. It is protected by lock_sys->latch;
+				holders of the S-latch increment it with
+				atomic operations. */
 	ulint		n_ref_count;
 				/*!< count of how many handles are opened
 				to this table; dropping of the table is
 				NOT allowed until this count gets to zero;
 				MySQL does NOT itself check the number of
-				open handles at drop */
+				open handles at drop. Protected by
+				dict_sys->mutex, except that if
+				DICT_TABLE_OPEN_FAST_PATH is defined, a
+				nonzero count may be incremented, or
+				decremented to a nonzero value, with
+				atomic operations without the mutex */
+	bool		schema_checked;
+				/*!< true if the table has passed
+				dict_table_schema_check() and its columns
+				and foreign keys have not changed since;
+				written by dict_table_set_schema_checked()
+				under dict_sys->mutex and the
+				dict_sys->hash_latches latch of the table
+				in X mode; may be read under either */
 	UT_LIST_BASE_NODE_T(lock_t)
 			locks;	/*!< list of locks on the table; protected
-				by lock_sys->mutex */
+				by lock_sys->latch */
 #endif /* !UNIV_HOTBACKUP */
 
 #ifdef UNIV_DEBUG
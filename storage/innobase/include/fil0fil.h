@@ -159,6 +159,10 @@ extern fil_addr_t	fil_addr_null;
 #define FIL_PAGE_TYPE_ZBLOB2	12	/*!< Subsequent compressed BLOB page */
 #define FIL_PAGE_TYPE_LAST	FIL_PAGE_TYPE_ZBLOB2
 					/*!< Last page type */
+#define FIL_PAGE_COMPRESSED	14	/*!< Page image compressed on write
+					by innodb_page_compression. It only
+					exists on disk: the buffer pool never
+					holds a page of this type. */
 /* @} */
 
 /** Space types @{ */
@@ -618,14 +622,37 @@ fil_open_single_table_tablespace(
 	const char*	filepath)	/*!< in: tablespace filepath */
 	__attribute__((nonnull(5), warn_unused_result));
 
+/********************************************************************//**
+Registers a single-table tablespace of the data dictionary in the memory
+cache without opening its .ibd file in the default location. The file is
+opened on the first i/o, or when fil_space_for_table_exists_in_mem() is
+called for the table; if it cannot be opened then, the space is removed
+from the cache again. Used at a normal startup if srv_lazy_tablespace_open
+is set.
+@return	DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+fil_space_create_deferred(
+/*======================*/
+	ulint		id,		/*!< in: space id */
+	ulint		flags,		/*!< in: tablespace flags */
+	const char*	tablename)	/*!< in: table name in the
+					databasename/tablename format */
+	__attribute__((nonnull, warn_unused_result));
+
 #endif /* !UNIV_HOTBACKUP */
+
+/** Maximum number of threads in fil_load_single_table_tablespaces() */
+#define FIL_LOAD_THREADS_MAX	64
+
 /********************************************************************//**
 At the server startup, if we need crash recovery, scans the database
 directories under the MySQL datadir, looking for .ibd files. Those files are
 single-table tablespaces. We need to know the space id in each of them so that
 we know into which file we should look to check the contents of a page stored
 in the doublewrite buffer, also to know where to apply log records where the
-space id is != 0.
+space id is != 0. The directories are scanned first, and the files found are
+then opened and validated by srv_tablespace_discovery_threads threads.
 @return	DB_SUCCESS or error number */
 UNIV_INTERN
 dberr_t
@@ -766,6 +793,19 @@ fil_io(
 	void*	message)	/*!< in: message for aio handler if non-sync
 				aio used, else ignored */
 	__attribute__((nonnull(8)));
+/********************************************************************//**
+Releases the unused tail of a page that was written with fewer than
+UNIV_PAGE_SIZE bytes by innodb_page_compression, once the write has
+completed. This is best effort: if the file is not open, or its file system
+does not support punching holes, the tail simply stays allocated. */
+UNIV_INTERN
+void
+fil_page_punch_hole(
+/*================*/
+	ulint	space_id,	/*!< in: space id */
+	ulint	page_no,	/*!< in: page number */
+	ulint	len);		/*!< in: number of bytes written at the
+				start of the page */
 /**********************************************************************//**
 Waits for an aio operation to complete. This function is used to write the
 handler for completed requests. The aio array of pending requests is divided
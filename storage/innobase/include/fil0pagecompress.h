@@ -0,0 +1,130 @@
+/*****************************************************************************
+
+Copyright (c) 2026, the contributors of this file. See the version control
+history for the individual authors.
+
+This file is a contribution to MySQL. It is distributed under the same
+license as the rest of the server, with no copyright assigned to Oracle.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/fil0pagecompress.h
+Compression of uncompressed pages on the write path (page compression with
+hole punching)
+
+Unlike ROW_FORMAT=COMPRESSED, the buffer pool only holds the uncompressed
+page. The page is compressed just before it is written to the data file, the
+write is shortened to the compressed size rounded up to
+FIL_PAGE_COMPRESS_BLOCK_SIZE, and the rest of the page is released with
+os_file_punch_hole(). A read decompresses the page back into the frame.
+
+Layout of a compressed page image:
+
+FIL_PAGE_SPACE_OR_CHKSUM .. FIL_PAGE_LSN: as on the uncompressed page
+FIL_PAGE_TYPE: FIL_PAGE_COMPRESSED
+FIL_PAGE_FILE_FLUSH_LSN: the compression header below
+FIL_PAGE_SPACE_ID: as on the uncompressed page
+FIL_PAGE_DATA..: the compressed bytes FIL_PAGE_DATA..UNIV_PAGE_SIZE of the
+uncompressed page
+
+The checksum stored in the image is that of the uncompressed page, so it is
+verified after decompression like for any other page.
+
+Created 10/18/2026
+*******************************************************/
+
+#ifndef fil0pagecompress_h
+#define fil0pagecompress_h
+
+#include "univ.i"
+#include "fil0fil.h"
+
+/** Algorithms of innodb_page_compression */
+enum fil_page_compression_t {
+	FIL_PAGE_COMPRESSION_NONE = 0,	/*!< pages are written as is */
+	FIL_PAGE_COMPRESSION_ZLIB,	/*!< zlib deflate, at the level of
+					innodb_compression_level */
+	FIL_PAGE_COMPRESSION_LZ4	/*!< LZ4, if available at build time */
+};
+
+/** The compression header, stored in the FIL_PAGE_FILE_FLUSH_LSN field
+of a FIL_PAGE_COMPRESSED page @{ */
+#define FIL_PAGE_COMP_VERSION	FIL_PAGE_FILE_FLUSH_LSN
+					/*!< format version (1 byte) */
+#define FIL_PAGE_COMP_ALGORITHM	(FIL_PAGE_FILE_FLUSH_LSN + 1)
+					/*!< fil_page_compression_t (1 byte) */
+#define FIL_PAGE_COMP_ORIG_TYPE	(FIL_PAGE_FILE_FLUSH_LSN + 2)
+					/*!< FIL_PAGE_TYPE of the uncompressed
+					page (2 bytes) */
+#define FIL_PAGE_COMP_SIZE	(FIL_PAGE_FILE_FLUSH_LSN + 4)
+					/*!< length of the compressed data
+					following FIL_PAGE_DATA (2 bytes) */
+/* @} */
+
+/** Current format version of FIL_PAGE_COMPRESSED pages */
+#define FIL_PAGE_COMP_VERSION_1	1
+
+/** The length of a compressed page write is rounded up to this. It is the
+usual file system block size, which is also the unit of hole punching. */
+#define FIL_PAGE_COMPRESS_BLOCK_SIZE	4096
+
+/** innodb_page_compression: a fil_page_compression_t */
+extern ulong	fil_page_compression;
+
+/********************************************************************//**
+Checks whether the page image was compressed by fil_page_compress().
+@return	true if the page must be decompressed before it is used */
+UNIV_INLINE
+bool
+fil_page_is_compressed(
+/*===================*/
+	const byte*	page)	/*!< in: page image read from a file */
+	__attribute__((nonnull, pure));
+
+/********************************************************************//**
+Compresses an uncompressed page for writing. The page checksum must
+already have been computed.
+@return	number of bytes to write from out, a multiple of
+FIL_PAGE_COMPRESS_BLOCK_SIZE, or 0 if the page should be written
+uncompressed because it would not save a block */
+UNIV_INTERN
+ulint
+fil_page_compress(
+/*==============*/
+	const byte*	page,		/*!< in: uncompressed page */
+	byte*		out,		/*!< out: compressed page image,
+					UNIV_PAGE_SIZE bytes */
+	ulint		algorithm)	/*!< in: fil_page_compression_t */
+	__attribute__((nonnull, warn_unused_result));
+
+/********************************************************************//**
+Decompresses a page image that was written by fil_page_compress(), in
+place.
+@return	true if success, false if the image is corrupted or was written
+with an algorithm that this server does not support */
+UNIV_INTERN
+bool
+fil_page_decompress(
+/*================*/
+	byte*		page)		/*!< in/out: FIL_PAGE_COMPRESSED image;
+					out: uncompressed page */
+	__attribute__((nonnull, warn_unused_result));
+
+#ifndef UNIV_NONINL
+#include "fil0pagecompress.ic"
+#endif
+
+#endif /* fil0pagecompress_h */
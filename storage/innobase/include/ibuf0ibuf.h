@@ -364,6 +364,14 @@ void
 ibuf_delete_for_discarded_space(
 /*============================*/
 	ulint	space);	/*!< in: space id */
+/****************************************************************//**
+Forgets the change buffer backlog of an index whose tree is being
+dropped. */
+UNIV_INTERN
+void
+ibuf_backlog_drop_index(
+/*====================*/
+	index_id_t	index_id);	/*!< in: index id */
 /*********************************************************************//**
 Contracts insert buffer trees by reading pages to the buffer pool.
 @return a lower limit for the combined size in bytes of entries which
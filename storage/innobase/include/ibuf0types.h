@@ -27,5 +27,6 @@ Created 7/29/1997 Heikki Tuuri
 #define ibuf0types_h
 
 struct ibuf_t;
+struct ibuf_backlog_t;
 
 #endif
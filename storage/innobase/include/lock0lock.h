@@ -635,7 +635,7 @@ lock_print_info_all_transactions(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys->mutex. */
+The caller must be holding lock_sys->latch. */
 UNIV_INTERN
 ulint
 lock_number_of_rows_locked(
@@ -909,10 +909,24 @@ struct lock_op_t{
 
 /** The lock system struct */
 struct lock_sys_t{
-	ib_mutex_t	mutex;			/*!< Mutex protecting the
-						locks */
+	rw_lock_t	latch;			/*!< Latch protecting the
+						locks. Table locks, lock waits,
+						deadlock detection and any
+						operation on the record locks
+						of more than one page need it
+						in X mode; see
+						lock_mutex_enter(). The record
+						lock fast paths hold it in S
+						mode together with the
+						rec_mutexes shard of the page */
 	hash_table_t*	rec_hash;		/*!< hash table of the record
 						locks */
+	ib_mutex_t*	rec_mutexes;		/*!< Mutexes protecting shards
+						of rec_hash for the holders of
+						an S-latch on lock_sys->latch;
+						the shard of a page is its
+						rec_hash cell modulo
+						LOCK_REC_HASH_N_MUTEXES */
 	ib_mutex_t	wait_mutex;		/*!< Mutex protecting the
 						next two fields */
 	srv_slot_t*	waiting_threads;	/*!< Array  of user threads
@@ -927,7 +941,7 @@ struct lock_sys_t{
 						/*!< TRUE if rollback of all
 						recovered transactions is
 						complete. Protected by
-						lock_sys->mutex */
+						lock_sys->latch */
 
 	ulint		n_lock_max_wait_time;	/*!< Max wait time */
 
@@ -943,20 +957,29 @@ struct lock_sys_t{
 /** The lock system */
 extern lock_sys_t*	lock_sys;
 
-/** Test if lock_sys->mutex can be acquired without waiting. */
-#define lock_mutex_enter_nowait() mutex_enter_nowait(&lock_sys->mutex)
+/** Number of mutexes in lock_sys->rec_mutexes; must be a power of 2 */
+#define LOCK_REC_HASH_N_MUTEXES	64
+
+/** Test if lock_sys->latch can be X-latched without waiting.
+@return	nonzero if the latch could not be acquired */
+#define lock_mutex_enter_nowait()				\
+	(!rw_lock_x_lock_nowait(&lock_sys->latch))
 
-/** Test if lock_sys->mutex is owned. */
-#define lock_mutex_own() mutex_own(&lock_sys->mutex)
+/** Test if lock_sys->latch is X-latched by the current thread. */
+#define lock_mutex_own()					\
+	(rw_lock_get_writer(&lock_sys->latch) == RW_LOCK_EX	\
+	 && os_thread_eq(lock_sys->latch.writer_thread,		\
+			 os_thread_get_curr_id()))
 
-/** Acquire the lock_sys->mutex. */
+/** Acquire the lock_sys->latch in X mode. This excludes every other
+thread from the lock system, including the record lock fast paths. */
 #define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys->mutex);		\
+	rw_lock_x_lock(&lock_sys->latch);	\
 } while (0)
 
-/** Release the lock_sys->mutex. */
+/** Release the lock_sys->latch from X mode. */
 #define lock_mutex_exit() do {			\
-	mutex_exit(&lock_sys->mutex);		\
+	rw_lock_x_unlock(&lock_sys->latch);	\
 } while (0)
 
 /** Test if lock_sys->wait_mutex is owned. */
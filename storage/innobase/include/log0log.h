@@ -70,6 +70,38 @@ extern	ibool	log_debug_writes;
 /** Maximum number of log groups in log_group_t::checkpoint_buf */
 #define LOG_MAX_N_GROUPS	32
 
+/** Number of events the threads waiting for the log_writer and
+log_flusher threads are spread over, by the log block of their lsn */
+#define LOG_WAIT_EVENTS		32
+
+/** Number of log buffer regions that may be filled in concurrently
+after log_sys->mutex has been released; see log_copy_open() */
+#define LOG_COPY_SLOTS		64
+
+/** A region of the log buffer reserved by a mini-transaction commit.
+The space and the block headers are set up while holding log_sys->mutex,
+but the log records themselves are copied in by log_copy_low() after the
+mutex has been released, so that concurrent commits only serialize on
+the lsn arithmetic and not on the memcpy. */
+struct log_copy_t {
+	lsn_t		start_lsn;	/*!< lsn where the region starts */
+	ulint		offset;		/*!< offset in log_sys->buf where
+					the next byte is to be copied */
+	ulint		slot;		/*!< index in log_sys->copy_slots,
+					or ULINT_UNDEFINED if the records
+					are copied while holding the log
+					mutex */
+};
+
+/** Maximum number of file segments a log read is split into */
+#define LOG_READ_SEGS_MAX	4
+
+/** A contiguous part of a log segment read, within one log file */
+struct log_read_seg_t {
+	lsn_t		offset;		/*!< offset within the log group */
+	ulint		len;		/*!< length in bytes */
+};
+
 /*******************************************************************//**
 Calculates where in log files we find a specified lsn.
 @return	log file number */
@@ -98,7 +130,30 @@ log_reserve_and_write_fast(
 /*=======================*/
 	const void*	str,	/*!< in: string */
 	ulint		len,	/*!< in: string length */
-	lsn_t*		start_lsn);/*!< out: start lsn of the log record */
+	lsn_t*		start_lsn,/*!< out: start lsn of the log record */
+	log_copy_t*	copy);	/*!< out: if copy->slot != ULINT_UNDEFINED,
+				the string must be copied with
+				log_copy_low() after log_release() */
+/************************************************************//**
+Registers a log buffer region about to be reserved at the current lsn, so
+that its log records can be copied in after the log mutex is released.
+The caller must own the log mutex.
+@return	true if the copy can be deferred, false if there are no free
+slots and the records must be copied while holding the log mutex */
+UNIV_INLINE
+bool
+log_copy_open(
+/*==========*/
+	log_copy_t*	copy);	/*!< out: reserved region */
+/************************************************************//**
+Marks a deferred copy completed, making the region available to the log
+writer. The caller must not own the log mutex. */
+UNIV_INLINE
+void
+log_copy_close(
+/*===========*/
+	const log_copy_t*	copy);	/*!< in: region filled in by
+					log_copy_low() */
 /***********************************************************************//**
 Releases the log mutex. */
 UNIV_INLINE
@@ -133,6 +188,27 @@ log_write_low(
 	byte*	str,		/*!< in: string */
 	ulint	str_len);	/*!< in: string length */
 /************************************************************//**
+Reserves space for the string of the given length in the log buffer,
+like log_write_low() but without copying the string. It is assumed
+that the caller holds the log mutex and has called log_copy_open(). */
+UNIV_INTERN
+void
+log_reserve_low(
+/*============*/
+	ulint	str_len);	/*!< in: string length */
+/************************************************************//**
+Copies a string to a log buffer region reserved with log_reserve_low()
+or log_reserve_and_write_fast(), skipping the log block headers and
+trailers. The log mutex must not be held. Several strings may be copied
+in order to the same region. */
+UNIV_INTERN
+void
+log_copy_low(
+/*=========*/
+	log_copy_t*	copy,		/*!< in/out: reserved region */
+	const byte*	str,		/*!< in: string */
+	ulint		str_len);	/*!< in: string length */
+/************************************************************//**
 Closes the log.
 @return	lsn */
 UNIV_INTERN
@@ -208,6 +284,43 @@ log_write_up_to(
 	ibool	flush_to_disk);
 			/*!< in: TRUE if we want the written log
 			also to be flushed to disk */
+/******************************************************************//**
+Starts the log_writer and log_flusher threads. After this, the redo log
+is written and flushed to disk only by them, and log_write_up_to() just
+wakes them up and waits for the lsn. */
+UNIV_INTERN
+void
+log_writer_threads_start(void);
+/*==========================*/
+/******************************************************************//**
+Stops the log_writer and log_flusher threads and waits for them to exit.
+After this, log_write_up_to() writes and flushes the log itself. */
+UNIV_INTERN
+void
+log_writer_threads_stop(void);
+/*=========================*/
+/******************************************************************//**
+The log_writer thread writes the log buffer to the log files whenever
+some thread waits in log_write_up_to(), and hands the fsync over to the
+log_flusher thread.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg);		/*!< in: a dummy parameter required by
+				os_thread_create */
+/******************************************************************//**
+The log_flusher thread flushes the log files to disk up to what the
+log_writer has written so far, so that one fsync covers all the commits
+that arrived during the previous one.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg);		/*!< in: a dummy parameter required by
+				os_thread_create */
 /****************************************************************//**
 Does a syncronous flush of the log buffer to disk. */
 UNIV_INTERN
@@ -378,6 +491,31 @@ log_group_read_log_seg(
 	lsn_t		start_lsn,	/*!< in: read area start */
 	lsn_t		end_lsn);	/*!< in: read area end */
 /******************************************************//**
+Splits a log segment read into reads within single log files. The
+caller must own log_sys->mutex; the reads can then be issued with
+log_group_read_segs() without it, as long as the group is not resized.
+@return number of segments */
+UNIV_INTERN
+ulint
+log_group_calc_read_segs(
+/*=====================*/
+	const log_group_t*	group,	/*!< in: log group */
+	lsn_t			start_lsn,/*!< in: read area start */
+	lsn_t			end_lsn,/*!< in: read area end */
+	log_read_seg_t*		segs);	/*!< out: LOG_READ_SEGS_MAX
+					segments */
+/******************************************************//**
+Reads the segments computed by log_group_calc_read_segs() synchronously
+to a buffer. Does not need log_sys->mutex. */
+UNIV_INTERN
+void
+log_group_read_segs(
+/*================*/
+	const log_group_t*	group,	/*!< in: log group */
+	byte*			buf,	/*!< out: buffer where to read */
+	const log_read_seg_t*	segs,	/*!< in: segments */
+	ulint			n_segs);/*!< in: number of segments */
+/******************************************************//**
 Writes a buffer to a log file group. */
 UNIV_INTERN
 void
@@ -787,6 +925,24 @@ struct log_t{
 	ulint		max_buf_free;	/*!< recommended maximum value of
 					buf_free, after which the buffer is
 					flushed */
+#ifndef UNIV_HOTBACKUP
+	lsn_t		copy_slots[LOG_COPY_SLOTS];
+					/*!< start lsn of each log buffer
+					region whose records are still being
+					copied in without the log mutex, or 0
+					if the slot is free; a slot is taken
+					while holding the log mutex and freed
+					by the copying thread without it */
+	ulint		copy_slot_hint;	/*!< slot where log_copy_open()
+					starts looking for a free one;
+					protected by mutex */
+	byte*		copy_block_ptr;	/*!< unaligned copy_block */
+	byte*		copy_block;	/*!< when some copies are still in
+					progress in the last log block to
+					write, that block is written from this
+					private copy, with the data length
+					cut at the first incomplete region */
+#endif /* !UNIV_HOTBACKUP */
  #ifdef UNIV_LOG_DEBUG
 	ulint		old_buf_free;	/*!< value of buf free when log was
 					last time opened; only in the debug
@@ -878,6 +1034,34 @@ struct log_t{
 					but NOTE that to set or reset this
 					event, the thread MUST own the log
 					mutex! */
+	/** Fields used by the log_writer and log_flusher threads. They
+	are protected by writer_mutex, except that the events are set and
+	reset without it. @{ */
+	os_fast_mutex_t	writer_mutex;	/*!< mutex protecting the fields
+					below; never held while acquiring
+					the log mutex */
+	ulint		n_writer_threads;/*!< number of log_writer and
+					log_flusher threads running */
+	bool		writer_exit;	/*!< set to true to ask the log_writer
+					and log_flusher threads to exit */
+	lsn_t		write_requested_lsn;/*!< the log_writer writes the
+					log up to at least this lsn */
+	lsn_t		flush_requested_lsn;/*!< the log_flusher flushes the
+					log up to at least this lsn */
+	lsn_t		writer_written_lsn;/*!< copy of written_to_all_lsn,
+					made by the log_writer */
+	lsn_t		writer_flushed_lsn;/*!< copy of flushed_to_disk_lsn,
+					made by the log_flusher */
+	os_event_t	writer_event;	/*!< wakes up the log_writer */
+	os_event_t	flusher_event;	/*!< wakes up the log_flusher */
+	os_event_t	write_events[LOG_WAIT_EVENTS];
+					/*!< set when the log_writer has
+					written past some lsn in the log blocks
+					of the event, see log_wait_event() */
+	os_event_t	flush_events[LOG_WAIT_EVENTS];
+					/*!< like write_events, for the
+					log_flusher */
+	/* @} */
 	ulint		n_log_ios;	/*!< number of log i/os initiated thus
 					far */
 	ulint		n_log_ios_old;	/*!< number of log i/o's at the
@@ -384,8 +384,8 @@ struct recv_dblwr_t {
 struct recv_sys_t{
 #ifndef UNIV_HOTBACKUP
 	ib_mutex_t		mutex;	/*!< mutex protecting the fields apply_log_recs,
-				n_addrs, and the state field in each recv_addr
-				struct */
+				n_addrs, n_apply_threads, and the state field
+				in each recv_addr struct */
 	ib_mutex_t		writer_mutex;/*!< mutex coordinating
 				flushing between recv_writer_thread and
 				the recovery thread. */
@@ -444,6 +444,9 @@ struct recv_sys_t{
 	hash_table_t*	addr_hash;/*!< hash table of file addresses of pages */
 	ulint		n_addrs;/*!< number of not processed hashed file
 				addresses in the hash table */
+	ulint		n_apply_threads;
+				/*!< number of recv_apply_thread instances
+				still working on the current batch */
 
 	recv_dblwr_t	dblwr;
 };
@@ -483,6 +486,15 @@ extern ibool		recv_is_making_a_backup;
 #endif /* UNIV_HOTBACKUP */
 /** Maximum page number encountered in the redo log */
 extern ulint		recv_max_parsed_page_no;
+/** Number of pages to which redo log records have been applied during
+crash recovery; protected by recv_sys->mutex */
+extern ulint		recv_n_pages_applied;
+/** Time spent in redo log apply batches during crash recovery, in
+milliseconds */
+extern ulint		recv_apply_time_ms;
+
+/** Maximum number of recv_apply_thread instances */
+#define RECV_APPLY_THREADS_MAX	64
 
 /** Size of the parsing buffer; it must accommodate RECV_SCAN_SIZE many
 times! */
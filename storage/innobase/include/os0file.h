@@ -878,6 +878,19 @@ os_file_set_eof(
 /*============*/
 	FILE*		file);	/*!< in: file to be truncated */
 /***********************************************************************//**
+Deallocates the file system blocks of a byte range of a file, keeping the
+file size. The range reads back as zeroes. This is only implemented with
+fallocate(FALLOC_FL_PUNCH_HOLE) on Linux.
+@return	TRUE if success, FALSE if the file system does not support it
+or the call failed */
+UNIV_INTERN
+ibool
+os_file_punch_hole(
+/*===============*/
+	os_file_t	file,	/*!< in: handle to a file */
+	os_offset_t	offset,	/*!< in: start of the range */
+	os_offset_t	len);	/*!< in: length of the range in bytes */
+/***********************************************************************//**
 NOTE! Use the corresponding macro os_file_flush(), not directly this function!
 Flushes the write buffers of a given file to the disk.
 @return	TRUE if success */
@@ -1079,6 +1092,35 @@ UNIV_INTERN
 void
 os_aio_free(void);
 /*=============*/
+/***********************************************************************
+Registers an open data file with the io_urings, so that requests refer to
+it by index instead of by descriptor. Does nothing unless
+innodb_use_io_uring is in effect. The caller must hold the fil_system
+mutex. */
+UNIV_INTERN
+void
+os_aio_register_file(
+/*=================*/
+	os_file_t	file);	/*!< in: file handle */
+/***********************************************************************
+Removes a file from the io_urings. Must be called before the file is
+closed. The caller must hold the fil_system mutex. */
+UNIV_INTERN
+void
+os_aio_deregister_file(
+/*===================*/
+	os_file_t	file);	/*!< in: file handle */
+/***********************************************************************
+Registers memory with the io_urings, so that page i/o into it uses the
+fixed buffer operations. Does nothing unless innodb_use_io_uring is in
+effect. Can be called once, before any i/o into the memory. */
+UNIV_INTERN
+void
+os_aio_register_buffers(
+/*====================*/
+	byte**		bufs,	/*!< in: start of each block */
+	const ulint*	lens,	/*!< in: length of each block */
+	ulint		n);	/*!< in: number of blocks */
 
 /*******************************************************************//**
 NOTE! Use the corresponding macro os_aio(), not directly this function!
@@ -1132,7 +1174,9 @@ void
 os_aio_wait_until_no_pending_writes(void);
 /*=====================================*/
 /**********************************************************************//**
-Wakes up simulated aio i/o-handler threads if they have something to do. */
+Wakes up simulated aio i/o-handler threads if they have something to do.
+With Linux native aio, submits the requests that are waiting to be
+batched instead. */
 UNIV_INTERN
 void
 os_aio_simulated_wake_handler_threads(void);
@@ -736,6 +736,17 @@ architecture. Disable memory barrier for Intel architecture for now. */
 	"Memory barrier is not used"
 #endif
 
+/** Prevents the compiler from moving memory accesses across this point.
+os_rmb and os_wmb are empty on some platforms; code that relies on the
+order of plain memory accesses must use this next to them. */
+#if defined __GNUC__
+# define os_compiler_barrier()	__asm__ __volatile__("" ::: "memory")
+#elif defined _MSC_VER
+# define os_compiler_barrier()	_ReadWriteBarrier()
+#else
+# define os_compiler_barrier()
+#endif
+
 #ifndef UNIV_NONINL
 #include "os0sync.ic"
 #endif
@@ -37,6 +37,10 @@ Created 10/4/1994 Heikki Tuuri
 
 #define PAGE_CUR_ADAPT
 
+/** innodb_page_search_keys: whether page_cur_search_with_match() caches
+the key prefixes of the page directory slots in the buf_block_t */
+extern my_bool	page_cur_search_keys;
+
 /* Page cursor search modes; the values must be in this order! */
 
 #define	PAGE_CUR_UNSUPP	0
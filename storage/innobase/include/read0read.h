@@ -35,17 +35,18 @@ Created 2/16/1997 Heikki Tuuri
 #include "read0types.h"
 
 /*********************************************************************//**
-Opens a read view where exactly the transactions serialized before this
-point in time are seen in the view.
-@return	own: read view struct */
+Opens a read view for a transaction of MySQL, where exactly the transactions
+serialized before this point in time are seen in the view. Reuses the view
+that the transaction closed last, if no read-write transaction has started
+or committed since it was opened.
+@return	own: read view struct, allocated from
+trx->global_read_view_heap */
 UNIV_INTERN
 read_view_t*
-read_view_open_now(
-/*===============*/
-	trx_id_t	cr_trx_id,	/*!< in: trx_id of creating
-					transaction, or 0 used in purge */
-	mem_heap_t*	heap);		/*!< in: memory heap from which
-					allocated */
+read_view_open_for_mysql(
+/*=====================*/
+	trx_t*		trx);		/*!< in/out: transaction that has
+					no global read view */
 /*********************************************************************//**
 Makes a copy of the oldest existing read view, or opens a new. The view
 must be closed with ..._close.
@@ -67,7 +68,9 @@ read_view_remove(
 					trx_sys_t::mutex */
 /*********************************************************************//**
 Closes a consistent read view for MySQL. This function is called at an SQL
-statement end if the trx isolation level is <= TRX_ISO_READ_COMMITTED. */
+statement end if the trx isolation level is <= TRX_ISO_READ_COMMITTED.
+The view is removed from trx_sys->view_list and kept in
+trx->closed_read_view for reuse. */
 UNIV_INTERN
 void
 read_view_close_for_mysql(
@@ -153,9 +156,17 @@ struct read_view_t{
 				descending order. These trx_ids should be
 				between the "low" and "high" water marks,
 				that is, up_limit_id and low_limit_id. */
+	ulint		max_trx_ids;
+				/*!< Number of cells allocated for the
+				trx_ids array */
 	trx_id_t	creator_trx_id;
 				/*!< trx id of creating transaction, or
 				0 used in purge */
+	ulint		version;/*!< trx_sys->snapshot.version that the
+				view was copied from */
+	ibool		closed;	/*!< TRUE if the view was closed by
+				read_view_close_for_mysql() and is kept
+				outside trx_sys->view_list for reuse */
 	UT_LIST_NODE_T(read_view_t) view_list;
 				/*!< List of read views in trx_sys */
 };
@@ -111,7 +111,9 @@ struct index_def_t {
 /** Structure for reporting duplicate records. */
 struct row_merge_dup_t {
 	dict_index_t*		index;	/*!< index being sorted */
-	struct TABLE*		table;	/*!< MySQL table object */
+	struct TABLE*		table;	/*!< MySQL table object, or NULL
+					if the duplicate is not to be
+					copied to it */
 	const ulint*		col_map;/*!< mapping of column numbers
 					in table to the rebuilt table
 					(index->table), or NULL if not
@@ -370,7 +372,10 @@ row_merge_sort(
 	merge_file_t*		file,	/*!< in/out: file containing
 					index entries */
 	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
-	int*			tmpfd)	/*!< in/out: temporary file handle */
+	int*			tmpfd,	/*!< in/out: temporary file handle */
+	ulint			n_threads)
+					/*!< in: maximum number of threads
+					merging runs in parallel */
 	__attribute__((nonnull));
 /*********************************************************************//**
 Allocate a sort buffer.
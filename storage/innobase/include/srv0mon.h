@@ -181,7 +181,16 @@ enum monitor_id_t {
 	MONITOR_FLUSH_LSN_AVG_RATE,
 	MONITOR_FLUSH_PCT_FOR_DIRTY,
 	MONITOR_FLUSH_PCT_FOR_LSN,
+	MONITOR_FLUSH_CHECKPOINT_AGE,
+	MONITOR_FLUSH_TARGET_CHECKPOINT_AGE,
+	MONITOR_FLUSH_PID_FEED_FORWARD,
+	MONITOR_FLUSH_PID_ERROR,
+	MONITOR_FLUSH_PID_INTEGRAL,
 	MONITOR_FLUSH_SYNC_WAITS,
+	MONITOR_FLUSH_AVG_TIME_THREAD,
+	MONITOR_LRU_BATCH_FLUSH_AVG_TIME_THREAD,
+	MONITOR_FLUSH_AVG_PAGES_THREAD,
+	MONITOR_FLUSH_MAX_TIME_THREAD,
 	MONITOR_FLUSH_ADAPTIVE_TOTAL_PAGE,
 	MONITOR_FLUSH_ADAPTIVE_COUNT,
 	MONITOR_FLUSH_ADAPTIVE_PAGES,
@@ -202,6 +211,10 @@ enum monitor_id_t {
 	MONITOR_LRU_SINGLE_FLUSH_SCANNED_PER_CALL,
 	MONITOR_LRU_SINGLE_FLUSH_FAILURE_COUNT,
 	MONITOR_LRU_GET_FREE_SEARCH,
+	MONITOR_LRU_GET_FREE_FAST,
+	MONITOR_LRU_YOUNG_BATCHES,
+	MONITOR_LRU_GHOST_HIT_OLD,
+	MONITOR_LRU_GHOST_HIT_YOUNG,
 	MONITOR_LRU_SEARCH_SCANNED,
 	MONITOR_LRU_SEARCH_SCANNED_NUM_CALL,
 	MONITOR_LRU_SEARCH_SCANNED_PER_CALL,
@@ -255,6 +268,8 @@ enum monitor_id_t {
 	MONITOR_OVLD_OS_LOG_FSYNC,
 	MONITOR_OVLD_OS_LOG_PENDING_FSYNC,
 	MONITOR_OVLD_OS_LOG_PENDING_WRITES,
+	MONITOR_OS_AIO_SUBMIT_CALLS,
+	MONITOR_OS_AIO_MERGED,
 
 	/* Transaction related counters */
 	MONITOR_MODULE_TRX,
@@ -266,6 +281,7 @@ enum monitor_id_t {
 	MONITOR_TRX_ROLLBACK_SAVEPOINT,
 	MONITOR_TRX_ROLLBACK_ACTIVE,
 	MONITOR_TRX_ACTIVE,
+	MONITOR_READ_VIEW_REUSED,
 	MONITOR_RSEG_HISTORY_LEN,
 	MONITOR_NUM_UNDO_SLOT_USED,
 	MONITOR_NUM_UNDO_SLOT_CACHED,
@@ -277,6 +293,7 @@ enum monitor_id_t {
 	MONITOR_N_UPD_EXIST_EXTERN,
 	MONITOR_PURGE_INVOKED,
 	MONITOR_PURGE_N_PAGE_HANDLED,
+	MONITOR_PURGE_N_PAGE_PREFETCHED,
 	MONITOR_DML_PURGE_DELAY,
 	MONITOR_PURGE_STOP_COUNT,
 	MONITOR_PURGE_RESUME_COUNT,
@@ -297,6 +314,11 @@ enum monitor_id_t {
 	MONITOR_OVLD_LOG_WAITS,
 	MONITOR_OVLD_LOG_WRITE_REQUEST,
 	MONITOR_OVLD_LOG_WRITES,
+	MONITOR_LOG_COPY_INLINE,
+	MONITOR_LOG_COPY_WAITS,
+	MONITOR_LOG_WAITS_SPIN,
+	MONITOR_LOG_WAITS_EVENT,
+	MONITOR_LOG_FLUSHER_FSYNCS,
 
 	/* Page Manager related counters */
 	MONITOR_MODULE_PAGE,
@@ -304,6 +326,10 @@ enum monitor_id_t {
 	MONITOR_PAGE_DECOMPRESS,
 	MONITOR_PAD_INCREMENTS,
 	MONITOR_PAD_DECREMENTS,
+	MONITOR_PAGE_HOLE_COMPRESS,
+	MONITOR_PAGE_HOLE_DECOMPRESS,
+	MONITOR_PAGE_HOLE_SAVED,
+	MONITOR_PAGE_HOLE_PUNCH_FAILED,
 
 	/* Index related counters */
 	MONITOR_MODULE_INDEX,
@@ -339,6 +365,9 @@ enum monitor_id_t {
 	MONITOR_OVLD_IBUF_MERGE_DISCARD_PURGE,
 	MONITOR_OVLD_IBUF_MERGES,
 	MONITOR_OVLD_IBUF_SIZE,
+	MONITOR_IBUF_MERGE_SAMPLED,
+	MONITOR_IBUF_MERGE_SKIPPED,
+	MONITOR_IBUF_MERGE_READ,
 
 	/* Counters for server operations */
 	MONITOR_MODULE_SERVER,
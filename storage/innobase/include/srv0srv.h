@@ -150,6 +150,12 @@ and/or load it during startup. */
 extern char		srv_buffer_pool_dump_at_shutdown;
 extern char		srv_buffer_pool_load_at_startup;
 
+/** Number of threads reading pages during a buffer pool load */
+extern ulong		srv_buf_load_threads;
+/** Maximum number of pages per second read by a buffer pool load,
+0 means unlimited */
+extern ulong		srv_buf_load_io_capacity;
+
 /* Whether to disable file system cache if it is defined */
 extern char		srv_disable_sort_file_cache;
 
@@ -209,6 +215,9 @@ extern ibool	srv_locks_unsafe_for_binlog;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Number of threads that scan the clustered index and merge sort the
+entries when creating secondary indexes */
+extern ulong	srv_index_build_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -217,6 +226,14 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
+
+/* If this flag is TRUE, the Linux native aio uses io_uring instead of
+libaio, if InnoDB was compiled with it and the kernel supports it */
+extern my_bool	srv_use_io_uring;
+
+/* If this flag is TRUE, the io_urings use a kernel thread that polls
+the submission queues */
+extern my_bool	srv_io_uring_sqpoll;
 #ifdef __WIN__
 extern ibool	srv_use_native_conditions;
 #endif /* __WIN__ */
@@ -264,6 +281,21 @@ extern ib_uint64_t	srv_log_file_size;
 extern ib_uint64_t	srv_log_file_size_requested;
 extern ulint	srv_log_buffer_size;
 extern ulong	srv_flush_log_at_trx_commit;
+/** If TRUE, the redo log is written and flushed by the dedicated
+log_writer and log_flusher threads */
+extern my_bool	srv_log_writer_threads;
+/** Number of rounds a thread waiting for the log writer threads spins
+before it sleeps */
+extern ulong	srv_log_wait_spin_rounds;
+/** Number of threads applying redo log records during crash recovery */
+extern ulong	srv_recovery_apply_threads;
+/** Number of threads reading the headers of the .ibd files found when
+scanning the data directory at a crash recovery */
+extern ulong	srv_tablespace_discovery_threads;
+/** If TRUE, a normal startup registers the tablespaces of the data
+dictionary without opening their .ibd files; a file is looked at when
+its table is first loaded */
+extern my_bool	srv_lazy_tablespace_open;
 extern uint	srv_flush_log_at_timeout;
 extern char	srv_adaptive_flushing;
 
@@ -334,6 +366,10 @@ extern ulong	srv_max_dirty_pages_pct_lwm;
 
 extern ulong	srv_adaptive_flushing_lwm;
 extern ulong	srv_flushing_avg_loops;
+extern ulong	srv_adaptive_flushing_method;
+extern ulong	srv_adaptive_flushing_target_pct;
+
+extern ulong	srv_n_page_cleaners;
 
 extern ulong	srv_force_recovery;
 #ifndef DBUG_OFF
@@ -457,6 +493,7 @@ extern srv_stats_t	srv_stats;
 # ifdef UNIV_PFS_THREAD
 /* Keys to register InnoDB threads with performance schema */
 extern mysql_pfs_key_t	buf_page_cleaner_thread_key;
+extern mysql_pfs_key_t	buf_page_cleaner_worker_thread_key;
 extern mysql_pfs_key_t	trx_rollback_clean_thread_key;
 extern mysql_pfs_key_t	io_handler_thread_key;
 extern mysql_pfs_key_t	srv_lock_timeout_thread_key;
@@ -465,6 +502,11 @@ extern mysql_pfs_key_t	srv_monitor_thread_key;
 extern mysql_pfs_key_t	srv_master_thread_key;
 extern mysql_pfs_key_t	srv_purge_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
+extern mysql_pfs_key_t	recv_apply_thread_key;
+extern mysql_pfs_key_t	recv_scan_read_thread_key;
+extern mysql_pfs_key_t	fil_load_thread_key;
+extern mysql_pfs_key_t	log_writer_thread_key;
+extern mysql_pfs_key_t	log_flusher_thread_key;
 
 /* This macro register the current thread and its key with performance
 schema */
@@ -556,6 +598,16 @@ enum srv_stats_method_name_enum {
 	SRV_STATS_NULLS_IGNORED		/* NULL values are ignored */
 };
 
+/** Alternatives for srv_adaptive_flushing_method, which can be changed by
+setting innodb_adaptive_flushing_method */
+enum srv_flush_controller_t {
+	SRV_FLUSH_CONTROLLER_HEURISTIC,	/*!< blend of the dirty page and
+					redo space heuristics, averaged
+					over innodb_flushing_avg_loops */
+	SRV_FLUSH_CONTROLLER_PID	/*!< PID controller targeting a
+					checkpoint age set point */
+};
+
 typedef enum srv_stats_method_name_enum		srv_stats_method_name_t;
 
 #ifndef UNIV_HOTBACKUP
@@ -834,6 +886,8 @@ struct export_var_t{
 	ulint innodb_pages_created;		/*!< buf_pool->stat.n_pages_created */
 	ulint innodb_pages_read;		/*!< buf_pool->stat.n_pages_read */
 	ulint innodb_pages_written;		/*!< buf_pool->stat.n_pages_written */
+	ulint innodb_recovery_pages_applied;	/*!< recv_n_pages_applied */
+	ulint innodb_recovery_apply_time;	/*!< recv_apply_time_ms */
 	ulint innodb_row_lock_waits;		/*!< srv_n_lock_wait_count */
 	ulint innodb_row_lock_current_waits;	/*!< srv_n_lock_wait_current_count */
 	ib_int64_t innodb_row_lock_time;	/*!< srv_n_lock_wait_time
@@ -169,13 +169,47 @@ trx_sysf_rseg_set_page_no(
 					the slot is reset to unused */
 	mtr_t*		mtr);		/*!< in: mtr */
 /*****************************************************************//**
-Allocates a new transaction id.
+Allocates a new transaction id. Where 64-bit atomic operations are
+available, trx_sys->mutex is not needed.
 @return	new, allocated trx id */
 UNIV_INLINE
 trx_id_t
 trx_sys_get_new_trx_id(void);
 /*========================*/
 /*****************************************************************//**
+Assigns a new id to a read-write transaction and adds it to
+trx_sys->snapshot. The caller must hold trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_sys_snapshot_add_new(
+/*=====================*/
+	trx_t*		trx);	/*!< in/out: read-write transaction */
+/*****************************************************************//**
+Adds a transaction with an id assigned earlier to trx_sys->snapshot.
+Used for recovered transactions. The caller must hold trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_sys_snapshot_add(
+/*=================*/
+	const trx_t*	trx);	/*!< in: read-write transaction */
+/*****************************************************************//**
+Assigns the serialisation number trx->no of a committing read-write
+transaction and publishes it in trx_sys->snapshot. The caller must hold
+trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_sys_snapshot_assign_no(
+/*=======================*/
+	trx_t*		trx);	/*!< in/out: read-write transaction */
+/*****************************************************************//**
+Removes a read-write transaction from trx_sys->snapshot. The caller must
+hold trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_sys_snapshot_remove(
+/*====================*/
+	const trx_t*	trx);	/*!< in: read-write transaction */
+/*****************************************************************//**
 Determines the maximum transaction id.
 @return maximum currently allocated trx id; will be stale after the
 next call to trx_sys_get_new_trx_id() */
@@ -213,7 +247,7 @@ trx_read_trx_id(
 Looks for the trx instance with the given id in the rw trx_list.
 The caller must be holding trx_sys->mutex.
 @return	the trx handle or NULL if not found;
-the pointer must not be dereferenced unless lock_sys->mutex was
+the pointer must not be dereferenced unless lock_sys->latch was
 acquired before calling this function and is still being held */
 UNIV_INLINE
 trx_t*
@@ -233,9 +267,9 @@ trx_rw_min_trx_id(void);
 /****************************************************************//**
 Checks if a rw transaction with the given id is active. Caller must hold
 trx_sys->mutex in shared mode. If the caller is not holding
-lock_sys->mutex, the transaction may already have been committed.
+lock_sys->latch, the transaction may already have been committed.
 @return	transaction instance if active, or NULL;
-the pointer must not be dereferenced unless lock_sys->mutex was
+the pointer must not be dereferenced unless lock_sys->latch was
 acquired before calling this function and is still being held */
 UNIV_INLINE
 trx_t*
@@ -246,10 +280,10 @@ trx_rw_is_active_low(
 					that will be set if corrupt */
 /****************************************************************//**
 Checks if a rw transaction with the given id is active. If the caller is
-not holding lock_sys->mutex, the transaction may already have been
+not holding lock_sys->latch, the transaction may already have been
 committed.
 @return	transaction instance if active, or NULL;
-the pointer must not be dereferenced unless lock_sys->mutex was
+the pointer must not be dereferenced unless lock_sys->latch was
 acquired before calling this function and is still being held */
 UNIV_INLINE
 trx_t*
@@ -599,6 +633,51 @@ identifier is added to this 64-bit constant. */
 /* @} */
 
 #ifndef UNIV_HOTBACKUP
+/** An active read-write transaction in trx_sys_t::snapshot */
+struct trx_snapshot_elem_t{
+	trx_id_t	id;		/*!< trx_t::id */
+	trx_id_t	no;		/*!< trx_t::no, or TRX_ID_MAX if the
+					transaction is not committing */
+};
+
+/** A buffer of trx_sys_t::snapshot. A buffer that is replaced by a larger
+one is not freed before shutdown, because readers may still be copying
+from it. */
+struct trx_snapshot_buf_t{
+	trx_snapshot_buf_t*	retired;/*!< the buffer that this one
+					replaced, or NULL */
+	ulint			size;	/*!< number of elements in elems */
+	trx_snapshot_elem_t*	elems;	/*!< the elements */
+};
+
+/** The ids of the active read-write transactions, for creating read views
+without trx_sys->mutex. Writers hold trx_sys->mutex, and make version odd
+while they modify the snapshot and even again when they are done. A
+reader copies the snapshot between two reads of version and retries if
+version was odd or changed. A new read-write transaction gets its id
+inside such a modification, so that every read-write transaction with an
+id below the copied max_trx_id is in the copy. */
+struct trx_snapshot_t{
+	volatile ulint		version;/*!< incremented before and after
+					each modification */
+	trx_id_t		max_trx_id;
+					/*!< upper bound of the ids and
+					serialisation numbers that were
+					published in the snapshot; the
+					low limit of a read view */
+	volatile ulint		n_elems;/*!< number of active read-write
+					transactions */
+	trx_snapshot_buf_t* volatile buf;
+					/*!< the elements, sorted by id in
+					ascending order */
+};
+
+#if defined HAVE_ATOMIC_BUILTINS_64 && UNIV_WORD_SIZE >= DATA_TRX_ID_LEN
+/** Defined if trx_sys->max_trx_id is incremented with atomic operations
+and trx_sys_get_new_trx_id() can be called without trx_sys->mutex */
+# define TRX_SYS_ATOMIC_TRX_ID
+#endif
+
 /** The transaction system central memory data structure. */
 struct trx_sys_t{
 
@@ -617,7 +696,15 @@ struct trx_sys_t{
 					if such transactions exist. */
 	trx_id_t	max_trx_id;	/*!< The smallest number not yet
 					assigned as a transaction id or
-					transaction number */
+					transaction number; incremented
+					with atomic operations where
+					available, see
+					trx_sys_get_new_trx_id() */
+	trx_id_t	flushed_max_trx_id;
+					/*!< The value of max_trx_id that was
+					last written to TRX_SYS_TRX_ID_STORE;
+					protected by the trx system header
+					page latch */
 #ifdef UNIV_DEBUG
 	trx_id_t	rw_max_trx_id;	/*!< Max trx id of read-write transactions
 					which exist or existed */
@@ -659,11 +746,17 @@ struct trx_sys_t{
 	UT_LIST_BASE_NODE_T(read_view_t) view_list;
 					/*!< List of read views sorted
 					on trx no, biggest first */
+	trx_snapshot_t	snapshot;	/*!< The active read-write
+					transactions, for read views;
+					mirrors rw_trx_list except that
+					transactions are removed only
+					after they were committed in
+					memory */
 };
 
-/** When a trx id which is zero modulo this number (which must be a power of
-two) is assigned, the field TRX_SYS_TRX_ID_STORE on the transaction system
-page is updated */
+/** When a trx id is assigned that is this much or more above the value
+last written to the field TRX_SYS_TRX_ID_STORE on the transaction system
+page, the field is updated. This number must be a power of two. */
 #define TRX_SYS_TRX_ID_WRITE_MARGIN	256
 #endif /* !UNIV_HOTBACKUP */
 
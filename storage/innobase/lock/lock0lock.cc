@@ -385,11 +385,16 @@ static const ulint	lock_types = UT_ARR_SIZE(lock_compatibility_matrix);
 
 #ifdef UNIV_PFS_MUTEX
 /* Key to register mutex with performance schema */
-UNIV_INTERN mysql_pfs_key_t	lock_sys_mutex_key;
+UNIV_INTERN mysql_pfs_key_t	lock_rec_hash_mutex_key;
 /* Key to register mutex with performance schema */
 UNIV_INTERN mysql_pfs_key_t	lock_sys_wait_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
 
+#ifdef UNIV_PFS_RWLOCK
+/* Key to register rw-lock with performance schema */
+UNIV_INTERN mysql_pfs_key_t	lock_sys_latch_key;
+#endif /* UNIV_PFS_RWLOCK */
+
 #ifdef UNIV_DEBUG
 UNIV_INTERN ibool	lock_print_waits	= FALSE;
 
@@ -608,7 +613,7 @@ lock_sys_create(
 
 	lock_sys->last_slot = lock_sys->waiting_threads;
 
-	mutex_create(lock_sys_mutex_key, &lock_sys->mutex, SYNC_LOCK_SYS);
+	rw_lock_create(lock_sys_latch_key, &lock_sys->latch, SYNC_LOCK_SYS);
 
 	mutex_create(lock_sys_wait_mutex_key,
 		     &lock_sys->wait_mutex, SYNC_LOCK_WAIT_SYS);
@@ -617,6 +622,14 @@ lock_sys_create(
 
 	lock_sys->rec_hash = hash_create(n_cells);
 
+	lock_sys->rec_mutexes = static_cast<ib_mutex_t*>(
+		mem_alloc(LOCK_REC_HASH_N_MUTEXES * sizeof(ib_mutex_t)));
+
+	for (ulint i = 0; i < LOCK_REC_HASH_N_MUTEXES; i++) {
+		mutex_create(lock_rec_hash_mutex_key,
+			     &lock_sys->rec_mutexes[i], SYNC_LOCK_REC_HASH);
+	}
+
 	if (!srv_read_only_mode) {
 		lock_latest_err_file = os_file_create_tmpfile();
 		ut_a(lock_latest_err_file);
@@ -637,7 +650,13 @@ lock_sys_close(void)
 
 	hash_table_free(lock_sys->rec_hash);
 
-	mutex_free(&lock_sys->mutex);
+	for (ulint i = 0; i < LOCK_REC_HASH_N_MUTEXES; i++) {
+		mutex_free(&lock_sys->rec_mutexes[i]);
+	}
+
+	mem_free(lock_sys->rec_mutexes);
+
+	rw_lock_free(&lock_sys->latch);
 	mutex_free(&lock_sys->wait_mutex);
 
 	mem_free(lock_stack);
@@ -713,7 +732,7 @@ lock_get_src_table(
 	Other transactions could want to convert one of our implicit
 	record locks to an explicit one. For that, they would need our
 	trx mutex. Waiting locks can be removed while only holding
-	lock_sys->mutex, but this is a running transaction and cannot
+	lock_sys->latch, but this is a running transaction and cannot
 	thus be holding any waiting locks. */
 	trx_mutex_enter(trx);
 
@@ -1142,6 +1161,81 @@ lock_rec_reset_nth_bit(
 	((byte*) &lock[1])[byte_index] &= ~(1 << bit_index);
 }
 
+/*********************************************************************//**
+Gets the mutex of the lock_sys->rec_hash shard of a page. All pages whose
+record locks are in the same rec_hash cell map to the same shard.
+@return	shard mutex */
+UNIV_INLINE
+ib_mutex_t*
+lock_rec_get_mutex(
+/*===============*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+	return(lock_sys->rec_mutexes
+	       + ut_2pow_remainder(lock_rec_hash(space, page_no),
+				   LOCK_REC_HASH_N_MUTEXES));
+}
+
+/*********************************************************************//**
+Latches the record locks of one page for a fast path: S-latches
+lock_sys->latch and acquires the rec_hash shard mutex of the page. The
+caller may look at the lock queue of the page and create or extend
+granted record locks of its own transaction on it, but must not create
+waiting locks, grant or release locks, or touch table locks; for those,
+lock_mutex_enter() must be used instead. */
+UNIV_INLINE
+void
+lock_rec_mutex_enter(
+/*=================*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+#ifdef HAVE_ATOMIC_BUILTINS
+	rw_lock_s_lock(&lock_sys->latch);
+	mutex_enter(lock_rec_get_mutex(space, page_no));
+#else /* HAVE_ATOMIC_BUILTINS */
+	/* dict_table_t::n_rec_locks could not be updated by concurrent
+	holders of different shards. */
+	lock_mutex_enter();
+#endif /* HAVE_ATOMIC_BUILTINS */
+}
+
+/*********************************************************************//**
+Releases the latches acquired by lock_rec_mutex_enter(). */
+UNIV_INLINE
+void
+lock_rec_mutex_exit(
+/*================*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+#ifdef HAVE_ATOMIC_BUILTINS
+	mutex_exit(lock_rec_get_mutex(space, page_no));
+	rw_lock_s_unlock(&lock_sys->latch);
+#else /* HAVE_ATOMIC_BUILTINS */
+	lock_mutex_exit();
+#endif /* HAVE_ATOMIC_BUILTINS */
+}
+
+#ifdef UNIV_DEBUG
+/*********************************************************************//**
+Checks if the current thread may access the record lock queue of a page,
+that is, owns either lock_sys->latch in X mode or the shard mutex of the
+page.
+@return	TRUE if the record locks of the page are latched */
+static
+ibool
+lock_rec_mutex_own(
+/*===============*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+	return(lock_mutex_own()
+	       || mutex_own(lock_rec_get_mutex(space, page_no)));
+}
+#endif /* UNIV_DEBUG */
+
 /*********************************************************************//**
 Gets the first or next record lock on a page.
 @return	next lock, NULL if none exists */
@@ -1154,12 +1248,13 @@ lock_rec_get_next_on_page_const(
 	ulint	space;
 	ulint	page_no;
 
-	ut_ad(lock_mutex_own());
 	ut_ad(lock_get_type_low(lock) == LOCK_REC);
 
 	space = lock->un_member.rec_lock.space;
 	page_no = lock->un_member.rec_lock.page_no;
 
+	ut_ad(lock_rec_mutex_own(space, page_no));
+
 	for (;;) {
 		lock = static_cast<const lock_t*>(HASH_GET_NEXT(hash, lock));
 
@@ -1203,7 +1298,7 @@ lock_rec_get_first_on_page_addr(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_mutex_own(space, page_no));
 
 	for (lock = static_cast<lock_t*>(
 			HASH_GET_FIRST(lock_sys->rec_hash,
@@ -1233,9 +1328,9 @@ lock_rec_expl_exist_on_page(
 {
 	lock_t*	lock;
 
-	lock_mutex_enter();
+	lock_rec_mutex_enter(space, page_no);
 	lock = lock_rec_get_first_on_page_addr(space, page_no);
-	lock_mutex_exit();
+	lock_rec_mutex_exit(space, page_no);
 
 	return(lock);
 }
@@ -1255,7 +1350,7 @@ lock_rec_get_first_on_page(
 	ulint	space	= buf_block_get_space(block);
 	ulint	page_no	= buf_block_get_page_no(block);
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_mutex_own(space, page_no));
 
 	hash = buf_block_get_lock_hash_val(block);
 
@@ -1284,8 +1379,6 @@ lock_rec_get_next(
 	ulint	heap_no,/*!< in: heap number of the record */
 	lock_t*	lock)	/*!< in: lock */
 {
-	ut_ad(lock_mutex_own());
-
 	do {
 		ut_ad(lock_get_type_low(lock) == LOCK_REC);
 		lock = lock_rec_get_next_on_page(lock);
@@ -1319,8 +1412,6 @@ lock_rec_get_first(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
-
 	for (lock = lock_rec_get_first_on_page(block); lock;
 	     lock = lock_rec_get_next_on_page(lock)) {
 		if (lock_rec_get_nth_bit(lock, heap_no)) {
@@ -1740,7 +1831,7 @@ lock_rec_other_trx_holds_expl(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys->mutex. */
+The caller must be holding lock_sys->latch. */
 UNIV_INTERN
 ulint
 lock_number_of_rows_locked(
@@ -1800,7 +1891,6 @@ lock_rec_create(
 	ulint		n_bytes;
 	const page_t*	page;
 
-	ut_ad(lock_mutex_own());
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1812,6 +1902,12 @@ lock_rec_create(
 	page_no	= buf_block_get_page_no(block);
 	page = block->frame;
 
+	/* A waiting lock may only be created in the X mode of
+	lock_sys->latch, because it takes part in deadlock detection. */
+	ut_ad(lock_mutex_own()
+	      || (!(type_mode & LOCK_WAIT)
+		  && lock_rec_mutex_own(space, page_no)));
+
 	btr_assert_not_corrupted(block, index);
 
 	/* If rec is the supremum record, then we reset the gap and
@@ -1848,7 +1944,13 @@ lock_rec_create(
 	/* Set the bit corresponding to rec */
 	lock_rec_set_nth_bit(lock, heap_no);
 
+	/* Holders of different rec_hash shards may create record locks
+	on the same table concurrently. */
+#ifdef HAVE_ATOMIC_BUILTINS
+	os_atomic_increment_ulint(&index->table->n_rec_locks, 1);
+#else /* HAVE_ATOMIC_BUILTINS */
 	index->table->n_rec_locks++;
+#endif /* HAVE_ATOMIC_BUILTINS */
 
 	ut_ad(index->table->n_ref_count > 0 || !index->table->can_be_evicted);
 
@@ -2118,7 +2220,8 @@ there are no explicit locks on the page, or there is just one lock, owned
 by this transaction, and of the right type_mode. This is a low-level function
 which does NOT look at implicit locks! Checks lock compatibility within
 explicit locks. This function sets a normal next-key lock, or in the case of
-a page supremum record, a gap type lock.
+a page supremum record, a gap type lock. The caller must hold either the
+lock_sys->latch in X mode or the page's shard, see lock_rec_mutex_enter().
 @return whether the locking succeeded */
 UNIV_INLINE
 enum lock_rec_req_status
@@ -2141,7 +2244,8 @@ lock_rec_lock_fast(
 	trx_t*			trx;
 	enum lock_rec_req_status status = LOCK_REC_SUCCESS;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_mutex_own(buf_block_get_space(block),
+				  buf_block_get_page_no(block)));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2293,7 +2397,12 @@ lock_rec_lock(
 	dict_index_t*		index,	/*!< in: index of record */
 	que_thr_t*		thr)	/*!< in: query thread */
 {
-	ut_ad(lock_mutex_own());
+	ulint	space	= buf_block_get_space(block);
+	ulint	page_no	= buf_block_get_page_no(block);
+	enum lock_rec_req_status	status;
+	dberr_t	err;
+
+	ut_ad(!lock_mutex_own());
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2306,15 +2415,28 @@ lock_rec_lock(
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
 	/* We try a simplified and faster subroutine for the most
-	common cases */
-	switch (lock_rec_lock_fast(impl, mode, block, heap_no, index, thr)) {
+	common cases. It only needs the shard of the page, so that
+	requests on pages in other shards can proceed concurrently. */
+	lock_rec_mutex_enter(space, page_no);
+	status = lock_rec_lock_fast(impl, mode, block, heap_no, index, thr);
+	lock_rec_mutex_exit(space, page_no);
+
+	switch (status) {
 	case LOCK_REC_SUCCESS:
 		return(DB_SUCCESS);
 	case LOCK_REC_SUCCESS_CREATED:
 		return(DB_SUCCESS_LOCKED_REC);
 	case LOCK_REC_FAIL:
-		return(lock_rec_lock_slow(impl, mode, block,
-					  heap_no, index, thr));
+		/* There may be a conflict, and we may have to wait
+		and check for deadlocks: retry in the exclusive mode.
+		The fast path did not modify anything, and the slow
+		path checks the lock queue from scratch. */
+		lock_mutex_enter();
+		err = lock_rec_lock_slow(impl, mode, block,
+					 heap_no, index, thr);
+		lock_mutex_exit();
+
+		return(err);
 	}
 
 	ut_error;
@@ -2367,7 +2489,7 @@ lock_rec_has_to_wait_in_queue(
 
 /*************************************************************//**
 Grants a lock to a waiting lock request and releases the waiting transaction.
-The caller must hold lock_sys->mutex but not lock->trx->mutex. */
+The caller must hold lock_sys->latch but not lock->trx->mutex. */
 static
 void
 lock_grant(
@@ -3583,7 +3705,7 @@ lock_deadlock_lock_print(
 	}
 }
 
-/** Used in deadlock tracking. Protected by lock_sys->mutex. */
+/** Used in deadlock tracking. Protected by lock_sys->latch. */
 static ib_uint64_t	lock_mark_counter = 0;
 
 /** Check if the search is too deep. */
@@ -4850,7 +4972,7 @@ lock_remove_recovered_trx_record_locks(
 			continue;
 		}
 
-		/* Because we are holding the lock_sys->mutex,
+		/* Because we are holding the lock_sys->latch,
 		implicit locks cannot be converted to explicit ones
 		while we are scanning the explicit locks. */
 
@@ -5272,7 +5394,7 @@ lock_print_info_all_transactions(
 	}
 
 loop:
-	/* Since we temporarily release lock_sys->mutex and
+	/* Since we temporarily release lock_sys->latch and
 	trx_sys->mutex when reading a database page in below,
 	variable trx may be obsolete now and we must loop
 	through the trx list to get probably the same trx,
@@ -5505,7 +5627,7 @@ lock_table_queue_validate(
 		/* lock->trx->state cannot change from or to NOT_STARTED
 		while we are holding the trx_sys->mutex. It may change
 		from ACTIVE to PREPARED, but it may not change to
-		COMMITTED, because we are holding the lock_sys->mutex. */
+		COMMITTED, because we are holding the lock_sys->latch. */
 		ut_ad(trx_assert_started(lock->trx));
 
 		if (!lock_get_wait(lock)) {
@@ -5591,7 +5713,7 @@ lock_rec_queue_validate(
 
 		ut_ad(lock_mutex_own());
 		/* impl_trx cannot be committed until lock_mutex_exit()
-		because lock_trx_release_locks() acquires lock_sys->mutex */
+		because lock_trx_release_locks() acquires lock_sys->latch */
 
 		if (impl_trx != NULL
 		    && lock_rec_other_has_expl_req(LOCK_S, 0, LOCK_WAIT,
@@ -5927,6 +6049,8 @@ lock_rec_insert_check_and_lock(
 	dberr_t		err;
 	ulint		next_rec_heap_no;
 	ibool		inherit_in = *inherit;
+	ulint		space	= buf_block_get_space(block);
+	ulint		page_no	= buf_block_get_page_no(block);
 
 	ut_ad(block->frame == page_align(rec));
 	ut_ad(!dict_index_is_online_ddl(index)
@@ -5942,7 +6066,6 @@ lock_rec_insert_check_and_lock(
 	next_rec = page_rec_get_next_const(rec);
 	next_rec_heap_no = page_rec_get_heap_no(next_rec);
 
-	lock_mutex_enter();
 	/* Because this code is invoked for a running transaction by
 	the thread that is serving the transaction, it is not necessary
 	to hold trx->mutex here. */
@@ -5952,13 +6075,16 @@ lock_rec_insert_check_and_lock(
 	BTR_NO_LOCKING_FLAG and skip the locking altogether. */
 	ut_ad(lock_table_has(trx, index->table, LOCK_IX));
 
+	/* Look for locks on the successor only in the shard of the
+	page. No new lock can be set on the page before our insert
+	completes, because we hold the page latch. */
+	lock_rec_mutex_enter(space, page_no);
 	lock = lock_rec_get_first(block, next_rec_heap_no);
+	lock_rec_mutex_exit(space, page_no);
 
 	if (UNIV_LIKELY(lock == NULL)) {
 		/* We optimize CPU time usage in the simplest case */
 
-		lock_mutex_exit();
-
 		if (inherit_in && !dict_index_is_clust(index)) {
 			/* Update the page max trx id field */
 			page_update_max_trx_id(block,
@@ -5973,6 +6099,8 @@ lock_rec_insert_check_and_lock(
 
 	*inherit = TRUE;
 
+	lock_mutex_enter();
+
 	/* If another transaction has an explicit lock request which locks
 	the gap, waiting or granted, on the successor, the insert has to wait.
 
@@ -6088,7 +6216,7 @@ lock_rec_convert_impl_to_expl(
 		impl_trx = trx_rw_is_active(trx_id, NULL);
 
 		/* impl_trx cannot be committed until lock_mutex_exit()
-		because lock_trx_release_locks() acquires lock_sys->mutex */
+		because lock_trx_release_locks() acquires lock_sys->latch */
 
 		if (impl_trx != NULL
 		    && !lock_rec_has_expl(LOCK_X | LOCK_REC_NOT_GAP, block,
@@ -6147,8 +6275,6 @@ lock_clust_rec_modify_check_and_lock(
 
 	lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 
-	lock_mutex_enter();
-
 	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 
 	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
@@ -6156,8 +6282,6 @@ lock_clust_rec_modify_check_and_lock(
 
 	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
 
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	if (UNIV_UNLIKELY(err == DB_SUCCESS_LOCKED_REC)) {
@@ -6207,8 +6331,6 @@ lock_sec_rec_modify_check_and_lock(
 	index record, and this would not have been possible if another active
 	transaction had modified this secondary index record. */
 
-	lock_mutex_enter();
-
 	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 
 	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
@@ -6216,8 +6338,6 @@ lock_sec_rec_modify_check_and_lock(
 
 	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
 
-	lock_mutex_exit();
-
 #ifdef UNIV_DEBUG
 	{
 		mem_heap_t*	heap		= NULL;
@@ -6306,8 +6426,6 @@ lock_sec_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
 	ut_ad(mode != LOCK_X
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 	ut_ad(mode != LOCK_S
@@ -6318,8 +6436,6 @@ lock_sec_rec_read_check_and_lock(
 
 	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
 
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	return(err);
@@ -6378,8 +6494,6 @@ lock_clust_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
 	ut_ad(mode != LOCK_X
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 	ut_ad(mode != LOCK_S
@@ -6390,8 +6504,6 @@ lock_clust_rec_read_check_and_lock(
 
 	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
 
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	return(err);
@@ -6832,7 +6944,7 @@ lock_trx_release_locks(
 	}
 
 	/* The transition of trx->state to TRX_STATE_COMMITTED_IN_MEMORY
-	is protected by both the lock_sys->mutex and the trx->mutex. */
+	is protected by both the lock_sys->latch and the trx->mutex. */
 	lock_mutex_enter();
 	trx_mutex_enter(trx);
 
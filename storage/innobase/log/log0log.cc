@@ -90,8 +90,14 @@ UNIV_INTERN mysql_pfs_key_t	archive_lock_key;
 #ifdef UNIV_PFS_MUTEX
 UNIV_INTERN mysql_pfs_key_t	log_sys_mutex_key;
 UNIV_INTERN mysql_pfs_key_t	log_flush_order_mutex_key;
+UNIV_INTERN mysql_pfs_key_t	log_writer_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
 
+#ifdef UNIV_PFS_THREAD
+UNIV_INTERN mysql_pfs_key_t	log_writer_thread_key;
+UNIV_INTERN mysql_pfs_key_t	log_flusher_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
 #ifdef UNIV_DEBUG
 UNIV_INTERN ibool	log_do_write = TRUE;
 #endif /* UNIV_DEBUG */
@@ -184,6 +190,73 @@ log_buf_pool_get_oldest_modification(void)
 	return(lsn);
 }
 
+/****************************************************************//**
+Returns the lsn up to which the log buffer content is complete, that is,
+the start lsn of the oldest region still being copied in by
+log_copy_low(), or log_sys->lsn if there is none.
+@return	lsn up to which the log buffer may be written */
+static
+lsn_t
+log_copy_ready_lsn(void)
+/*====================*/
+{
+	lsn_t	lsn;
+
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+	lsn = log_sys->lsn;
+
+	for (ulint i = 0; i < LOG_COPY_SLOTS; i++) {
+		lsn_t	slot_lsn = log_sys->copy_slots[i];
+
+		if (slot_lsn != 0 && slot_lsn < lsn) {
+			lsn = slot_lsn;
+		}
+	}
+
+	/* Pairs with the barrier in log_copy_close(): the records of the
+	freed slots must be seen before they are written */
+	os_rmb;
+
+	return(lsn);
+}
+
+/****************************************************************//**
+Waits until all the log buffer regions starting below the given lsn have
+been copied in. If called while holding the log mutex, no new regions can
+be reserved and LSN_MAX waits until there are no copies in progress. The
+copying threads never wait for the log mutex. */
+static
+void
+log_copy_wait(
+/*==========*/
+	lsn_t	lsn)	/*!< in: lsn to wait for */
+{
+	ulint	i = 0;
+	ulint	rounds = 0;
+
+	while (i < LOG_COPY_SLOTS) {
+		lsn_t	slot_lsn = log_sys->copy_slots[i];
+
+		if (slot_lsn == 0 || slot_lsn >= lsn) {
+			i++;
+			continue;
+		}
+
+		if (rounds++ == 0) {
+			MONITOR_INC(MONITOR_LOG_COPY_WAITS);
+		}
+
+		if (rounds < srv_n_spin_wait_rounds) {
+			ut_delay(ut_rnd_interval(0, srv_spin_wait_delay));
+		} else {
+			os_thread_yield();
+		}
+	}
+
+	os_rmb;
+}
+
 /** Extends the log buffer.
 @param[in] len	requested minimum size in bytes */
 static
@@ -228,6 +301,9 @@ log_buffer_extend(
 		mutex_enter(&(log_sys->mutex));
 	}
 
+	/* Let the copies into the last block finish before it is moved */
+	log_copy_wait(LSN_MAX);
+
 	move_start = ut_calc_align_down(
 		log_sys->buf_free,
 		OS_FILE_LOG_BLOCK_SIZE);
@@ -366,14 +442,16 @@ loop:
 }
 
 /************************************************************//**
-Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
-UNIV_INTERN
+Advances the log buffer over a string of the given length, initializing
+the log block headers on the way, and copies the string in unless it is
+NULL. It is assumed that the caller holds the log mutex. */
+static
 void
-log_write_low(
-/*==========*/
-	byte*	str,		/*!< in: string */
-	ulint	str_len)	/*!< in: string length */
+log_buf_append(
+/*===========*/
+	const byte*	str,		/*!< in: string, or NULL if the
+					caller copies it in later */
+	ulint		str_len)	/*!< in: string length */
 {
 	log_t*	log	= log_sys;
 	ulint	len;
@@ -400,10 +478,13 @@ part_loop:
 			- LOG_BLOCK_TRL_SIZE;
 	}
 
-	ut_memcpy(log->buf + log->buf_free, str, len);
+	if (str != NULL) {
+		ut_memcpy(log->buf + log->buf_free, str, len);
+
+		str = str + len;
+	}
 
 	str_len -= len;
-	str = str + len;
 
 	log_block = static_cast<byte*>(
 		ut_align_down(
@@ -437,6 +518,78 @@ part_loop:
 	srv_stats.log_write_requests.inc();
 }
 
+/************************************************************//**
+Writes to the log the string given. It is assumed that the caller holds the
+log mutex. */
+UNIV_INTERN
+void
+log_write_low(
+/*==========*/
+	byte*	str,		/*!< in: string */
+	ulint	str_len)	/*!< in: string length */
+{
+	log_buf_append(str, str_len);
+}
+
+/************************************************************//**
+Reserves space for the string of the given length in the log buffer,
+like log_write_low() but without copying the string. It is assumed
+that the caller holds the log mutex and has called log_copy_open(). */
+UNIV_INTERN
+void
+log_reserve_low(
+/*============*/
+	ulint	str_len)	/*!< in: string length */
+{
+	log_buf_append(NULL, str_len);
+}
+
+/************************************************************//**
+Copies a string to a log buffer region reserved with log_reserve_low()
+or log_reserve_and_write_fast(), skipping the log block headers and
+trailers. The log mutex must not be held. Several strings may be copied
+in order to the same region. */
+UNIV_INTERN
+void
+log_copy_low(
+/*=========*/
+	log_copy_t*	copy,		/*!< in/out: reserved region */
+	const byte*	str,		/*!< in: string */
+	ulint		str_len)	/*!< in: string length */
+{
+	ut_ad(copy->slot < LOG_COPY_SLOTS);
+
+	/* The region cannot be moved by log_sys_check_flush_completion()
+	or log_buffer_extend() before log_copy_close(), so that
+	copy->offset stays valid without the log mutex */
+
+	while (str_len > 0) {
+		ulint	len;
+		ulint	block_offset = copy->offset % OS_FILE_LOG_BLOCK_SIZE;
+
+		if (block_offset
+		    == OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE) {
+			/* Skip the trailer and the next block header */
+			copy->offset += LOG_BLOCK_TRL_SIZE
+				+ LOG_BLOCK_HDR_SIZE;
+			continue;
+		}
+
+		ut_ad(block_offset >= LOG_BLOCK_HDR_SIZE);
+
+		len = ut_min(str_len, OS_FILE_LOG_BLOCK_SIZE
+			     - LOG_BLOCK_TRL_SIZE - block_offset);
+
+		ut_memcpy(log_sys->buf + copy->offset, str, len);
+
+		copy->offset += len;
+		str += len;
+		str_len -= len;
+	}
+
+	ut_ad(copy->offset <= log_sys->buf_size);
+}
+
 /************************************************************//**
 Closes the log.
 @return	lsn */
@@ -866,6 +1019,15 @@ log_init(void)
 	log_sys->buf_size = LOG_BUFFER_SIZE;
 	log_sys->is_extending = false;
 
+	memset(log_sys->copy_slots, 0, sizeof log_sys->copy_slots);
+	log_sys->copy_slot_hint = 0;
+
+	log_sys->copy_block_ptr = static_cast<byte*>(
+		mem_zalloc(2 * OS_FILE_LOG_BLOCK_SIZE));
+
+	log_sys->copy_block = static_cast<byte*>(
+		ut_align(log_sys->copy_block_ptr, OS_FILE_LOG_BLOCK_SIZE));
+
 	log_sys->max_buf_free = log_sys->buf_size / LOG_BUF_FLUSH_RATIO
 		- LOG_BUF_FLUSH_MARGIN;
 	log_sys->check_flush_or_checkpoint = TRUE;
@@ -896,6 +1058,23 @@ log_init(void)
 
 	os_event_set(log_sys->one_flushed_event);
 
+	os_fast_mutex_init(log_writer_mutex_key, &log_sys->writer_mutex);
+
+	log_sys->n_writer_threads = 0;
+	log_sys->writer_exit = false;
+	log_sys->write_requested_lsn = 0;
+	log_sys->flush_requested_lsn = 0;
+	log_sys->writer_written_lsn = 0;
+	log_sys->writer_flushed_lsn = 0;
+
+	log_sys->writer_event = os_event_create();
+	log_sys->flusher_event = os_event_create();
+
+	for (ulint i = 0; i < LOG_WAIT_EVENTS; i++) {
+		log_sys->write_events[i] = os_event_create();
+		log_sys->flush_events[i] = os_event_create();
+	}
+
 	/*----------------------------*/
 
 	log_sys->next_checkpoint_no = 0;
@@ -1134,7 +1313,9 @@ log_sys_check_flush_completion(void)
 
 		if (log_sys->write_end_offset > log_sys->max_buf_free / 2) {
 			/* Move the log buffer content to the start of the
-			buffer */
+			buffer, once the copies in progress have completed */
+
+			log_copy_wait(LSN_MAX);
 
 			move_start = ut_calc_align_down(
 				log_sys->write_end_offset,
@@ -1420,14 +1601,13 @@ loop:
 }
 
 /******************************************************//**
-This function is called, e.g., when a transaction wants to commit. It checks
-that the log has been written to the log file up to the last log entry written
-by the transaction. If there is a flush running, it waits and checks if the
-flush flushed enough. If not, starts a new flush. */
-UNIV_INTERN
+Writes the log up to the given lsn from the calling thread, and flushes it
+to disk if requested. If there is a flush running, it waits and checks if
+the flush flushed enough. If not, starts a new flush. */
+static
 void
-log_write_up_to(
-/*============*/
+log_write_up_to_low(
+/*================*/
 	lsn_t	lsn,	/*!< in: log sequence number up to which
 			the log should be written,
 			LSN_MAX if not specified */
@@ -1442,6 +1622,8 @@ log_write_up_to(
 	ulint		end_offset;
 	ulint		area_start;
 	ulint		area_end;
+	lsn_t		ready_lsn;
+	byte*		last_block;
 #ifdef UNIV_DEBUG
 	ulint		loop_count	= 0;
 #endif /* UNIV_DEBUG */
@@ -1472,6 +1654,12 @@ loop:
 	mutex_enter(&(log_sys->mutex));
 	ut_ad(!recv_no_log_write);
 
+	if (lsn > log_sys->lsn) {
+		/* Nobody can be waiting for log records that have not been
+		reserved yet (LSN_MAX means everything up to now) */
+		lsn = log_sys->lsn;
+	}
+
 	if (flush_to_disk
 	    && log_sys->flushed_to_disk_lsn >= lsn) {
 
@@ -1528,12 +1716,25 @@ loop:
 		return;
 	}
 
+	ready_lsn = log_copy_ready_lsn();
+
+	if (ready_lsn < lsn) {
+		/* Some mini-transactions are still copying their records
+		into the log buffer */
+
+		mutex_exit(&(log_sys->mutex));
+
+		log_copy_wait(lsn);
+
+		goto loop;
+	}
+
 #ifdef UNIV_DEBUG
 	if (log_debug_writes) {
 		fprintf(stderr,
 			"Writing log from " LSN_PF " up to lsn " LSN_PF "\n",
 			log_sys->written_to_all_lsn,
-			log_sys->lsn);
+			ready_lsn);
 	}
 #endif /* UNIV_DEBUG */
 	log_sys->n_pending_writes++;
@@ -1547,17 +1748,18 @@ loop:
 	os_event_reset(log_sys->one_flushed_event);
 
 	start_offset = log_sys->buf_next_to_write;
-	end_offset = log_sys->buf_free;
+	end_offset = log_sys->buf_free
+		- (ulint) (log_sys->lsn - ready_lsn);
 
 	area_start = ut_calc_align_down(start_offset, OS_FILE_LOG_BLOCK_SIZE);
 	area_end = ut_calc_align(end_offset, OS_FILE_LOG_BLOCK_SIZE);
 
 	ut_ad(area_end - area_start > 0);
 
-	log_sys->write_lsn = log_sys->lsn;
+	log_sys->write_lsn = ready_lsn;
 
 	if (flush_to_disk) {
-		log_sys->current_flush_lsn = log_sys->lsn;
+		log_sys->current_flush_lsn = ready_lsn;
 	}
 
 	log_sys->one_flushed = FALSE;
@@ -1567,28 +1769,75 @@ loop:
 		log_sys->buf + area_end - OS_FILE_LOG_BLOCK_SIZE,
 		log_sys->next_checkpoint_no);
 
-	/* Copy the last, incompletely written, log block a log block length
-	up, so that when the flush operation writes from the log buffer, the
-	segment to write will not be changed by writers to the log */
+	last_block = NULL;
+
+	if (ready_lsn == log_sys->lsn) {
+		/* Copy the last, incompletely written, log block a log
+		block length up, so that when the flush operation writes
+		from the log buffer, the segment to write will not be
+		changed by writers to the log */
+
+		ut_memcpy(log_sys->buf + area_end,
+			  log_sys->buf + area_end - OS_FILE_LOG_BLOCK_SIZE,
+			  OS_FILE_LOG_BLOCK_SIZE);
+
+		log_sys->buf_free += OS_FILE_LOG_BLOCK_SIZE;
+		log_sys->write_end_offset = log_sys->buf_free;
+	} else {
+		/* Copies beyond ready_lsn are still in progress, and they
+		can not be moved up. Write up to ready_lsn only: the last
+		block, if incomplete, from a private copy that ends at
+		ready_lsn. The next write starts from that block again. */
+
+		log_sys->write_end_offset = end_offset;
+
+		if (end_offset % OS_FILE_LOG_BLOCK_SIZE) {
+			ulint	data_len = end_offset % OS_FILE_LOG_BLOCK_SIZE;
+
+			last_block = log_sys->copy_block;
 
-	ut_memcpy(log_sys->buf + area_end,
-		  log_sys->buf + area_end - OS_FILE_LOG_BLOCK_SIZE,
-		  OS_FILE_LOG_BLOCK_SIZE);
+			ut_memcpy(last_block,
+				  log_sys->buf + area_end
+				  - OS_FILE_LOG_BLOCK_SIZE,
+				  OS_FILE_LOG_BLOCK_SIZE);
 
-	log_sys->buf_free += OS_FILE_LOG_BLOCK_SIZE;
-	log_sys->write_end_offset = log_sys->buf_free;
+			log_block_set_data_len(last_block, data_len);
+
+			if (log_block_get_first_rec_group(last_block)
+			    >= data_len) {
+				/* No record group starts in the part
+				written now */
+				log_block_set_first_rec_group(last_block, 0);
+			}
+		}
+	}
 
 	group = UT_LIST_GET_FIRST(log_sys->log_groups);
 
 	/* Do the write to the log files */
 
 	while (group) {
-		log_group_write_buf(
-			group, log_sys->buf + area_start,
-			area_end - area_start,
-			ut_uint64_align_down(log_sys->written_to_all_lsn,
-					     OS_FILE_LOG_BLOCK_SIZE),
-			start_offset - area_start);
+		lsn_t	area_lsn = ut_uint64_align_down(
+			log_sys->written_to_all_lsn, OS_FILE_LOG_BLOCK_SIZE);
+
+		if (last_block == NULL) {
+			log_group_write_buf(
+				group, log_sys->buf + area_start,
+				area_end - area_start, area_lsn,
+				start_offset - area_start);
+		} else {
+			ulint	len = area_end - OS_FILE_LOG_BLOCK_SIZE
+				- area_start;
+
+			log_group_write_buf(
+				group, log_sys->buf + area_start, len,
+				area_lsn, start_offset - area_start);
+
+			log_group_write_buf(
+				group, last_block, OS_FILE_LOG_BLOCK_SIZE,
+				area_lsn + len,
+				len > 0 ? 0 : start_offset - area_start);
+		}
 
 		log_group_set_fields(group, log_sys->write_lsn);
 
@@ -1650,6 +1899,454 @@ do_waits:
 	}
 }
 
+/******************************************************//**
+Returns the event a thread waiting for the log_writer or log_flusher to
+reach an lsn waits on. The waiters are spread over LOG_WAIT_EVENTS events
+by the log block of the lsn, so that a write or flush only wakes up the
+threads whose lsn it has reached, plus a few neighbours.
+@return	index in log_sys->write_events and log_sys->flush_events */
+UNIV_INLINE
+ulint
+log_wait_event_no(
+/*==============*/
+	lsn_t	lsn)	/*!< in: lsn waited for */
+{
+	return((ulint) ((lsn / OS_FILE_LOG_BLOCK_SIZE) % LOG_WAIT_EVENTS));
+}
+
+/******************************************************//**
+Wakes up the threads waiting for an lsn in the range that the log_writer
+or log_flusher has just advanced over. */
+static
+void
+log_wait_events_set(
+/*================*/
+	os_event_t*	events,		/*!< in: log_sys->write_events or
+					log_sys->flush_events */
+	lsn_t		old_lsn,	/*!< in: lsn before the advance */
+	lsn_t		new_lsn)	/*!< in: lsn after the advance */
+{
+	lsn_t	first = old_lsn / OS_FILE_LOG_BLOCK_SIZE;
+	lsn_t	last = new_lsn / OS_FILE_LOG_BLOCK_SIZE;
+
+	if (new_lsn <= old_lsn) {
+		return;
+	}
+
+	if (last - first >= LOG_WAIT_EVENTS) {
+		first = 0;
+		last = LOG_WAIT_EVENTS - 1;
+	}
+
+	for (lsn_t i = first; i <= last; i++) {
+		os_event_set(events[i % LOG_WAIT_EVENTS]);
+	}
+}
+
+/******************************************************//**
+Checks under writer_mutex whether the log_writer or the log_flusher has
+reached an lsn.
+@return	true if *done_lsn >= lsn */
+static
+bool
+log_writer_has_reached(
+/*===================*/
+	const lsn_t*	done_lsn,	/*!< in: &log_sys->writer_written_lsn
+					or &log_sys->writer_flushed_lsn */
+	lsn_t		lsn)		/*!< in: lsn waited for */
+{
+	bool	reached;
+
+	os_fast_mutex_lock(&log_sys->writer_mutex);
+	reached = *done_lsn >= lsn;
+	os_fast_mutex_unlock(&log_sys->writer_mutex);
+
+	return(reached);
+}
+
+/******************************************************//**
+Asks the log_writer (and the log_flusher) to write (and flush) the log up
+to an lsn, and waits for it unless wait == LOG_NO_WAIT. The thread first
+spins innodb_log_wait_spin_rounds times, trading CPU for commit latency,
+and then sleeps on the event of its lsn.
+@return	false if the log_writer threads are not running, in which case the
+caller must do the write itself */
+static
+bool
+log_writer_wait(
+/*============*/
+	lsn_t	lsn,		/*!< in: lsn to wait for */
+	ulint	wait,		/*!< in: LOG_NO_WAIT, LOG_WAIT_ONE_GROUP,
+				or LOG_WAIT_ALL_GROUPS */
+	ibool	flush_to_disk)	/*!< in: TRUE if the log must also be
+				flushed to disk */
+{
+	const lsn_t*	done_lsn;
+	os_event_t	event;
+
+	done_lsn = flush_to_disk
+		? &log_sys->writer_flushed_lsn
+		: &log_sys->writer_written_lsn;
+
+	os_fast_mutex_lock(&log_sys->writer_mutex);
+
+	if (log_sys->n_writer_threads == 0 || log_sys->writer_exit) {
+		os_fast_mutex_unlock(&log_sys->writer_mutex);
+
+		return(false);
+	}
+
+	if (*done_lsn >= lsn) {
+		os_fast_mutex_unlock(&log_sys->writer_mutex);
+
+		return(true);
+	}
+
+	if (log_sys->write_requested_lsn < lsn) {
+		log_sys->write_requested_lsn = lsn;
+	}
+
+	if (flush_to_disk && log_sys->flush_requested_lsn < lsn) {
+		log_sys->flush_requested_lsn = lsn;
+	}
+
+	os_fast_mutex_unlock(&log_sys->writer_mutex);
+
+	os_event_set(log_sys->writer_event);
+
+	if (wait == LOG_NO_WAIT) {
+
+		return(true);
+	}
+
+	for (ulint i = 0; i < srv_log_wait_spin_rounds; i++) {
+		/* Dirty read first, to avoid bouncing writer_mutex */
+		if (*done_lsn >= lsn && log_writer_has_reached(done_lsn, lsn)) {
+			MONITOR_INC(MONITOR_LOG_WAITS_SPIN);
+
+			return(true);
+		}
+
+		ut_delay(ut_rnd_interval(0, srv_spin_wait_delay));
+	}
+
+	MONITOR_INC(MONITOR_LOG_WAITS_EVENT);
+
+	event = flush_to_disk
+		? log_sys->flush_events[log_wait_event_no(lsn)]
+		: log_sys->write_events[log_wait_event_no(lsn)];
+
+	for (;;) {
+		ib_int64_t	sig_count = os_event_reset(event);
+
+		if (log_writer_has_reached(done_lsn, lsn)) {
+
+			return(true);
+		}
+
+		os_event_wait_low(event, sig_count);
+	}
+}
+
+/******************************************************//**
+This function is called, e.g., when a transaction wants to commit. It checks
+that the log has been written to the log file up to the last log entry written
+by the transaction. If the log_writer threads are running, it asks them to
+write and flush and waits for them; otherwise it does the write itself. */
+UNIV_INTERN
+void
+log_write_up_to(
+/*============*/
+	lsn_t	lsn,	/*!< in: log sequence number up to which
+			the log should be written,
+			LSN_MAX if not specified */
+	ulint	wait,	/*!< in: LOG_NO_WAIT, LOG_WAIT_ONE_GROUP,
+			or LOG_WAIT_ALL_GROUPS */
+	ibool	flush_to_disk)
+			/*!< in: TRUE if we want the written log
+			also to be flushed to disk */
+{
+	ut_ad(!srv_read_only_mode);
+
+	if (recv_no_ibuf_operations) {
+		/* Recovery is running and no operations on the log files are
+		allowed yet (the variable name .._no_ibuf_.. is misleading) */
+
+		return;
+	}
+
+	if (log_sys->n_writer_threads > 0) {
+		if (lsn == LSN_MAX) {
+			lsn = log_get_lsn();
+		}
+
+		if (log_writer_wait(lsn, wait, flush_to_disk)) {
+
+			return;
+		}
+	}
+
+	log_write_up_to_low(lsn, wait, flush_to_disk);
+}
+
+/******************************************************************//**
+Publishes how far the log has been written and flushed after a write by
+the log_writer, wakes up the threads waiting for it, and the log_flusher
+if some of them want the log flushed to disk. */
+static
+void
+log_writer_publish(void)
+/*====================*/
+{
+	lsn_t	written_lsn;
+	lsn_t	flushed_lsn;
+	lsn_t	old_written_lsn;
+	lsn_t	old_flushed_lsn;
+	bool	need_flush;
+
+	mutex_enter(&log_sys->mutex);
+	written_lsn = log_sys->written_to_all_lsn;
+	flushed_lsn = log_sys->flushed_to_disk_lsn;
+	mutex_exit(&log_sys->mutex);
+
+	os_fast_mutex_lock(&log_sys->writer_mutex);
+
+	old_written_lsn = log_sys->writer_written_lsn;
+	old_flushed_lsn = log_sys->writer_flushed_lsn;
+
+	if (written_lsn > old_written_lsn) {
+		log_sys->writer_written_lsn = written_lsn;
+	}
+
+	if (flushed_lsn > old_flushed_lsn) {
+		/* With O_DSYNC the write did the flush */
+		log_sys->writer_flushed_lsn = flushed_lsn;
+	}
+
+	need_flush = log_sys->flush_requested_lsn
+		> log_sys->writer_flushed_lsn;
+
+	os_fast_mutex_unlock(&log_sys->writer_mutex);
+
+	log_wait_events_set(log_sys->write_events,
+			    old_written_lsn, written_lsn);
+	log_wait_events_set(log_sys->flush_events,
+			    old_flushed_lsn, flushed_lsn);
+
+	if (need_flush) {
+		os_event_set(log_sys->flusher_event);
+	}
+}
+
+/******************************************************************//**
+Lets a log_writer or log_flusher thread exit. */
+static
+void
+log_writer_thread_exit(void)
+/*========================*/
+{
+	os_fast_mutex_lock(&log_sys->writer_mutex);
+	ut_a(log_sys->n_writer_threads > 0);
+	log_sys->n_writer_threads--;
+	os_fast_mutex_unlock(&log_sys->writer_mutex);
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+}
+
+/******************************************************************//**
+The log_writer thread writes the log buffer to the log files whenever
+some thread waits in log_write_up_to(), and hands the fsync over to the
+log_flusher thread.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg __attribute__((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	ut_ad(!srv_read_only_mode);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(log_writer_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	for (;;) {
+		ib_int64_t	sig_count;
+		lsn_t		requested_lsn;
+		lsn_t		written_lsn;
+		bool		quit;
+
+		sig_count = os_event_reset(log_sys->writer_event);
+
+		os_fast_mutex_lock(&log_sys->writer_mutex);
+		requested_lsn = log_sys->write_requested_lsn;
+		written_lsn = log_sys->writer_written_lsn;
+		quit = log_sys->writer_exit;
+		os_fast_mutex_unlock(&log_sys->writer_mutex);
+
+		if (requested_lsn <= written_lsn) {
+			if (quit) {
+				break;
+			}
+
+			os_event_wait_low(log_sys->writer_event, sig_count);
+			continue;
+		}
+
+		/* Write all that is in the log buffer, not only what was
+		requested: the commits arriving meanwhile will be covered */
+		log_write_up_to_low(LSN_MAX, LOG_WAIT_ALL_GROUPS, FALSE);
+
+		log_writer_publish();
+	}
+
+	log_writer_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************************//**
+The log_flusher thread flushes the log files to disk up to what the
+log_writer has written so far, so that one fsync covers all the commits
+that arrived during the previous one.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg __attribute__((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	ut_ad(!srv_read_only_mode);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(log_flusher_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	for (;;) {
+		ib_int64_t	sig_count;
+		lsn_t		requested_lsn;
+		lsn_t		written_lsn;
+		lsn_t		flushed_lsn;
+		bool		quit;
+
+		sig_count = os_event_reset(log_sys->flusher_event);
+
+		os_fast_mutex_lock(&log_sys->writer_mutex);
+		requested_lsn = log_sys->flush_requested_lsn;
+		written_lsn = log_sys->writer_written_lsn;
+		flushed_lsn = log_sys->writer_flushed_lsn;
+		quit = log_sys->writer_exit;
+		os_fast_mutex_unlock(&log_sys->writer_mutex);
+
+		if (requested_lsn <= flushed_lsn) {
+			if (quit) {
+				break;
+			}
+
+			os_event_wait_low(log_sys->flusher_event, sig_count);
+			continue;
+		}
+
+		if (written_lsn <= flushed_lsn) {
+			/* The log_writer wakes us up when it has written */
+			os_event_wait_low(log_sys->flusher_event, sig_count);
+			continue;
+		}
+
+		/* The writes up to written_lsn have completed, so this covers
+		them all, while the log_writer goes on with the next ones.
+		With O_DSYNC the OS did not buffer the log file at all, so
+		what was written is already on disk. */
+		if (srv_unix_file_flush_method != SRV_UNIX_O_DSYNC
+		    && srv_unix_file_flush_method != SRV_UNIX_NOSYNC) {
+
+			fil_flush(UT_LIST_GET_FIRST(
+					  log_sys->log_groups)->space_id);
+
+			MONITOR_INC(MONITOR_LOG_FLUSHER_FSYNCS);
+		}
+
+		mutex_enter(&log_sys->mutex);
+
+		if (log_sys->flushed_to_disk_lsn < written_lsn) {
+			log_sys->flushed_to_disk_lsn = written_lsn;
+		}
+
+		mutex_exit(&log_sys->mutex);
+
+		os_fast_mutex_lock(&log_sys->writer_mutex);
+		flushed_lsn = log_sys->writer_flushed_lsn;
+
+		if (flushed_lsn < written_lsn) {
+			log_sys->writer_flushed_lsn = written_lsn;
+		}
+
+		os_fast_mutex_unlock(&log_sys->writer_mutex);
+
+		log_wait_events_set(log_sys->flush_events,
+				    flushed_lsn, written_lsn);
+	}
+
+	log_writer_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************************//**
+Starts the log_writer and log_flusher threads. After this, the redo log
+is written and flushed to disk only by them, and log_write_up_to() just
+wakes them up and waits for the lsn. */
+UNIV_INTERN
+void
+log_writer_threads_start(void)
+/*==========================*/
+{
+	ut_ad(!srv_read_only_mode);
+	ut_a(log_sys->n_writer_threads == 0);
+
+	mutex_enter(&log_sys->mutex);
+	log_sys->writer_written_lsn = log_sys->written_to_all_lsn;
+	log_sys->writer_flushed_lsn = log_sys->flushed_to_disk_lsn;
+	mutex_exit(&log_sys->mutex);
+
+	log_sys->write_requested_lsn = log_sys->writer_written_lsn;
+	log_sys->flush_requested_lsn = log_sys->writer_flushed_lsn;
+	log_sys->writer_exit = false;
+	log_sys->n_writer_threads = 2;
+
+	os_thread_create(log_writer_thread, NULL, NULL);
+	os_thread_create(log_flusher_thread, NULL, NULL);
+}
+
+/******************************************************************//**
+Stops the log_writer and log_flusher threads and waits for them to exit.
+After this, log_write_up_to() writes and flushes the log itself. */
+UNIV_INTERN
+void
+log_writer_threads_stop(void)
+/*=========================*/
+{
+	os_fast_mutex_lock(&log_sys->writer_mutex);
+	log_sys->writer_exit = true;
+	os_fast_mutex_unlock(&log_sys->writer_mutex);
+
+	/* The threads serve the requests made before writer_exit was set
+	before they exit */
+
+	while (log_sys->n_writer_threads > 0) {
+		os_event_set(log_sys->writer_event);
+		os_event_set(log_sys->flusher_event);
+
+		os_thread_sleep(10000);
+	}
+}
+
 /****************************************************************//**
 Does a syncronous flush of the log buffer to disk. */
 UNIV_INTERN
@@ -2344,6 +3041,83 @@ loop:
 	}
 }
 
+/******************************************************//**
+Splits a log segment read into reads within single log files. The
+caller must own log_sys->mutex; the reads can then be issued with
+log_group_read_segs() without it, as long as the group is not resized.
+@return number of segments */
+UNIV_INTERN
+ulint
+log_group_calc_read_segs(
+/*=====================*/
+	const log_group_t*	group,	/*!< in: log group */
+	lsn_t			start_lsn,/*!< in: read area start */
+	lsn_t			end_lsn,/*!< in: read area end */
+	log_read_seg_t*		segs)	/*!< out: LOG_READ_SEGS_MAX
+					segments */
+{
+	ulint	n = 0;
+
+	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(end_lsn > start_lsn);
+
+	while (start_lsn != end_lsn) {
+		lsn_t	source_offset;
+		ulint	len;
+
+		ut_a(n < LOG_READ_SEGS_MAX);
+
+		source_offset = log_group_calc_lsn_offset(start_lsn, group);
+
+		ut_a(end_lsn - start_lsn <= ULINT_MAX);
+		len = (ulint) (end_lsn - start_lsn);
+
+		if ((source_offset % group->file_size) + len
+		    > group->file_size) {
+
+			len = (ulint) (group->file_size
+				       - (source_offset % group->file_size));
+		}
+
+		segs[n].offset = source_offset;
+		segs[n].len = len;
+		n++;
+
+		log_sys->n_log_ios++;
+
+		start_lsn += len;
+	}
+
+	return(n);
+}
+
+/******************************************************//**
+Reads the segments computed by log_group_calc_read_segs() synchronously
+to a buffer. Does not need log_sys->mutex. */
+UNIV_INTERN
+void
+log_group_read_segs(
+/*================*/
+	const log_group_t*	group,	/*!< in: log group */
+	byte*			buf,	/*!< out: buffer where to read */
+	const log_read_seg_t*	segs,	/*!< in: segments */
+	ulint			n_segs)	/*!< in: number of segments */
+{
+	for (ulint i = 0; i < n_segs; i++) {
+
+		MONITOR_INC(MONITOR_LOG_IO);
+
+		ut_a(segs[i].offset / UNIV_PAGE_SIZE <= ULINT_MAX);
+
+		fil_io(OS_FILE_READ | OS_FILE_LOG, true, group->space_id, 0,
+		       (ulint) (segs[i].offset / UNIV_PAGE_SIZE),
+		       (ulint) (segs[i].offset % UNIV_PAGE_SIZE),
+		       segs[i].len, buf, NULL);
+
+		buf += segs[i].len;
+	}
+}
+
 #ifdef UNIV_LOG_ARCHIVE
 /******************************************************//**
 Generates an archived log file name. */
@@ -3320,6 +4094,9 @@ loop:
 		}
 	}
 
+	/* The rest of the shutdown writes the log from this thread */
+	log_writer_threads_stop();
+
 	mutex_enter(&log_sys->mutex);
 	server_busy = log_sys->n_pending_checkpoint_writes
 #ifdef UNIV_LOG_ARCHIVE
@@ -3702,10 +4479,25 @@ log_shutdown(void)
 	mem_free(log_sys->checkpoint_buf_ptr);
 	log_sys->checkpoint_buf_ptr = NULL;
 	log_sys->checkpoint_buf = NULL;
+	mem_free(log_sys->copy_block_ptr);
+	log_sys->copy_block_ptr = NULL;
+	log_sys->copy_block = NULL;
 
 	os_event_free(log_sys->no_flush_event);
 	os_event_free(log_sys->one_flushed_event);
 
+	ut_a(log_sys->n_writer_threads == 0);
+
+	os_event_free(log_sys->writer_event);
+	os_event_free(log_sys->flusher_event);
+
+	for (ulint i = 0; i < LOG_WAIT_EVENTS; i++) {
+		os_event_free(log_sys->write_events[i]);
+		os_event_free(log_sys->flush_events[i]);
+	}
+
+	os_fast_mutex_free(&log_sys->writer_mutex);
+
 	rw_lock_free(&log_sys->checkpoint_lock);
 
 	mutex_free(&log_sys->mutex);
@@ -142,6 +142,14 @@ static ulint	recv_previous_parsed_rec_is_multi;
 /** Maximum page number encountered in the redo log */
 UNIV_INTERN ulint	recv_max_parsed_page_no;
 
+/** Number of pages to which redo log records have been applied during
+crash recovery; protected by recv_sys->mutex */
+UNIV_INTERN ulint	recv_n_pages_applied;
+
+/** Time spent in redo log apply batches during crash recovery, in
+milliseconds */
+UNIV_INTERN ulint	recv_apply_time_ms;
+
 /** This many frames must be left free in the buffer pool when we scan
 the log and store the scanned log records in the buffer pool: we will
 use these free frames to read in pages when we start applying the
@@ -166,6 +174,8 @@ UNIV_INTERN mysql_pfs_key_t	recv_sys_mutex_key;
 #ifndef UNIV_HOTBACKUP
 # ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t	recv_writer_thread_key;
+UNIV_INTERN mysql_pfs_key_t	recv_apply_thread_key;
+UNIV_INTERN mysql_pfs_key_t	recv_scan_read_thread_key;
 # endif /* UNIV_PFS_THREAD */
 
 # ifdef UNIV_PFS_MUTEX
@@ -414,6 +424,7 @@ recv_sys_init(
 
 	recv_sys->addr_hash = hash_create(available_memory / 512);
 	recv_sys->n_addrs = 0;
+	recv_sys->n_apply_threads = 0;
 
 	recv_sys->apply_log_recs = FALSE;
 	recv_sys->apply_batch_on = FALSE;
@@ -1775,6 +1786,7 @@ recv_recover_page_func(
 
 	ut_a(recv_sys->n_addrs);
 	recv_sys->n_addrs--;
+	recv_n_pages_applied++;
 
 	mutex_exit(&(recv_sys->mutex));
 
@@ -1829,9 +1841,113 @@ recv_read_in_area(
 	return(n);
 }
 
+/*******************************************************************//**
+Applies the hashed log records of one partition of recv_sys->addr_hash.
+The partition consists of the hash cells first, first + step, ... so that
+all the records of a (space, page) pair are handled by the same thread.
+In the prefetch pass only reads are issued for the pages that are not in
+the buffer pool; the records of those pages are applied by the i/o handler
+threads when the reads complete. */
+static
+void
+recv_apply_hashed_log_recs_part(
+/*============================*/
+	ulint	first,		/*!< in: first hash cell of the partition */
+	ulint	step,		/*!< in: number of partitions */
+	bool	prefetch)	/*!< in: true=only issue page reads */
+{
+	recv_addr_t*	recv_addr;
+	ulint		i;
+	mtr_t		mtr;
+
+	mutex_enter(&(recv_sys->mutex));
+
+	for (i = first; i < hash_get_n_cells(recv_sys->addr_hash); i += step) {
+
+		for (recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_FIRST(recv_sys->addr_hash, i));
+		     recv_addr != 0;
+		     recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_NEXT(addr_hash, recv_addr))) {
+
+			ulint	space = recv_addr->space;
+			ulint	zip_size = fil_space_get_zip_size(space);
+			ulint	page_no = recv_addr->page_no;
+
+			if (recv_addr->state != RECV_NOT_PROCESSED) {
+				continue;
+			}
+
+			mutex_exit(&(recv_sys->mutex));
+
+			if (!buf_page_peek(space, page_no)) {
+				recv_read_in_area(space, zip_size, page_no);
+			} else if (!prefetch) {
+				buf_block_t*	block;
+
+				mtr_start(&mtr);
+
+				block = buf_page_get(
+					space, zip_size, page_no,
+					RW_X_LATCH, &mtr);
+				buf_block_dbg_add_level(
+					block, SYNC_NO_ORDER_CHECK);
+
+				recv_recover_page(FALSE, block);
+				mtr_commit(&mtr);
+			}
+
+			mutex_enter(&(recv_sys->mutex));
+		}
+	}
+
+	mutex_exit(&(recv_sys->mutex));
+}
+
+/** Partition numbers passed to the recv_apply_thread instances */
+static ulint	recv_apply_thread_ids[RECV_APPLY_THREADS_MAX];
+
+/******************************************************************//**
+Worker thread of a log apply batch. It first issues the reads for the
+pages of its partition of recv_sys->addr_hash that are not in the buffer
+pool, and then applies the records of the pages that are.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(
+/*==============================*/
+	void*	arg)	/*!< in: pointer to the partition number */
+{
+	ulint	id = *static_cast<ulint*>(arg);
+	ulint	n_threads;
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_apply_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	n_threads = ut_min(ut_max(srv_recovery_apply_threads, 1),
+			   RECV_APPLY_THREADS_MAX);
+
+	recv_apply_hashed_log_recs_part(id, n_threads, true);
+	recv_apply_hashed_log_recs_part(id, n_threads, false);
+
+	mutex_enter(&(recv_sys->mutex));
+	ut_a(recv_sys->n_apply_threads > 0);
+	recv_sys->n_apply_threads--;
+	mutex_exit(&(recv_sys->mutex));
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /*******************************************************************//**
 Empties the hash table of stored log records, applying them to appropriate
-pages. */
+pages. The hash table is partitioned by (space, page) among
+srv_recovery_apply_threads recv_apply_thread instances. */
 UNIV_INTERN
 void
 recv_apply_hashed_log_recs(
@@ -1846,10 +1962,13 @@ recv_apply_hashed_log_recs(
 				the caller must in this case own the log
 				mutex */
 {
-	recv_addr_t* recv_addr;
 	ulint	i;
+	ulint	n_threads;
+	ulint	n_total;
+	ulint	n_applied_start;
+	ulint	last_percent	= 0;
+	ulint	start_time;
 	ibool	has_printed	= FALSE;
-	mtr_t	mtr;
 loop:
 	mutex_enter(&(recv_sys->mutex));
 
@@ -1871,78 +1990,61 @@ loop:
 	recv_sys->apply_log_recs = TRUE;
 	recv_sys->apply_batch_on = TRUE;
 
-	for (i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
-
-		for (recv_addr = static_cast<recv_addr_t*>(
-				HASH_GET_FIRST(recv_sys->addr_hash, i));
-		     recv_addr != 0;
-		     recv_addr = static_cast<recv_addr_t*>(
-				HASH_GET_NEXT(addr_hash, recv_addr))) {
-
-			ulint	space = recv_addr->space;
-			ulint	zip_size = fil_space_get_zip_size(space);
-			ulint	page_no = recv_addr->page_no;
-
-			if (recv_addr->state == RECV_NOT_PROCESSED) {
-				if (!has_printed) {
-					ib_logf(IB_LOG_LEVEL_INFO,
-						"Starting an apply batch"
-						" of log records"
-						" to the database...");
-					fputs("InnoDB: Progress in percent: ",
-					      stderr);
-					has_printed = TRUE;
-				}
-
-				mutex_exit(&(recv_sys->mutex));
-
-				if (buf_page_peek(space, page_no)) {
-					buf_block_t*	block;
-
-					mtr_start(&mtr);
+	n_total = recv_sys->n_addrs;
+	n_applied_start = recv_n_pages_applied;
+	start_time = ut_time_ms();
 
-					block = buf_page_get(
-						space, zip_size, page_no,
-						RW_X_LATCH, &mtr);
-					buf_block_dbg_add_level(
-						block, SYNC_NO_ORDER_CHECK);
+	if (n_total != 0) {
+		n_threads = ut_min(ut_max(srv_recovery_apply_threads, 1),
+				   RECV_APPLY_THREADS_MAX);
 
-					recv_recover_page(FALSE, block);
-					mtr_commit(&mtr);
-				} else {
-					recv_read_in_area(space, zip_size,
-							  page_no);
-				}
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Starting an apply batch of log records to %lu pages"
+			" using %lu threads...",
+			(ulong) n_total, (ulong) n_threads);
+		fputs("InnoDB: Progress in percent: ", stderr);
+		has_printed = TRUE;
 
-				mutex_enter(&(recv_sys->mutex));
-			}
-		}
+		recv_sys->n_apply_threads = n_threads;
 
-		if (has_printed
-		    && (i * 100) / hash_get_n_cells(recv_sys->addr_hash)
-		    != ((i + 1) * 100)
-		    / hash_get_n_cells(recv_sys->addr_hash)) {
+		for (i = 0; i < n_threads; i++) {
+			recv_apply_thread_ids[i] = i;
 
-			fprintf(stderr, "%lu ", (ulong)
-				((i * 100)
-				 / hash_get_n_cells(recv_sys->addr_hash)));
+			os_thread_create(recv_apply_thread,
+					 &recv_apply_thread_ids[i], NULL);
 		}
 	}
 
 	/* Wait until all the pages have been processed */
 
-	while (recv_sys->n_addrs != 0) {
+	while (recv_sys->n_addrs != 0 || recv_sys->n_apply_threads != 0) {
+		ulint	percent = ((n_total - recv_sys->n_addrs) * 100)
+			/ n_total;
+
+		for (; last_percent < percent; last_percent++) {
+			fprintf(stderr, "%lu ", (ulong) last_percent);
+		}
 
 		mutex_exit(&(recv_sys->mutex));
 
-		os_thread_sleep(500000);
+		os_thread_sleep(100000);
 
 		mutex_enter(&(recv_sys->mutex));
 	}
 
 	if (has_printed) {
+		ulint	n_pages = recv_n_pages_applied - n_applied_start;
+		ulint	elapsed = ut_time_ms() - start_time;
 
 		fprintf(stderr, "\n");
+
+		recv_apply_time_ms += elapsed;
+
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Applied log records to %lu pages in %lu ms"
+			" (%lu pages/s)",
+			(ulong) n_pages, (ulong) elapsed,
+			(ulong) (n_pages * 1000 / ut_max(elapsed, 1)));
 	}
 
 	if (!allow_ibuf) {
@@ -2905,9 +3007,88 @@ recv_scan_log_recs(
 }
 
 #ifndef UNIV_HOTBACKUP
+/** Double-buffered redo log scan: recv_scan_read_thread reads the chunk
+of RECV_SCAN_SIZE bytes that follows the one recv_group_scan_log_recs()
+is parsing. The read plan of each chunk is computed by the parsing
+thread, which owns log_sys->mutex. */
+struct recv_scan_pipe_t {
+	const log_group_t*	group;	/*!< log group being scanned */
+	byte*		buf_unaligned;	/*!< memory for buf[] */
+	byte*		buf[2];		/*!< chunk buffers */
+	log_read_seg_t	segs[2][LOG_READ_SEGS_MAX];
+					/*!< read plan of each buffer */
+	ulint		n_segs[2];	/*!< number of segments in segs[] */
+	os_event_t	requested[2];	/*!< set when segs[i] is ready to be
+					read into buf[i], or when quit is set */
+	os_event_t	filled[2];	/*!< set when buf[i] has been read */
+	os_event_t	exited;		/*!< set when the read thread exits */
+	bool		quit;		/*!< true when the read thread
+					must exit */
+	ulint		idle_ms;	/*!< time the read thread waited for
+					the parser */
+};
+
+/** Number of bytes of redo log scanned during crash recovery */
+static ib_uint64_t	recv_scan_bytes;
+/** ut_time_ms() when recv_recovery_from_checkpoint_start() was called */
+static ulint		recv_start_time;
+/** Time spent scanning and parsing the redo log, in milliseconds */
+static ulint		recv_scan_time_ms;
+/** Time the parsing thread waited for log reads, in milliseconds */
+static ulint		recv_scan_read_wait_ms;
+/** Time the log read thread waited for the parsing thread, in
+milliseconds */
+static ulint		recv_scan_parse_wait_ms;
+
+/******************************************************************//**
+Reads the redo log chunks requested by recv_group_scan_log_recs() ahead
+of the parsing.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(recv_scan_read_thread)(
+/*==================================*/
+	void*	arg)	/*!< in: recv_scan_pipe_t */
+{
+	recv_scan_pipe_t*	pipe = static_cast<recv_scan_pipe_t*>(arg);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_scan_read_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	for (ulint n = 0; ; n++) {
+		ulint	i = n & 1;
+		ulint	start_time = ut_time_ms();
+
+		os_event_wait(pipe->requested[i]);
+		os_event_reset(pipe->requested[i]);
+
+		pipe->idle_ms += ut_time_ms() - start_time;
+
+		if (pipe->quit) {
+			break;
+		}
+
+		log_group_read_segs(pipe->group, pipe->buf[i],
+				    pipe->segs[i], pipe->n_segs[i]);
+
+		os_event_set(pipe->filled[i]);
+	}
+
+	os_event_set(pipe->exited);
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /*******************************************************//**
 Scans log from a buffer and stores new log data to the parsing buffer. Parses
-and hashes the log records if new data found. */
+and hashes the log records if new data found. The next RECV_SCAN_SIZE bytes
+are read by recv_scan_read_thread while a chunk is being parsed. */
 static
 void
 recv_group_scan_log_recs(
@@ -2919,29 +3100,102 @@ recv_group_scan_log_recs(
 	lsn_t*		group_scanned_lsn)/*!< out: scanning succeeded up to
 					this lsn */
 {
-	ibool	finished;
-	lsn_t	start_lsn;
-	lsn_t	end_lsn;
+	recv_scan_pipe_t	pipe;
+	ibool			finished;
+	lsn_t			start_lsn;
+	ulint			start_time;
+	ulint			i;
+
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+	start_time = ut_time_ms();
+
+	memset(&pipe, 0, sizeof pipe);
+
+	pipe.group = group;
+	pipe.buf_unaligned = static_cast<byte*>(
+		ut_malloc(2 * RECV_SCAN_SIZE + OS_FILE_LOG_BLOCK_SIZE));
+
+	for (i = 0; i < 2; i++) {
+		pipe.buf[i] = static_cast<byte*>(
+			ut_align(pipe.buf_unaligned, OS_FILE_LOG_BLOCK_SIZE))
+			+ i * RECV_SCAN_SIZE;
+		pipe.requested[i] = os_event_create();
+		pipe.filled[i] = os_event_create();
+
+		/* Request the first two chunks. */
+		start_lsn = *contiguous_lsn + i * RECV_SCAN_SIZE;
+		pipe.n_segs[i] = log_group_calc_read_segs(
+			group, start_lsn, start_lsn + RECV_SCAN_SIZE,
+			pipe.segs[i]);
+		os_event_set(pipe.requested[i]);
+	}
+
+	pipe.exited = os_event_create();
+
+	os_thread_create(recv_scan_read_thread, &pipe, NULL);
 
 	finished = FALSE;
 
 	start_lsn = *contiguous_lsn;
 
-	while (!finished) {
-		end_lsn = start_lsn + RECV_SCAN_SIZE;
+	for (ulint n = 0; !finished; n++) {
+		ulint	wait_start = ut_time_ms();
 
-		log_group_read_log_seg(LOG_RECOVER, log_sys->buf,
-				       group, start_lsn, end_lsn);
+		i = n & 1;
+
+		os_event_wait(pipe.filled[i]);
+		os_event_reset(pipe.filled[i]);
+
+		recv_scan_read_wait_ms += ut_time_ms() - wait_start;
 
 		finished = recv_scan_log_recs(
 			(buf_pool_get_n_pages()
 			- (recv_n_pool_free_frames * srv_buf_pool_instances))
 			* UNIV_PAGE_SIZE,
-			TRUE, log_sys->buf, RECV_SCAN_SIZE,
+			TRUE, pipe.buf[i], RECV_SCAN_SIZE,
 			start_lsn, contiguous_lsn, group_scanned_lsn);
-		start_lsn = end_lsn;
+
+		/* The last chunk is only scanned up to the end of
+		the log. */
+		if (*group_scanned_lsn > start_lsn) {
+			recv_scan_bytes += ut_min(*group_scanned_lsn - start_lsn,
+						  (lsn_t) RECV_SCAN_SIZE);
+		}
+
+		start_lsn += RECV_SCAN_SIZE;
+
+		if (!finished) {
+			/* Let the read thread refill this buffer with the
+			chunk after the one it is reading now. */
+			lsn_t	next_lsn = start_lsn + RECV_SCAN_SIZE;
+
+			pipe.n_segs[i] = log_group_calc_read_segs(
+				group, next_lsn, next_lsn + RECV_SCAN_SIZE,
+				pipe.segs[i]);
+			os_event_set(pipe.requested[i]);
+		}
 	}
 
+	pipe.quit = true;
+
+	for (i = 0; i < 2; i++) {
+		os_event_set(pipe.requested[i]);
+	}
+
+	os_event_wait(pipe.exited);
+
+	recv_scan_parse_wait_ms += pipe.idle_ms;
+	recv_scan_time_ms += ut_time_ms() - start_time;
+
+	for (i = 0; i < 2; i++) {
+		os_event_free(pipe.requested[i]);
+		os_event_free(pipe.filled[i]);
+	}
+
+	os_event_free(pipe.exited);
+	ut_free(pipe.buf_unaligned);
+
 #ifdef UNIV_DEBUG
 	if (log_debug_writes) {
 		fprintf(stderr,
@@ -3051,6 +3305,7 @@ recv_recovery_from_checkpoint_start_func(
 	}
 
 	recv_recovery_on = TRUE;
+	recv_start_time = ut_time_ms();
 
 	recv_sys->limit_lsn = LIMIT_LSN;
 
@@ -3366,6 +3621,35 @@ recv_recovery_from_checkpoint_start_func(
 #undef LIMIT_LSN
 }
 
+/********************************************************//**
+Reports the time spent in the phases of crash recovery and the log scan
+and page apply throughput. */
+static
+void
+recv_report_stats(void)
+/*===================*/
+{
+	ulint	total_ms = ut_time_ms() - recv_start_time;
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Scanned " UINT64PF " bytes of redo log in %lu ms"
+		" (%lu KB/s); parsing waited %lu ms for log reads,"
+		" log reads waited %lu ms for parsing",
+		recv_scan_bytes, (ulong) recv_scan_time_ms,
+		(ulong) (recv_scan_bytes / ut_max(recv_scan_time_ms, 1)
+			 * 1000 / 1024),
+		(ulong) recv_scan_read_wait_ms,
+		(ulong) recv_scan_parse_wait_ms);
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Applied log records to %lu pages in %lu ms (%lu pages/s);"
+		" crash recovery took %lu ms",
+		(ulong) recv_n_pages_applied, (ulong) recv_apply_time_ms,
+		(ulong) (recv_n_pages_applied * 1000
+			 / ut_max(recv_apply_time_ms, 1)),
+		(ulong) total_ms);
+}
+
 /********************************************************//**
 Completes recovery from a checkpoint. */
 UNIV_INTERN
@@ -3382,6 +3666,11 @@ recv_recovery_from_checkpoint_finish(void)
 
 	DBUG_PRINT("ib_log", ("apply completed"));
 
+	if (srv_force_recovery < SRV_FORCE_NO_LOG_REDO
+	    && recv_needed_recovery) {
+		recv_report_stats();
+	}
+
 	if (recv_needed_recovery) {
 		trx_sys_print_mysql_master_log_pos();
 		trx_sys_print_mysql_binlog_offset();
@@ -240,6 +240,7 @@ mtr_log_reserve_and_write(
 	dyn_array_t*	mlog;
 	ulint		data_size;
 	byte*		first_data;
+	log_copy_t	copy;
 
 	ut_ad(!srv_read_only_mode);
 
@@ -261,7 +262,7 @@ mtr_log_reserve_and_write(
 			? dyn_block_get_used(mlog) : 0;
 
 		mtr->end_lsn = log_reserve_and_write_fast(
-			first_data, len, &mtr->start_lsn);
+			first_data, len, &mtr->start_lsn, &copy);
 
 		if (mtr->end_lsn) {
 
@@ -269,6 +270,11 @@ mtr_log_reserve_and_write(
 			Add pages to flush list and exit */
 			mtr_add_dirtied_pages_to_flush_list(mtr);
 
+			if (copy.slot != ULINT_UNDEFINED) {
+				log_copy_low(&copy, first_data, len);
+				log_copy_close(&copy);
+			}
+
 			return;
 		}
 	}
@@ -278,8 +284,17 @@ mtr_log_reserve_and_write(
 	/* Open the database log for log_write_low */
 	mtr->start_lsn = log_reserve_and_open(data_size);
 
-	if (mtr->log_mode == MTR_LOG_ALL) {
+	copy.slot = ULINT_UNDEFINED;
 
+	if (mtr->log_mode != MTR_LOG_ALL) {
+		ut_ad(mtr->log_mode == MTR_LOG_NONE
+		      || mtr->log_mode == MTR_LOG_NO_REDO);
+		/* Do nothing */
+	} else if (log_copy_open(&copy)) {
+		/* Only reserve the space now: the records are copied
+		in after the log mutex has been released */
+		log_reserve_low(data_size);
+	} else {
 		for (dyn_block_t* block = mlog;
 		     block != 0;
 		     block = dyn_array_get_next_block(mlog, block)) {
@@ -288,16 +303,24 @@ mtr_log_reserve_and_write(
 				dyn_block_get_data(block),
 				dyn_block_get_used(block));
 		}
-
-	} else {
-		ut_ad(mtr->log_mode == MTR_LOG_NONE
-		      || mtr->log_mode == MTR_LOG_NO_REDO);
-		/* Do nothing */
 	}
 
 	mtr->end_lsn = log_close();
 
 	mtr_add_dirtied_pages_to_flush_list(mtr);
+
+	if (copy.slot != ULINT_UNDEFINED) {
+		for (dyn_block_t* block = mlog;
+		     block != 0;
+		     block = dyn_array_get_next_block(mlog, block)) {
+
+			log_copy_low(&copy,
+				     dyn_block_get_data(block),
+				     dyn_block_get_used(block));
+		}
+
+		log_copy_close(&copy);
+	}
 }
 #endif /* !UNIV_HOTBACKUP */
 
@@ -44,6 +44,7 @@ Created 10/21/1995 Heikki Tuuri
 #include "fil0fil.h"
 #include "buf0buf.h"
 #include "srv0mon.h"
+#include "ut0sort.h"
 #ifndef UNIV_HOTBACKUP
 # include "os0sync.h"
 # include "os0thread.h"
@@ -56,10 +57,19 @@ Created 10/21/1995 Heikki Tuuri
 # endif /* __WIN__ */
 #endif /* !UNIV_HOTBACKUP */
 
+#ifdef UNIV_LINUX
+#include <fcntl.h>
+#endif
+
 #if defined(LINUX_NATIVE_AIO)
 #include <libaio.h>
 #endif
 
+#if defined(LINUX_IO_URING)
+#include <liburing.h>
+#include <sys/resource.h>
+#endif
+
 /** Insert buffer segment id */
 static const ulint IO_IBUF_SEGMENT = 0;
 
@@ -151,6 +161,18 @@ UNIV_INTERN mysql_pfs_key_t  innodb_file_log_key;
 UNIV_INTERN mysql_pfs_key_t  innodb_file_temp_key;
 #endif /* UNIV_PFS_IO */
 
+#if defined(LINUX_NATIVE_AIO)
+/** maximum number of contiguous requests that are merged into
+one vectored iocb */
+#define OS_AIO_LINUX_MERGE_MAX		16
+
+/** maximum number of requests handed to the kernel per io_submit() */
+#define OS_AIO_LINUX_SUBMIT_BATCH	256
+
+/** time to sleep, in microseconds, if io_submit() returns EAGAIN. */
+#define OS_AIO_SUBMIT_RETRY_SLEEP	1000UL
+#endif /* LINUX_NATIVE_AIO */
+
 /** The asynchronous i/o array slot structure */
 struct os_aio_slot_t{
 	ibool		is_read;	/*!< TRUE if a read operation */
@@ -184,6 +206,16 @@ struct os_aio_slot_t{
 	struct iocb	control;	/* Linux control block for aio */
 	int		n_bytes;	/* bytes written/read. */
 	int		ret;		/* AIO return code */
+	ibool		pending;	/* TRUE if the request has been
+					prepared but not yet handed to
+					io_submit() */
+	os_aio_slot_t*	merged_next;	/* next slot whose request was
+					merged into the iocb of this
+					slot, or NULL */
+	struct iovec	iov[OS_AIO_LINUX_MERGE_MAX];
+					/* buffers of a merged request;
+					used only in the first slot of
+					the run */
 #endif /* WIN_ASYNC_IO */
 };
 
@@ -234,7 +266,20 @@ struct os_aio_array_t{
 				There is one such event for each
 				possible pending IO. The size of the
 				array is equal to n_slots. */
+	ulint			n_pending;
+				/* Number of slots that have been
+				reserved but not yet submitted to the
+				kernel; protected by mutex */
 #endif /* LINUX_NATIV_AIO */
+#if defined(LINUX_IO_URING)
+	struct io_uring**	uring;
+				/* With innodb_use_io_uring, one
+				io_uring per segment, used instead of
+				aio_ctx. The submission queue is
+				protected by mutex, the completion
+				queue is only accessed by the
+				i/o-handler thread of the segment. */
+#endif /* LINUX_IO_URING */
 };
 
 #if defined(LINUX_NATIVE_AIO)
@@ -248,6 +293,86 @@ struct os_aio_array_t{
 #define OS_AIO_IO_SETUP_RETRY_ATTEMPTS	5
 #endif
 
+#if defined(LINUX_IO_URING)
+/** idle time in milliseconds before the submission queue polling
+thread goes to sleep */
+#define OS_AIO_URING_SQ_THREAD_IDLE	1000
+
+/** size of the registered file table; file descriptors at or above it
+are not registered */
+#define OS_AIO_URING_MAX_FILES		32768
+
+/** number of submission queue entries of the fsync ring */
+#define OS_AIO_URING_SYNC_ENTRIES	64
+
+/** maximum size of one registered buffer */
+#define OS_AIO_URING_MAX_BUF		(1UL << 30)
+
+/** All io_urings, for registering files and buffers with each of them:
+one per aio array segment and the fsync ring */
+static struct io_uring*	os_aio_uring_rings[SRV_MAX_N_IO_THREADS + 2];
+
+/** Number of elements in os_aio_uring_rings */
+static ulint		os_aio_uring_n_rings = 0;
+
+/** File descriptor of the ring whose submission queue polling thread
+the other rings share, or -1 */
+static int		os_aio_uring_wq_fd = -1;
+
+/** Size of the registered file table of each ring. A registered file
+has its descriptor as index. 0 if files are not registered. */
+static ulint		os_aio_uring_n_files = 0;
+
+/** os_aio_uring_files[fd] is nonzero if fd is a registered file;
+protected by the fil_system mutex */
+static byte*		os_aio_uring_files = NULL;
+
+/** Buffers registered with every ring, in the order of their indexes */
+static struct iovec*	os_aio_uring_bufs = NULL;
+
+/** Number of elements in os_aio_uring_bufs */
+static ulint		os_aio_uring_n_bufs = 0;
+
+/** The ring used for fsync */
+static struct io_uring*	os_aio_uring_sync_ring = NULL;
+
+/** Protects the submission queue of os_aio_uring_sync_ring */
+static os_ib_mutex_t	os_aio_uring_sync_sq_mutex;
+
+/** Protects the completion queue of os_aio_uring_sync_ring */
+static os_ib_mutex_t	os_aio_uring_sync_cq_mutex;
+
+/** A thread waiting for an fsync on os_aio_uring_sync_ring */
+struct os_aio_uring_wait_t {
+	bool		done;	/*!< true when res is valid; protected
+				by os_aio_uring_sync_cq_mutex */
+	int		res;	/*!< result of the fsync, 0 or -errno */
+};
+
+/******************************************************************//**
+Checks if a file is registered with the io_urings.
+@return true if registered */
+static inline
+bool
+os_aio_uring_file_is_registered(
+/*============================*/
+	os_file_t	file)	/*!< in: file */
+{
+	return(file >= 0
+	       && (ulint) file < os_aio_uring_n_files
+	       && os_aio_uring_files[file]);
+}
+
+/******************************************************************//**
+Flushes a file through the fsync io_uring.
+@return	0 if success, -1 otherwise, with errno set */
+static
+int
+os_aio_uring_fsync(
+/*===============*/
+	os_file_t	file);	/*!< in: handle to a file */
+#endif /* LINUX_IO_URING */
+
 /** Array of events used in simulated aio */
 static os_event_t*	os_aio_segment_wait_events = NULL;
 
@@ -2202,6 +2327,45 @@ os_file_set_eof(
 #endif /* __WIN__ */
 }
 
+/***********************************************************************//**
+Deallocates the file system blocks of a byte range of a file, keeping the
+file size. The range reads back as zeroes. This is only implemented with
+fallocate(FALLOC_FL_PUNCH_HOLE) on Linux.
+@return	TRUE if success, FALSE if the file system does not support it
+or the call failed */
+UNIV_INTERN
+ibool
+os_file_punch_hole(
+/*===============*/
+	os_file_t	file,	/*!< in: handle to a file */
+	os_offset_t	offset,	/*!< in: start of the range */
+	os_offset_t	len)	/*!< in: length of the range in bytes */
+{
+#if defined(UNIV_LINUX) && defined(FALLOC_FL_PUNCH_HOLE) \
+	&& defined(FALLOC_FL_KEEP_SIZE)
+	int	ret;
+
+	ret = fallocate(file, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+			offset, len);
+
+	if (ret == 0) {
+		return(TRUE);
+	}
+
+	if (errno != EOPNOTSUPP && errno != ENOSYS) {
+		os_file_handle_error_no_exit(NULL, "fallocate", FALSE);
+	}
+
+	return(FALSE);
+#else
+	UT_NOT_USED(file);
+	UT_NOT_USED(offset);
+	UT_NOT_USED(len);
+
+	return(FALSE);
+#endif /* UNIV_LINUX && FALLOC_FL_PUNCH_HOLE && FALLOC_FL_KEEP_SIZE */
+}
+
 #ifndef __WIN__
 /***********************************************************************//**
 Wrapper to fsync(2) that retries the call on some errors.
@@ -2222,7 +2386,11 @@ os_file_fsync(
 	failures = 0;
 
 	do {
+#if defined(LINUX_IO_URING)
+		ret = srv_use_io_uring ? os_aio_uring_fsync(file) : fsync(file);
+#else
 		ret = fsync(file);
+#endif /* LINUX_IO_URING */
 
 		os_n_fsyncs++;
 
@@ -3720,6 +3888,254 @@ os_aio_native_aio_supported(void)
 }
 #endif /* LINUX_NATIVE_AIO */
 
+#if defined(LINUX_IO_URING)
+/******************************************************************//**
+Creates an io_uring and registers it in os_aio_uring_rings. With
+innodb_io_uring_sqpoll, the rings share the submission queue polling
+thread of the first ring. If files are registered, the ring gets an
+empty registered file table of os_aio_uring_n_files entries.
+@return	ring, or NULL on failure */
+static
+struct io_uring*
+os_aio_uring_create_ring(
+/*=====================*/
+	ulint	entries)	/*!< in: number of submission queue entries */
+{
+	struct io_uring*	ring;
+	struct io_uring_params	params;
+	int			ret;
+
+	ut_a(os_aio_uring_n_rings < UT_ARR_SIZE(os_aio_uring_rings));
+
+	ring = static_cast<struct io_uring*>(ut_malloc(sizeof(*ring)));
+	memset(ring, 0x0, sizeof(*ring));
+	memset(&params, 0x0, sizeof(params));
+
+	if (srv_io_uring_sqpoll) {
+		params.flags |= IORING_SETUP_SQPOLL;
+		params.sq_thread_idle = OS_AIO_URING_SQ_THREAD_IDLE;
+
+		if (os_aio_uring_wq_fd >= 0) {
+			params.flags |= IORING_SETUP_ATTACH_WQ;
+			params.wq_fd = os_aio_uring_wq_fd;
+		}
+	}
+
+	ret = io_uring_queue_init_params((unsigned) entries, ring, &params);
+
+	if (ret < 0 && (params.flags & IORING_SETUP_ATTACH_WQ)) {
+		/* Sharing the polling thread is not supported: let
+		this ring have its own. */
+		params.flags &= ~IORING_SETUP_ATTACH_WQ;
+		params.wq_fd = 0;
+
+		ret = io_uring_queue_init_params(
+			(unsigned) entries, ring, &params);
+	}
+
+	if (ret < 0) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"io_uring_queue_init() failed with error %d", -ret);
+		ut_free(ring);
+		return(NULL);
+	}
+
+	if (srv_io_uring_sqpoll && os_aio_uring_wq_fd < 0) {
+		os_aio_uring_wq_fd = ring->ring_fd;
+	}
+
+	if (os_aio_uring_n_files > 0) {
+		int*	fds = static_cast<int*>(
+			ut_malloc(os_aio_uring_n_files * sizeof(*fds)));
+
+		for (ulint i = 0; i < os_aio_uring_n_files; ++i) {
+			fds[i] = -1;
+		}
+
+		ret = io_uring_register_files(
+			ring, fds, (unsigned) os_aio_uring_n_files);
+
+		ut_free(fds);
+
+		if (ret < 0) {
+			ib_logf(IB_LOG_LEVEL_WARN,
+				"io_uring: registering files failed with"
+				" error %d; files will not be registered",
+				-ret);
+
+			/* The tables of the other rings stay empty. */
+			os_aio_uring_n_files = 0;
+		}
+	}
+
+	os_aio_uring_rings[os_aio_uring_n_rings++] = ring;
+
+	return(ring);
+}
+
+/******************************************************************//**
+Closes an io_uring created by os_aio_uring_create_ring(). */
+static
+void
+os_aio_uring_free_ring(
+/*===================*/
+	struct io_uring*	ring)	/*!< in, own: ring */
+{
+	for (ulint i = 0; i < os_aio_uring_n_rings; ++i) {
+		if (os_aio_uring_rings[i] == ring) {
+			os_aio_uring_rings[i]
+				= os_aio_uring_rings[--os_aio_uring_n_rings];
+			break;
+		}
+	}
+
+	io_uring_queue_exit(ring);
+	ut_free(ring);
+}
+
+/******************************************************************//**
+Checks if the kernel supports the io_uring features that the io_uring
+backend needs: waiting for completions with a timeout without using a
+submission queue entry, so that the i/o-handler threads never touch the
+submission queue, and the submission queue polling thread if
+innodb_io_uring_sqpoll is set. Clears innodb_io_uring_sqpoll if only
+the polling is not available.
+@return TRUE if supported */
+static
+ibool
+os_aio_uring_supported(void)
+/*========================*/
+{
+	struct io_uring		ring;
+	struct io_uring_params	params;
+	int			ret;
+
+	memset(&params, 0x0, sizeof(params));
+
+	if (srv_io_uring_sqpoll) {
+		params.flags |= IORING_SETUP_SQPOLL;
+		params.sq_thread_idle = OS_AIO_URING_SQ_THREAD_IDLE;
+	}
+
+	ret = io_uring_queue_init_params(4, &ring, &params);
+
+	if (ret < 0 && srv_io_uring_sqpoll) {
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"io_uring submission queue polling is not available"
+			" (error %d); disabling innodb_io_uring_sqpoll",
+			-ret);
+
+		srv_io_uring_sqpoll = FALSE;
+
+		memset(&params, 0x0, sizeof(params));
+		ret = io_uring_queue_init_params(4, &ring, &params);
+	}
+
+	if (ret < 0) {
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"io_uring_queue_init() failed with error %d", -ret);
+		return(FALSE);
+	}
+
+	io_uring_queue_exit(&ring);
+
+	if (!(params.features & IORING_FEAT_EXT_ARG)) {
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"The kernel does not support IORING_FEAT_EXT_ARG");
+		return(FALSE);
+	}
+
+	return(TRUE);
+}
+
+/******************************************************************//**
+Flushes a file through the fsync io_uring. Concurrent callers have their
+fsync requests in flight together; whoever holds the completion mutex
+reaps the completions of all of them.
+@return	0 if success, -1 otherwise, with errno set */
+static
+int
+os_aio_uring_fsync(
+/*===============*/
+	os_file_t	file)	/*!< in: handle to a file */
+{
+	struct io_uring*	ring = os_aio_uring_sync_ring;
+	struct io_uring_sqe*	sqe;
+	struct io_uring_cqe*	cqe;
+	os_aio_uring_wait_t	wait;
+	int			ret;
+
+	if (ring == NULL) {
+		return(fsync(file));
+	}
+
+	wait.done = false;
+	wait.res = 0;
+
+	os_mutex_enter(os_aio_uring_sync_sq_mutex);
+
+	while ((sqe = io_uring_get_sqe(ring)) == NULL) {
+		io_uring_submit(ring);
+	}
+
+	/* The index of a registered file is its descriptor. */
+	io_uring_prep_fsync(sqe, file, 0);
+
+	if (os_aio_uring_file_is_registered(file)) {
+		io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE);
+	}
+
+	io_uring_sqe_set_data(sqe, &wait);
+
+	while ((ret = io_uring_submit(ring)) < 0) {
+		if (ret != -EAGAIN && ret != -EBUSY && ret != -EINTR) {
+			ib_logf(IB_LOG_LEVEL_FATAL,
+				"io_uring_submit() failed with error %d",
+				-ret);
+		}
+
+		os_thread_sleep(OS_AIO_SUBMIT_RETRY_SLEEP);
+	}
+
+	os_mutex_exit(os_aio_uring_sync_sq_mutex);
+
+	os_mutex_enter(os_aio_uring_sync_cq_mutex);
+
+	while (!wait.done) {
+		ret = io_uring_wait_cqe(ring, &cqe);
+
+		if (ret == -EINTR) {
+			continue;
+		} else if (ret < 0) {
+			ib_logf(IB_LOG_LEVEL_FATAL,
+				"io_uring_wait_cqe() failed with error %d",
+				-ret);
+		}
+
+		do {
+			os_aio_uring_wait_t*	w;
+
+			w = static_cast<os_aio_uring_wait_t*>(
+				io_uring_cqe_get_data(cqe));
+
+			w->res = cqe->res;
+			w->done = true;
+
+			io_uring_cqe_seen(ring, cqe);
+		} while (io_uring_peek_cqe(ring, &cqe) == 0);
+	}
+
+	os_mutex_exit(os_aio_uring_sync_cq_mutex);
+
+	if (wait.res < 0) {
+		errno = -wait.res;
+		return(-1);
+	}
+
+	return(0);
+}
+#endif /* LINUX_IO_URING */
+
 /******************************************************************//**
 Creates an aio wait array. Note that we return NULL in case of failure.
 We don't care about freeing memory here because we assume that a
@@ -3766,6 +4182,11 @@ os_aio_array_create(
 #if defined(LINUX_NATIVE_AIO)
 	array->aio_ctx = NULL;
 	array->aio_events = NULL;
+	array->n_pending = 0;
+
+#if defined(LINUX_IO_URING)
+	array->uring = NULL;
+#endif /* LINUX_IO_URING */
 
 	/* If we are not using native aio interface then skip this
 	part of initialization. */
@@ -3773,6 +4194,25 @@ os_aio_array_create(
 		goto skip_native_aio;
 	}
 
+#if defined(LINUX_IO_URING)
+	if (srv_use_io_uring) {
+		/* One io_uring per segment instead of an io_context. */
+		array->uring = static_cast<struct io_uring**>(
+			ut_malloc(n_segments * sizeof(*array->uring)));
+
+		for (ulint i = 0; i < n_segments; ++i) {
+			array->uring[i] = os_aio_uring_create_ring(
+				n / n_segments);
+
+			if (array->uring[i] == NULL) {
+				return(NULL);
+			}
+		}
+
+		goto skip_native_aio;
+	}
+#endif /* LINUX_IO_URING */
+
 	/* Initialize the io_context array. One io_context
 	per segment in the array. */
 
@@ -3821,6 +4261,8 @@ skip_native_aio:
 		memset(&slot->control, 0x0, sizeof(slot->control));
 		slot->n_bytes = 0;
 		slot->ret = 0;
+		slot->pending = FALSE;
+		slot->merged_next = NULL;
 #endif /* WIN_ASYNC_IO */
 	}
 
@@ -3858,6 +4300,16 @@ os_aio_array_free(
 	}
 #endif /* LINUX_NATIVE_AIO */
 
+#if defined(LINUX_IO_URING)
+	if (array->uring != NULL) {
+		for (ulint i = 0; i < array->n_segments; ++i) {
+			os_aio_uring_free_ring(array->uring[i]);
+		}
+
+		ut_free(array->uring);
+	}
+#endif /* LINUX_IO_URING */
+
 	ut_free(array->slots);
 	ut_free(array);
 
@@ -3894,6 +4346,49 @@ os_aio_init(
 	}
 #endif /* LINUX_NATIVE_AIO */
 
+#if defined(LINUX_IO_URING)
+	if (srv_use_io_uring && !srv_use_native_aio) {
+
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"innodb_use_io_uring requires innodb_use_native_aio;"
+			" io_uring disabled.");
+
+		srv_use_io_uring = FALSE;
+
+	} else if (srv_use_io_uring && !os_aio_uring_supported()) {
+
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"io_uring disabled, falling back to Linux Native AIO.");
+
+		srv_use_io_uring = FALSE;
+	}
+
+	if (srv_use_io_uring) {
+		struct rlimit	rlim;
+
+		/* Registered files are indexed by their descriptor, so
+		the table must cover the descriptors we may get. */
+		os_aio_uring_n_files = OS_AIO_URING_MAX_FILES;
+
+		if (getrlimit(RLIMIT_NOFILE, &rlim) == 0
+		    && rlim.rlim_cur < os_aio_uring_n_files) {
+
+			os_aio_uring_n_files = (ulint) rlim.rlim_cur;
+		}
+
+		os_aio_uring_files = static_cast<byte*>(
+			ut_malloc(os_aio_uring_n_files));
+		memset(os_aio_uring_files, 0x0, os_aio_uring_n_files);
+
+		os_aio_uring_sync_sq_mutex = os_mutex_create();
+		os_aio_uring_sync_cq_mutex = os_mutex_create();
+
+		ib_logf(IB_LOG_LEVEL_INFO, "Using io_uring%s",
+			srv_io_uring_sqpoll
+			? " with submission queue polling" : "");
+	}
+#endif /* LINUX_IO_URING */
+
 	srv_reset_io_thread_op_info();
 
 	os_aio_read_array = os_aio_array_create(
@@ -3961,6 +4456,17 @@ os_aio_init(
 		return(FALSE);
 	}
 
+#if defined(LINUX_IO_URING)
+	if (srv_use_io_uring) {
+		os_aio_uring_sync_ring = os_aio_uring_create_ring(
+			OS_AIO_URING_SYNC_ENTRIES);
+
+		if (os_aio_uring_sync_ring == NULL) {
+			return(FALSE);
+		}
+	}
+#endif /* LINUX_IO_URING */
+
 	os_aio_n_segments = n_segments;
 
 	os_aio_validate();
@@ -4003,6 +4509,28 @@ os_aio_free(void)
 
 	os_aio_array_free(os_aio_read_array);
 
+#if defined(LINUX_IO_URING)
+	if (os_aio_uring_sync_ring != NULL) {
+		os_aio_uring_free_ring(os_aio_uring_sync_ring);
+		os_aio_uring_sync_ring = NULL;
+
+		os_mutex_free(os_aio_uring_sync_sq_mutex);
+		os_mutex_free(os_aio_uring_sync_cq_mutex);
+	}
+
+	ut_a(os_aio_uring_n_rings == 0);
+
+	ut_free(os_aio_uring_files);
+	os_aio_uring_files = NULL;
+	os_aio_uring_n_files = 0;
+
+	ut_free(os_aio_uring_bufs);
+	os_aio_uring_bufs = NULL;
+	os_aio_uring_n_bufs = 0;
+
+	os_aio_uring_wq_fd = -1;
+#endif /* LINUX_IO_URING */
+
 	for (ulint i = 0; i < os_aio_n_segments; i++) {
 		os_event_free(os_aio_segment_wait_events[i]);
 	}
@@ -4012,49 +4540,197 @@ os_aio_free(void)
 	os_aio_n_segments = 0;
 }
 
-#ifdef WIN_ASYNC_IO
-/************************************************************************//**
-Wakes up all async i/o threads in the array in Windows async i/o at
-shutdown. */
+#if defined(LINUX_IO_URING)
+/***********************************************************************
+Points an entry of the registered file table of every io_uring to a file.
+@return	true on success */
 static
-void
-os_aio_array_wake_win_aio_at_shutdown(
-/*==================================*/
-	os_aio_array_t*	array)	/*!< in: aio array */
+bool
+os_aio_uring_update_files(
+/*======================*/
+	ulint	index,	/*!< in: entry in the table */
+	int	fd)	/*!< in: file descriptor, or -1 to clear */
 {
-	ulint	i;
+	for (ulint i = 0; i < os_aio_uring_n_rings; ++i) {
+		int	ret;
 
-	for (i = 0; i < array->n_slots; i++) {
+		ret = io_uring_register_files_update(
+			os_aio_uring_rings[i], (unsigned) index, &fd, 1);
 
-		SetEvent((array->slots + i)->handle);
+		if (ret < 0) {
+			return(false);
+		}
 	}
+
+	return(true);
 }
-#endif
+#endif /* LINUX_IO_URING */
 
-/************************************************************************//**
-Wakes up all async i/o threads so that they know to exit themselves in
-shutdown. */
+/***********************************************************************
+Registers an open data file with the io_urings, so that requests refer to
+it by index instead of by descriptor. Does nothing unless
+innodb_use_io_uring is in effect. The caller must hold the fil_system
+mutex. */
 UNIV_INTERN
 void
-os_aio_wake_all_threads_at_shutdown(void)
-/*=====================================*/
+os_aio_register_file(
+/*=================*/
+	os_file_t	file)	/*!< in: file handle */
 {
-#ifdef WIN_ASYNC_IO
-	/* This code wakes up all ai/o threads in Windows native aio */
-	os_aio_array_wake_win_aio_at_shutdown(os_aio_read_array);
-	if (os_aio_write_array != 0) {
-		os_aio_array_wake_win_aio_at_shutdown(os_aio_write_array);
+#if defined(LINUX_IO_URING)
+	if (!srv_use_io_uring
+	    || file < 0
+	    || (ulint) file >= os_aio_uring_n_files) {
+
+		return;
 	}
 
-	if (os_aio_ibuf_array != 0) {
-		os_aio_array_wake_win_aio_at_shutdown(os_aio_ibuf_array);
+	ut_ad(!os_aio_uring_files[file]);
+
+	if (os_aio_uring_update_files(file, file)) {
+		os_aio_uring_files[file] = 1;
+	} else {
+		/* Do not keep the file referenced by some of the
+		rings: the request uses the descriptor. */
+		os_aio_uring_update_files(file, -1);
 	}
+#endif /* LINUX_IO_URING */
+}
 
-	if (os_aio_log_array != 0) {
-		os_aio_array_wake_win_aio_at_shutdown(os_aio_log_array);
+/***********************************************************************
+Removes a file from the io_urings. Must be called before the file is
+closed. The caller must hold the fil_system mutex. */
+UNIV_INTERN
+void
+os_aio_deregister_file(
+/*===================*/
+	os_file_t	file)	/*!< in: file handle */
+{
+#if defined(LINUX_IO_URING)
+	if (os_aio_uring_file_is_registered(file)) {
+		os_aio_uring_files[file] = 0;
+		os_aio_uring_update_files(file, -1);
 	}
+#endif /* LINUX_IO_URING */
+}
 
-#elif defined(LINUX_NATIVE_AIO)
+/***********************************************************************
+Registers memory with the io_urings, so that page i/o into it uses the
+fixed buffer operations. Does nothing unless innodb_use_io_uring is in
+effect. Can be called once, before any i/o into the memory. */
+UNIV_INTERN
+void
+os_aio_register_buffers(
+/*====================*/
+	byte**		bufs,	/*!< in: start of each block */
+	const ulint*	lens,	/*!< in: length of each block */
+	ulint		n)	/*!< in: number of blocks */
+{
+#if defined(LINUX_IO_URING)
+	struct iovec*	iov;
+	ulint		n_iov = 0;
+	ulint		i;
+
+	if (!srv_use_io_uring || n == 0) {
+		return;
+	}
+
+	ut_a(os_aio_uring_bufs == NULL);
+
+	/* The kernel limits the size of one registered buffer. */
+	for (i = 0; i < n; ++i) {
+		n_iov += (lens[i] + OS_AIO_URING_MAX_BUF - 1)
+			/ OS_AIO_URING_MAX_BUF;
+	}
+
+	iov = static_cast<struct iovec*>(ut_malloc(n_iov * sizeof(*iov)));
+
+	n_iov = 0;
+
+	for (i = 0; i < n; ++i) {
+		for (ulint off = 0; off < lens[i];
+		     off += OS_AIO_URING_MAX_BUF) {
+
+			iov[n_iov].iov_base = bufs[i] + off;
+			iov[n_iov].iov_len = ut_min(lens[i] - off,
+						    OS_AIO_URING_MAX_BUF);
+			++n_iov;
+		}
+	}
+
+	for (i = 0; i < os_aio_uring_n_rings; ++i) {
+		int	ret;
+
+		ret = io_uring_register_buffers(
+			os_aio_uring_rings[i], iov, (unsigned) n_iov);
+
+		if (ret < 0) {
+			ib_logf(IB_LOG_LEVEL_WARN,
+				"io_uring: registering %lu buffers failed"
+				" with error %d; check the limit of locked"
+				" memory (ulimit -l)",
+				(ulong) n_iov, -ret);
+
+			while (i-- > 0) {
+				io_uring_unregister_buffers(
+					os_aio_uring_rings[i]);
+			}
+
+			ut_free(iov);
+			return;
+		}
+	}
+
+	/* Publish the table only when every ring has it. */
+	os_aio_uring_bufs = iov;
+	os_wmb;
+	os_aio_uring_n_bufs = n_iov;
+#endif /* LINUX_IO_URING */
+}
+
+#ifdef WIN_ASYNC_IO
+/************************************************************************//**
+Wakes up all async i/o threads in the array in Windows async i/o at
+shutdown. */
+static
+void
+os_aio_array_wake_win_aio_at_shutdown(
+/*==================================*/
+	os_aio_array_t*	array)	/*!< in: aio array */
+{
+	ulint	i;
+
+	for (i = 0; i < array->n_slots; i++) {
+
+		SetEvent((array->slots + i)->handle);
+	}
+}
+#endif
+
+/************************************************************************//**
+Wakes up all async i/o threads so that they know to exit themselves in
+shutdown. */
+UNIV_INTERN
+void
+os_aio_wake_all_threads_at_shutdown(void)
+/*=====================================*/
+{
+#ifdef WIN_ASYNC_IO
+	/* This code wakes up all ai/o threads in Windows native aio */
+	os_aio_array_wake_win_aio_at_shutdown(os_aio_read_array);
+	if (os_aio_write_array != 0) {
+		os_aio_array_wake_win_aio_at_shutdown(os_aio_write_array);
+	}
+
+	if (os_aio_ibuf_array != 0) {
+		os_aio_array_wake_win_aio_at_shutdown(os_aio_ibuf_array);
+	}
+
+	if (os_aio_log_array != 0) {
+		os_aio_array_wake_win_aio_at_shutdown(os_aio_log_array);
+	}
+
+#elif defined(LINUX_NATIVE_AIO)
 
 	/* When using native AIO interface the io helper threads
 	wait on io_getevents with a timeout value of 500ms. At
@@ -4227,12 +4903,13 @@ loop:
 	if (array->n_reserved == array->n_slots) {
 		os_mutex_exit(array->mutex);
 
-		if (!srv_use_native_aio) {
-			/* If the handler threads are suspended, wake them
-			so that we get more slots */
+		/* If the handler threads are suspended, wake them
+		so that we get more slots. With native aio this submits
+		the requests that were posted with
+		OS_AIO_SIMULATED_WAKE_LATER and are still waiting in
+		the array. */
 
-			os_aio_simulated_wake_handler_threads();
-		}
+		os_aio_simulated_wake_handler_threads();
 
 		os_event_wait(array->not_full);
 
@@ -4315,6 +4992,13 @@ found:
 	slot->n_bytes = 0;
 	slot->ret = 0;
 
+	/* The request is handed to the kernel later, in a batch
+	with the other pending requests of the segment, see
+	os_aio_linux_submit_pending(). */
+	slot->pending = TRUE;
+	slot->merged_next = NULL;
+	array->n_pending++;
+
 skip_native_aio:
 #endif /* LINUX_NATIVE_AIO */
 	os_mutex_exit(array->mutex);
@@ -4354,6 +5038,8 @@ os_aio_array_free_slot(
 #elif defined(LINUX_NATIVE_AIO)
 
 	if (srv_use_native_aio) {
+		ut_ad(!slot->pending);
+		ut_ad(slot->merged_next == NULL);
 		memset(&slot->control, 0x0, sizeof(slot->control));
 		slot->n_bytes = 0;
 		slot->ret = 0;
@@ -4369,6 +5055,398 @@ os_aio_array_free_slot(
 	os_mutex_exit(array->mutex);
 }
 
+#if defined(LINUX_NATIVE_AIO)
+/**********************************************************************//**
+Compares two native aio slots by file and offset.
+@return 1, 0, -1, if a is greater, equal, less, respectively, than b */
+static
+int
+os_aio_linux_slot_cmp(
+/*==================*/
+	const os_aio_slot_t*	a,	/*!< in: slot */
+	const os_aio_slot_t*	b)	/*!< in: slot */
+{
+	if (a->file != b->file) {
+		return(a->file > b->file ? 1 : -1);
+	} else if (a->offset != b->offset) {
+		return(a->offset > b->offset ? 1 : -1);
+	}
+
+	return(0);
+}
+
+/**********************************************************************//**
+Sorts native aio slots by file and offset, see os_aio_linux_slot_cmp(). */
+static
+void
+os_aio_linux_slot_sort(
+/*===================*/
+	os_aio_slot_t**	slots,	/*!< in/out: slots to sort */
+	os_aio_slot_t**	aux,	/*!< in/out: temp storage */
+	ulint		low,	/*!< in: lowest index (inclusive) */
+	ulint		high)	/*!< in: highest index (non-inclusive) */
+{
+	UT_SORT_FUNCTION_BODY(os_aio_linux_slot_sort, slots, aux, low, high,
+			      os_aio_linux_slot_cmp);
+}
+
+/**********************************************************************//**
+Turns the iocb of the first slot of a run of contiguous requests into a
+vectored request that covers the whole run. The other slots of the run
+are chained to the first one through merged_next, so that the completion
+can be passed on to each of them in os_aio_linux_collect(). The caller
+must hold the array mutex. */
+static
+void
+os_aio_linux_merge(
+/*===============*/
+	os_aio_slot_t**	run,	/*!< in: slots sorted by offset, each
+				starting where the previous one ends */
+	ulint		n)	/*!< in: number of slots in the run */
+{
+	os_aio_slot_t*	first = run[0];
+
+	ut_ad(n > 1);
+	ut_ad(n <= OS_AIO_LINUX_MERGE_MAX);
+
+	for (ulint i = 0; i < n; ++i) {
+		ut_ad(run[i]->file == first->file);
+		ut_ad(run[i]->type == first->type);
+
+		first->iov[i].iov_base = run[i]->buf;
+		first->iov[i].iov_len = run[i]->len;
+
+		run[i]->merged_next = (i + 1 < n) ? run[i + 1] : NULL;
+	}
+
+	if (first->type == OS_FILE_READ) {
+		io_prep_preadv(&first->control, first->file, first->iov,
+			       (int) n, (off_t) first->offset);
+	} else {
+		ut_a(first->type == OS_FILE_WRITE);
+		io_prep_pwritev(&first->control, first->file, first->iov,
+				(int) n, (off_t) first->offset);
+	}
+
+	first->control.data = (void*) first;
+}
+
+/**********************************************************************//**
+Does the i/o of a request that the kernel refused synchronously and marks
+the slots of the request completed, so that the i/o-handler thread of the
+segment passes them on as if they had been done by the kernel. */
+static
+void
+os_aio_linux_complete_sync(
+/*=======================*/
+	os_aio_array_t*	array,	/*!< in: aio array */
+	os_aio_slot_t*	slot)	/*!< in: first slot of the request */
+{
+	while (slot != NULL) {
+		os_aio_slot_t*	next;
+		ssize_t		n_bytes;
+		int		err;
+
+		if (slot->type == OS_FILE_READ) {
+			n_bytes = pread(slot->file, slot->buf, slot->len,
+					(off_t) slot->offset);
+		} else {
+			n_bytes = pwrite(slot->file, slot->buf, slot->len,
+					 (off_t) slot->offset);
+		}
+
+		err = (n_bytes < 0) ? errno : 0;
+
+		os_mutex_enter(array->mutex);
+
+		/* The slot may be freed as soon as it is marked done. */
+		next = slot->merged_next;
+		slot->merged_next = NULL;
+
+		slot->n_bytes = (int) n_bytes;
+		slot->ret = -err;
+		slot->io_already_done = TRUE;
+
+		os_mutex_exit(array->mutex);
+
+		slot = next;
+	}
+}
+
+/**********************************************************************//**
+Hands a batch of prepared iocbs to the kernel. If the kernel refuses a
+request for other reasons than lack of resources, the rest of the batch
+is done synchronously. */
+static
+void
+os_aio_linux_submit_iocbs(
+/*======================*/
+	os_aio_array_t*	array,	/*!< in: aio array */
+	ulint		segment,/*!< in: local segment number */
+	struct iocb**	iocbs,	/*!< in: requests to submit */
+	ulint		n)	/*!< in: number of requests */
+{
+	ulint	n_done = 0;
+
+	while (n_done < n) {
+		int	ret;
+
+		ret = io_submit(array->aio_ctx[segment],
+				(long) (n - n_done), iocbs + n_done);
+
+		MONITOR_INC(MONITOR_OS_AIO_SUBMIT_CALLS);
+
+#if defined(UNIV_AIO_DEBUG)
+		fprintf(stderr,
+			"io_submit ret[%d]: n[%lu] ctx[%p] seg[%lu]\n",
+			ret, (ulong) (n - n_done),
+			array->aio_ctx[segment], (ulong) segment);
+#endif
+
+		/* io_submit returns number of successfully
+		queued requests or -errno. */
+		if (ret > 0) {
+			n_done += ret;
+			continue;
+		} else if (ret == 0 || ret == -EAGAIN) {
+			/* Out of kernel resources: wait for some of
+			the pending requests to complete. */
+			os_thread_sleep(OS_AIO_SUBMIT_RETRY_SLEEP);
+			continue;
+		}
+
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"io_submit() failed with error %d, doing %lu"
+			" aio requests synchronously", -ret,
+			(ulong) (n - n_done));
+
+		for (; n_done < n; ++n_done) {
+			os_aio_linux_complete_sync(
+				array,
+				static_cast<os_aio_slot_t*>(
+					iocbs[n_done]->data));
+		}
+	}
+}
+
+#if defined(LINUX_IO_URING)
+/**********************************************************************//**
+Looks up the registered buffer that contains a block of memory.
+@return index of the registered buffer, or -1 */
+static
+int
+os_aio_uring_buf_index(
+/*===================*/
+	const byte*	buf,	/*!< in: start of the block */
+	ulint		len)	/*!< in: length of the block */
+{
+	for (ulint i = 0; i < os_aio_uring_n_bufs; ++i) {
+		const byte*	start = static_cast<const byte*>(
+			os_aio_uring_bufs[i].iov_base);
+
+		if (buf >= start
+		    && buf + len <= start + os_aio_uring_bufs[i].iov_len) {
+
+			return((int) i);
+		}
+	}
+
+	return(-1);
+}
+
+/**********************************************************************//**
+Queues requests on the io_uring of an aio array segment and submits
+them. A request that is not merged and whose buffer is inside a
+registered buffer, typically a buffer pool frame, uses the fixed buffer
+operations. Registered files are referred to by their index. The caller
+must hold the array mutex, which protects the submission queue; it is
+released while waiting for the kernel to accept requests. */
+static
+void
+os_aio_uring_submit(
+/*================*/
+	os_aio_array_t*	array,	/*!< in: aio array */
+	ulint		segment,/*!< in: local segment number */
+	os_aio_slot_t**	reqs,	/*!< in: first slots of the requests,
+				merged by os_aio_linux_merge() */
+	ulint		n)	/*!< in: number of requests */
+{
+	struct io_uring*	ring = array->uring[segment];
+	int			ret;
+
+	for (ulint i = 0; i < n; ++i) {
+		os_aio_slot_t*		slot = reqs[i];
+		struct io_uring_sqe*	sqe;
+		unsigned		n_iov = 1;
+		int			buf_index = -1;
+
+		while ((sqe = io_uring_get_sqe(ring)) == NULL) {
+			/* The submission queue is full: hand the queued
+			requests to the kernel to make room. */
+			io_uring_submit(ring);
+		}
+
+		if (slot->merged_next != NULL) {
+			for (const os_aio_slot_t* s = slot->merged_next;
+			     s != NULL; s = s->merged_next) {
+				++n_iov;
+			}
+		} else {
+			slot->iov[0].iov_base = slot->buf;
+			slot->iov[0].iov_len = slot->len;
+
+			buf_index = os_aio_uring_buf_index(
+				slot->buf, slot->len);
+		}
+
+		/* The index of a registered file is its descriptor. */
+		if (buf_index >= 0 && slot->type == OS_FILE_READ) {
+			io_uring_prep_read_fixed(
+				sqe, slot->file, slot->buf,
+				(unsigned) slot->len, slot->offset,
+				buf_index);
+		} else if (buf_index >= 0) {
+			io_uring_prep_write_fixed(
+				sqe, slot->file, slot->buf,
+				(unsigned) slot->len, slot->offset,
+				buf_index);
+		} else if (slot->type == OS_FILE_READ) {
+			io_uring_prep_readv(
+				sqe, slot->file, slot->iov, n_iov,
+				slot->offset);
+		} else {
+			ut_a(slot->type == OS_FILE_WRITE);
+			io_uring_prep_writev(
+				sqe, slot->file, slot->iov, n_iov,
+				slot->offset);
+		}
+
+		if (os_aio_uring_file_is_registered(slot->file)) {
+			io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE);
+		}
+
+		io_uring_sqe_set_data(sqe, slot);
+	}
+
+	while ((ret = io_uring_submit(ring)) < 0) {
+		if (ret != -EAGAIN && ret != -EBUSY && ret != -EINTR) {
+			ib_logf(IB_LOG_LEVEL_FATAL,
+				"io_uring_submit() failed with error %d",
+				-ret);
+		}
+
+		/* Let the i/o-handler thread reap completions. The
+		queued requests stay in the submission queue. */
+		os_mutex_exit(array->mutex);
+		os_thread_sleep(OS_AIO_SUBMIT_RETRY_SLEEP);
+		os_mutex_enter(array->mutex);
+	}
+
+	MONITOR_INC(MONITOR_OS_AIO_SUBMIT_CALLS);
+}
+#endif /* LINUX_IO_URING */
+
+/**********************************************************************//**
+Submits the pending requests of an aio array segment to the kernel. The
+requests are sorted by file and offset, runs of contiguous requests of
+the same type are merged into one vectored iocb, and the resulting iocbs
+are handed to io_submit() in as few calls as possible. */
+static
+void
+os_aio_linux_submit_pending(
+/*========================*/
+	os_aio_array_t*	array,	/*!< in: aio array */
+	ulint		segment)/*!< in: local segment number */
+{
+	os_aio_slot_t*	slots[OS_AIO_LINUX_SUBMIT_BATCH];
+	os_aio_slot_t*	aux[OS_AIO_LINUX_SUBMIT_BATCH];
+	struct iocb*	iocbs[OS_AIO_LINUX_SUBMIT_BATCH];
+	ulint		n_per_seg = array->n_slots / array->n_segments;
+
+	ut_ad(srv_use_native_aio);
+	ut_ad(segment < array->n_segments);
+
+	for (;;) {
+		ulint	n_slots = 0;
+		ulint	n_reqs = 0;
+
+		os_mutex_enter(array->mutex);
+
+		for (ulint i = 0;
+		     i < n_per_seg && n_slots < OS_AIO_LINUX_SUBMIT_BATCH;
+		     ++i) {
+
+			os_aio_slot_t*	slot;
+
+			slot = os_aio_array_get_nth_slot(
+				array, segment * n_per_seg + i);
+
+			if (slot->reserved && slot->pending) {
+				slot->pending = FALSE;
+				slots[n_slots++] = slot;
+			}
+		}
+
+		if (n_slots == 0) {
+			os_mutex_exit(array->mutex);
+			return;
+		}
+
+		ut_ad(array->n_pending >= n_slots);
+		array->n_pending -= n_slots;
+
+		if (n_slots > 1) {
+			os_aio_linux_slot_sort(slots, aux, 0, n_slots);
+		}
+
+		for (ulint i = 0; i < n_slots; /* No op */) {
+			ulint	j;
+
+			for (j = i + 1;
+			     j < n_slots
+			     && j - i < OS_AIO_LINUX_MERGE_MAX
+			     && slots[j]->file == slots[i]->file
+			     && slots[j]->type == slots[i]->type
+			     && slots[j - 1]->offset + slots[j - 1]->len
+			     == slots[j]->offset;
+			     ++j) {
+				/* No op */
+			}
+
+			if (j - i > 1) {
+				os_aio_linux_merge(slots + i, j - i);
+
+				MONITOR_INC_VALUE(
+					MONITOR_OS_AIO_MERGED, j - i - 1);
+			}
+
+			/* Keep the first slot of each request. */
+			slots[n_reqs++] = slots[i];
+
+			i = j;
+		}
+
+#if defined(LINUX_IO_URING)
+		if (srv_use_io_uring) {
+			os_aio_uring_submit(array, segment, slots, n_reqs);
+
+			os_mutex_exit(array->mutex);
+
+			continue;
+		}
+#endif /* LINUX_IO_URING */
+
+		os_mutex_exit(array->mutex);
+
+		for (ulint i = 0; i < n_reqs; ++i) {
+			iocbs[i] = &slots[i]->control;
+		}
+
+		os_aio_linux_submit_iocbs(array, segment, iocbs, n_reqs);
+	}
+}
+#endif /* LINUX_NATIVE_AIO */
+
 /**********************************************************************//**
 Wakes up a simulated aio i/o-handler thread if it has something to do. */
 static
@@ -4418,14 +5496,33 @@ os_aio_simulated_wake_handler_thread(
 }
 
 /**********************************************************************//**
-Wakes up simulated aio i/o-handler threads if they have something to do. */
+Wakes up simulated aio i/o-handler threads if they have something to do.
+With Linux native aio, submits the requests that are waiting to be
+batched instead. */
 UNIV_INTERN
 void
 os_aio_simulated_wake_handler_threads(void)
 /*=======================================*/
 {
 	if (srv_use_native_aio) {
-		/* We do not use simulated aio: do nothing */
+#if defined(LINUX_NATIVE_AIO)
+		/* Hand the requests that were posted with
+		OS_AIO_SIMULATED_WAKE_LATER to the kernel, one batch
+		per segment. The handler threads wait in
+		io_getevents() and need no wakeup. */
+
+		for (ulint i = 0; i < os_aio_n_segments; i++) {
+			os_aio_array_t*	array;
+			ulint		segment;
+
+			segment = os_aio_get_array_and_local_segment(
+				&array, i);
+
+			if (array->n_pending > 0) {
+				os_aio_linux_submit_pending(array, segment);
+			}
+		}
+#endif /* LINUX_NATIVE_AIO */
 
 		return;
 	}
@@ -4474,54 +5571,6 @@ readahead requests. */
 #endif /* __WIN__ */
 }
 
-#if defined(LINUX_NATIVE_AIO)
-/*******************************************************************//**
-Dispatch an AIO request to the kernel.
-@return	TRUE on success. */
-static
-ibool
-os_aio_linux_dispatch(
-/*==================*/
-	os_aio_array_t*	array,	/*!< in: io request array. */
-	os_aio_slot_t*	slot)	/*!< in: an already reserved slot. */
-{
-	int		ret;
-	ulint		io_ctx_index;
-	struct iocb*	iocb;
-
-	ut_ad(slot != NULL);
-	ut_ad(array);
-
-	ut_a(slot->reserved);
-
-	/* Find out what we are going to work with.
-	The iocb struct is directly in the slot.
-	The io_context is one per segment. */
-
-	iocb = &slot->control;
-	io_ctx_index = (slot->pos * array->n_segments) / array->n_slots;
-
-	ret = io_submit(array->aio_ctx[io_ctx_index], 1, &iocb);
-
-#if defined(UNIV_AIO_DEBUG)
-	fprintf(stderr,
-		"io_submit[%c] ret[%d]: slot[%p] ctx[%p] seg[%lu]\n",
-		(slot->type == OS_FILE_WRITE) ? 'w' : 'r', ret, slot,
-		array->aio_ctx[io_ctx_index], (ulong) io_ctx_index);
-#endif
-
-	/* io_submit returns number of successfully
-	queued requests or -errno. */
-	if (UNIV_UNLIKELY(ret != 1)) {
-		errno = -ret;
-		return(FALSE);
-	}
-
-	return(TRUE);
-}
-#endif /* LINUX_NATIVE_AIO */
-
-
 /*******************************************************************//**
 NOTE! Use the corresponding macro os_aio(), not directly this function!
 Requests an asynchronous i/o operation.
@@ -4666,8 +5715,11 @@ try_again:
 				       &(slot->control));
 
 #elif defined(LINUX_NATIVE_AIO)
-			if (!os_aio_linux_dispatch(array, slot)) {
-				goto err_exit;
+			if (!wake_later) {
+				os_aio_linux_submit_pending(
+					array,
+					(slot->pos * array->n_segments)
+					/ array->n_slots);
 			}
 #endif /* WIN_ASYNC_IO */
 		} else {
@@ -4686,8 +5738,11 @@ try_again:
 					&(slot->control));
 
 #elif defined(LINUX_NATIVE_AIO)
-			if (!os_aio_linux_dispatch(array, slot)) {
-				goto err_exit;
+			if (!wake_later) {
+				os_aio_linux_submit_pending(
+					array,
+					(slot->pos * array->n_segments)
+					/ array->n_slots);
 			}
 #endif /* WIN_ASYNC_IO */
 		} else {
@@ -4730,9 +5785,9 @@ try_again:
 	/* aio was queued successfully! */
 	return(TRUE);
 
-#if defined LINUX_NATIVE_AIO || defined WIN_ASYNC_IO
+#ifdef WIN_ASYNC_IO
 err_exit:
-#endif /* LINUX_NATIVE_AIO || WIN_ASYNC_IO */
+#endif /* WIN_ASYNC_IO */
 	os_aio_array_free_slot(array, slot);
 
 	if (os_file_handle_error(
@@ -4920,6 +5975,103 @@ os_aio_windows_handle(
 #endif
 
 #if defined(LINUX_NATIVE_AIO)
+#if defined(LINUX_IO_URING)
+/******************************************************************//**
+The io_uring counterpart of os_aio_linux_collect(): waits for completed
+requests on the io_uring of a segment and marks their slots done. Only
+the i/o-handler thread of the segment calls this, so the completion
+queue needs no latch. Returns after at most OS_AIO_REAP_TIMEOUT. */
+static
+void
+os_aio_uring_collect(
+/*=================*/
+	os_aio_array_t* array,		/*!< in/out: slot array. */
+	ulint		segment,	/*!< in: local segment no. */
+	ulint		seg_size)	/*!< in: segment size. */
+{
+	struct io_uring*	ring = array->uring[segment];
+	struct io_uring_cqe*	cqes[OS_AIO_LINUX_SUBMIT_BATCH];
+	struct io_uring_cqe*	cqe;
+	struct __kernel_timespec	timeout;
+	ulint			start_pos = segment * seg_size;
+	ulint			end_pos = start_pos + seg_size;
+	unsigned		n;
+	int			ret;
+
+	timeout.tv_sec = 0;
+	timeout.tv_nsec = OS_AIO_REAP_TIMEOUT;
+
+	ret = io_uring_wait_cqe_timeout(ring, &cqe, &timeout);
+
+	switch (ret) {
+	case 0:
+		break;
+	case -ETIME:
+	case -EINTR:
+	case -EAGAIN:
+		/* Let the caller look at the array again. */
+		return;
+	default:
+		ib_logf(IB_LOG_LEVEL_FATAL,
+			"unexpected ret_code[%d] from"
+			" io_uring_wait_cqe_timeout()", ret);
+	}
+
+	/* Reap all the completed requests under one acquisition of
+	the array mutex. */
+	os_mutex_enter(array->mutex);
+
+	while ((n = io_uring_peek_batch_cqe(
+			ring, cqes, OS_AIO_LINUX_SUBMIT_BATCH)) > 0) {
+
+		for (unsigned i = 0; i < n; ++i) {
+			os_aio_slot_t*	slot;
+			long		remaining;
+
+			slot = static_cast<os_aio_slot_t*>(
+				io_uring_cqe_get_data(cqes[i]));
+
+			ut_a(slot != NULL);
+
+			/* Distribute the result over the merged slots
+			like os_aio_linux_collect() does. */
+			remaining = cqes[i]->res;
+
+			do {
+				os_aio_slot_t*	next = slot->merged_next;
+
+				ut_a(slot->reserved);
+				ut_ad(!slot->pending);
+				ut_a(slot->pos >= start_pos);
+				ut_a(slot->pos < end_pos);
+
+				if (remaining < 0) {
+					slot->n_bytes = (int) remaining;
+					slot->ret = (int) remaining;
+				} else if ((ulint) remaining >= slot->len) {
+					slot->n_bytes = (int) slot->len;
+					slot->ret = 0;
+					remaining -= (long) slot->len;
+				} else {
+					slot->n_bytes = (int) remaining;
+					slot->ret = 0;
+					remaining = 0;
+				}
+
+				slot->io_already_done = TRUE;
+				slot->merged_next = NULL;
+
+				slot = next;
+			} while (slot != NULL);
+		}
+
+		io_uring_cq_advance(ring, n);
+	}
+
+	os_mutex_exit(array->mutex);
+}
+#endif /* LINUX_IO_URING */
+
 /******************************************************************//**
 This function is only used in Linux native asynchronous i/o. This is
 called from within the io-thread. If there are no completed IO requests
@@ -4952,6 +6104,13 @@ os_aio_linux_collect(
 	ut_ad(seg_size > 0);
 	ut_ad(segment < array->n_segments);
 
+#if defined(LINUX_IO_URING)
+	if (srv_use_io_uring) {
+		os_aio_uring_collect(array, segment, seg_size);
+		return;
+	}
+#endif /* LINUX_IO_URING */
+
 	/* Which part of event array we are going to work on. */
 	events = &array->aio_events[segment * seg_size];
 
@@ -4975,9 +6134,14 @@ retry:
 	ret = io_getevents(io_ctx, 1, seg_size, events, &timeout);
 
 	if (ret > 0) {
+		/* Reap all the completed requests under one
+		acquisition of the array mutex. */
+		os_mutex_enter(array->mutex);
+
 		for (i = 0; i < ret; i++) {
 			os_aio_slot_t*	slot;
 			struct iocb*	control;
+			long		remaining;
 
 			control = (struct iocb*) events[i].obj;
 			ut_a(control != NULL);
@@ -4996,20 +6160,47 @@ retry:
 				slot, io_ctx, segment);
 #endif
 
-			/* We are not scribbling previous segment. */
-			ut_a(slot->pos >= start_pos);
+			/* A merged request completes all the slots
+			chained to its first slot. The transferred bytes
+			are distributed over the slots in file order, so
+			that after a short transfer the trailing slots
+			report the error. */
+			remaining = (long) events[i].res;
+
+			do {
+				os_aio_slot_t*	next = slot->merged_next;
+
+				ut_a(slot->reserved);
+				ut_ad(!slot->pending);
+
+				/* We are not scribbling previous segment. */
+				ut_a(slot->pos >= start_pos);
+
+				/* We have not overstepped to next segment. */
+				ut_a(slot->pos < end_pos);
+
+				/* Mark this request as completed. The error
+				handling will be done in the calling
+				function. */
+				if (remaining < 0) {
+					slot->n_bytes = (int) remaining;
+				} else if ((ulint) remaining >= slot->len) {
+					slot->n_bytes = (int) slot->len;
+					remaining -= (long) slot->len;
+				} else {
+					slot->n_bytes = (int) remaining;
+					remaining = 0;
+				}
 
-			/* We have not overstepped to next segment. */
-			ut_a(slot->pos < end_pos);
+				slot->ret = events[i].res2;
+				slot->io_already_done = TRUE;
+				slot->merged_next = NULL;
 
-			/* Mark this request as completed. The error handling
-			will be done in the calling function. */
-			os_mutex_enter(array->mutex);
-			slot->n_bytes = events[i].res;
-			slot->ret = events[i].res2;
-			slot->io_already_done = TRUE;
-			os_mutex_exit(array->mutex);
+				slot = next;
+			} while (slot != NULL);
 		}
+
+		os_mutex_exit(array->mutex);
 		return;
 	}
 
@@ -5029,9 +6220,12 @@ retry:
 		interrupt. If we have some completed IOs available then
 		the return code will be the number of IOs. We get EINTR only
 		if there are no completed IOs and we have been interrupted. */
-	case 0:
-		/* No pending request! Go back and check again. */
 		goto retry;
+	case 0:
+		/* No completed request! Let the caller look at the array
+		again: a request may have been completed synchronously or
+		be waiting to be submitted. */
+		return;
 	}
 
 	/* All other errors should cause a trap for now. */
@@ -5111,8 +6305,15 @@ os_aio_linux_handle(
 			return(TRUE);
 		}
 
+		/* Submit the requests that are still waiting for a
+		batch, in case nobody else does it. */
+		if (array->n_pending > 0) {
+			os_aio_linux_submit_pending(array, segment);
+		}
+
 		/* Wait for some request. Note that we return
-		from wait iff we have found a request. */
+		from wait iff we have found a request or the
+		wait timed out. */
 
 		srv_set_io_thread_op_info(global_seg,
 			"waiting for completed aio requests");
@@ -241,6 +241,193 @@ page_cur_rec_field_extends(
 }
 #endif /* PAGE_CUR_LE_OR_EXTENDS */
 
+/** innodb_page_search_keys: whether page_cur_search_with_match() caches
+the key prefixes of the page directory slots in the buf_block_t */
+UNIV_INTERN my_bool	page_cur_search_keys = FALSE;
+
+/****************************************************************//**
+Determines whether the page directory of an index can be searched by
+key prefixes. The first field must be a NOT NULL integer or binary
+string of at most 8 bytes, whose stored bytes sort like the values.
+@return	length of the first field, or 0 if the index is not eligible */
+UNIV_INLINE
+ulint
+page_cur_search_key_len(
+/*====================*/
+	const dict_index_t*	index)	/*!< in: index */
+{
+	const dict_field_t*	field;
+	const dict_col_t*	col;
+
+	if (dict_index_is_univ(index)) {
+		return(0);
+	}
+
+	field = dict_index_get_nth_field(index, 0);
+	col = dict_field_get_col(field);
+
+	if (field->fixed_len == 0
+	    || field->fixed_len > sizeof(ib_uint64_t)
+	    || field->prefix_len != 0
+	    || !(col->prtype & DATA_NOT_NULL)) {
+
+		return(0);
+	}
+
+	switch (col->mtype) {
+	case DATA_INT:
+	case DATA_SYS:
+	case DATA_FIXBINARY:
+		return(field->fixed_len);
+	}
+
+	return(0);
+}
+
+/****************************************************************//**
+Converts the first field of a record or a search tuple to a key prefix
+that compares like the field.
+@return	the field as a left-aligned big-endian integer */
+UNIV_INLINE
+ib_uint64_t
+page_cur_search_key(
+/*================*/
+	const byte*	data,	/*!< in: field data */
+	ulint		len)	/*!< in: length of the field, at most 8 */
+{
+	ib_uint64_t	key = 0;
+
+	for (ulint i = 0; i < len; i++) {
+		key = key << 8 | data[i];
+	}
+
+	return(key << (8 * (sizeof key - len)));
+}
+
+/****************************************************************//**
+Returns the key prefixes of the records owning the page directory slots,
+building them first if the page has been modified since they were built.
+The page can only be modified under an exclusive latch, so the prefixes
+that are valid for the page are never rebuilt while another thread that
+holds a latch on the block is reading them.
+@return	key prefixes, indexed by slot number */
+static
+const ib_uint64_t*
+page_cur_search_keys_get(
+/*=====================*/
+	buf_block_t*	block,		/*!< in/out: latched index page */
+	ulint		key_len)	/*!< in: page_cur_search_key_len() */
+{
+	const page_t*	page	= buf_block_get_frame(block);
+	ulint		n_slots	= page_dir_get_n_slots(page);
+	ib_uint64_t	clock	= block->modify_clock;
+	ulint		valid_n_slots;
+
+	/* search_clock is written before search_n_slots and after the
+	keys. Seeing the current clock thus means that the keys are
+	complete, even if the old search_n_slots was read. */
+	valid_n_slots = block->search_n_slots;
+	os_rmb;
+
+	if (valid_n_slots == n_slots && block->search_clock == clock) {
+		os_rmb;
+		return(block->search_keys);
+	}
+
+	mutex_enter(&block->mutex);
+
+	if (block->search_n_slots != n_slots
+	    || block->search_clock != clock) {
+
+		block->search_n_slots = 0;
+		os_wmb;
+
+		if (block->search_keys_size < n_slots) {
+			ut_free(block->search_keys);
+			block->search_keys = static_cast<ib_uint64_t*>(
+				ut_malloc(n_slots * sizeof *block->search_keys));
+			block->search_keys_size = n_slots;
+		}
+
+		for (ulint i = 0; i < n_slots; i++) {
+			const rec_t*	rec = page_dir_slot_get_rec(
+				page_dir_get_nth_slot(page, i));
+
+			/* The slots of the infimum and supremum records
+			are never probed. The first user record, which may
+			carry REC_INFO_MIN_REC_FLAG, does not own a slot
+			when there are more than two slots. */
+			block->search_keys[i] = page_rec_is_user_rec(rec)
+				? page_cur_search_key(rec, key_len)
+				: 0;
+		}
+
+		os_wmb;
+		block->search_clock = clock;
+		os_wmb;
+		block->search_n_slots = n_slots;
+	}
+
+	mutex_exit(&block->mutex);
+
+	return(block->search_keys);
+}
+
+/****************************************************************//**
+Narrows down the binary search of page_cur_search_with_match() by the
+cached key prefixes of the page directory slots. Only the slots whose
+key prefix differs from that of the tuple are skipped; an equal prefix
+leaves the comparison of the remaining fields to the caller. */
+static
+void
+page_cur_search_slots(
+/*==================*/
+	const buf_block_t*	block,	/*!< in: latched index page */
+	const dict_index_t*	index,	/*!< in: record descriptor */
+	const dtuple_t*		tuple,	/*!< in: data tuple */
+	ulint*			low,	/*!< in/out: slot whose record is
+					less than the tuple */
+	ulint*			up)	/*!< in/out: slot whose record is
+					greater than the tuple */
+{
+	ulint			key_len	= page_cur_search_key_len(index);
+	const dfield_t*		field;
+	const ib_uint64_t*	keys;
+	ib_uint64_t		key;
+
+	if (key_len == 0
+	    || dtuple_get_n_fields_cmp(tuple) == 0
+	    || (dtuple_get_info_bits(tuple) & REC_INFO_MIN_REC_FLAG)) {
+
+		return;
+	}
+
+	field = dtuple_get_nth_field(tuple, 0);
+
+	if (dfield_get_len(field) != key_len) {
+		/* This includes SQL NULL. */
+		return;
+	}
+
+	key = page_cur_search_key(
+		static_cast<const byte*>(dfield_get_data(field)), key_len);
+
+	keys = page_cur_search_keys_get(
+		const_cast<buf_block_t*>(block), key_len);
+
+	while (*up - *low > 1) {
+		ulint	mid = (*low + *up) / 2;
+
+		if (key > keys[mid]) {
+			*low = mid;
+		} else if (key < keys[mid]) {
+			*up = mid;
+		} else {
+			break;
+		}
+	}
+}
+
 /****************************************************************//**
 Searches the right position for a page cursor. */
 UNIV_INTERN
@@ -363,6 +550,53 @@ page_cur_search_with_match(
 	low = 0;
 	up = page_dir_get_n_slots(page) - 1;
 
+	if (page_cur_search_keys && up - low > 1) {
+		ulint	n_slots = up + 1;
+
+		page_cur_search_slots(block, index, tuple, &low, &up);
+
+		/* Compute the matched fields of the new limits, which
+		the caller may need in the end. Any record on the page
+		matches at least the minimum of the given limits. */
+		if (low > 0) {
+			ut_pair_min(&cur_matched_fields, &cur_matched_bytes,
+				    low_matched_fields, low_matched_bytes,
+				    up_matched_fields, up_matched_bytes);
+
+			mid_rec = page_dir_slot_get_rec(
+				page_dir_get_nth_slot(page, low));
+			offsets = rec_get_offsets(
+				mid_rec, index, offsets,
+				dtuple_get_n_fields_cmp(tuple), &heap);
+			cmp = cmp_dtuple_rec_with_match(
+				tuple, mid_rec, offsets,
+				&cur_matched_fields, &cur_matched_bytes);
+			ut_ad(cmp > 0);
+
+			low_matched_fields = cur_matched_fields;
+			low_matched_bytes = cur_matched_bytes;
+		}
+
+		if (up < n_slots - 1) {
+			ut_pair_min(&cur_matched_fields, &cur_matched_bytes,
+				    *ilow_matched_fields, *ilow_matched_bytes,
+				    up_matched_fields, up_matched_bytes);
+
+			mid_rec = page_dir_slot_get_rec(
+				page_dir_get_nth_slot(page, up));
+			offsets = rec_get_offsets(
+				mid_rec, index, offsets,
+				dtuple_get_n_fields_cmp(tuple), &heap);
+			cmp = cmp_dtuple_rec_with_match(
+				tuple, mid_rec, offsets,
+				&cur_matched_fields, &cur_matched_bytes);
+			ut_ad(cmp < 0);
+
+			up_matched_fields = cur_matched_fields;
+			up_matched_bytes = cur_matched_bytes;
+		}
+	}
+
 	/* Perform binary search until the lower and upper limit directory
 	slots come to the distance 1 of each other */
 
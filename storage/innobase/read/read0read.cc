@@ -29,6 +29,7 @@ Created 2/16/1997 Heikki Tuuri
 #include "read0read.ic"
 #endif
 
+#include "srv0mon.h"
 #include "srv0srv.h"
 #include "trx0sys.h"
 
@@ -172,8 +173,28 @@ In which order will the views be opened? Should it matter? If no, why?
 
 The order does not matter. No new transactions can be created and no running
 transaction can commit or rollback (or free views).
+
+Read views are copied from trx_sys->snapshot without holding trx_sys->mutex.
+The view is then added to trx_sys->view_list under the mutex, and copied
+again if trx_sys->snapshot.version changed meanwhile, because purge may
+already have opened a newer view. Thus the views in the list are never older
+than the purge view, as above.
+
+A view closed by read_view_close_for_mysql() is removed from the list and
+kept in trx_t::closed_read_view with read_view_t::closed set. If
+trx_sys->snapshot.version has not changed when the transaction needs a view
+again, the view is added back to the list as is, without copying the
+snapshot: purge could not have opened a newer view in the meantime.
 */
 
+/** Minimum number of cells allocated for the trx_ids array of a view, so
+that the view can be refilled when a few more transactions are active */
+#define READ_VIEW_MIN_TRX_IDS	16
+
+/** Number of times that read_view_copy_snapshot() retries with
+UT_RELAX_CPU() before it yields the processor */
+#define READ_VIEW_SNAPSHOT_SPIN_ROUNDS	30
+
 /*********************************************************************//**
 Creates a read view object.
 @return	own: read view struct */
@@ -190,8 +211,10 @@ read_view_create_low(
 		mem_heap_alloc(
 			heap, sizeof(*view) + n * sizeof(*view->trx_ids)));
 
-	view->n_trx_ids = n;
+	view->n_trx_ids = 0;
+	view->max_trx_ids = n;
 	view->trx_ids = (trx_id_t*) &view[1];
+	view->closed = FALSE;
 
 	return(view);
 }
@@ -231,10 +254,13 @@ read_view_clone(
 	memcpy(clone, view, sz);
 
 	clone->trx_ids = (trx_id_t*) &clone[1];
+	clone->max_trx_ids = clone->n_trx_ids;
 
 	new_view = (read_view_t*) &clone->trx_ids[clone->n_trx_ids];
 	new_view->trx_ids = (trx_id_t*) &new_view[1];
 	new_view->n_trx_ids = clone->n_trx_ids + 1;
+	new_view->max_trx_ids = new_view->n_trx_ids;
+	new_view->closed = FALSE;
 
 	ut_a(new_view->n_trx_ids == view->n_trx_ids + 1);
 
@@ -273,85 +299,90 @@ read_view_add(
 	ut_ad(read_view_list_validate());
 }
 
-/** Functor to create thew view trx_ids array. */
-struct	CreateView {
+/*********************************************************************//**
+Copies trx_sys->snapshot to a read view, without trx_sys->mutex.
+@return	0, or the number of trx_ids cells that the view would need if
+it is too small */
+static
+ulint
+read_view_copy_snapshot(
+/*====================*/
+	read_view_t*	view,		/*!< in/out: read view */
+	trx_id_t	exclude_id)	/*!< in: id of the transaction whose
+					changes the view sees, or 0 */
+{
+	const trx_snapshot_t*	snapshot = &trx_sys->snapshot;
+	ulint			n_spins = 0;
 
-	CreateView(read_view_t*	view)
-		: m_view(view)
-	{
-		  m_n_trx = m_view->n_trx_ids;
-		  m_view->n_trx_ids = 0;
-	}
+	for (;;) {
+		ulint	version = snapshot->version;
 
-	void	operator()(const trx_t* trx)
-	{
-		ut_ad(mutex_own(&trx_sys->mutex));
-		ut_ad(trx->in_rw_trx_list);
+		os_rmb;
+		os_compiler_barrier();
 
-		/* trx->state cannot change from or to NOT_STARTED
-		while we are holding the trx_sys->mutex. It may change
-		from ACTIVE to PREPARED or COMMITTED. */
+		if (!(version & 1)) {
+			const trx_snapshot_buf_t*	buf = snapshot->buf;
+			ulint				n = snapshot->n_elems;
+			trx_id_t			low_limit_no;
 
-		if (trx->id != m_view->creator_trx_id
-		    && !trx_state_eq(trx, TRX_STATE_COMMITTED_IN_MEMORY)) {
+			/* No future transactions should be visible in
+			the view */
 
-			ut_ad(m_n_trx > m_view->n_trx_ids);
+			low_limit_no = snapshot->max_trx_id;
+			view->low_limit_id = low_limit_no;
+			view->n_trx_ids = 0;
 
-			m_view->trx_ids[m_view->n_trx_ids++] = trx->id;
+			/* No active transaction should be visible,
+			except exclude_id. Copy the ids in descending
+			order. */
 
-			/* NOTE that a transaction whose trx number is <
-			trx_sys->max_trx_id can still be active, if it is
-			in the middle of its commit! Note that when a
-			transaction starts, we initialize trx->no to
-			TRX_ID_MAX. */
+			if (n <= buf->size && n <= view->max_trx_ids) {
 
-			/* trx->no is protected by trx_sys->mutex, which
-			we are holding. It is assigned by trx_commit()
-			before lock_trx_release_locks() assigns
-			trx->state = TRX_STATE_COMMITTED_IN_MEMORY. */
+				for (ulint i = n; i--; ) {
+					trx_id_t	id = buf->elems[i].id;
+					trx_id_t	no = buf->elems[i].no;
 
-			if (m_view->low_limit_no > trx->no) {
-				m_view->low_limit_no = trx->no;
-			}
-		}
-	}
+					if (id == exclude_id) {
+						continue;
+					}
 
-	read_view_t*	m_view;
-	ulint		m_n_trx;
-};
+					view->trx_ids[view->n_trx_ids++] = id;
 
-/*********************************************************************//**
-Opens a read view where exactly the transactions serialized before this
-point in time are seen in the view.
-@return	own: read view struct */
-static
-read_view_t*
-read_view_open_now_low(
-/*===================*/
-	trx_id_t	cr_trx_id,	/*!< in: trx_id of creating
-					transaction, or 0 used in purge */
-	mem_heap_t*	heap)		/*!< in: memory heap from which
-					allocated */
-{
-	read_view_t*	view;
-	ulint		n_trx = UT_LIST_GET_LEN(trx_sys->rw_trx_list);
-
-	ut_ad(mutex_own(&trx_sys->mutex));
+					/* NOTE that a transaction whose
+					trx number is < low_limit_no can
+					still be active, if it is in the
+					middle of its commit! */
 
-	view = read_view_create_low(n_trx, heap);
+					if (low_limit_no > no) {
+						low_limit_no = no;
+					}
+				}
+			}
 
-	view->undo_no = 0;
-	view->type = VIEW_NORMAL;
-	view->creator_trx_id = cr_trx_id;
+			os_rmb;
+			os_compiler_barrier();
 
-	/* No future transactions should be visible in the view */
+			if (version == snapshot->version) {
 
-	view->low_limit_no = trx_sys->max_trx_id;
-	view->low_limit_id = view->low_limit_no;
+				if (n > view->max_trx_ids) {
+					return(n);
+				}
 
-	/* No active transaction should be visible, except cr_trx */
+				view->low_limit_no = low_limit_no;
+				view->version = version;
+				break;
+			}
+		}
 
-	ut_list_map(trx_sys->rw_trx_list, &trx_t::trx_list, CreateView(view));
+		/* The writer may hold the snapshot across an access to
+		the trx system header page in trx_sys_get_new_trx_id(). */
+		if (++n_spins < READ_VIEW_SNAPSHOT_SPIN_ROUNDS) {
+			UT_RELAX_CPU();
+		} else {
+			n_spins = 0;
+			os_thread_yield();
+		}
+	}
 
 	if (view->n_trx_ids > 0) {
 		/* The last active transaction has the smallest id: */
@@ -360,9 +391,35 @@ read_view_open_now_low(
 		view->up_limit_id = view->low_limit_id;
 	}
 
-	/* Purge views are not added to the view list. */
-	if (cr_trx_id > 0) {
-		read_view_add(view);
+	return(0);
+}
+
+/*********************************************************************//**
+Fills a read view from trx_sys->snapshot, allocating a new view if the
+given one is NULL or too small.
+@return	read view struct */
+static
+read_view_t*
+read_view_fill(
+/*===========*/
+	read_view_t*	view,		/*!< in/out: view that is not in
+					trx_sys->view_list, or NULL */
+	trx_id_t	exclude_id,	/*!< in: id of the transaction whose
+					changes the view sees, or 0 */
+	mem_heap_t*	heap)		/*!< in: memory heap from which
+					allocated */
+{
+	ulint	n;
+
+	if (view == NULL) {
+		n = 2 * trx_sys->snapshot.n_elems;
+
+		view = read_view_create_low(
+			ut_max(n, READ_VIEW_MIN_TRX_IDS), heap);
+	}
+
+	while ((n = read_view_copy_snapshot(view, exclude_id)) != 0) {
+		view = read_view_create_low(2 * n, heap);
 	}
 
 	return(view);
@@ -370,28 +427,113 @@ read_view_open_now_low(
 
 /*********************************************************************//**
 Opens a read view where exactly the transactions serialized before this
-point in time are seen in the view.
+point in time are seen in the view, and adds it to trx_sys->view_list.
 @return	own: read view struct */
-UNIV_INTERN
+static
 read_view_t*
-read_view_open_now(
+read_view_open_low(
 /*===============*/
+	read_view_t*	view,		/*!< in/out: view to refill, not in
+					trx_sys->view_list, or NULL */
+	ulint		type,		/*!< in: VIEW_NORMAL or
+					VIEW_HIGH_GRANULARITY */
+	undo_no_t	undo_no,	/*!< in: undo_no of the creating
+					transaction if VIEW_HIGH_GRANULARITY */
 	trx_id_t	cr_trx_id,	/*!< in: trx_id of creating
-					transaction, or 0 used in purge */
+					transaction */
 	mem_heap_t*	heap)		/*!< in: memory heap from which
 					allocated */
 {
-	read_view_t*	view;
+	/* A high-granularity view does not see the changes of the
+	creating transaction either. */
+	trx_id_t	exclude_id = type == VIEW_NORMAL ? cr_trx_id : 0;
+
+	ut_ad(cr_trx_id > 0);
+
+	view = read_view_fill(view, exclude_id, heap);
 
 	mutex_enter(&trx_sys->mutex);
 
-	view = read_view_open_now_low(cr_trx_id, heap);
+	if (view->version != trx_sys->snapshot.version) {
+		/* A read-write transaction started or committed after
+		the copy. The snapshot cannot change while we hold
+		trx_sys->mutex. */
+		view = read_view_fill(view, exclude_id, heap);
+
+		ut_ad(view->version == trx_sys->snapshot.version);
+	}
+
+	view->type = type;
+	view->undo_no = undo_no;
+	view->creator_trx_id = cr_trx_id;
+	view->closed = FALSE;
+
+	read_view_add(view);
 
 	mutex_exit(&trx_sys->mutex);
 
 	return(view);
 }
 
+/*********************************************************************//**
+Opens a read view for a transaction of MySQL, where exactly the transactions
+serialized before this point in time are seen in the view. Reuses the view
+that the transaction closed last, if no read-write transaction has started
+or committed since it was opened.
+@return	own: read view struct, allocated from
+trx->global_read_view_heap */
+UNIV_INTERN
+read_view_t*
+read_view_open_for_mysql(
+/*=====================*/
+	trx_t*		trx)		/*!< in/out: transaction that has
+					no global read view */
+{
+	read_view_t*	view = trx->closed_read_view;
+
+	ut_ad(trx->global_read_view == NULL);
+
+	if (view == NULL) {
+		return(read_view_open_low(NULL, VIEW_NORMAL, 0, trx->id,
+					  trx->global_read_view_heap));
+	}
+
+	trx->closed_read_view = NULL;
+
+	ut_ad(view->closed);
+	ut_ad(view->type == VIEW_NORMAL);
+
+	if (view->version == trx_sys->snapshot.version) {
+
+		mutex_enter(&trx_sys->mutex);
+
+		/* The snapshot cannot change while we hold trx_sys->mutex.
+		If it is the one that the view was copied from, purge cannot
+		have opened a newer view meanwhile. */
+		if (view->version == trx_sys->snapshot.version) {
+
+			/* If the creating transaction is new, the view did
+			not exclude it: it is not in the unchanged snapshot. */
+			view->creator_trx_id = trx->id;
+			view->closed = FALSE;
+
+			read_view_add(view);
+
+			mutex_exit(&trx_sys->mutex);
+
+			MONITOR_INC(MONITOR_READ_VIEW_REUSED);
+
+			return(view);
+		}
+
+		mutex_exit(&trx_sys->mutex);
+	}
+
+	/* Refill the view without trx_sys->mutex. */
+	return(read_view_open_low(view, VIEW_NORMAL, 0, trx->id,
+				  trx->global_read_view_heap));
+}
+
 /*********************************************************************//**
 Makes a copy of the oldest existing read view, with the exception that also
 the creating trx of the oldest view is set as not visible in the 'copied'
@@ -417,7 +559,13 @@ read_view_purge_open(
 
 	if (oldest_view == NULL) {
 
-		view = read_view_open_now_low(0, heap);
+		/* The snapshot cannot change while we hold
+		trx_sys->mutex. */
+		view = read_view_fill(NULL, 0, heap);
+
+		view->type = VIEW_NORMAL;
+		view->undo_no = 0;
+		view->creator_trx_id = 0;
 
 		mutex_exit(&trx_sys->mutex);
 
@@ -486,10 +634,13 @@ read_view_close_for_mysql(
 	trx_t*		trx)	/*!< in: trx which has a read view */
 {
 	ut_a(trx->global_read_view);
+	ut_ad(trx->closed_read_view == NULL);
 
 	read_view_remove(trx->global_read_view, false);
 
-	mem_heap_empty(trx->global_read_view_heap);
+	trx->global_read_view->closed = TRUE;
+
+	trx->closed_read_view = trx->global_read_view;
 
 	trx->read_view = NULL;
 	trx->global_read_view = NULL;
@@ -544,9 +695,7 @@ read_cursor_view_create_for_mysql(
 /*==============================*/
 	trx_t*		cr_trx)	/*!< in: trx where cursor view is created */
 {
-	read_view_t*	view;
 	mem_heap_t*	heap;
-	ulint		n_trx;
 	cursor_view_t*	curview;
 
 	/* Use larger heap than in trx_create when creating a read_view
@@ -565,39 +714,9 @@ read_cursor_view_create_for_mysql(
 
 	cr_trx->n_mysql_tables_in_use = 0;
 
-	mutex_enter(&trx_sys->mutex);
-
-	n_trx = UT_LIST_GET_LEN(trx_sys->rw_trx_list);
-
-	curview->read_view = read_view_create_low(n_trx, curview->heap);
-
-	view = curview->read_view;
-	view->undo_no = cr_trx->undo_no;
-	view->type = VIEW_HIGH_GRANULARITY;
-	view->creator_trx_id = UINT64_UNDEFINED;
-
-	/* No future transactions should be visible in the view */
-
-	view->low_limit_no = trx_sys->max_trx_id;
-	view->low_limit_id = view->low_limit_no;
-
-	/* No active transaction should be visible */
-
-	ut_list_map(trx_sys->rw_trx_list, &trx_t::trx_list, CreateView(view));
-
-	view->creator_trx_id = cr_trx->id;
-
-	if (view->n_trx_ids > 0) {
-		/* The last active transaction has the smallest id: */
-
-		view->up_limit_id = view->trx_ids[view->n_trx_ids - 1];
-	} else {
-		view->up_limit_id = view->low_limit_id;
-	}
-
-	read_view_add(view);
-
-	mutex_exit(&trx_sys->mutex);
+	curview->read_view = read_view_open_low(
+		NULL, VIEW_HIGH_GRANULARITY, cr_trx->undo_no, cr_trx->id,
+		curview->heap);
 
 	return(curview);
 }
@@ -125,6 +125,109 @@ cmp_collate(
 	return((ulint) srv_latin1_ordering[code]);
 }
 
+/*************************************************************//**
+Skips the leading bytes that are equal in two byte strings, a machine
+word at a time. The first differing byte is left to the byte-by-byte
+comparison, which may have to collate it.
+@return	number of leading bytes that are known to be equal: a multiple of
+sizeof(ib_uint64_t) that is at most len */
+UNIV_INLINE
+ulint
+cmp_skip_equal_words(
+/*=================*/
+	const byte*	data1,	/*!< in: data */
+	const byte*	data2,	/*!< in: data */
+	ulint		len)	/*!< in: number of bytes available in both */
+{
+	ulint	n = 0;
+
+	while (n + sizeof(ib_uint64_t) <= len) {
+		ib_uint64_t	word1;
+		ib_uint64_t	word2;
+
+		memcpy(&word1, data1 + n, sizeof word1);
+		memcpy(&word2, data2 + n, sizeof word2);
+
+		if (word1 != word2) {
+			break;
+		}
+
+		n += sizeof(ib_uint64_t);
+	}
+
+	return(n);
+}
+
+/*************************************************************//**
+Compares two integer fields of the same length. The integer columns are
+stored big-endian with the sign bit inverted, and the system columns
+big-endian, so that they sort like unsigned integers.
+@return	TRUE if len is supported, in which case *ret is 1, 0, -1 if data1
+is greater, equal, less than data2, respectively, and if *ret is not 0,
+*matched is the number of leading bytes that are equal in data1 and data2 */
+UNIV_INLINE
+ibool
+cmp_int_data(
+/*=========*/
+	const byte*	data1,	/*!< in: data */
+	const byte*	data2,	/*!< in: data */
+	ulint		len,	/*!< in: length of data1 and data2 */
+	int*		ret,	/*!< out: comparison result */
+	ulint*		matched)/*!< out: number of equal leading bytes,
+				set only if the fields differ */
+{
+	ib_uint64_t	int1;
+	ib_uint64_t	int2;
+	ulint		i;
+
+	switch (len) {
+	case 1:
+		int1 = mach_read_from_1(data1);
+		int2 = mach_read_from_1(data2);
+		break;
+	case 2:
+		int1 = mach_read_from_2(data1);
+		int2 = mach_read_from_2(data2);
+		break;
+	case 3:
+		int1 = mach_read_from_3(data1);
+		int2 = mach_read_from_3(data2);
+		break;
+	case 4:
+		int1 = mach_read_from_4(data1);
+		int2 = mach_read_from_4(data2);
+		break;
+	case 6:
+		int1 = mach_read_from_6(data1);
+		int2 = mach_read_from_6(data2);
+		break;
+	case 8:
+		int1 = mach_read_from_8(data1);
+		int2 = mach_read_from_8(data2);
+		break;
+	default:
+		return(FALSE);
+	}
+
+	if (int1 == int2) {
+		*ret = 0;
+
+		return(TRUE);
+	}
+
+	*ret = int1 < int2 ? -1 : 1;
+
+	/* Both values are stored big-endian, so the bytes before the
+	first differing one are the common prefix of the fields. */
+	for (i = 0; data1[i] == data2[i]; i++) {
+		ut_ad(i < len);
+	}
+
+	*matched = i;
+
+	return(TRUE);
+}
+
 /*************************************************************//**
 Returns TRUE if two columns are equal for comparison purposes.
 @return	TRUE if the columns are considered equal in comparisons */
@@ -740,6 +843,19 @@ cmp_dtuple_rec_with_match_low(
 			}
 		}
 
+		if ((mtype == DATA_INT || mtype == DATA_SYS)
+		    && dtuple_f_len == rec_f_len
+		    && cmp_int_data(static_cast<const byte*>(
+					    dfield_get_data(dtuple_field)),
+				    rec_b_ptr, rec_f_len, &ret, &cur_bytes)) {
+
+			if (ret != 0) {
+				goto order_resolved;
+			} else {
+				goto next_field;
+			}
+		}
+
 		if (mtype >= DATA_FLOAT
 		    || (mtype == DATA_BLOB
 			&& 0 == (prtype & DATA_BINARY_TYPE)
@@ -767,6 +883,17 @@ cmp_dtuple_rec_with_match_low(
 		rec_b_ptr = rec_b_ptr + cur_bytes;
 		dtuple_b_ptr = (byte*) dfield_get_data(dtuple_field)
 			+ cur_bytes;
+
+		if (dtuple_f_len > cur_bytes && rec_f_len > cur_bytes) {
+			ulint	n = cmp_skip_equal_words(
+				dtuple_b_ptr, rec_b_ptr,
+				ut_min(dtuple_f_len, rec_f_len) - cur_bytes);
+
+			cur_bytes += n;
+			rec_b_ptr += n;
+			dtuple_b_ptr += n;
+		}
+
 		/* Compare then the fields */
 
 		for (;;) {
@@ -1233,6 +1360,18 @@ cmp_rec_rec_with_match(
 			}
 		}
 
+		if ((mtype == DATA_INT || mtype == DATA_SYS)
+		    && rec1_f_len == rec2_f_len
+		    && cmp_int_data(rec1_b_ptr, rec2_b_ptr, rec1_f_len,
+				    &ret, &cur_bytes)) {
+
+			if (ret != 0) {
+				goto order_resolved;
+			} else {
+				goto next_field;
+			}
+		}
+
 		if (mtype >= DATA_FLOAT
 		    || (mtype == DATA_BLOB
 			&& 0 == (prtype & DATA_BINARY_TYPE)
@@ -1257,6 +1396,16 @@ cmp_rec_rec_with_match(
 		rec1_b_ptr = rec1_b_ptr + cur_bytes;
 		rec2_b_ptr = rec2_b_ptr + cur_bytes;
 
+		if (rec1_f_len > cur_bytes && rec2_f_len > cur_bytes) {
+			ulint	n = cmp_skip_equal_words(
+				rec1_b_ptr, rec2_b_ptr,
+				ut_min(rec1_f_len, rec2_f_len) - cur_bytes);
+
+			cur_bytes += n;
+			rec1_b_ptr += n;
+			rec2_b_ptr += n;
+		}
+
 		/* Compare then the fields */
 		for (;;) {
 			if (rec2_f_len <= cur_bytes) {
@@ -36,6 +36,7 @@ Completed by Sunny Bains and Marko Makela
 #include "ut0sort.h"
 #include "row0ftsort.h"
 #include "row0import.h"
+#include "btr0bulk.h"
 #include "handler0alter.h"
 #include "ha_prototypes.h"
 
@@ -632,7 +633,7 @@ row_merge_dup_report(
 	row_merge_dup_t*	dup,	/*!< in/out: for reporting duplicates */
 	const dfield_t*		entry)	/*!< in: duplicate index entry */
 {
-	if (!dup->n_dup++) {
+	if (!dup->n_dup++ && dup->table) {
 		/* Only report the first duplicate record,
 		but count all duplicate records. */
 		innobase_fields_to_mysql(dup->table, dup->index, entry);
@@ -1241,6 +1242,684 @@ row_merge_write_eof(
 	return(&block[0]);
 }
 
+/** Number of key ranges per thread in a parallel scan of the clustered
+index. Threads take the ranges in turn, so that the work stays balanced
+when the subtrees are of uneven size. */
+#define ROW_MERGE_SCAN_RANGES_PER_THREAD	4
+
+/** A task of a parallel phase of index creation, see
+row_merge_run_threads()
+@param ctx	shared state of the phase
+@param thread	number of the thread running the task, 0..n_threads-1
+@param task	number of the task, 0..n_tasks-1 */
+typedef void (*row_merge_task_t)(void* ctx, ulint thread, ulint task);
+
+/** Threads running the tasks of a parallel phase of index creation */
+struct row_merge_threads_t {
+	row_merge_task_t	func;		/*!< function running a task */
+	void*			ctx;		/*!< shared state of the tasks */
+	ulint			n_tasks;	/*!< number of tasks */
+	ulint			next;		/*!< next task to be started;
+						updated with atomic operations */
+	ulint			n_running;	/*!< number of created threads
+						that have not exited; updated
+						with atomic operations */
+	os_event_t		done;		/*!< set when n_running drops
+						to 0 */
+};
+
+/** A thread created by row_merge_run_threads() */
+struct row_merge_thread_t {
+	row_merge_threads_t*	threads;	/*!< the threads of the phase */
+	ulint			no;		/*!< number of the thread */
+};
+
+/*********************************************************************//**
+Runs tasks of a parallel phase of index creation until none are left. */
+static
+void
+row_merge_thread_work(
+/*==================*/
+	row_merge_threads_t*	threads,	/*!< in/out: the phase */
+	ulint			no)		/*!< in: number of the thread */
+{
+	ulint	task;
+
+	while ((task = os_atomic_increment_ulint(&threads->next, 1) - 1)
+	       < threads->n_tasks) {
+		threads->func(threads->ctx, no, task);
+	}
+}
+
+/*********************************************************************//**
+Thread created by row_merge_run_threads().
+@return this function does not return, it calls os_thread_exit() */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_thread)(
+/*=============================*/
+	void*	arg)	/*!< in: row_merge_thread_t */
+{
+	row_merge_thread_t*	thread = static_cast<row_merge_thread_t*>(arg);
+	row_merge_threads_t*	threads = thread->threads;
+
+	row_merge_thread_work(threads, thread->no);
+
+	if (os_atomic_decrement_ulint(&threads->n_running, 1) == 0) {
+		os_event_set(threads->done);
+	}
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Runs the tasks of a parallel phase of index creation in the calling thread
+and n_threads - 1 created threads, and waits for all of them to finish. */
+static
+void
+row_merge_run_threads(
+/*==================*/
+	row_merge_task_t	func,		/*!< in: function running a
+						task */
+	void*			ctx,		/*!< in/out: shared state of
+						the tasks */
+	ulint			n_tasks,	/*!< in: number of tasks */
+	ulint			n_threads)	/*!< in: number of threads,
+						at most n_tasks */
+{
+	row_merge_threads_t	threads;
+	row_merge_thread_t*	thread;
+
+	ut_ad(n_threads > 0);
+	ut_ad(n_threads <= n_tasks);
+
+	threads.func = func;
+	threads.ctx = ctx;
+	threads.n_tasks = n_tasks;
+	threads.next = 0;
+	threads.n_running = n_threads - 1;
+	threads.done = os_event_create();
+
+	thread = static_cast<row_merge_thread_t*>(
+		mem_alloc(n_threads * sizeof *thread));
+
+	for (ulint i = 1; i < n_threads; i++) {
+		thread[i].threads = &threads;
+		thread[i].no = i;
+
+		os_thread_create(row_merge_thread, &thread[i], NULL);
+	}
+
+	row_merge_thread_work(&threads, 0);
+
+	if (n_threads > 1) {
+		os_event_wait(threads.done);
+	}
+
+	os_event_free(threads.done);
+	mem_free(thread);
+}
+
+/** Shared state of a parallel scan of the clustered index, see
+row_merge_read_clustered_index_parallel() */
+struct row_merge_scan_t {
+	trx_t*			trx;		/*!< transaction */
+	struct TABLE*		table;		/*!< MySQL table object, for
+						reporting duplicate keys */
+	const dict_table_t*	old_table;	/*!< table where rows are
+						read from */
+	dict_index_t*		clust_index;	/*!< clustered index */
+	bool			online;		/*!< true if creating indexes
+						online */
+	ulint			n_index;	/*!< number of indexes to
+						create */
+	merge_file_t*		files;		/*!< temporary files, one per
+						index; blocks are appended by
+						atomically incrementing
+						offset */
+	const dtuple_t**	bounds;		/*!< range i consists of the
+						records from bounds[i] up to
+						but excluding bounds[i + 1];
+						NULL for the ends of the
+						index */
+	row_merge_buf_t**	merge_buf;	/*!< sort buffers, n_index
+						per thread */
+	row_merge_block_t*	blocks;		/*!< write buffers, one per
+						thread */
+	ib_uint64_t*		n_rec;		/*!< number of records added
+						to each sort buffer */
+	ulint			dup_reported;	/*!< nonzero if a duplicate
+						key was copied to table;
+						updated with atomic
+						operations */
+	ulint			n_failed;	/*!< number of failed tasks;
+						the others stop early */
+	dberr_t			err;		/*!< error of the first
+						failed task */
+	ulint			error_key_num;	/*!< index in files[] of the
+						first failed task */
+};
+
+/*********************************************************************//**
+Notes an error in a parallel scan of the clustered index. */
+static
+void
+row_merge_scan_error(
+/*=================*/
+	row_merge_scan_t*	scan,	/*!< in/out: parallel scan */
+	dberr_t			err,	/*!< in: error code */
+	ulint			i)	/*!< in: index in scan->files[] */
+{
+	if (os_atomic_increment_ulint(&scan->n_failed, 1) == 1) {
+		scan->err = err;
+		scan->error_key_num = i;
+	}
+}
+
+/*********************************************************************//**
+Sorts a sort buffer of a parallel scan of the clustered index and writes
+it to the next free block of the temporary file of the index.
+@return	DB_SUCCESS or error code */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+row_merge_scan_write(
+/*=================*/
+	row_merge_scan_t*	scan,	/*!< in/out: parallel scan */
+	row_merge_buf_t*	buf,	/*!< in/out: sort buffer */
+	merge_file_t*		file,	/*!< in/out: temporary file */
+	row_merge_block_t*	block)	/*!< out: write buffer */
+{
+	if (dict_index_is_unique(buf->index)) {
+		/* Several threads may find duplicates at the same
+		time, and only one of them may copy its duplicate to
+		the MySQL record buffer. */
+		row_merge_dup_t	dup = {buf->index, NULL, NULL, 0};
+
+		row_merge_buf_sort(buf, &dup);
+
+		if (dup.n_dup) {
+			if (os_compare_and_swap_ulint(
+				    &scan->dup_reported, 0, 1)) {
+				/* Sorting the sorted buffer again
+				compares all adjacent tuples, and
+				finds the duplicate again. */
+				dup.table = scan->table;
+				dup.n_dup = 0;
+				row_merge_buf_sort(buf, &dup);
+			}
+
+			return(DB_DUPLICATE_KEY);
+		}
+	} else {
+		row_merge_buf_sort(buf, NULL);
+	}
+
+	row_merge_buf_write(buf, file, block);
+
+	if (!row_merge_write(file->fd,
+			     os_atomic_increment_ulint(&file->offset, 1) - 1,
+			     block)) {
+		return(DB_TEMP_FILE_WRITE_FAILURE);
+	}
+
+	UNIV_MEM_INVALID(&block[0], srv_sort_buf_size);
+
+	return(DB_SUCCESS);
+}
+
+/*********************************************************************//**
+Reads a key range of the clustered index into the sort buffers of the
+thread, writing the buffers to the temporary files whenever they fill up.
+This is a task of row_merge_read_clustered_index_parallel(), and a
+simplified row_merge_read_clustered_index() for the case where the
+table is not being rebuilt. */
+static
+void
+row_merge_scan_range(
+/*=================*/
+	void*	ctx,	/*!< in/out: row_merge_scan_t */
+	ulint	thread,	/*!< in: thread number */
+	ulint	task)	/*!< in: range number */
+{
+	row_merge_scan_t*	scan = static_cast<row_merge_scan_t*>(ctx);
+	dict_index_t*		clust_index = scan->clust_index;
+	const dtuple_t*		end = scan->bounds[task + 1];
+	const ibool		comp = dict_table_is_comp(scan->old_table);
+	row_merge_buf_t**	merge_buf
+		= &scan->merge_buf[thread * scan->n_index];
+	ib_uint64_t*		n_rec = &scan->n_rec[thread * scan->n_index];
+	row_merge_block_t*	block
+		= &scan->blocks[thread * srv_sort_buf_size];
+	mem_heap_t*		row_heap;
+	btr_pcur_t		pcur;
+	mtr_t			mtr;
+	doc_id_t		doc_id = 0;
+
+	if (scan->n_failed) {
+		return;
+	}
+
+	row_heap = mem_heap_create(sizeof(mrec_buf_t));
+
+	mtr_start(&mtr);
+
+	if (scan->bounds[task] == NULL) {
+		btr_pcur_open_at_index_side(
+			true, clust_index, BTR_SEARCH_LEAF, &pcur, true, 0,
+			&mtr);
+	} else {
+		/* Position the cursor before the first record of the
+		range. */
+		btr_pcur_open(clust_index, scan->bounds[task], PAGE_CUR_L,
+			      BTR_SEARCH_LEAF, &pcur, &mtr);
+	}
+
+	for (;;) {
+		const rec_t*	rec;
+		ulint*		offsets;
+		const dtuple_t*	row;
+		row_ext_t*	ext;
+		page_cur_t*	cur	= btr_pcur_get_page_cur(&pcur);
+
+		mem_heap_empty(row_heap);
+
+		page_cur_move_to_next(cur);
+
+		if (page_cur_is_after_last(cur)) {
+			if (UNIV_UNLIKELY(trx_is_interrupted(scan->trx))) {
+				row_merge_scan_error(scan, DB_INTERRUPTED, 0);
+				break;
+			}
+
+			if (scan->n_failed) {
+				break;
+			}
+
+			if (rw_lock_get_waiters(
+				    dict_index_get_lock(clust_index))) {
+				/* Yield to the waiters on the clustered
+				index tree lock, as in
+				row_merge_read_clustered_index(). */
+				btr_pcur_move_to_prev_on_page(&pcur);
+				btr_pcur_store_position(&pcur, &mtr);
+				mtr_commit(&mtr);
+
+				os_thread_yield();
+
+				mtr_start(&mtr);
+				btr_pcur_restore_position(
+					BTR_SEARCH_LEAF, &pcur, &mtr);
+
+				if (!btr_pcur_move_to_next_user_rec(
+					    &pcur, &mtr)) {
+					break;
+				}
+			} else {
+				ulint		next_page_no;
+				buf_block_t*	block;
+
+				next_page_no = btr_page_get_next(
+					page_cur_get_page(cur), &mtr);
+
+				if (next_page_no == FIL_NULL) {
+					break;
+				}
+
+				block = page_cur_get_block(cur);
+				block = btr_block_get(
+					buf_block_get_space(block),
+					buf_block_get_zip_size(block),
+					next_page_no, BTR_SEARCH_LEAF,
+					clust_index, &mtr);
+
+				btr_leaf_page_release(page_cur_get_block(cur),
+						      BTR_SEARCH_LEAF, &mtr);
+				page_cur_set_before_first(block, cur);
+				page_cur_move_to_next(cur);
+
+				ut_ad(!page_cur_is_after_last(cur));
+			}
+		}
+
+		rec = page_cur_get_rec(cur);
+
+		offsets = rec_get_offsets(rec, clust_index, NULL,
+					  ULINT_UNDEFINED, &row_heap);
+
+		if (end && cmp_dtuple_rec(end, rec, offsets) <= 0) {
+			break;
+		}
+
+		if (scan->online) {
+			/* Perform a REPEATABLE READ, see
+			row_merge_read_clustered_index(). */
+			ut_ad(scan->trx->read_view);
+
+			if (!read_view_sees_trx_id(
+				    scan->trx->read_view,
+				    row_get_rec_trx_id(
+					    rec, clust_index, offsets))) {
+				rec_t*	old_vers;
+
+				row_vers_build_for_consistent_read(
+					rec, &mtr, clust_index, &offsets,
+					scan->trx->read_view, &row_heap,
+					row_heap, &old_vers);
+
+				rec = old_vers;
+
+				if (!rec) {
+					continue;
+				}
+			}
+		}
+
+		if (rec_get_deleted_flag(rec, comp)) {
+			continue;
+		}
+
+		ut_ad(!rec_offs_any_null_extern(rec, offsets));
+
+		row = row_build(ROW_COPY_POINTERS, clust_index,
+				rec, offsets, scan->old_table,
+				NULL, NULL, &ext, row_heap);
+		ut_ad(row);
+
+		for (ulint i = 0; i < scan->n_index; i++) {
+			row_merge_buf_t*	buf	= merge_buf[i];
+			ulint			rows_added;
+			bool			exceed_page = false;
+			dberr_t			err;
+
+			rows_added = row_merge_buf_add(
+				buf, NULL, scan->old_table, NULL, row, ext,
+				&doc_id, NULL, &exceed_page);
+
+			if (!rows_added) {
+				/* The buffer is full. */
+				err = row_merge_scan_write(
+					scan, buf, &scan->files[i], block);
+
+				if (err != DB_SUCCESS) {
+					row_merge_scan_error(scan, err, i);
+					goto func_exit;
+				}
+
+				buf = merge_buf[i] = row_merge_buf_empty(buf);
+
+				rows_added = row_merge_buf_add(
+					buf, NULL, scan->old_table, NULL,
+					row, ext, &doc_id, NULL,
+					&exceed_page);
+
+				/* An empty buffer should have enough
+				room for at least one record. */
+				ut_a(rows_added);
+			}
+
+			if (exceed_page) {
+				row_merge_scan_error(
+					scan, DB_TOO_BIG_RECORD, 0);
+				goto func_exit;
+			}
+
+			n_rec[i] += rows_added;
+		}
+	}
+
+func_exit:
+	mtr_commit(&mtr);
+	btr_pcur_close(&pcur);
+	mem_heap_free(row_heap);
+}
+
+/*********************************************************************//**
+Writes out what is left in a sort buffer at the end of a parallel scan
+of the clustered index. This is a task of
+row_merge_read_clustered_index_parallel(). */
+static
+void
+row_merge_scan_flush(
+/*=================*/
+	void*	ctx,	/*!< in/out: row_merge_scan_t */
+	ulint	thread,	/*!< in: thread number */
+	ulint	task)	/*!< in: sort buffer number */
+{
+	row_merge_scan_t*	scan = static_cast<row_merge_scan_t*>(ctx);
+	row_merge_buf_t*	buf = scan->merge_buf[task];
+	ulint			i = task % scan->n_index;
+	dberr_t			err;
+
+	if (scan->n_failed || !buf->n_tuples) {
+		return;
+	}
+
+	err = row_merge_scan_write(
+		scan, buf, &scan->files[i],
+		&scan->blocks[thread * srv_sort_buf_size]);
+
+	if (err != DB_SUCCESS) {
+		row_merge_scan_error(scan, err, i);
+	}
+}
+
+/*********************************************************************//**
+Splits the clustered index into key ranges for a parallel scan, at node
+pointers of the root page.
+@return	number of ranges; if less than 2, the index cannot be split */
+static __attribute__((nonnull, warn_unused_result))
+ulint
+row_merge_scan_split(
+/*=================*/
+	dict_index_t*		clust_index,	/*!< in: clustered index */
+	ulint			n_ranges,	/*!< in: desired number of
+						ranges */
+	const dtuple_t***	bounds,		/*!< out: n_ranges + 1 range
+						bounds */
+	mem_heap_t*		heap)		/*!< in: memory heap for
+						bounds */
+{
+	const ulint	n_uniq = dict_index_get_n_unique_in_tree(clust_index);
+	mtr_t		mtr;
+	const page_t*	root;
+	const rec_t*	rec;
+	ulint		n_recs;
+
+	mtr_start(&mtr);
+	mtr_s_lock(dict_index_get_lock(clust_index), &mtr);
+
+	root = buf_block_get_frame(
+		btr_block_get(dict_index_get_space(clust_index),
+			      dict_table_zip_size(clust_index->table),
+			      dict_index_get_page(clust_index),
+			      RW_S_LATCH, clust_index, &mtr));
+
+	n_recs = page_get_n_recs(root);
+
+	if (btr_page_get_level(root, &mtr) == 0 || n_recs < 2) {
+		mtr_commit(&mtr);
+		return(0);
+	}
+
+	n_ranges = ut_min(n_ranges, n_recs);
+
+	*bounds = static_cast<const dtuple_t**>(
+		mem_heap_alloc(heap, (n_ranges + 1) * sizeof **bounds));
+
+	(*bounds)[0] = NULL;
+	(*bounds)[n_ranges] = NULL;
+
+	/* Range i starts at the node pointer i * n_recs / n_ranges.
+	The first node pointer is the minimum record. */
+	rec = page_rec_get_next_const(page_get_infimum_rec(root));
+
+	for (ulint i = 1, n = 0; i < n_ranges; i++) {
+		dtuple_t*	tuple;
+
+		for (; n < i * n_recs / n_ranges; n++) {
+			rec = page_rec_get_next_const(rec);
+		}
+
+		tuple = dict_index_build_data_tuple(
+			clust_index, const_cast<rec_t*>(rec), n_uniq, heap);
+
+		/* The tuple points to the page; copy the data. */
+		for (ulint j = 0; j < n_uniq; j++) {
+			dfield_dup(dtuple_get_nth_field(tuple, j), heap);
+		}
+
+		(*bounds)[i] = tuple;
+	}
+
+	mtr_commit(&mtr);
+
+	return(n_ranges);
+}
+
+/*********************************************************************//**
+Reads the clustered index of a table that is not being rebuilt in key
+ranges on several threads, and creates temporary files containing the
+index entries for the indexes to be built. Each thread fills its own
+sort buffers, and the sorted blocks are appended to the files in any
+order; each block is a run for row_merge_sort().
+@return DB_SUCCESS or error */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+row_merge_read_clustered_index_parallel(
+/*====================================*/
+	trx_t*			trx,	/*!< in: transaction */
+	struct TABLE*		table,	/*!< in/out: MySQL table object,
+					for reporting erroneous records */
+	const dict_table_t*	old_table,/*!< in: table where rows are
+					read from and indexes are created */
+	bool			online,	/*!< in: true if creating indexes
+					online */
+	dict_index_t**		index,	/*!< in: indexes to be created */
+	merge_file_t*		files,	/*!< in: temporary files */
+	const ulint*		key_numbers,
+					/*!< in: MySQL key numbers to create */
+	ulint			n_index,/*!< in: number of indexes to create */
+	const dtuple_t**	bounds,	/*!< in: key ranges, from
+					row_merge_scan_split() */
+	ulint			n_ranges,/*!< in: number of key ranges */
+	ulint			n_threads)/*!< in: number of threads */
+{
+	row_merge_scan_t	scan;
+	ulint			blocks_size;
+	dberr_t			err;
+	DBUG_ENTER("row_merge_read_clustered_index_parallel");
+
+	ut_ad(n_threads > 1);
+	ut_ad(n_threads <= n_ranges);
+
+	trx->op_info = "reading clustered index";
+
+	blocks_size = n_threads * srv_sort_buf_size;
+
+	scan.blocks = static_cast<row_merge_block_t*>(
+		os_mem_alloc_large(&blocks_size));
+
+	if (scan.blocks == NULL) {
+		trx->op_info = "";
+		DBUG_RETURN(DB_OUT_OF_MEMORY);
+	}
+
+	scan.trx = trx;
+	scan.table = table;
+	scan.old_table = old_table;
+	scan.clust_index = dict_table_get_first_index(old_table);
+	scan.online = online;
+	scan.n_index = n_index;
+	scan.files = files;
+	scan.bounds = bounds;
+	scan.dup_reported = 0;
+	scan.n_failed = 0;
+	scan.err = DB_SUCCESS;
+	scan.error_key_num = 0;
+
+	scan.merge_buf = static_cast<row_merge_buf_t**>(
+		mem_alloc(n_threads * n_index * sizeof *scan.merge_buf));
+	scan.n_rec = static_cast<ib_uint64_t*>(
+		mem_zalloc(n_threads * n_index * sizeof *scan.n_rec));
+
+	for (ulint i = 0; i < n_threads * n_index; i++) {
+		ut_ad(!(index[i % n_index]->type & DICT_FTS));
+		scan.merge_buf[i] = row_merge_buf_create(index[i % n_index]);
+	}
+
+	row_merge_run_threads(row_merge_scan_range, &scan,
+			      n_ranges, n_threads);
+
+	row_merge_run_threads(row_merge_scan_flush, &scan,
+			      n_threads * n_index, n_threads);
+
+	err = scan.err;
+
+	if (err != DB_SUCCESS) {
+		trx->error_key_num = err == DB_DUPLICATE_KEY
+			? key_numbers[scan.error_key_num] : 0;
+		goto func_exit;
+	}
+
+	for (ulint i = 0; i < n_index; i++) {
+		merge_file_t*	file	= &files[i];
+
+		for (ulint j = 0; j < n_threads; j++) {
+			file->n_rec += scan.n_rec[j * n_index + i];
+		}
+
+		if (file->offset == 0) {
+			/* The table is empty. Write an empty block,
+			as row_merge_read_clustered_index() would. */
+			row_merge_buf_write(scan.merge_buf[i], file,
+					    scan.blocks);
+
+			if (!row_merge_write(file->fd, file->offset++,
+					     scan.blocks)) {
+				err = DB_TEMP_FILE_WRITE_FAILURE;
+				trx->error_key_num = key_numbers[i];
+				goto func_exit;
+			}
+		}
+
+		if (online) {
+			/* Note the newest transaction that modified
+			this index when the scan was completed, see
+			row_merge_read_clustered_index(). */
+			trx_id_t	max_trx_id;
+
+			rw_lock_x_lock(dict_index_get_lock(index[i]));
+			ut_a(dict_index_get_online_status(index[i])
+			     == ONLINE_INDEX_CREATION);
+
+			max_trx_id = row_log_get_max_trx(index[i]);
+
+			if (max_trx_id > index[i]->trx_id) {
+				index[i]->trx_id = max_trx_id;
+			}
+
+			rw_lock_x_unlock(dict_index_get_lock(index[i]));
+		}
+	}
+
+func_exit:
+	for (ulint i = 0; i < n_threads * n_index; i++) {
+		row_merge_buf_free(scan.merge_buf[i]);
+	}
+
+	mem_free(scan.n_rec);
+	mem_free(scan.merge_buf);
+	os_mem_free_large(scan.blocks, blocks_size);
+
+	trx->op_info = "";
+
+	DBUG_RETURN(err);
+}
+
 /********************************************************************//**
 Reads clustered index of the table and create temporary files
 containing the index entries for the indexes to be built.
@@ -2144,8 +2823,124 @@ done0:
 	       != NULL);
 }
 
+/** Shared state of a merge pass, see row_merge() */
+struct row_merge_pass_t {
+	trx_t*			trx;		/*!< transaction */
+	const row_merge_dup_t*	dup;		/*!< descriptor of index being
+						created */
+	const merge_file_t*	file;		/*!< input file */
+	int			out_fd;		/*!< output file */
+	row_merge_block_t*	block;		/*!< 3 buffers of the calling
+						thread */
+	row_merge_block_t*	blocks;		/*!< 3 buffers for each
+						created thread */
+	bool			parallel;	/*!< whether several threads
+						run the pass */
+	ulint			half;		/*!< number of runs in the
+						first half of the input */
+	const ulint*		run_offset;	/*!< first block of each input
+						run, and the end of the
+						input */
+	const ulint*		out_offset;	/*!< first block of each output
+						run, and the end of the
+						output */
+	ib_uint64_t*		n_rec;		/*!< number of records in each
+						output run */
+	ulint			dup_reported;	/*!< nonzero if a duplicate
+						key was copied to dup->table;
+						updated with atomic
+						operations */
+	ulint			n_failed;	/*!< number of failed tasks;
+						the others stop early */
+	dberr_t			err;		/*!< error of the first
+						failed task */
+};
+
 /*************************************************************//**
-Merge disk files.
+Merges run i of the first half of the input with run i of the second
+half, or copies the last run of the second half if there is no run i in
+the first half. This is a task of row_merge(). */
+static
+void
+row_merge_pair(
+/*===========*/
+	void*	ctx,	/*!< in/out: row_merge_pass_t */
+	ulint	thread,	/*!< in: thread number */
+	ulint	i)	/*!< in: output run number */
+{
+	row_merge_pass_t*	pass	= static_cast<row_merge_pass_t*>(ctx);
+	row_merge_block_t*	block	= thread
+		? &pass->blocks[(thread - 1) * 3 * srv_sort_buf_size]
+		: pass->block;
+	row_merge_dup_t		dup	= *pass->dup;
+	merge_file_t		of;
+	ulint			foffs0;
+	ulint			foffs1;
+	dberr_t			err;
+
+	if (pass->n_failed) {
+		return;
+	}
+
+	if (trx_is_interrupted(pass->trx)) {
+		err = DB_INTERRUPTED;
+		goto func_exit;
+	}
+
+	if (pass->parallel) {
+		/* Several threads may find duplicates at the same
+		time, and only one of them may copy its duplicate to
+		the MySQL record buffer. */
+		dup.table = NULL;
+	}
+
+	for (;;) {
+		foffs0 = pass->run_offset[i];
+		foffs1 = pass->run_offset[pass->half + i];
+
+		of.fd = pass->out_fd;
+		of.offset = pass->out_offset[i];
+		of.n_rec = 0;
+
+		if (i < pass->half) {
+			err = row_merge_blocks(&dup, pass->file, block,
+					       &foffs0, &foffs1, &of);
+		} else if (row_merge_blocks_copy(dup.index, pass->file, block,
+						 &foffs1, &of)) {
+			err = DB_SUCCESS;
+		} else {
+			err = DB_CORRUPTION;
+		}
+
+		if (err != DB_DUPLICATE_KEY || dup.table || !pass->dup->table
+		    || !os_compare_and_swap_ulint(&pass->dup_reported, 0, 1)) {
+			break;
+		}
+
+		/* Merge the runs again, to copy the duplicate to the
+		MySQL record buffer. */
+		dup.table = pass->dup->table;
+	}
+
+	/* The output run must fit in the blocks of the input runs, so
+	that it does not overwrite the next output run. */
+	if (err == DB_SUCCESS && of.offset > pass->out_offset[i + 1]) {
+		err = DB_CORRUPTION;
+	}
+
+	pass->n_rec[i] = of.n_rec;
+
+func_exit:
+	if (err != DB_SUCCESS
+	    && os_atomic_increment_ulint(&pass->n_failed, 1) == 1) {
+		pass->err = err;
+	}
+}
+
+/*************************************************************//**
+Merge disk files. Run i of the output file occupies the blocks that runs
+i and half + i occupied in the input file, so that the runs can be merged
+by several threads at once.
 @return	DB_SUCCESS or error code */
 static __attribute__((nonnull))
 dberr_t
@@ -2157,29 +2952,27 @@ row_merge(
 	merge_file_t*		file,	/*!< in/out: file containing
 					index entries */
 	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
+	row_merge_block_t*	blocks,	/*!< in/out: 3 buffers for each
+					thread but the first one */
+	ulint			n_threads,/*!< in: number of threads */
 	int*			tmpfd,	/*!< in/out: temporary file handle */
 	ulint*			num_run,/*!< in/out: Number of runs remain
 					to be merged */
-	ulint*			run_offset) /*!< in/out: Array contains the
-					first offset number for each merge
-					run */
+	ulint*			run_offset,/*!< in/out: first block of each
+					merge run, and the end of the file */
+	ulint*			out_offset)/*!< out: scratch space of the
+					same size as run_offset */
 {
-	ulint		foffs0;	/*!< first input offset */
-	ulint		foffs1;	/*!< second input offset */
-	dberr_t		error;	/*!< error code */
-	merge_file_t	of;	/*!< output file */
-	const ulint	ihalf	= run_offset[*num_run / 2];
-				/*!< half the input file */
-	ulint		n_run	= 0;
-				/*!< num of runs generated from this merge */
+	row_merge_pass_t	pass;
+	const ulint		half	= *num_run / 2;
+	const ulint		n_run	= *num_run - half;
+				/* number of runs generated from this merge */
+	ib_uint64_t		n_rec	= 0;
 
 	UNIV_MEM_ASSERT_W(&block[0], 3 * srv_sort_buf_size);
 
-	ut_ad(ihalf < file->offset);
-
-	of.fd = *tmpfd;
-	of.offset = 0;
-	of.n_rec = 0;
+	ut_ad(half > 0);
+	ut_ad(run_offset[*num_run] == file->offset);
 
 #ifdef POSIX_FADV_SEQUENTIAL
 	/* The input file will be read sequentially, starting from the
@@ -2189,85 +2982,55 @@ row_merge(
 		      POSIX_FADV_SEQUENTIAL | POSIX_FADV_NOREUSE);
 #endif /* POSIX_FADV_SEQUENTIAL */
 
-	/* Merge blocks to the output file. */
-	foffs0 = 0;
-	foffs1 = ihalf;
-
-	UNIV_MEM_INVALID(run_offset, *num_run * sizeof *run_offset);
-
-	for (; foffs0 < ihalf && foffs1 < file->offset; foffs0++, foffs1++) {
-
-		if (trx_is_interrupted(trx)) {
-			return(DB_INTERRUPTED);
-		}
-
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
-
-		error = row_merge_blocks(dup, file, block,
-					 &foffs0, &foffs1, &of);
-
-		if (error != DB_SUCCESS) {
-			return(error);
-		}
-
+	for (ulint i = 0; i <= n_run; i++) {
+		out_offset[i] = run_offset[ut_min(i, half)]
+			+ run_offset[half + i] - run_offset[half];
 	}
 
-	/* Copy the last blocks, if there are any. */
-
-	while (foffs0 < ihalf) {
-		if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
-			return(DB_INTERRUPTED);
-		}
-
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
-
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs0, &of)) {
-			return(DB_CORRUPTION);
-		}
+	ut_ad(out_offset[n_run] == file->offset);
+
+	n_threads = ut_min(n_threads, n_run);
+
+	pass.trx = trx;
+	pass.dup = dup;
+	pass.file = file;
+	pass.out_fd = *tmpfd;
+	pass.block = block;
+	pass.blocks = blocks;
+	pass.parallel = n_threads > 1;
+	pass.half = half;
+	pass.run_offset = run_offset;
+	pass.out_offset = out_offset;
+	pass.n_rec = static_cast<ib_uint64_t*>(
+		mem_alloc(n_run * sizeof *pass.n_rec));
+	pass.dup_reported = 0;
+	pass.n_failed = 0;
+	pass.err = DB_SUCCESS;
+
+	row_merge_run_threads(row_merge_pair, &pass, n_run, n_threads);
+
+	for (ulint i = 0; pass.err == DB_SUCCESS && i < n_run; i++) {
+		n_rec += pass.n_rec[i];
 	}
 
-	ut_ad(foffs0 == ihalf);
-
-	while (foffs1 < file->offset) {
-		if (trx_is_interrupted(trx)) {
-			return(DB_INTERRUPTED);
-		}
-
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
+	mem_free(pass.n_rec);
 
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs1, &of)) {
-			return(DB_CORRUPTION);
-		}
+	if (pass.err != DB_SUCCESS) {
+		return(pass.err);
 	}
 
-	ut_ad(foffs1 == file->offset);
-
-	if (UNIV_UNLIKELY(of.n_rec != file->n_rec)) {
+	if (UNIV_UNLIKELY(n_rec != file->n_rec)) {
 		return(DB_CORRUPTION);
 	}
 
-	ut_ad(n_run <= *num_run);
-
 	*num_run = n_run;
+	memcpy(run_offset, out_offset, (n_run + 1) * sizeof *run_offset);
 
-	/* Each run can contain one or more offsets. As merge goes on,
-	the number of runs (to merge) will reduce until we have one
-	single run. So the number of runs will always be smaller than
-	the number of offsets in file */
-	ut_ad((*num_run) <= file->offset);
-
-	/* The number of offsets in output file is always equal or
-	smaller than input file */
-	ut_ad(of.offset <= file->offset);
-
-	/* Swap file descriptors for the next pass. */
+	/* Swap file descriptors for the next pass. The output file
+	spans as many blocks as the input file, some of them unused
+	after the end of a run. */
 	*tmpfd = file->fd;
-	*file = of;
+	file->fd = pass.out_fd;
 
 	UNIV_MEM_INVALID(&block[0], 3 * srv_sort_buf_size);
 
@@ -2287,12 +3050,16 @@ row_merge_sort(
 	merge_file_t*		file,	/*!< in/out: file containing
 					index entries */
 	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
-	int*			tmpfd)	/*!< in/out: temporary file handle */
+	int*			tmpfd,	/*!< in/out: temporary file handle */
+	ulint			n_threads)
+					/*!< in: maximum number of threads
+					merging runs in parallel */
 {
-	const ulint	half	= file->offset / 2;
-	ulint		num_runs;
-	ulint*		run_offset;
-	dberr_t		error	= DB_SUCCESS;
+	ulint			num_runs;
+	ulint*			run_offset;
+	row_merge_block_t*	blocks	= NULL;
+	ulint			blocks_size = 0;
+	dberr_t			error	= DB_SUCCESS;
 	DBUG_ENTER("row_merge_sort");
 
 	/* Record the number of merge runs we need to perform */
@@ -2303,12 +3070,29 @@ row_merge_sort(
 		DBUG_RETURN(error);
 	}
 
-	/* "run_offset" records each run's first offset number */
-	run_offset = (ulint*) mem_alloc(file->offset * sizeof(ulint));
+	/* The first pass has num_runs / 2 pairs of runs to merge. */
+	n_threads = ut_min(ut_max(n_threads, 1), num_runs / 2);
+
+	if (n_threads > 1) {
+		blocks_size = (n_threads - 1) * 3 * srv_sort_buf_size;
+		blocks = static_cast<row_merge_block_t*>(
+			os_mem_alloc_large(&blocks_size));
+
+		if (blocks == NULL) {
+			/* Merge on this thread only. */
+			n_threads = 1;
+		}
+	}
+
+	/* "run_offset" records each run's first offset number and the
+	end of the file, followed by scratch space for row_merge().
+	Initially, each block is a run. */
+	run_offset = static_cast<ulint*>(
+		mem_alloc(2 * (num_runs + 1) * sizeof *run_offset));
 
-	/* This tells row_merge() where to start for the first round
-	of merge. */
-	run_offset[half] = half;
+	for (ulint i = 0; i <= num_runs; i++) {
+		run_offset[i] = i;
+	}
 
 	/* The file should always contain at least one byte (the end
 	of file marker).  Thus, it must be at least one block. */
@@ -2316,8 +3100,9 @@ row_merge_sort(
 
 	/* Merge the runs until we have one big run */
 	do {
-		error = row_merge(trx, dup, file, block, tmpfd,
-				  &num_runs, run_offset);
+		error = row_merge(trx, dup, file, block, blocks, n_threads,
+				  tmpfd, &num_runs, run_offset,
+				  run_offset + file->offset + 1);
 
 		if (error != DB_SUCCESS) {
 			break;
@@ -2326,8 +3111,14 @@ row_merge_sort(
 		UNIV_MEM_ASSERT_RW(run_offset, num_runs * sizeof *run_offset);
 	} while (num_runs > 1);
 
+	ut_ad(error != DB_SUCCESS || run_offset[0] == 0);
+
 	mem_free(run_offset);
 
+	if (blocks != NULL) {
+		os_mem_free_large(blocks, blocks_size);
+	}
+
 	DBUG_RETURN(error);
 }
 
@@ -2376,13 +3167,14 @@ row_merge_copy_blobs(
 
 /********************************************************************//**
 Read sorted file containing index data tuples and insert these data
-tuples to the index
+tuples to the index. The secondary indexes of tables that are not
+ROW_FORMAT=COMPRESSED are built bottom-up by btr_bulk_insert().
 @return	DB_SUCCESS or error number */
 static __attribute__((nonnull, warn_unused_result))
 dberr_t
 row_merge_insert_index_tuples(
 /*==========================*/
-	trx_id_t		trx_id,	/*!< in: transaction identifier */
+	const trx_t*		trx,	/*!< in: transaction */
 	dict_index_t*		index,	/*!< in: index */
 	const dict_table_t*	old_table,/*!< in: old table */
 	int			fd,	/*!< in: file descriptor */
@@ -2396,12 +3188,20 @@ row_merge_insert_index_tuples(
 	ulint			foffs = 0;
 	ulint*			offsets;
 	mrec_buf_t*		buf;
+	const trx_id_t		trx_id = trx->id;
+	btr_bulk_t		bulk;
+	const bool		bulk_load = !dict_index_is_clust(index)
+		&& !dict_table_zip_size(index->table);
 	DBUG_ENTER("row_merge_insert_index_tuples");
 
 	ut_ad(!srv_read_only_mode);
 	ut_ad(!(index->type & DICT_FTS));
 	ut_ad(trx_id);
 
+	if (bulk_load) {
+		btr_bulk_init(&bulk, index, trx_id);
+	}
+
 	tuple_heap = mem_heap_create(1000);
 
 	{
@@ -2486,6 +3286,20 @@ row_merge_insert_index_tuples(
 			}
 
 			ut_ad(dtuple_validate(dtuple));
+
+			if (bulk_load) {
+				ut_ad(!n_ext);
+
+				error = btr_bulk_insert(&bulk, dtuple);
+
+				if (error != DB_SUCCESS) {
+					goto err_exit;
+				}
+
+				mem_heap_empty(tuple_heap);
+				continue;
+			}
+
 			log_free_check();
 
 			mtr_start(&mtr);
@@ -2576,6 +3390,10 @@ row_merge_insert_index_tuples(
 	}
 
 err_exit:
+	if (bulk_load) {
+		error = btr_bulk_finish(&bulk, error, trx);
+	}
+
 	mem_heap_free(tuple_heap);
 	mem_heap_free(ins_heap);
 	mem_heap_free(heap);
@@ -3567,6 +4385,10 @@ row_merge_build_indexes(
 	fts_psort_t*		merge_info = NULL;
 	ib_int64_t		sig_count = 0;
 	bool			fts_psort_initiated = false;
+	ulint			n_threads = srv_index_build_threads;
+	const dtuple_t**	bounds = NULL;
+	ulint			n_ranges = 0;
+	mem_heap_t*		bounds_heap = NULL;
 	DBUG_ENTER("row_merge_build_indexes");
 
 	ut_ad(!srv_read_only_mode);
@@ -3641,14 +4463,41 @@ row_merge_build_indexes(
 	duplicate keys. */
 	innobase_rec_reset(table);
 
+	/* The purge thread is only signalled from the scan on this
+	thread. */
+	DBUG_EXECUTE_IF("ib_purge_on_create_index_page_switch",
+			n_threads = 1;);
+
 	/* Read clustered index of the table and create files for
-	secondary index entries for merge sort */
+	secondary index entries for merge sort. When the table is not
+	being rebuilt and no full-text index is created, the scan can
+	be split into key ranges that are read by several threads. */
+
+	if (n_threads > 1 && old_table == new_table && !fts_sort_idx) {
+		bounds_heap = mem_heap_create(1024);
 
-	error = row_merge_read_clustered_index(
-		trx, table, old_table, new_table, online, indexes,
-		fts_sort_idx, psort_info, merge_files, key_numbers,
-		n_indexes, add_cols, col_map,
-		add_autoinc, sequence, block);
+		n_ranges = row_merge_scan_split(
+			dict_table_get_first_index(old_table),
+			n_threads * ROW_MERGE_SCAN_RANGES_PER_THREAD,
+			&bounds, bounds_heap);
+	}
+
+	if (n_ranges > 1) {
+		error = row_merge_read_clustered_index_parallel(
+			trx, table, old_table, online, indexes,
+			merge_files, key_numbers, n_indexes,
+			bounds, n_ranges, ut_min(n_threads, n_ranges));
+	} else {
+		error = row_merge_read_clustered_index(
+			trx, table, old_table, new_table, online, indexes,
+			fts_sort_idx, psort_info, merge_files, key_numbers,
+			n_indexes, add_cols, col_map,
+			add_autoinc, sequence, block);
+	}
+
+	if (bounds_heap != NULL) {
+		mem_heap_free(bounds_heap);
+	}
 
 	if (error != DB_SUCCESS) {
 
@@ -3735,11 +4584,11 @@ wait_again:
 
 			error = row_merge_sort(
 				trx, &dup, &merge_files[i],
-				block, &tmpfd);
+				block, &tmpfd, n_threads);
 
 			if (error == DB_SUCCESS) {
 				error = row_merge_insert_index_tuples(
-					trx->id, sort_idx, old_table,
+					trx, sort_idx, old_table,
 					merge_files[i].fd, block);
 			}
 		}
@@ -2137,6 +2137,10 @@ row_mysql_lock_data_dictionary_func(
 	trx->dict_operation_lock_mode = RW_X_LATCH;
 
 	mutex_enter(&(dict_sys->mutex));
+
+	/* DDL operations check the count of open handles of a table, so
+	tables must not be opened without dict_sys->mutex meanwhile */
+	dict_table_open_fast_disable();
 }
 
 /*********************************************************************//**
@@ -2154,6 +2158,7 @@ row_mysql_unlock_data_dictionary(
 	/* Serialize data dictionary operations with dictionary mutex:
 	no deadlocks can occur then in these operations */
 
+	dict_table_open_fast_enable();
 	mutex_exit(&(dict_sys->mutex));
 	rw_lock_x_unlock(&dict_operation_lock);
 
@@ -1215,7 +1215,7 @@ row_sel_try_search_shortcut(
 				index */
 	ibool		search_latch_locked,
 				/*!< in: whether the search holds
-				btr_search_latch */
+				btr_search_get_latch(plan->index) */
 	mtr_t*		mtr)	/*!< in: mtr */
 {
 	dict_index_t*	index;
@@ -1233,7 +1233,8 @@ row_sel_try_search_shortcut(
 	ut_ad(!plan->must_get_clust);
 #ifdef UNIV_SYNC_DEBUG
 	if (search_latch_locked) {
-		ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_SHARED));
+		ut_ad(rw_lock_own(btr_search_get_latch(index),
+				  RW_LOCK_SHARED));
 	}
 #endif /* UNIV_SYNC_DEBUG */
 
@@ -1326,7 +1327,8 @@ row_sel(
 	rec_t*		rec;
 	rec_t*		old_vers;
 	rec_t*		clust_rec;
-	ibool		search_latch_locked;
+	rw_lock_t*	search_latch;	/* the s-latched adaptive hash
+					index partition latch, or NULL */
 	ibool		consistent_read;
 
 	/* The following flag becomes TRUE when we are doing a
@@ -1354,7 +1356,7 @@ row_sel(
 
 	ut_ad(thr->run_node == node);
 
-	search_latch_locked = FALSE;
+	search_latch = NULL;
 
 	if (node->read_view) {
 		/* In consistent reads, we try to do with the hash index and
@@ -1404,11 +1406,20 @@ table_loop:
 	if (consistent_read && plan->unique_search && !plan->pcur_is_open
 	    && !plan->must_get_clust
 	    && !plan->table->big_rows) {
-		if (!search_latch_locked) {
-			rw_lock_s_lock(&btr_search_latch);
+		rw_lock_t*	ahi_latch = btr_search_get_latch(index);
 
-			search_latch_locked = TRUE;
-		} else if (rw_lock_get_writer(&btr_search_latch) == RW_LOCK_WAIT_EX) {
+		if (search_latch != ahi_latch) {
+			/* Never hold the latches of two adaptive hash
+			index partitions at a time. */
+			if (search_latch) {
+				rw_lock_s_unlock(search_latch);
+			}
+
+			rw_lock_s_lock(ahi_latch);
+
+			search_latch = ahi_latch;
+		} else if (rw_lock_get_writer(search_latch)
+			   == RW_LOCK_WAIT_EX) {
 
 			/* There is an x-latch request waiting: release the
 			s-latch for a moment; as an s-latch here is often
@@ -1417,12 +1428,11 @@ table_loop:
 			from acquiring an s-latch for a long time, lowering
 			performance significantly in multiprocessors. */
 
-			rw_lock_s_unlock(&btr_search_latch);
-			rw_lock_s_lock(&btr_search_latch);
+			rw_lock_s_unlock(search_latch);
+			rw_lock_s_lock(search_latch);
 		}
 
-		found_flag = row_sel_try_search_shortcut(node, plan,
-							 search_latch_locked,
+		found_flag = row_sel_try_search_shortcut(node, plan, TRUE,
 							 &mtr);
 
 		if (found_flag == SEL_FOUND) {
@@ -1442,17 +1452,17 @@ table_loop:
 		mtr_start(&mtr);
 	}
 
-	if (search_latch_locked) {
-		rw_lock_s_unlock(&btr_search_latch);
+	if (search_latch) {
+		rw_lock_s_unlock(search_latch);
 
-		search_latch_locked = FALSE;
+		search_latch = NULL;
 	}
 
 	if (!plan->pcur_is_open) {
 		/* Evaluate the expressions to build the search tuple and
 		open the cursor */
 
-		row_sel_open_pcur(plan, search_latch_locked, &mtr);
+		row_sel_open_pcur(plan, FALSE, &mtr);
 
 		cursor_just_opened = TRUE;
 
@@ -1838,7 +1848,7 @@ skip_lock:
 	}
 
 next_rec:
-	ut_ad(!search_latch_locked);
+	ut_ad(!search_latch);
 
 	if (mtr_has_extra_clust_latch) {
 
@@ -1877,7 +1887,7 @@ next_table:
 
 		plan->cursor_at_end = TRUE;
 	} else {
-		ut_ad(!search_latch_locked);
+		ut_ad(!search_latch);
 
 		plan->stored_cursor_rec_processed = TRUE;
 
@@ -1969,7 +1979,7 @@ stop_for_a_while:
 	inserted new records which should have appeared in the result set,
 	which would result in the phantom problem. */
 
-	ut_ad(!search_latch_locked);
+	ut_ad(!search_latch);
 
 	plan->stored_cursor_rec_processed = FALSE;
 	btr_pcur_store_position(&(plan->pcur), &mtr);
@@ -1989,7 +1999,7 @@ commit_mtr_for_a_while:
 
 	plan->stored_cursor_rec_processed = TRUE;
 
-	ut_ad(!search_latch_locked);
+	ut_ad(!search_latch);
 	btr_pcur_store_position(&(plan->pcur), &mtr);
 
 	mtr_commit(&mtr);
@@ -2006,7 +2016,7 @@ lock_wait_or_error:
 	/* See the note at stop_for_a_while: the same holds for this case */
 
 	ut_ad(!btr_pcur_is_before_first_on_page(&plan->pcur) || !node->asc);
-	ut_ad(!search_latch_locked);
+	ut_ad(!search_latch);
 
 	plan->stored_cursor_rec_processed = FALSE;
 	btr_pcur_store_position(&(plan->pcur), &mtr);
@@ -2018,8 +2028,8 @@ lock_wait_or_error:
 #endif /* UNIV_SYNC_DEBUG */
 
 func_exit:
-	if (search_latch_locked) {
-		rw_lock_s_unlock(&btr_search_latch);
+	if (search_latch) {
+		rw_lock_s_unlock(search_latch);
 	}
 	if (UNIV_LIKELY_NULL(heap)) {
 		mem_heap_free(heap);
@@ -3762,16 +3772,19 @@ row_search_for_mysql(
 	/* PHASE 0: Release a possible s-latch we are holding on the
 	adaptive hash index latch if there is someone waiting behind */
 
-	if (UNIV_UNLIKELY(rw_lock_get_writer(&btr_search_latch) != RW_LOCK_NOT_LOCKED)
-	    && trx->has_search_latch) {
+	if (trx->has_search_latch
+	    && (rw_lock_get_writer(trx->search_latch) != RW_LOCK_NOT_LOCKED
+		|| trx->search_latch != btr_search_get_latch(index))) {
 
-		/* There is an x-latch request on the adaptive hash index:
-		release the s-latch to reduce starvation and wait for
-		BTR_SEA_TIMEOUT rounds before trying to keep it again over
-		calls from MySQL */
+		/* There is an x-latch request on the adaptive hash index
+		partition, or this search is on an index in a different
+		partition: release the s-latch to reduce starvation and
+		wait for BTR_SEA_TIMEOUT rounds before trying to keep it
+		again over calls from MySQL */
 
-		rw_lock_s_unlock(&btr_search_latch);
+		rw_lock_s_unlock(trx->search_latch);
 		trx->has_search_latch = FALSE;
+		trx->search_latch = NULL;
 
 		trx->search_latch_timeout = BTR_SEA_TIMEOUT;
 	}
@@ -3923,9 +3936,14 @@ row_search_for_mysql(
 
 #ifndef UNIV_SEARCH_DEBUG
 			if (!trx->has_search_latch) {
-				rw_lock_s_lock(&btr_search_latch);
+				trx->search_latch
+					= btr_search_get_latch(index);
+				rw_lock_s_lock(trx->search_latch);
 				trx->has_search_latch = TRUE;
 			}
+
+			ut_ad(trx->search_latch
+			      == btr_search_get_latch(index));
 #endif
 			switch (row_sel_try_search_shortcut_for_mysql(
 					&rec, prebuilt, &offsets, &heap,
@@ -3995,8 +4013,8 @@ release_search_latch_if_needed:
 
 					trx->search_latch_timeout--;
 
-					rw_lock_s_unlock(&btr_search_latch);
-					trx->has_search_latch = FALSE;
+					trx_search_latch_release_if_reserved(
+						trx);
 				}
 
 				/* NOTE that we do NOT store the cursor
@@ -4018,10 +4036,7 @@ release_search_latch_if_needed:
 	/*-------------------------------------------------------------*/
 	/* PHASE 3: Open or restore index cursor position */
 
-	if (trx->has_search_latch) {
-		rw_lock_s_unlock(&btr_search_latch);
-		trx->has_search_latch = FALSE;
-	}
+	trx_search_latch_release_if_reserved(trx);
 
 	/* The state of a running trx can only be changed by the
 	thread that is currently serving the transaction. Because we
@@ -5227,13 +5242,9 @@ row_search_check_if_query_cache_permitted(
 		/* If the isolation level is high, assign a read view for the
 		transaction if it does not yet have one */
 
-		if (trx->isolation_level >= TRX_ISO_REPEATABLE_READ
-		    && !trx->read_view) {
-
-			trx->read_view = read_view_open_now(
-				trx->id, trx->global_read_view_heap);
+		if (trx->isolation_level >= TRX_ISO_REPEATABLE_READ) {
 
-			trx->global_read_view = trx->read_view;
+			trx_assign_read_view(trx);
 		}
 	}
 
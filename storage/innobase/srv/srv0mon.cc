@@ -387,11 +387,60 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_FLUSH_PCT_FOR_LSN},
 
+	{"buffer_flush_checkpoint_age", "buffer",
+	 "Checkpoint age seen by the flush rate controller",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_CHECKPOINT_AGE},
+
+	{"buffer_flush_target_checkpoint_age", "buffer",
+	 "Checkpoint age the PID flush rate controller aims at",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_TARGET_CHECKPOINT_AGE},
+
+	{"buffer_flush_pid_feed_forward", "buffer",
+	 "Pages per second the PID flush rate controller estimates are"
+	 " being dirtied",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_PID_FEED_FORWARD},
+
+	{"buffer_flush_pid_error", "buffer",
+	 "Checkpoint age error of the PID flush rate controller, in"
+	 " thousandths of the target age",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_PID_ERROR},
+
+	{"buffer_flush_pid_integral", "buffer",
+	 "Integral term of the PID flush rate controller, in thousandths",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_PID_INTEGRAL},
+
 	{"buffer_flush_sync_waits", "buffer",
 	 "Number of times a wait happens due to sync flushing",
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_FLUSH_SYNC_WAITS},
 
+	{"buffer_flush_avg_time_thread", "buffer",
+	 "Avg time (ms) spent by a page cleaner thread in flush list"
+	 " batches per pass",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_AVG_TIME_THREAD},
+
+	{"buffer_LRU_batch_flush_avg_time_thread", "buffer",
+	 "Avg time (ms) spent by a page cleaner thread in LRU batches"
+	 " per pass",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_BATCH_FLUSH_AVG_TIME_THREAD},
+
+	{"buffer_flush_avg_pages_thread", "buffer",
+	 "Avg number of pages flushed by a page cleaner thread per pass",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_AVG_PAGES_THREAD},
+
+	{"buffer_flush_max_time_thread", "buffer",
+	 "Longest time (ms) a single page cleaner thread spent in one pass",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_MAX_TIME_THREAD},
+
 	/* Cumulative counter for flush batches for adaptive flushing  */
 	{"buffer_flush_adaptive_total_pages", "buffer",
 	 "Total pages flushed as part of adaptive flushing",
@@ -499,6 +548,28 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_LRU_GET_FREE_SEARCH},
 
+	{"buffer_LRU_get_free_fast", "Buffer",
+	 "Number of free blocks taken without acquiring the buffer pool mutex",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GET_FREE_FAST},
+
+	{"buffer_LRU_young_batches", "Buffer",
+	 "Number of batches of deferred moves to the head of the LRU list",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_YOUNG_BATCHES},
+
+	{"buffer_LRU_ghost_hits_old", "Buffer",
+	 "Number of pages read again after eviction from the old sublist"
+	 " (innodb_lru_policy=adaptive)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GHOST_HIT_OLD},
+
+	{"buffer_LRU_ghost_hits_young", "Buffer",
+	 "Number of pages read again after eviction from the working set"
+	 " (innodb_lru_policy=adaptive)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GHOST_HIT_YOUNG},
+
 	/* Cumulative counter for LRU search scans */
 	{"buffer_LRU_search_scanned", "buffer",
 	 "Total pages scanned as part of LRU search",
@@ -674,6 +745,17 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_OS_LOG_PENDING_WRITES},
 
+	{"os_aio_submit_calls", "os",
+	 "Number of io_submit() calls made for native aio",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_SUBMIT_CALLS},
+
+	{"os_aio_merged_requests", "os",
+	 "Number of native aio requests merged into the preceding"
+	 " contiguous request",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_OS_AIO_MERGED},
+
 	/* ========== Counters for Transaction Module ========== */
 	{"module_trx", "transaction", "Transaction Manager",
 	 MONITOR_MODULE,
@@ -716,6 +798,11 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_TRX_ACTIVE},
 
+	{"trx_read_views_reused", "transaction",
+	 "Number of read views reused without copying the snapshot",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_READ_VIEW_REUSED},
+
 	{"trx_rseg_history_len", "transaction",
 	 "Length of the TRX_RSEG_HISTORY list",
 	 static_cast<monitor_type_t>(
@@ -763,6 +850,11 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_PURGE_N_PAGE_HANDLED},
 
+	{"purge_undo_log_pages_prefetched", "purge",
+	 "Number of undo log pages read ahead for the next purge batch",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_N_PAGE_PREFETCHED},
+
 	{"purge_dml_delay_usec", "purge",
 	 "Microseconds DML to be delayed due to purge lagging",
 	 MONITOR_DISPLAY_CURRENT,
@@ -855,6 +947,34 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_LOG_WRITES},
 
+	{"log_copy_inline", "recovery",
+	 "Number of mini-transaction log copies done holding the log mutex"
+	 " because all the concurrent copy slots were busy",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_COPY_INLINE},
+
+	{"log_copy_waits", "recovery",
+	 "Number of times a log write waited for mini-transactions to finish"
+	 " copying their log records into the log buffer",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_COPY_WAITS},
+
+	{"log_waits_spin", "recovery",
+	 "Number of waits for the log writer threads that ended while"
+	 " spinning (innodb_log_wait_spin_rounds)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_WAITS_SPIN},
+
+	{"log_waits_event", "recovery",
+	 "Number of waits for the log writer threads that had to sleep",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_WAITS_EVENT},
+
+	{"log_flusher_fsyncs", "recovery",
+	 "Number of log file flushes done by the log flusher thread",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_FLUSHER_FSYNCS},
+
 	/* ========== Counters for Page Compression ========== */
 	{"module_compress", "compression", "Page Compression Info",
 	 MONITOR_MODULE,
@@ -879,6 +999,26 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_PAD_DECREMENTS},
 
+	{"compress_hole_pages_compressed", "compression",
+	 "Number of pages compressed on write by innodb_page_compression",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_HOLE_COMPRESS},
+
+	{"compress_hole_pages_decompressed", "compression",
+	 "Number of pages decompressed on read after innodb_page_compression",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_HOLE_DECOMPRESS},
+
+	{"compress_hole_bytes_saved", "compression",
+	 "Number of bytes not written because of innodb_page_compression",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_HOLE_SAVED},
+
+	{"compress_hole_punch_failures", "compression",
+	 "Number of times punching a hole after a compressed page failed",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_HOLE_PUNCH_FAILED},
+
 	/* ========== Counters for Index ========== */
 	{"module_index", "index", "Index Manager",
 	 MONITOR_MODULE,
@@ -1023,6 +1163,22 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_IBUF_SIZE},
 
+	{"ibuf_merge_sampled_ranges", "change_buffer",
+	 "Page ranges sampled by the background change buffer merge",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_SAMPLED},
+
+	{"ibuf_merge_skipped_ranges", "change_buffer",
+	 "Sampled page ranges that the background change buffer merge"
+	 " skipped for having few buffered changes",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_SKIPPED},
+
+	{"ibuf_merge_read_pages", "change_buffer",
+	 "Pages read by the background change buffer merge",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_READ},
+
 	/* ========== Counters for server operations ========== */
 	{"module_innodb", "innodb",
 	 "Counter for general InnoDB server wide operations and properties",
@@ -136,6 +136,9 @@ on duplicate key checking and foreign key checking */
 UNIV_INTERN ibool	srv_locks_unsafe_for_binlog = FALSE;
 /** Sort buffer size in index creation */
 UNIV_INTERN ulong	srv_sort_buf_size = 1048576;
+/** Number of threads that scan the clustered index and merge sort the
+entries when creating secondary indexes */
+UNIV_INTERN ulong	srv_index_build_threads = 4;
 /** Maximum modification log file size for online index creation */
 UNIV_INTERN unsigned long long	srv_online_max_size;
 
@@ -145,6 +148,14 @@ use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 UNIV_INTERN my_bool	srv_use_native_aio = TRUE;
 
+/* If this flag is TRUE, the Linux native aio uses io_uring instead of
+libaio, if InnoDB was compiled with it and the kernel supports it */
+UNIV_INTERN my_bool	srv_use_io_uring = FALSE;
+
+/* If this flag is TRUE, the io_urings use a kernel thread that polls
+the submission queues */
+UNIV_INTERN my_bool	srv_io_uring_sqpoll = FALSE;
+
 #ifdef __WIN__
 /* Windows native condition variables. We use runtime loading / function
 pointers, because they are not available on Windows Server 2003 and
@@ -199,6 +210,11 @@ UNIV_INTERN ib_uint64_t	srv_log_file_size_requested;
 /* size in database pages */
 UNIV_INTERN ulint	srv_log_buffer_size	= ULINT_MAX;
 UNIV_INTERN ulong	srv_flush_log_at_trx_commit = 1;
+UNIV_INTERN my_bool	srv_log_writer_threads = TRUE;
+UNIV_INTERN ulong	srv_log_wait_spin_rounds = 30;
+UNIV_INTERN ulong	srv_recovery_apply_threads = 4;
+UNIV_INTERN ulong	srv_tablespace_discovery_threads = 4;
+UNIV_INTERN my_bool	srv_lazy_tablespace_open = FALSE;
 UNIV_INTERN uint	srv_flush_log_at_timeout = 1;
 UNIV_INTERN ulong	srv_page_size		= UNIV_PAGE_SIZE_DEF;
 UNIV_INTERN ulong	srv_page_size_shift	= UNIV_PAGE_SIZE_SHIFT_DEF;
@@ -295,6 +311,18 @@ UNIV_INTERN ulong	srv_adaptive_flushing_lwm	= 10;
 /* Number of iterations over which adaptive flushing is averaged. */
 UNIV_INTERN ulong	srv_flushing_avg_loops		= 30;
 
+/* The flush rate controller used by the page_cleaner, one of
+srv_flush_controller_t. */
+UNIV_INTERN ulong	srv_adaptive_flushing_method
+	= SRV_FLUSH_CONTROLLER_HEURISTIC;
+
+/* The checkpoint age, in percent of log capacity, that the PID flush rate
+controller tries to maintain. */
+UNIV_INTERN ulong	srv_adaptive_flushing_target_pct	= 50;
+
+/* The number of page cleaner threads, the coordinator included. */
+UNIV_INTERN ulong	srv_n_page_cleaners		= 1;
+
 /* The number of purge threads to use.*/
 UNIV_INTERN ulong	srv_n_purge_threads = 1;
 
@@ -608,6 +636,12 @@ and/or load it during startup. */
 UNIV_INTERN char	srv_buffer_pool_dump_at_shutdown = FALSE;
 UNIV_INTERN char	srv_buffer_pool_load_at_startup = FALSE;
 
+/** Number of threads reading pages during a buffer pool load */
+UNIV_INTERN ulong	srv_buf_load_threads = 4;
+/** Maximum number of pages per second read by a buffer pool load,
+0 means unlimited */
+UNIV_INTERN ulong	srv_buf_load_io_capacity = 0;
+
 /** Slot index in the srv_sys->sys_threads array for the purge thread. */
 static const ulint	SRV_PURGE_SLOT	= 1;
 
@@ -1222,7 +1256,7 @@ srv_printf_innodb_monitor(
 	      "-------------------------------------\n", file);
 	ibuf_print(file);
 
-	ha_print_info(file, btr_search_sys->hash_index);
+	btr_search_print_info(file);
 
 	fprintf(file,
 		"%.2f hash searches/s, %.2f non-hash searches/s\n",
@@ -1249,6 +1283,7 @@ srv_printf_innodb_monitor(
 	fprintf(file, "Dictionary memory allocated " ULINTPF "\n",
 		dict_sys->size);
 
+	buf_flush_page_cleaner_print(file);
 	buf_print_io(file);
 
 #ifdef SSD_CACHE_FACE
@@ -1465,6 +1500,10 @@ srv_export_innodb_status(void)
 	export_vars.innodb_row_lock_time_max =
 		lock_sys->n_lock_max_wait_time / 1000;
 
+	export_vars.innodb_recovery_pages_applied = recv_n_pages_applied;
+
+	export_vars.innodb_recovery_apply_time = recv_apply_time_ms;
+
 	export_vars.innodb_rows_read = srv_stats.n_rows_read;
 
 	export_vars.innodb_rows_inserted = srv_stats.n_rows_inserted;
@@ -1568,7 +1607,7 @@ loop:
 		if (srv_print_innodb_monitor) {
 			/* Reset mutex_skipped counter everytime
 			srv_print_innodb_monitor changes. This is to
-			ensure we will not be blocked by lock_sys->mutex
+			ensure we will not be blocked by lock_sys->latch
 			for short duration information printing,
 			such as requested by sync_array_print_long_waits() */
 			if (!last_srv_print_monitor) {
@@ -51,6 +51,7 @@ Created 2/16/1996 Heikki Tuuri
 #include "os0file.h"
 #include "os0thread.h"
 #include "fil0fil.h"
+#include "fil0pagecompress.h"
 #include "fsp0fsp.h"
 #include "rem0rec.h"
 #include "mtr0mtr.h"
@@ -1759,6 +1760,21 @@ innobase_start_or_create_for_mysql(void)
 	srv_use_native_aio = FALSE;
 #endif /* __WIN__ */
 
+#if !defined(LINUX_IO_URING)
+	/* The io_uring backend was not compiled in. */
+	srv_use_io_uring = FALSE;
+#endif /* !LINUX_IO_URING */
+
+#ifndef HAVE_LZ4
+	if (fil_page_compression == FIL_PAGE_COMPRESSION_LZ4) {
+		/* LZ4 was not compiled in. */
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"innodb_page_compression=lz4 is not supported"
+			" by this build, using zlib instead.");
+		fil_page_compression = FIL_PAGE_COMPRESSION_ZLIB;
+	}
+#endif /* !HAVE_LZ4 */
+
 	if (srv_file_flush_method_str == NULL) {
 		/* These are the default options */
 
@@ -1806,12 +1822,25 @@ innobase_start_or_create_for_mysql(void)
 	/* Note that the call srv_boot() also changes the values of
 	some variables to the units used by InnoDB internally */
 
+#define BUF_POOL_SIZE_THRESHOLD (1024 * 1024 * 1024)
+	if (srv_buf_pool_size < BUF_POOL_SIZE_THRESHOLD) {
+		/* If buffer pool is less than 1 GB,
+		use only one buffer pool instance */
+		srv_buf_pool_instances = 1;
+	}
+
+	if (srv_n_page_cleaners > srv_buf_pool_instances) {
+		/* Each page cleaner owns at least one buffer
+		pool instance. This must be known before
+		srv_max_n_threads is computed. */
+		srv_n_page_cleaners = srv_buf_pool_instances;
+	}
+
 	/* Set the maximum number of threads which can wait for a semaphore
 	inside InnoDB: this is the 'sync wait array' size, as well as the
 	maximum number of threads that can wait in the 'srv_conc array' for
 	their time to enter InnoDB. */
 
-#define BUF_POOL_SIZE_THRESHOLD (1024 * 1024 * 1024)
 	srv_max_n_threads = 1   /* io_ibuf_thread */
 			    + 1 /* io_log_thread */
 			    + 1 /* lock_wait_timeout_thread */
@@ -1820,10 +1849,14 @@ innobase_start_or_create_for_mysql(void)
 			    + 1 /* srv_master_thread */
 			    + 1 /* srv_purge_coordinator_thread */
 			    + 1 /* buf_dump_thread */
+			    + srv_buf_load_threads /* buf_load_thread */
 			    + 1 /* dict_stats_thread */
 			    + 1 /* fts_optimize_thread */
 			    + 1 /* recv_writer_thread */
-			    + 1 /* buf_flush_page_cleaner_thread */
+			    + srv_recovery_apply_threads /* recv_apply_thread */
+			    + 1 /* recv_scan_read_thread */
+			    + srv_n_page_cleaners /* page cleaner threads */
+			    + 2 /* log_writer_thread, log_flusher_thread */
 			    + 1 /* trx_rollback_or_clean_all_recovered */
 			    + 128 /* added as margin, for use of
 				  InnoDB Memcached etc. */
@@ -1835,12 +1868,6 @@ innobase_start_or_create_for_mysql(void)
 			    + fts_sort_pll_degree * FTS_NUM_AUX_INDEX
 			      * max_connections;
 
-	if (srv_buf_pool_size < BUF_POOL_SIZE_THRESHOLD) {
-		/* If buffer pool is less than 1 GB,
-		use only one buffer pool instance */
-		srv_buf_pool_instances = 1;
-	}
-
 	srv_boot();
 
 	ib_logf(IB_LOG_LEVEL_INFO,
@@ -2738,7 +2765,13 @@ files_checked:
 	}
 
 	if (!srv_read_only_mode) {
+		buf_flush_page_cleaner_init();
+
 		os_thread_create(buf_flush_page_cleaner_thread, NULL, NULL);
+
+		if (srv_log_writer_threads) {
+			log_writer_threads_start();
+		}
 	}
 
 #ifdef UNIV_DEBUG
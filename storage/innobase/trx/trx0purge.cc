@@ -45,6 +45,12 @@ Created 3/26/1996 Heikki Tuuri
 #include "os0thread.h"
 #include "srv0mon.h"
 #include "mtr0log.h"
+#include "buf0rea.h"
+
+#include <map>
+
+/** Map of table_id to the purge node that purges the table in a batch */
+typedef std::map<table_id_t, purge_node_t*>	purge_table_map_t;
 
 /** Maximum allowable purge history length.  <=0 means 'infinite'. */
 UNIV_INTERN ulong		srv_max_purge_lag = 0;
@@ -956,7 +962,48 @@ trx_purge_fetch_next_rec(
 }
 
 /*******************************************************************//**
-This function runs a purge batch.
+Chooses the purge node with the fewest undo records in the batch.
+@return	purge node */
+static
+purge_node_t*
+trx_purge_get_least_loaded_node(
+/*============================*/
+	ulint		n_purge_threads,/*!< in: number of purge threads */
+	trx_purge_t*	purge_sys)	/*!< in: purge instance */
+{
+	que_thr_t*	thr;
+	purge_node_t*	least = NULL;
+	ulint		least_n_recs = ULINT_UNDEFINED;
+	ulint		i = 0;
+
+	for (thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
+	     thr != NULL && i < n_purge_threads;
+	     thr = UT_LIST_GET_NEXT(thrs, thr), ++i) {
+
+		purge_node_t*	node = (purge_node_t*) thr->child;
+		ulint		n_recs;
+
+		ut_a(!thr->is_active);
+
+		n_recs = node->undo_recs == NULL
+			? 0 : ib_vector_size(node->undo_recs);
+
+		if (n_recs < least_n_recs) {
+			least = node;
+			least_n_recs = n_recs;
+		}
+	}
+
+	ut_a(least != NULL);
+
+	return(least);
+}
+
+/*******************************************************************//**
+Fetches the undo records of a purge batch and attaches them to the purge
+nodes. All records of a table go to the same node, so that the purge
+threads do not contend for the pages of the same indexes. A table that
+was not seen before in the batch goes to the node with the fewest records.
 @return	number of undo log pages handled in the batch */
 static
 ulint
@@ -967,10 +1014,11 @@ trx_purge_attach_undo_recs(
 	purge_iter_t*	limit,		/*!< out: records read up to */
 	ulint		batch_size)	/*!< in: no. of pages to purge */
 {
-	que_thr_t*	thr;
-	ulint		i = 0;
-	ulint		n_pages_handled = 0;
-	ulint		n_thrs = UT_LIST_GET_LEN(purge_sys->query->thrs);
+	que_thr_t*		thr;
+	ulint			i = 0;
+	ulint			n_pages_handled = 0;
+	ulint			n_thrs = UT_LIST_GET_LEN(purge_sys->query->thrs);
+	purge_table_map_t	table_map;
 
 	ut_a(n_purge_threads > 0);
 
@@ -996,28 +1044,20 @@ trx_purge_attach_undo_recs(
 	/* There should never be fewer nodes than threads, the inverse
 	however is allowed because we only use purge threads as needed. */
 	ut_a(i == n_purge_threads);
-
-	/* Fetch and parse the UNDO records. The UNDO records are added
-	to a per purge node vector. */
-	thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
-	ut_a(n_thrs > 0 && thr != NULL);
+	ut_a(n_thrs > 0);
 
 	ut_ad(trx_purge_check_limit());
 
-	i = 0;
+	/* Fetch and parse the UNDO records. The UNDO records are added
+	to a per purge node vector. They are copied to purge_sys->heap,
+	because a node empties its own heap as soon as it is done. */
 
 	for (;;) {
 		purge_node_t*		node;
 		trx_purge_rec_t*	purge_rec;
 
-		ut_a(!thr->is_active);
-
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-
 		purge_rec = static_cast<trx_purge_rec_t*>(
-			mem_heap_zalloc(node->heap, sizeof(*purge_rec)));
+			mem_heap_zalloc(purge_sys->heap, sizeof(*purge_rec)));
 
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
@@ -1031,36 +1071,58 @@ trx_purge_attach_undo_recs(
 
 		/* Fetch the next record, and advance the purge_sys->iter. */
 		purge_rec->undo_rec = trx_purge_fetch_next_rec(
-			&purge_rec->roll_ptr, &n_pages_handled, node->heap);
+			&purge_rec->roll_ptr, &n_pages_handled,
+			purge_sys->heap);
 
-		if (purge_rec->undo_rec != NULL) {
+		if (purge_rec->undo_rec == NULL) {
+			break;
+		} else if (purge_rec->undo_rec == &trx_purge_dummy_rec) {
+			/* There is nothing to purge for a dummy record. */
+			node = trx_purge_get_least_loaded_node(
+				n_purge_threads, purge_sys);
+		} else {
+			ulint		type;
+			ulint		cmpl_info;
+			bool		updated_extern;
+			undo_no_t	undo_no;
+			table_id_t	table_id;
 
-			if (node->undo_recs == NULL) {
-				node->undo_recs = ib_vector_create(
-					ib_heap_allocator_create(node->heap),
-					sizeof(trx_purge_rec_t),
-					batch_size);
-			} else {
-				ut_a(!ib_vector_is_empty(node->undo_recs));
-			}
+			trx_undo_rec_get_pars(
+				purge_rec->undo_rec, &type, &cmpl_info,
+				&updated_extern, &undo_no, &table_id);
 
-			ib_vector_push(node->undo_recs, purge_rec);
+			purge_table_map_t::iterator	it
+				= table_map.find(table_id);
 
-			if (n_pages_handled >= batch_size) {
+			if (it != table_map.end()) {
+				node = it->second;
+			} else {
+				node = trx_purge_get_least_loaded_node(
+					n_purge_threads, purge_sys);
 
-				break;
+				table_map.insert(
+					purge_table_map_t::value_type(
+						table_id, node));
 			}
-		} else {
-			break;
 		}
 
-		thr = UT_LIST_GET_NEXT(thrs, thr);
+		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
 
-		if (!(++i % n_purge_threads)) {
-			thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
+		if (node->undo_recs == NULL) {
+			node->undo_recs = ib_vector_create(
+				ib_heap_allocator_create(node->heap),
+				sizeof(trx_purge_rec_t),
+				batch_size);
+		} else {
+			ut_a(!ib_vector_is_empty(node->undo_recs));
 		}
 
-		ut_a(thr != NULL);
+		ib_vector_push(node->undo_recs, purge_rec);
+
+		if (n_pages_handled >= batch_size) {
+
+			break;
+		}
 	}
 
 	ut_ad(trx_purge_check_limit());
@@ -1068,6 +1130,106 @@ trx_purge_attach_undo_recs(
 	return(n_pages_handled);
 }
 
+/*******************************************************************//**
+Issues asynchronous reads of the undo log pages that the next purge batch
+is going to parse: the pages that follow the current position in the
+current undo log, and the header pages of the next undo logs in the other
+rollback segments. Pages that are in the buffer pool are not read.
+@return	number of read requests issued */
+static
+ulint
+trx_purge_prefetch_undo_pages(
+/*==========================*/
+	ulint		n_pages)	/*!< in: maximum number of pages of
+					the current undo log to visit */
+{
+	trx_rseg_t*	rsegs[TRX_SYS_N_RSEGS];
+	ulint		n_rsegs;
+	ulint		n_reads = 0;
+
+	if (!purge_sys->next_stored || purge_sys->rseg == NULL) {
+
+		return(0);
+	}
+
+	if (purge_sys->offset != 0) {
+		const trx_rseg_t*	rseg = purge_sys->rseg;
+		ulint			page_no = purge_sys->page_no;
+
+		/* The next page number is stored in the previous page.
+		Follow the list while the pages are in the buffer pool,
+		and read the first page that is not. */
+
+		for (ulint i = 0; i < n_pages && page_no != FIL_NULL; i++) {
+			mtr_t		mtr;
+			buf_block_t*	block;
+
+			mtr_start(&mtr);
+
+			block = buf_page_get_gen(
+				rseg->space, rseg->zip_size, page_no,
+				RW_S_LATCH, NULL, BUF_PEEK_IF_IN_POOL,
+				__FILE__, __LINE__, &mtr);
+
+			if (block == NULL) {
+				mtr_commit(&mtr);
+
+				n_reads += buf_read_page_async(
+					rseg->space, page_no);
+				break;
+			}
+
+			buf_block_dbg_add_level(block, SYNC_TRX_UNDO_PAGE);
+
+			page_no = flst_get_next_addr(
+				buf_block_get_frame(block) + TRX_UNDO_PAGE_HDR
+				+ TRX_UNDO_PAGE_NODE, &mtr).page;
+
+			mtr_commit(&mtr);
+		}
+	}
+
+	/* Only the purge coordinator pops from the heap. User threads
+	may push while we are reading the rollback segments. */
+
+	mutex_enter(&purge_sys->bh_mutex);
+
+	n_rsegs = ib_bh_size(purge_sys->ib_bh);
+
+	ut_a(n_rsegs <= TRX_SYS_N_RSEGS);
+
+	for (ulint i = 0; i < n_rsegs; ++i) {
+		rsegs[i] = static_cast<rseg_queue_t*>(
+			ib_bh_get(purge_sys->ib_bh, i))->rseg;
+	}
+
+	mutex_exit(&purge_sys->bh_mutex);
+
+	for (ulint i = 0; i < n_rsegs; ++i) {
+		ulint	space;
+		ulint	page_no;
+
+		mutex_enter(&rsegs[i]->mutex);
+
+		space = rsegs[i]->space;
+		page_no = rsegs[i]->last_page_no;
+
+		mutex_exit(&rsegs[i]->mutex);
+
+		if (page_no != FIL_NULL) {
+			n_reads += buf_read_page_async(space, page_no);
+		}
+	}
+
+	if (n_reads > 0) {
+		os_aio_simulated_wake_handler_threads();
+
+		MONITOR_INC_VALUE(MONITOR_PURGE_N_PAGE_PREFETCHED, n_reads);
+	}
+
+	return(n_reads);
+}
+
 /*******************************************************************//**
 Calculate the DML delay required.
 @return delay in microseconds or ULINT_MAX */
@@ -1243,6 +1405,10 @@ trx_purge(
 run_synchronously:
 		++purge_sys->n_submitted;
 
+		/* While the batch runs, read the undo log pages that the
+		next batch will start with. */
+		trx_purge_prefetch_undo_pages(batch_size);
+
 		que_run_threads(thr);
 
 		os_atomic_inc_ulint(
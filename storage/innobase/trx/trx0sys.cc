@@ -165,30 +165,258 @@ trx_in_trx_list(
 #endif /* UNIV_DEBUG */
 
 /*****************************************************************//**
-Writes the value of max_trx_id to the file based trx system header. */
+Writes the value of max_trx_id to the file based trx system header, unless
+a value that covers the given trx id was already written. */
 UNIV_INTERN
 void
-trx_sys_flush_max_trx_id(void)
-/*==========================*/
+trx_sys_flush_max_trx_id(
+/*=====================*/
+	trx_id_t	id)	/*!< in: trx id that was assigned */
 {
 	mtr_t		mtr;
 	trx_sysf_t*	sys_header;
 
-	ut_ad(mutex_own(&trx_sys->mutex));
-
 	if (!srv_read_only_mode) {
 		mtr_start(&mtr);
 
+		/* The page latch serialises the threads that were
+		assigned ids above the margin at the same time. */
 		sys_header = trx_sysf_get(&mtr);
 
-		mlog_write_ull(
-			sys_header + TRX_SYS_TRX_ID_STORE,
-			trx_sys->max_trx_id, &mtr);
+		if (id >= trx_sys->flushed_max_trx_id
+		    + TRX_SYS_TRX_ID_WRITE_MARGIN) {
+
+			/* Write the current value, which exceeds id,
+			so that the threads that were assigned ids
+			below it need not wait for another write. */
+			trx_id_t	max_trx_id = trx_sys->max_trx_id;
+
+			ut_ad(max_trx_id > id);
+
+			mlog_write_ull(sys_header + TRX_SYS_TRX_ID_STORE,
+				       max_trx_id, &mtr);
+
+			trx_sys->flushed_max_trx_id = max_trx_id;
+		}
 
 		mtr_commit(&mtr);
 	}
 }
 
+/** Initial number of elements in a trx_sys->snapshot buffer */
+#define TRX_SNAPSHOT_INITIAL_SIZE	64
+
+/*****************************************************************//**
+Allocates a buffer for trx_sys->snapshot.
+@return	own: buffer */
+static
+trx_snapshot_buf_t*
+trx_sys_snapshot_buf_create(
+/*========================*/
+	ulint			size,	/*!< in: number of elements */
+	trx_snapshot_buf_t*	retired)/*!< in: the buffer being replaced,
+					or NULL */
+{
+	trx_snapshot_buf_t*	buf;
+
+	buf = static_cast<trx_snapshot_buf_t*>(
+		mem_alloc(sizeof(*buf) + size * sizeof(*buf->elems)));
+
+	buf->retired = retired;
+	buf->size = size;
+	buf->elems = reinterpret_cast<trx_snapshot_elem_t*>(&buf[1]);
+
+	return(buf);
+}
+
+/*****************************************************************//**
+Starts a modification of trx_sys->snapshot. */
+static
+void
+trx_sys_snapshot_write_begin(void)
+/*==============================*/
+{
+	ut_ad(mutex_own(&trx_sys->mutex));
+	ut_ad(!(trx_sys->snapshot.version & 1));
+
+	trx_sys->snapshot.version++;
+
+	/* Readers must see the odd version before any other change. */
+	os_wmb;
+	os_compiler_barrier();
+}
+
+/*****************************************************************//**
+Ends a modification of trx_sys->snapshot. */
+static
+void
+trx_sys_snapshot_write_end(void)
+/*============================*/
+{
+	ut_ad(mutex_own(&trx_sys->mutex));
+	ut_ad(trx_sys->snapshot.version & 1);
+
+	/* Readers must see all changes before the even version. */
+	os_wmb;
+	os_compiler_barrier();
+
+	trx_sys->snapshot.version++;
+}
+
+/*****************************************************************//**
+Inserts a transaction id into trx_sys->snapshot, between
+trx_sys_snapshot_write_begin() and trx_sys_snapshot_write_end(). */
+static
+void
+trx_sys_snapshot_insert(
+/*====================*/
+	trx_id_t	id)	/*!< in: transaction id */
+{
+	trx_snapshot_t*		snapshot = &trx_sys->snapshot;
+	trx_snapshot_buf_t*	buf = snapshot->buf;
+	ulint			i = snapshot->n_elems;
+
+	if (i == buf->size) {
+		/* Readers may be copying from the old buffer. Keep it
+		until shutdown. */
+		buf = trx_sys_snapshot_buf_create(2 * buf->size, buf);
+
+		memcpy(buf->elems, snapshot->buf->elems,
+		       i * sizeof *buf->elems);
+
+		snapshot->buf = buf;
+	}
+
+	/* New transactions have the biggest ids, except at startup
+	when the recovered transactions are inserted. */
+	for (; i > 0 && buf->elems[i - 1].id > id; i--) {
+		buf->elems[i] = buf->elems[i - 1];
+	}
+
+	ut_ad(i == 0 || buf->elems[i - 1].id < id);
+
+	buf->elems[i].id = id;
+	buf->elems[i].no = TRX_ID_MAX;
+
+	snapshot->n_elems++;
+
+	if (id >= snapshot->max_trx_id) {
+		snapshot->max_trx_id = id + 1;
+	}
+}
+
+/*****************************************************************//**
+Looks up a transaction id in trx_sys->snapshot.
+@return	index of the id in trx_sys->snapshot.buf->elems */
+static
+ulint
+trx_sys_snapshot_find(
+/*==================*/
+	trx_id_t	id)	/*!< in: transaction id */
+{
+	const trx_snapshot_elem_t*	elems = trx_sys->snapshot.buf->elems;
+	ulint				low = 0;
+	ulint				high = trx_sys->snapshot.n_elems;
+
+	ut_ad(mutex_own(&trx_sys->mutex));
+
+	while (high - low > 1) {
+		ulint	mid = (low + high) / 2;
+
+		if (elems[mid].id > id) {
+			high = mid;
+		} else {
+			low = mid;
+		}
+	}
+
+	ut_a(low < trx_sys->snapshot.n_elems);
+	ut_a(elems[low].id == id);
+
+	return(low);
+}
+
+/*****************************************************************//**
+Assigns a new id to a read-write transaction and adds it to
+trx_sys->snapshot. The caller must hold trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_sys_snapshot_add_new(
+/*=====================*/
+	trx_t*		trx)	/*!< in/out: read-write transaction */
+{
+	trx_sys_snapshot_write_begin();
+
+	trx->id = trx_sys_get_new_trx_id();
+
+	trx_sys_snapshot_insert(trx->id);
+
+	trx_sys_snapshot_write_end();
+}
+
+/*****************************************************************//**
+Adds a transaction with an id assigned earlier to trx_sys->snapshot.
+Used for recovered transactions. The caller must hold trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_sys_snapshot_add(
+/*=================*/
+	const trx_t*	trx)	/*!< in: read-write transaction */
+{
+	trx_sys_snapshot_write_begin();
+
+	trx_sys_snapshot_insert(trx->id);
+
+	trx_sys_snapshot_write_end();
+}
+
+/*****************************************************************//**
+Assigns the serialisation number trx->no of a committing read-write
+transaction and publishes it in trx_sys->snapshot. The caller must hold
+trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_sys_snapshot_assign_no(
+/*=======================*/
+	trx_t*		trx)	/*!< in/out: read-write transaction */
+{
+	ulint	i = trx_sys_snapshot_find(trx->id);
+
+	trx_sys_snapshot_write_begin();
+
+	trx->no = trx_sys_get_new_trx_id();
+
+	trx_sys->snapshot.buf->elems[i].no = trx->no;
+
+	if (trx->no >= trx_sys->snapshot.max_trx_id) {
+		trx_sys->snapshot.max_trx_id = trx->no + 1;
+	}
+
+	trx_sys_snapshot_write_end();
+}
+
+/*****************************************************************//**
+Removes a read-write transaction from trx_sys->snapshot. The caller must
+hold trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_sys_snapshot_remove(
+/*====================*/
+	const trx_t*	trx)	/*!< in: read-write transaction */
+{
+	trx_snapshot_t*	snapshot = &trx_sys->snapshot;
+	ulint		i = trx_sys_snapshot_find(trx->id);
+
+	trx_sys_snapshot_write_begin();
+
+	memmove(snapshot->buf->elems + i, snapshot->buf->elems + i + 1,
+		(snapshot->n_elems - i - 1) * sizeof *snapshot->buf->elems);
+
+	snapshot->n_elems--;
+
+	trx_sys_snapshot_write_end();
+}
+
 /*****************************************************************//**
 Updates the offset information about the end of the MySQL binlog entry
 which corresponds to the transaction just being committed. In a MySQL
@@ -513,17 +741,21 @@ trx_sys_init_at_db_start(void)
 	}
 
 	/* VERY important: after the database is started, max_trx_id value is
-	divisible by TRX_SYS_TRX_ID_WRITE_MARGIN, and the 'if' in
-	trx_sys_get_new_trx_id will evaluate to TRUE when the function
-	is first time called, and the value for trx id will be written
-	to the disk-based header! Thus trx id values will not overlap when
-	the database is repeatedly started! */
+	at least 2 * TRX_SYS_TRX_ID_WRITE_MARGIN above flushed_max_trx_id,
+	and the 'if' in trx_sys_get_new_trx_id will evaluate to TRUE when
+	the function is first time called, and the value for trx id will be
+	written to the disk-based header! Thus trx id values will not overlap
+	when the database is repeatedly started! */
+
+	trx_sys->flushed_max_trx_id = mach_read_from_8(
+		sys_header + TRX_SYS_TRX_ID_STORE);
 
 	trx_sys->max_trx_id = 2 * TRX_SYS_TRX_ID_WRITE_MARGIN
-		+ ut_uint64_align_up(mach_read_from_8(sys_header
-						   + TRX_SYS_TRX_ID_STORE),
+		+ ut_uint64_align_up(trx_sys->flushed_max_trx_id,
 				     TRX_SYS_TRX_ID_WRITE_MARGIN);
 
+	trx_sys->snapshot.max_trx_id = trx_sys->max_trx_id;
+
 	ut_d(trx_sys->rw_max_trx_id = trx_sys->max_trx_id);
 
 	UT_LIST_INIT(trx_sys->mysql_trx_list);
@@ -592,6 +824,9 @@ trx_sys_create(void)
 	trx_sys = static_cast<trx_sys_t*>(mem_zalloc(sizeof(*trx_sys)));
 
 	mutex_create(trx_sys_mutex_key, &trx_sys->mutex, SYNC_TRX_SYS);
+
+	trx_sys->snapshot.buf = trx_sys_snapshot_buf_create(
+		TRX_SNAPSHOT_INITIAL_SIZE, NULL);
 }
 
 /*****************************************************************//**
@@ -1225,6 +1460,14 @@ trx_sys_close(void)
 	ut_a(UT_LIST_GET_LEN(trx_sys->ro_trx_list) == 0);
 	ut_a(UT_LIST_GET_LEN(trx_sys->rw_trx_list) == 0);
 	ut_a(UT_LIST_GET_LEN(trx_sys->mysql_trx_list) == 0);
+	ut_a(trx_sys->snapshot.n_elems == 0);
+
+	while (trx_sys->snapshot.buf != NULL) {
+		trx_snapshot_buf_t*	buf = trx_sys->snapshot.buf;
+
+		trx_sys->snapshot.buf = buf->retired;
+		mem_free(buf);
+	}
 
 	mutex_free(&trx_sys->mutex);
 
@@ -292,6 +292,8 @@ trx_free_for_background(
 	ut_a(trx->update_undo == NULL);
 	ut_a(trx->read_view == NULL);
 
+	trx->closed_read_view = NULL;
+
 	trx_free(trx);
 }
 
@@ -316,6 +318,10 @@ trx_free_prepared(
 	UT_LIST_REMOVE(trx_list, trx_sys->rw_trx_list, trx);
 	ut_d(trx->in_rw_trx_list = FALSE);
 
+	mutex_enter(&trx_sys->mutex);
+	trx_sys_snapshot_remove(trx);
+	mutex_exit(&trx_sys->mutex);
+
 	/* Undo trx_resurrect_table_locks(). */
 	UT_LIST_INIT(trx->lock.trx_locks);
 
@@ -393,6 +399,12 @@ trx_list_rw_insert_ordered(
 		UT_LIST_ADD_LAST(trx_list, trx_sys->rw_trx_list, trx);
 	}
 
+	/* We are still running in single threaded bootstrap mode. The
+	mutex is only acquired to satisfy the debug assertions. */
+	mutex_enter(&trx_sys->mutex);
+	trx_sys_snapshot_add(trx);
+	mutex_exit(&trx_sys->mutex);
+
 #ifdef UNIV_DEBUG
 	if (trx->id > trx_sys->rw_max_trx_id) {
 		trx_sys->rw_max_trx_id = trx->id;
@@ -852,14 +864,37 @@ trx_start_low(
 			srv_undo_logs, srv_undo_tablespaces);
 	}
 
-	/* The initial value for trx->no: TRX_ID_MAX is used in
-	read_view_open_now: */
+	/* The initial value for trx->no: TRX_ID_MAX is also used for it
+	in trx_sys->snapshot: */
 
 	trx->no = TRX_ID_MAX;
 
 	ut_a(ib_vector_is_empty(trx->autoinc_locks));
 	ut_a(ib_vector_is_empty(trx->lock.table_locks));
 
+	ut_ad(!trx->in_rw_trx_list);
+	ut_ad(!trx->in_ro_trx_list);
+
+#ifdef TRX_SYS_ATOMIC_TRX_ID
+	if (trx->read_only && trx_is_autocommit_non_locking(trx)) {
+
+		/* An autocommit non-locking SELECT is in neither
+		transaction list, and its id is not needed by read views.
+		lock_print_info_all_transactions() may see a stale
+		trx->state for it. */
+
+		trx->state = TRX_STATE_ACTIVE;
+
+		trx->id = trx_sys_get_new_trx_id();
+
+		trx->start_time = ut_time();
+
+		MONITOR_INC(MONITOR_TRX_ACTIVE);
+
+		return;
+	}
+#endif /* TRX_SYS_ATOMIC_TRX_ID */
+
 	mutex_enter(&trx_sys->mutex);
 
 	/* If this transaction came from trx_allocate_for_mysql(),
@@ -869,13 +904,10 @@ trx_start_low(
 
 	trx->state = TRX_STATE_ACTIVE;
 
-	trx->id = trx_sys_get_new_trx_id();
-
-	ut_ad(!trx->in_rw_trx_list);
-	ut_ad(!trx->in_ro_trx_list);
-
 	if (trx->read_only) {
 
+		trx->id = trx_sys_get_new_trx_id();
+
 		/* Note: The trx_sys_t::ro_trx_list doesn't really need to
 		be ordered, we should exploit this using a list type that
 		doesn't need a list wide lock to increase concurrency. */
@@ -890,6 +922,12 @@ trx_start_low(
 		      || srv_force_recovery >= SRV_FORCE_NO_TRX_UNDO);
 
 		ut_ad(!trx_is_autocommit_non_locking(trx));
+
+		/* The id is assigned while the transaction is being
+		added to trx_sys->snapshot, so that no read view can see
+		the id without the transaction. */
+		trx_sys_snapshot_add_new(trx);
+
 		UT_LIST_ADD_FIRST(trx_list, trx_sys->rw_trx_list, trx);
 		ut_d(trx->in_rw_trx_list = TRUE);
 #ifdef UNIV_DEBUG
@@ -924,7 +962,13 @@ trx_serialisation_number_get(
 
 	mutex_enter(&trx_sys->mutex);
 
-	trx->no = trx_sys_get_new_trx_id();
+	if (trx->read_only) {
+		/* A read-only transaction that modified temporary
+		tables is not in trx_sys->snapshot. */
+		trx->no = trx_sys_get_new_trx_id();
+	} else {
+		trx_sys_snapshot_assign_no(trx);
+	}
 
 	/* If the rollack segment is not empty then the
 	new trx_t::no can't be less than any trx_t::no
@@ -1181,7 +1225,12 @@ trx_commit_in_memory(
 
 		trx->state = TRX_STATE_NOT_STARTED;
 
-		read_view_remove(trx->global_read_view, false);
+		/* Keep the view for the next transaction of this
+		connection. It can be reused if no read-write transaction
+		starts or commits before then. */
+		if (trx->global_read_view != NULL) {
+			read_view_close_for_mysql(trx);
+		}
 
 		MONITOR_INC(MONITOR_TRX_NL_RO_COMMIT);
 	} else {
@@ -1203,6 +1252,7 @@ trx_commit_in_memory(
 		} else {
 			UT_LIST_REMOVE(trx_list, trx_sys->rw_trx_list, trx);
 			ut_d(trx->in_rw_trx_list = FALSE);
+			trx_sys_snapshot_remove(trx);
 			MONITOR_INC(MONITOR_TRX_RW_COMMIT);
 		}
 
@@ -1215,19 +1265,22 @@ trx_commit_in_memory(
 		trx->state = TRX_STATE_NOT_STARTED;
 
 		/* We already own the trx_sys_t::mutex, by doing it here we
-		avoid a potential context switch later. */
+		avoid a potential context switch later. A closed view is
+		not kept: it could not be reused after this commit. */
 		read_view_remove(trx->global_read_view, true);
 
 		ut_ad(trx_sys_validate_trx_list());
 
 		mutex_exit(&trx_sys->mutex);
-	}
 
-	if (trx->global_read_view != NULL) {
+		if (trx->global_read_view != NULL
+		    || trx->closed_read_view != NULL) {
 
-		mem_heap_empty(trx->global_read_view_heap);
+			mem_heap_empty(trx->global_read_view_heap);
 
-		trx->global_read_view = NULL;
+			trx->global_read_view = NULL;
+			trx->closed_read_view = NULL;
+		}
 	}
 
 	trx->read_view = NULL;
@@ -1446,6 +1499,8 @@ trx_cleanup_at_db_startup(
 	assert_trx_in_rw_list(trx);
 	ut_d(trx->in_rw_trx_list = FALSE);
 
+	trx_sys_snapshot_remove(trx);
+
 	mutex_exit(&trx_sys->mutex);
 
 	/* Change the transaction state without mutex protection, now
@@ -1475,13 +1530,9 @@ trx_assign_read_view(
 		return(trx->read_view);
 	}
 
-	if (!trx->read_view) {
+	trx->read_view = read_view_open_for_mysql(trx);
 
-		trx->read_view = read_view_open_now(
-			trx->id, trx->global_read_view_heap);
-
-		trx->global_read_view = trx->read_view;
-	}
+	trx->global_read_view = trx->read_view;
 
 	return(trx->read_view);
 }
@@ -1821,7 +1872,7 @@ state_ok:
 
 /**********************************************************************//**
 Prints info about a transaction.
-The caller must hold lock_sys->mutex and trx_sys->mutex.
+The caller must hold lock_sys->latch and trx_sys->mutex.
 When possible, use trx_print() instead. */
 UNIV_INTERN
 void
@@ -1843,7 +1894,7 @@ trx_print_latched(
 
 /**********************************************************************//**
 Prints info about a transaction.
-Acquires and releases lock_sys->mutex and trx_sys->mutex. */
+Acquires and releases lock_sys->latch and trx_sys->mutex. */
 UNIV_INTERN
 void
 trx_print(
@@ -1889,7 +1940,7 @@ trx_assert_started(
 	/* trx->state can change from or to NOT_STARTED while we are holding
 	trx_sys->mutex for non-locking autocommit selects but not for other
 	types of transactions. It may change from ACTIVE to PREPARED. Unless
-	we are holding lock_sys->mutex, it may also change to COMMITTED. */
+	we are holding lock_sys->latch, it may also change to COMMITTED. */
 
 	switch (trx->state) {
 	case TRX_STATE_PREPARED:
@@ -2135,7 +2186,7 @@ This function is used to find one X/Open XA distributed transaction
 which is in the prepared state
 @return	trx on match, the trx->xid will be invalidated;
 note that the trx may have been committed, unless the caller is
-holding lock_sys->mutex */
+holding lock_sys->latch */
 static __attribute__((nonnull, warn_unused_result))
 trx_t*
 trx_get_trx_by_xid_low(
@@ -2181,7 +2232,7 @@ This function is used to find one X/Open XA distributed transaction
 which is in the prepared state
 @return	trx or NULL; on match, the trx->xid will be invalidated;
 note that the trx may have been committed, unless the caller is
-holding lock_sys->mutex */
+holding lock_sys->latch */
 UNIV_INTERN
 trx_t*
 trx_get_trx_by_xid(